@@ -3,9 +3,9 @@
 namespace bts
 {
 
-Application::Application(ILogger& logger, std::initializer_list<std::shared_ptr<IComponent>> components)
+Application::Application(ILogger& logger, std::vector<std::shared_ptr<IComponent>> components)
     :   logger(logger, "[Application]"),
-        components(components)
+        components(std::move(components))
 {}
 
 Application::~Application()
@@ -4,7 +4,6 @@
 #include "IApplicationEnvironment.hpp"
 #include "Logger/PrefixedLogger.hpp"
 #include <memory>
-#include <initializer_list>
 #include <vector>
 
 namespace bts
@@ -13,7 +12,7 @@ namespace bts
 class Application : public IComponent
 {
 public:
-    Application(ILogger &logger, std::initializer_list<std::shared_ptr<IComponent>> components);
+    Application(ILogger &logger, std::vector<std::shared_ptr<IComponent>> components);
     ~Application();
 
     void start() override;
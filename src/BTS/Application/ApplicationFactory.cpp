@@ -1,10 +1,16 @@
 #include "ApplicationFactory.hpp"
 #include "Application.hpp"
-#include "SibMolester.hpp"
+#include "SibScheduler.hpp"
 #include "UeConnection/UeConnectionFactory.hpp"
 #include "UeConnection/UeConnectionSpawner.hpp"
-#include "UeRelay/UeRelay.hpp"
+#include "UeRelay/ShardedUeRelay.hpp"
+#include "UeRelay/FlatUeRelay.hpp"
+#include "UeRelay/LoadLimitingUeRelay.hpp"
 #include "ConsoleCommands.hpp"
+#include "Peering/PeerRouter.hpp"
+#include "Peering/PeeringUeRelay.hpp"
+#include "Peering/PeerLinkSpawner.hpp"
+#include <algorithm>
 
 namespace bts
 {
@@ -14,13 +20,75 @@ std::unique_ptr<IComponent> createApplication(IApplicationEnvironment& environme
     auto syncGuard = std::make_shared<SyncGuard>();
     auto& logger = environment.getLogger();
 
-    auto ueRelay = std::make_shared<UeRelay>(environment.getLogger());
-    auto ueConnectionFactory = std::make_shared<UeConnectionFactory>(environment.getLogger(), syncGuard);
+    std::shared_ptr<IUeRelay> ueRelay;
+    SyncGuardPtr ueConnectionSyncGuard = syncGuard;
+    auto numberOfRelayShards = environment.getProperty("relay_shards", 0);
+    if (numberOfRelayShards > 0)
+    {
+        logger.logInfo("Sharded UE relay, shards: ", numberOfRelayShards);
+        ueRelay = std::make_shared<ShardedUeRelay>(environment.getLogger(), numberOfRelayShards);
+        // sharded relay does not need the global guard - so UE connections can forward in parallel
+        ueConnectionSyncGuard = nullptr;
+    }
+    else
+    {
+        auto relayCapacity = environment.getProperty("relay_capacity", FlatUeRelay::DEFAULT_CAPACITY);
+        ueRelay = std::make_shared<FlatUeRelay>(environment.getLogger(), std::max(relayCapacity, 1));
+    }
+    std::vector<std::shared_ptr<IComponent>> components;
+    if (environment.getProperty("peer_port", 0) > 0)
+    {
+        logger.logInfo("Peering with other BTS");
+        // forwarded from peers - delivered as if sent by local UE
+        auto localDelivery = [localRelay = ueRelay, syncGuard = ueConnectionSyncGuard](Frame message, PhoneNumber to)
+        {
+            std::unique_lock<SyncGuard> lock;
+            if (syncGuard)
+            {
+                lock = std::unique_lock<SyncGuard>(*syncGuard);
+            }
+            return localRelay->sendMessage(std::move(message), to);
+        };
+        auto peerRouter = std::make_shared<PeerRouter>(environment.getBtsId(), environment.getLogger(), localDelivery);
+        ueRelay = std::make_shared<PeeringUeRelay>(ueRelay, peerRouter);
+        components.push_back(std::make_shared<PeerLinkSpawner>(environment, peerRouter));
+    }
+    auto maxAttached = environment.getProperty("max_attached", 0);
+    auto maxForwardRate = environment.getProperty("max_forward_rate", 0);
+    if (maxAttached > 0 or maxForwardRate > 0)
+    {
+        logger.logInfo("Load limited, max attached: ", maxAttached, ", max forwarded messages/s: ", maxForwardRate);
+        ueRelay = std::make_shared<LoadLimitingUeRelay>(ueRelay, environment.getLogger(),
+                                                        std::max(maxAttached, 0), std::max(maxForwardRate, 0));
+    }
+    auto callSessions = std::make_shared<CallSessions>(environment.getLogger());
+    std::shared_ptr<SmsStore> smsStore;
+    auto smsStorePath = environment.getProperty("sms_store", std::string{});
+    if (not smsStorePath.empty())
+    {
+        SmsStore::Options smsStoreOptions{};
+        smsStoreOptions.quota = std::max(environment.getProperty("sms_quota", static_cast<int>(smsStoreOptions.quota)), 0);
+        try
+        {
+            smsStore = std::make_shared<SmsStore>(smsStorePath, environment.getLogger(), smsStoreOptions);
+            logger.logInfo("SMS stored for offline UE in: ", smsStorePath, ", quota: ", smsStoreOptions.quota);
+        }
+        catch (std::exception const& ex)
+        {
+            logger.logError("SMS store not opened: ", smsStorePath, ", ", ex.what());
+        }
+    }
+    auto ueConnectionFactory = std::make_shared<UeConnectionFactory>(environment.getLogger(), ueConnectionSyncGuard,
+                                                                     callSessions, smsStore);
     auto ueConnectionSpawner = std::make_shared<UeConnectionSpawner>(environment, ueConnectionFactory, ueRelay, syncGuard);
-    auto sibMolester = std::make_shared<SibMolester>(ueRelay, syncGuard, environment.getBtsId(), environment.getLogger());
+    std::chrono::milliseconds sibDiscoveryLatency{
+        environment.getProperty("sib_latency_ms", SibScheduler::DEFAULT_DISCOVERY_LATENCY.count())};
+    std::chrono::milliseconds sibPeriod{environment.getProperty("sib_period_ms", SibScheduler::DEFAULT_PERIOD.count())};
+    auto sibScheduler = std::make_shared<SibScheduler>(ueRelay, syncGuard, environment.getBtsId(), environment.getLogger(),
+                                                       sibDiscoveryLatency, sibPeriod);
     auto consoleCommands = std::make_shared<ConsoleCommands>(environment.getConsole(), environment, environment.getLogger(), ueRelay, syncGuard);
-    std::initializer_list<std::shared_ptr<IComponent>> components = {ueConnectionSpawner, sibMolester, consoleCommands};
-    return std::make_unique<Application>(environment.getLogger(), components);
+    components.insert(components.begin(), {ueConnectionSpawner, sibScheduler, consoleCommands});
+    return std::make_unique<Application>(environment.getLogger(), std::move(components));
 }
 
 }
@@ -0,0 +1,202 @@
+#include "CallSessions.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace bts
+{
+
+namespace schema = common::schema;
+using common::MessageId;
+
+CallSessions::CallSessions(common::ILogger &logger)
+    : logger(logger, "[CALLS]")
+{}
+
+void CallSessions::onCallRequest(PhoneNumber caller, PhoneNumber callee, const PartyPtr &callerParty)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (auto previous = sessions.find(caller.value); previous != sessions.end())
+    {
+        logger.logDebug("Call replaced: ", previous->second->caller, "->", previous->second->callee);
+        remove(previous->second);
+    }
+    callerParty->phone = caller;
+    // indexed by the callee when accepted - so it can still be in other call till then
+    sessions.emplace(caller.value, std::make_shared<Session>(Session{caller, callee, callerParty}));
+    logger.logDebug("Call requested: ", caller, "->", callee);
+}
+
+void CallSessions::onCallAccepted(PhoneNumber callee, PhoneNumber caller, const PartyPtr &calleeParty)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto requested = sessions.find(caller.value);
+    if (requested == sessions.end() or requested->second->callee != callee or requested->second->calleeParty)
+    {
+        logger.logDebug("Not requested call accepted: ", caller, "->", callee);
+        return;
+    }
+    auto session = requested->second;
+    if (auto previous = sessions.find(callee.value); previous != sessions.end())
+    {
+        logger.logDebug("Call replaced: ", previous->second->caller, "->", previous->second->callee);
+        remove(previous->second);
+    }
+    calleeParty->phone = callee;
+    session->calleeParty = calleeParty;
+    sessions.emplace(callee.value, session);
+    session->callerParty->link(caller, callee, calleeParty);
+    calleeParty->link(callee, caller, session->callerParty);
+    logger.logDebug("Call established: ", caller, "->", callee);
+}
+
+void CallSessions::onCallDropped(PhoneNumber from, PhoneNumber to)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (auto session = find(from, to))
+    {
+        logger.logDebug("Call dropped: ", session->caller, "->", session->callee, " by: ", from);
+        remove(session);
+    }
+}
+
+void CallSessions::release(const PartyPtr &party)
+{
+    PartyPtr peerParty;
+    Frame callDropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = sessions.find(party->phone.value);
+        if (found == sessions.end())
+        {
+            return;
+        }
+        auto session = found->second;
+        if (session->callerParty != party and session->calleeParty != party)
+        {
+            return;
+        }
+        if (session->calleeParty)
+        {
+            bool isCaller = session->callerParty == party;
+            peerParty = isCaller ? session->calleeParty : session->callerParty;
+            auto from = isCaller ? session->caller : session->callee;
+            auto to = isCaller ? session->callee : session->caller;
+            callDropped = schema::encode<MessageId::CallDropped>(from, to);
+            logger.logInfo("Call dropped by BTS: ", from, "->", to, " - UE gone");
+        }
+        remove(session);
+    }
+    // UE of the peer might be released concurrently - it is locked by send only
+    if (peerParty)
+    {
+        peerParty->send(std::move(callDropped));
+    }
+}
+
+std::size_t CallSessions::countEstablished() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::count_if(sessions.begin(), sessions.end(), [](auto& entry)
+    {
+        return entry.second->calleeParty and entry.first == entry.second->caller.value;
+    });
+}
+
+std::size_t CallSessions::countPending() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::count_if(sessions.begin(), sessions.end(), [](auto& entry)
+    {
+        return not entry.second->calleeParty;
+    });
+}
+
+void CallSessions::remove(SessionPtr session)
+{
+    for (auto phone: {session->caller, session->callee})
+    {
+        auto found = sessions.find(phone.value);
+        if (found != sessions.end() and found->second == session)
+        {
+            sessions.erase(found);
+        }
+    }
+    session->callerParty->unlink();
+    if (session->calleeParty)
+    {
+        session->calleeParty->unlink();
+    }
+}
+
+CallSessions::SessionPtr CallSessions::find(PhoneNumber first, PhoneNumber second) const
+{
+    for (auto [phone, other]: {std::pair{first, second}, std::pair{second, first}})
+    {
+        auto found = sessions.find(phone.value);
+        if (found == sessions.end())
+        {
+            continue;
+        }
+        auto& session = found->second;
+        if ((session->caller == phone and session->callee == other)
+            or (session->callee == phone and session->caller == other))
+        {
+            return session;
+        }
+    }
+    return nullptr;
+}
+
+CallSessions::Party::Party(IUeConnection &ue)
+    : ue(&ue)
+{}
+
+bool CallSessions::Party::talk(const Frame &message)
+{
+    auto link = callLink.load();
+    if (not link or message.size() < link->talkHeader.size()
+        or not std::equal(link->talkHeader.begin(), link->talkHeader.end(), message.begin()))
+    {
+        return false;
+    }
+    auto peer = link->peer.lock();
+    return peer and peer->send(message);
+}
+
+bool CallSessions::Party::isInCall() const
+{
+    return callLink.load() != nullptr;
+}
+
+bool CallSessions::Party::send(Frame message)
+{
+    std::lock_guard<std::mutex> lock(ueMutex);
+    if (not ue)
+    {
+        return false;
+    }
+    ue->sendMessage(std::move(message));
+    return true;
+}
+
+void CallSessions::Party::release()
+{
+    std::lock_guard<std::mutex> lock(ueMutex);
+    ue = nullptr;
+}
+
+void CallSessions::Party::link(PhoneNumber own, PhoneNumber peer, const PartyPtr &peerParty)
+{
+    auto callTalk = schema::encode<MessageId::CallTalk>(own, peer);
+    auto newLink = std::make_shared<Link>();
+    newLink->peer = peerParty;
+    std::copy_n(callTalk.value.begin(), newLink->talkHeader.size(), newLink->talkHeader.begin());
+    callLink.store(std::move(newLink));
+}
+
+void CallSessions::Party::unlink()
+{
+    callLink.store(nullptr);
+}
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "UeConnection/IUeConnection.hpp"
+#include "Messages/MessageSchema.hpp"
+#include "Logger/PrefixedLogger.hpp"
+
+namespace bts
+{
+
+/**
+ * Calls between UE of this BTS: CallRequest -> CallAccepted (established) -> CallDropped,
+ * or till either UE disconnects - then BTS sends CallDropped to the other one on its behalf.
+ * One call per phone - new CallRequest or CallAccepted replaces the previous call of the phone.
+ *
+ * Parties of the established call are linked directly (Party::talk) - their CallTalk frames go straight
+ * to the peer connection, without the global SyncGuard, relay lookup and sender checks:
+ * only the header is compared with the one precomputed for the call.
+ * Calls with UE of peer BTS are not tracked - their CallTalk is forwarded the generic way.
+ * So is CallTalk sent with narrow header (old UE, see NarrowHeader.hpp) - it must be widened first.
+ *
+ * Thread safe.
+ */
+class CallSessions
+{
+public:
+    class Party;
+    using PartyPtr = std::shared_ptr<Party>;
+
+    explicit CallSessions(common::ILogger& logger);
+
+    /**
+     * Shall be called when the message was forwarded to the other party
+     */
+    void onCallRequest(PhoneNumber caller, PhoneNumber callee, const PartyPtr& callerParty);
+    void onCallAccepted(PhoneNumber callee, PhoneNumber caller, const PartyPtr& calleeParty);
+    void onCallDropped(PhoneNumber from, PhoneNumber to);
+
+    /**
+     * Party is not in call any more (UE disconnected or attached with other phone)
+     */
+    void release(const PartyPtr& party);
+
+    std::size_t countEstablished() const;
+    std::size_t countPending() const;
+
+private:
+    struct Session
+    {
+        PhoneNumber caller;
+        PhoneNumber callee;
+        PartyPtr callerParty;
+        // known since CallAccepted
+        PartyPtr calleeParty{};
+    };
+    using SessionPtr = std::shared_ptr<Session>;
+
+    // shall be called with mutex locked, session by value - it might be the one erased from sessions
+    void remove(SessionPtr session);
+    SessionPtr find(PhoneNumber first, PhoneNumber second) const;
+
+    common::PrefixedLogger logger;
+    mutable std::mutex mutex;
+    // by phone of both parties
+    std::unordered_map<PhoneNumber::Value, SessionPtr> sessions;
+};
+
+/**
+ * Call endpoint of one UeConnection - created with it, released by it before it is destroyed
+ */
+class CallSessions::Party
+{
+public:
+    explicit Party(IUeConnection& ue);
+
+    /**
+     * Fast path of CallTalk from this party
+     * @return false when the message is not CallTalk of the established call or the peer is gone -
+     *         it shall be forwarded the generic way
+     */
+    bool talk(const Frame& message);
+
+    bool isInCall() const;
+
+    /**
+     * @return false when UE is released
+     */
+    bool send(Frame message);
+    void release();
+
+private:
+    friend class CallSessions;
+
+    struct Link
+    {
+        std::weak_ptr<Party> peer;
+        std::array<std::uint8_t, common::schema::HEADER_SIZE> talkHeader;
+    };
+
+    void link(PhoneNumber own, PhoneNumber peer, const PartyPtr& peerParty);
+    void unlink();
+
+    std::mutex ueMutex;
+    IUeConnection* ue;
+    std::atomic<std::shared_ptr<const Link>> callLink{};
+    // of UE, when in any session - guarded by CallSessions mutex
+    PhoneNumber phone{};
+};
+
+}
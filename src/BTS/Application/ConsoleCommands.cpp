@@ -1,5 +1,10 @@
 #include "ConsoleCommands.hpp"
 #include "TestCommands/TestCommands.hpp"
+#include "Statistics/ForwardingLatency.hpp"
+#include "Metrics/MetricsRegistry.hpp"
+#include "Messages/MessageSchema.hpp"
+#include <algorithm>
+#include <sstream>
 
 namespace bts
 {
@@ -30,6 +35,10 @@ void ConsoleCommands::start()
     console.addCloseCommand();
     console.addHelpCommand();
     console.addCommand("t", "Test commands - details in implementation",std::bind(&ConsoleCommands::testCommands, this, argsArgument, streamArgument));
+    console.addCommand("f", "Test commands from file: f <path>", std::bind(&ConsoleCommands::testCommandsFromFile, this, argsArgument, streamArgument));
+    console.addCommand("p", "Forwarding latency percentiles: p [reset]", std::bind(&ConsoleCommands::showLatency, this, argsArgument, streamArgument));
+    console.addCommand("m", "Metrics: m [json]", std::bind(&ConsoleCommands::showMetrics, this, argsArgument, streamArgument));
+    console.addCommand("b", "Broadcast SMS to attached ue: b <text>", std::bind(&ConsoleCommands::broadcastSms, this, argsArgument, streamArgument));
 }
 
 void ConsoleCommands::stop()
@@ -63,27 +72,43 @@ void ConsoleCommands::listAttachedUe(std::string, std::ostream& os)
     });
 }
 
+void ConsoleCommands::broadcastSms(std::string args, std::ostream &os)
+{
+    auto text = args.substr(std::min(args.size(), args.find_first_not_of(' ')));
+    // from and to no phone number - so encoded once for all
+    Frame sms = common::schema::encode<common::MessageId::Sms>(
+                PhoneNumber{}, PhoneNumber{}, {},
+                Frame::View(reinterpret_cast<const std::uint8_t*>(text.data()), text.size()));
+    SyncLock lock(*syncGuard);
+    os << "SMS sent to: " << ueRelay->broadcast(std::move(sms), IUeRelay::BroadcastScope::Attached) << " ue\n";
+}
+
+void ConsoleCommands::showLatency(std::string args, std::ostream &os)
+{
+    auto& histograms = common::ForwardingLatency::getHistograms();
+    os << "Forwarding latency:\n" << histograms;
+    std::string option;
+    if (std::istringstream(args) >> option and option == "reset")
+    {
+        histograms.reset();
+        os << "reset\n";
+    }
+}
+
+void ConsoleCommands::showMetrics(std::string args, std::ostream &os)
+{
+    std::string format;
+    std::istringstream(args) >> format;
+    common::MetricsRegistry::getGlobal().write(os, format == "json" ? common::MetricsRegistry::Format::Json
+                                                                    : common::MetricsRegistry::Format::Prometheus);
+}
+
 void ConsoleCommands::testCommands(std::string args, std::ostream &os)
 {
-    using common::TestCommands;
     try
     {
-        TestCommands testParser(args);
-        TestCommands::Parameters parameters{};
-        parameters.sendMessage = [this] (BinaryMessage message,
-                                         PhoneNumber to)
-        {
-            SyncLock lock(*syncGuard);
-            ueRelay->sendMessage(message, to);
-        };
-        parameters.printText = [this, &os] (std::string message)
-        {
-            SyncLock lock(*syncGuard);
-            os << message;
-        };
-
-        SyncLock lock(*syncGuard);
-        testParser.run(parameters);
+        common::TestCommands testParser(args);
+        runTestCommands(testParser, os);
     }
     catch (std::exception& ex)
     {
@@ -92,4 +117,42 @@ void ConsoleCommands::testCommands(std::string args, std::ostream &os)
     }
 }
 
+void ConsoleCommands::testCommandsFromFile(std::string args, std::ostream &os)
+{
+    std::string path;
+    std::istringstream(args) >> path;
+    try
+    {
+        auto testParser = common::TestCommands::fromFile(path);
+        runTestCommands(testParser, os);
+    }
+    catch (std::exception& ex)
+    {
+        SyncLock lock(*syncGuard);
+        os << " test commands file error: " << ex.what();
+    }
+}
+
+void ConsoleCommands::runTestCommands(common::TestCommands& testParser, std::ostream &os)
+{
+    common::TestCommands::Parameters parameters{};
+    parameters.sendMessage = [this] (const Frame& message,
+                                     PhoneNumber to)
+    {
+        SyncLock lock(*syncGuard);
+        ueRelay->sendMessage(message, to);
+    };
+    parameters.printText = [this, &os] (std::string message)
+    {
+        SyncLock lock(*syncGuard);
+        os << message;
+    };
+
+    // not locked - commands run by worker threads lock for each message
+    testParser.run(parameters);
+
+    SyncLock lock(*syncGuard);
+    os << testParser.getStatistics();
+}
+
 }
@@ -6,6 +6,7 @@
 #include "UeRelay/IUeRelay.hpp"
 #include "IApplicationEnvironment.hpp"
 #include "IComponent.hpp"
+#include "TestCommands/TestCommands.hpp"
 
 namespace bts
 {
@@ -27,7 +28,12 @@ private:
     void showAddress(std::string args, std::ostream &os);
     void showStatus(std::string args, std::ostream &os);
     void listAttachedUe(std::string args, std::ostream &os);
+    void broadcastSms(std::string args, std::ostream &os);
+    void showLatency(std::string args, std::ostream &os);
+    void showMetrics(std::string args, std::ostream &os);
     void testCommands(std::string args, std::ostream &os);
+    void testCommandsFromFile(std::string args, std::ostream &os);
+    void runTestCommands(common::TestCommands& testParser, std::ostream &os);
 
     SyncGuardPtr syncGuard;
     common::PrefixedLogger logger;
@@ -0,0 +1,24 @@
+#include "PeerLinkSpawner.hpp"
+
+namespace bts
+{
+
+PeerLinkSpawner::PeerLinkSpawner(IApplicationEnvironment& environment, std::shared_ptr<PeerRouter> router)
+    : environment(environment),
+      router(router),
+      logger(environment.getLogger(), "[PEERING]")
+{}
+
+void PeerLinkSpawner::start()
+{
+    logger.logDebug("Listen to peer links");
+    environment.registerPeerConnectedCallback([router = router](ITransportPtr transport) { router->addLink(transport); });
+}
+
+void PeerLinkSpawner::stop()
+{
+    logger.logDebug("Stop listenning to peer links");
+    environment.registerPeerConnectedCallback(nullptr);
+}
+
+}
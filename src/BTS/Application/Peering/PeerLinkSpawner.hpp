@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+#include "IApplicationEnvironment.hpp"
+#include "Logger/PrefixedLogger.hpp"
+#include "IComponent.hpp"
+#include "PeerRouter.hpp"
+
+namespace bts
+{
+
+/**
+ * Hands links to peer BTS (both accepted and connected by the environment) over to PeerRouter
+ */
+class PeerLinkSpawner : public IComponent
+{
+public:
+    PeerLinkSpawner(IApplicationEnvironment& environment, std::shared_ptr<PeerRouter> router);
+
+    void start() override;
+    void stop() override;
+
+private:
+    IApplicationEnvironment& environment;
+    std::shared_ptr<PeerRouter> router;
+    common::PrefixedLogger logger;
+};
+
+}
@@ -0,0 +1,252 @@
+#include "PeerRouter.hpp"
+#include "Messages/IncomingMessage.hpp"
+#include "Messages/OutgoingMessage.hpp"
+#include "Messages/MessageSchema.hpp"
+#include <algorithm>
+
+namespace bts
+{
+
+namespace
+{
+
+// without WIDE_HEADER_FLAG - so not to be confused with forwarded UE messages, always with wide header
+enum class PeerMessageId : std::uint8_t
+{
+    Hello = 0x40,
+    Attached = 0x41,
+    Detached = 0x42
+};
+
+Frame encodePeerMessage(PeerMessageId messageId, std::uint32_t value)
+{
+    common::OutgoingMessage message;
+    message.writeNumber(static_cast<std::uint8_t>(messageId));
+    message.writeNumber(value);
+    return Frame(message.getMessage());
+}
+
+bool isForwarded(Frame::View message)
+{
+    return not message.empty() and (message[0] & common::schema::WIDE_HEADER_FLAG) != 0;
+}
+
+}
+
+PeerRouter::PeerRouter(BtsId btsId, common::ILogger& logger, LocalDelivery localDelivery)
+    : btsId(btsId),
+      logger(logger, "[PEERING]"),
+      localDelivery(std::move(localDelivery))
+{}
+
+PeerRouter::~PeerRouter()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& link: links)
+    {
+        link->transport->registerMessageCallback(nullptr);
+        link->transport->registerDisconnectedCallback(nullptr);
+    }
+}
+
+void PeerRouter::addLink(ITransportPtr transport)
+{
+    logger.logInfo("New link: ", transport->addressToString());
+    auto link = std::make_shared<Link>(Link{transport});
+    std::weak_ptr<Link> weakLink = link;
+    transport->registerMessageCallback([this, weakLink](Frame message) { handleMessage(weakLink, std::move(message)); });
+    transport->registerDisconnectedCallback([this, weakLink] { handleDisconnected(weakLink); });
+
+    std::lock_guard<std::mutex> lock(mutex);
+    links.push_back(link);
+    transport->sendMessage(encodePeerMessage(PeerMessageId::Hello, btsId.value));
+    for (auto phone: localPhones)
+    {
+        transport->sendMessage(encodePeerMessage(PeerMessageId::Attached, phone.value));
+    }
+}
+
+bool PeerRouter::forward(Frame message, PhoneNumber to)
+{
+    ITransportPtr transport;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto route = routes.find(to.value);
+        if (route == routes.end())
+        {
+            return false;
+        }
+        transport = peerLinks.at(route->second).front()->transport;
+    }
+    return transport->sendMessage(std::move(message));
+}
+
+void PeerRouter::announceAttached(PhoneNumber phone)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    localPhones.insert(phone);
+    sendToAllLinks(encodePeerMessage(PeerMessageId::Attached, phone.value));
+}
+
+void PeerRouter::announceDetached(PhoneNumber phone)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    localPhones.erase(phone);
+    sendToAllLinks(encodePeerMessage(PeerMessageId::Detached, phone.value));
+}
+
+std::size_t PeerRouter::countPeers() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return peerLinks.size();
+}
+
+std::size_t PeerRouter::countRoutes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return routes.size();
+}
+
+void PeerRouter::handleMessage(const std::weak_ptr<Link>& weakLink, Frame message)
+{
+    if (isForwarded(message.view()))
+    {
+        handleForwarded(weakLink, std::move(message));
+        return;
+    }
+    auto link = weakLink.lock();
+    if (not link)
+    {
+        return;
+    }
+    try
+    {
+        handleAnnouncement(link, message.view());
+    }
+    catch (common::IncomingMessage::ReadEx& ex)
+    {
+        logger.logError("Malformed message from peer: ", link->transport->addressToString(), ", ", ex.what());
+    }
+}
+
+void PeerRouter::handleAnnouncement(const LinkPtr& link, Frame::View message)
+{
+    common::IncomingMessage reader(message);
+    auto messageId = static_cast<PeerMessageId>(reader.readNumber<std::uint8_t>());
+    auto value = reader.readNumber<std::uint32_t>();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (messageId == PeerMessageId::Hello)
+    {
+        if (link->peer)
+        {
+            logger.logError("Hello repeated by: ", *link->peer);
+            return;
+        }
+        link->peer = BtsId{value};
+        auto& linksToPeer = peerLinks[*link->peer];
+        linksToPeer.push_back(link);
+        logger.logInfo("Peer: ", *link->peer, ", links: ", linksToPeer.size());
+        return;
+    }
+    if (not link->peer)
+    {
+        logger.logError("Announcement before Hello from: ", link->transport->addressToString());
+        return;
+    }
+    PhoneNumber phone{value};
+    switch (messageId)
+    {
+    case PeerMessageId::Attached:
+        routes[phone.value] = *link->peer;
+        logger.logDebug("Route to: ", phone, " via: ", *link->peer);
+        break;
+    case PeerMessageId::Detached:
+    {
+        // the phone might be attached to other peer already
+        auto route = routes.find(phone.value);
+        if (route != routes.end() and route->second == *link->peer)
+        {
+            routes.erase(route);
+            logger.logDebug("Route removed to: ", phone);
+        }
+        break;
+    }
+    default:
+        logger.logError("Unknown message from peer: ", *link->peer);
+        break;
+    }
+}
+
+void PeerRouter::handleForwarded(const std::weak_ptr<Link>& weakLink, Frame message)
+{
+    common::MessageHeader header{};
+    try
+    {
+        header = common::schema::decodeHeader(message.view());
+    }
+    catch (common::IncomingMessage::ReadEx& ex)
+    {
+        logger.logError("Malformed message forwarded: ", ex.what());
+        return;
+    }
+    if (localDelivery(std::move(message), header.to))
+    {
+        return;
+    }
+    logger.logInfo("Forwarded message not delivered, not attached: ", header);
+    auto link = weakLink.lock();
+    if (not link)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // attached meanwhile - Attached already sent over the link
+    if (not localPhones.contains(header.to))
+    {
+        link->transport->sendMessage(encodePeerMessage(PeerMessageId::Detached, header.to.value));
+    }
+    // never answered - would bounce between BTS when the sender is gone as well
+    if (header.messageId != common::MessageId::UnknownRecipient and header.messageId != common::MessageId::UnknownSender)
+    {
+        link->transport->sendMessage(common::schema::encode<common::MessageId::UnknownRecipient>(
+                                         PhoneNumber{}, header.from, {header}));
+    }
+}
+
+void PeerRouter::handleDisconnected(const std::weak_ptr<Link>& weakLink)
+{
+    auto link = weakLink.lock();
+    if (not link)
+    {
+        return;
+    }
+    logger.logInfo("Link disconnected: ", link->transport->addressToString());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    links.erase(std::remove(links.begin(), links.end(), link), links.end());
+    if (not link->peer)
+    {
+        return;
+    }
+    auto peer = peerLinks.find(*link->peer);
+    auto& linksToPeer = peer->second;
+    linksToPeer.erase(std::remove(linksToPeer.begin(), linksToPeer.end(), link), linksToPeer.end());
+    if (linksToPeer.empty())
+    {
+        peerLinks.erase(peer);
+        std::erase_if(routes, [&link](auto& route) { return route.second == *link->peer; });
+        logger.logInfo("Peer lost: ", *link->peer);
+    }
+}
+
+void PeerRouter::sendToAllLinks(const Frame& message)
+{
+    for (auto& link: links)
+    {
+        link->transport->sendMessage(message);
+    }
+}
+
+}
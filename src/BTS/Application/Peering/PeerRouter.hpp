@@ -0,0 +1,86 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "ITransport.hpp"
+#include "Messages/BtsId.hpp"
+#include "Messages/PhoneNumber.hpp"
+#include "Logger/PrefixedLogger.hpp"
+
+namespace bts
+{
+
+using common::BtsId;
+using common::PhoneNumber;
+
+/**
+ * Links to peer BTS and the phone -> BTS routing table built from what peers announce over them.
+ *
+ * Over each link BTS sends Hello (own BtsId) first, then Attached for every local phone,
+ * then Attached/Detached whenever local UE attach or leave.
+ * Messages to phones attached at peer BTS are forwarded as they are over the link to that BTS.
+ * Messages received from peers are only delivered locally - never forwarded again,
+ * so nothing circulates between BTS when routing tables are out of date. When the phone is not attached
+ * (route of the peer is stale) the peer gets Detached for it and the sender UnknownRecipient over the same link.
+ *
+ * Routes via peer BTS are forgotten when its last link is disconnected.
+ * Thread safe - local delivery is called without the router lock held.
+ */
+class PeerRouter
+{
+public:
+    using LocalDelivery = std::function<bool(Frame message, PhoneNumber to)>;
+
+    PeerRouter(BtsId btsId, common::ILogger& logger, LocalDelivery localDelivery);
+    ~PeerRouter();
+
+    /**
+     * For both accepted and connected links - transport shall start receiving after this call
+     */
+    void addLink(ITransportPtr transport);
+
+    /**
+     * @return false when no peer BTS has the phone attached
+     */
+    bool forward(Frame message, PhoneNumber to);
+
+    void announceAttached(PhoneNumber phone);
+    void announceDetached(PhoneNumber phone);
+
+    std::size_t countPeers() const;
+    std::size_t countRoutes() const;
+
+private:
+    struct Link
+    {
+        ITransportPtr transport;
+        // known since Hello from peer
+        std::optional<BtsId> peer{};
+    };
+    using LinkPtr = std::shared_ptr<Link>;
+
+    void handleMessage(const std::weak_ptr<Link>& link, Frame message);
+    void handleAnnouncement(const LinkPtr& link, Frame::View message);
+    void handleForwarded(const std::weak_ptr<Link>& link, Frame message);
+    void handleDisconnected(const std::weak_ptr<Link>& link);
+    // shall be called with mutex locked
+    void sendToAllLinks(const Frame& message);
+
+    const BtsId btsId;
+    common::PrefixedLogger logger;
+    LocalDelivery localDelivery;
+
+    mutable std::mutex mutex;
+    std::vector<LinkPtr> links;
+    std::map<BtsId, std::vector<LinkPtr>> peerLinks;
+    std::unordered_map<PhoneNumber::Value, BtsId> routes;
+    std::set<PhoneNumber> localPhones;
+};
+
+}
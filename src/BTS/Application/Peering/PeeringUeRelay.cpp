@@ -0,0 +1,129 @@
+#include "PeeringUeRelay.hpp"
+
+namespace bts
+{
+
+class PeeringUeRelay::SlotImpl : public UeSlot::IImpl
+{
+public:
+    SlotImpl(UeSlot localSlot, PeerRouter& router);
+
+    bool sendMessage(UeSlot::Handle, Frame message, PhoneNumber to) override;
+    UeSlot::IImplPtr attach(UeSlot::Handle, PhoneNumber phone) override;
+    bool isAttached(UeSlot::Handle) const override;
+    PhoneNumber getPhoneNumber(UeSlot::Handle) const override;
+    void remove(UeSlot::Handle) override;
+
+private:
+    UeSlot localSlot;
+    PeerRouter& router;
+};
+
+PeeringUeRelay::PeeringUeRelay(std::shared_ptr<IUeRelay> localRelay, std::shared_ptr<PeerRouter> router)
+    : localRelay(localRelay),
+      router(router)
+{}
+
+UeSlot PeeringUeRelay::add(UePtr ue)
+{
+    return UeSlot(std::make_shared<SlotImpl>(localRelay->add(std::move(ue)), *router));
+}
+
+std::size_t PeeringUeRelay::count() const
+{
+    return localRelay->count();
+}
+
+std::size_t PeeringUeRelay::countAttached() const
+{
+    return localRelay->countAttached();
+}
+
+std::size_t PeeringUeRelay::countNotAttached() const
+{
+    return localRelay->countNotAttached();
+}
+
+void PeeringUeRelay::visitAttachedUe(UeVisitor ueVisitor)
+{
+    localRelay->visitAttachedUe(std::move(ueVisitor));
+}
+
+void PeeringUeRelay::visitNotAttachedUe(UeVisitor ueVisitor)
+{
+    localRelay->visitNotAttachedUe(std::move(ueVisitor));
+}
+
+std::size_t PeeringUeRelay::visitNextNotAttachedUe(UeVisitor ueVisitor, std::size_t maxCount)
+{
+    return localRelay->visitNextNotAttachedUe(std::move(ueVisitor), maxCount);
+}
+
+bool PeeringUeRelay::sendMessage(Frame message, PhoneNumber to)
+{
+    // Frame copy shares the payload
+    return localRelay->sendMessage(message, to) or router->forward(std::move(message), to);
+}
+
+std::size_t PeeringUeRelay::broadcast(Frame message, BroadcastScope scope)
+{
+    return localRelay->broadcast(std::move(message), scope);
+}
+
+std::optional<CellLoad> PeeringUeRelay::getLoad()
+{
+    return localRelay->getLoad();
+}
+
+PeeringUeRelay::SlotImpl::SlotImpl(UeSlot localSlot, PeerRouter& router)
+    : localSlot(std::move(localSlot)),
+      router(router)
+{}
+
+bool PeeringUeRelay::SlotImpl::sendMessage(UeSlot::Handle, Frame message, PhoneNumber to)
+{
+    return localSlot.sendMessage(message, to) or router.forward(std::move(message), to);
+}
+
+UeSlot::IImplPtr PeeringUeRelay::SlotImpl::attach(UeSlot::Handle, PhoneNumber phone)
+{
+    auto oldPhone = localSlot.getPhoneNumber();
+    localSlot.attach(phone);
+    auto newPhone = localSlot.getPhoneNumber();
+    if (newPhone != oldPhone)
+    {
+        if (oldPhone.isValid())
+        {
+            router.announceDetached(oldPhone);
+        }
+        if (newPhone.isValid())
+        {
+            router.announceAttached(newPhone);
+        }
+    }
+    return shared_from_this();
+}
+
+bool PeeringUeRelay::SlotImpl::isAttached(UeSlot::Handle) const
+{
+    return localSlot.isAttached();
+}
+
+PhoneNumber PeeringUeRelay::SlotImpl::getPhoneNumber(UeSlot::Handle) const
+{
+    return localSlot.getPhoneNumber();
+}
+
+void PeeringUeRelay::SlotImpl::remove(UeSlot::Handle)
+{
+    // removed UE owns this slot
+    auto self = shared_from_this();
+    auto phone = localSlot.getPhoneNumber();
+    localSlot.remove();
+    if (phone.isValid())
+    {
+        router.announceDetached(phone);
+    }
+}
+
+}
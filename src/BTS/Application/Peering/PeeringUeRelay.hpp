@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+#include "UeRelay/IUeRelay.hpp"
+#include "PeerRouter.hpp"
+
+namespace bts
+{
+
+/**
+ * IUeRelay decorator making the local relay part of BTS network (see PeerRouter):
+ * attach/detach of local UE are announced to peer BTS, messages to phones not attached here
+ * are forwarded to the peer BTS having them attached.
+ *
+ * Shall be used as the decorated relay is (i.e. under the global SyncGuard or not).
+ */
+class PeeringUeRelay : public IUeRelay
+{
+public:
+    PeeringUeRelay(std::shared_ptr<IUeRelay> localRelay, std::shared_ptr<PeerRouter> router);
+
+    UeSlot add(UePtr) override;
+
+    std::size_t count() const override;
+    std::size_t countAttached() const override;
+    std::size_t countNotAttached() const override;
+
+    void visitAttachedUe(UeVisitor) override;
+    void visitNotAttachedUe(UeVisitor) override;
+    std::size_t visitNextNotAttachedUe(UeVisitor, std::size_t maxCount) override;
+
+    bool sendMessage(Frame message, PhoneNumber to) override;
+    /**
+     * Local UE only
+     */
+    std::size_t broadcast(Frame message, BroadcastScope scope) override;
+    std::optional<CellLoad> getLoad() override;
+
+private:
+    class SlotImpl;
+
+    std::shared_ptr<IUeRelay> localRelay;
+    std::shared_ptr<PeerRouter> router;
+};
+
+}
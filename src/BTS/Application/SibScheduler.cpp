@@ -0,0 +1,119 @@
+#include "SibScheduler.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace bts
+{
+
+SibScheduler::SibScheduler(std::shared_ptr<IUeRelay> ueRelay,
+                           SyncGuardPtr syncGuard,
+                           BtsId btsId,
+                           common::ILogger &logger,
+                           std::chrono::milliseconds discoveryLatency,
+                           std::chrono::milliseconds period)
+    : ueRelay(ueRelay),
+      syncGuard(syncGuard),
+      logger(logger, "[SIB]"),
+      btsId(btsId),
+      DISCOVERY_LATENCY(discoveryLatency),
+      PERIOD(period)
+{
+    if (DISCOVERY_LATENCY.count() <= 0 or PERIOD.count() <= 0)
+    {
+        throw std::invalid_argument("SIB discovery latency and period shall be positive");
+    }
+}
+
+SibScheduler::~SibScheduler()
+{
+    if (scheduler.joinable())
+    {
+        logger.logError("running on destruction!");
+        stop();
+    }
+}
+
+void SibScheduler::start()
+{
+    std::lock_guard<std::mutex> lock(runningMutex);
+    if (running)
+    {
+        logger.logError("attempt to restart!");
+        return;
+    }
+    running = true;
+    scheduler = std::thread(&SibScheduler::run, this);
+}
+
+void SibScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(runningMutex);
+        if (not running)
+        {
+            logger.logError("attempt to stop not running thread!");
+            return;
+        }
+        running = false;
+    }
+    runningChanged.notify_all();
+    scheduler.join();
+}
+
+void SibScheduler::run()
+{
+    logger.logDebug("started, discovery latency: ", DISCOVERY_LATENCY.count(), "ms, period: ", PERIOD.count(), "ms");
+    auto periodEnd = std::chrono::steady_clock::now() + PERIOD;
+    while (waitForPeriod(periodEnd))
+    {
+        sendSibs();
+    }
+    logger.logDebug("finished");
+}
+
+bool SibScheduler::waitForPeriod(std::chrono::steady_clock::time_point& periodEnd)
+{
+    std::unique_lock<std::mutex> lock(runningMutex);
+    if (runningChanged.wait_until(lock, periodEnd, [this] { return not running; }))
+    {
+        return false;
+    }
+    // next period is counted from the planned end of this one - unless sending took longer than period
+    periodEnd = std::max(periodEnd + PERIOD, std::chrono::steady_clock::now());
+    return true;
+}
+
+std::size_t SibScheduler::countSibsForPeriod(std::size_t notAttached)
+{
+    if (notAttached == 0)
+    {
+        sibCredit = 0;
+        return 0;
+    }
+    sibCredit += notAttached * static_cast<std::uint64_t>(PERIOD.count());
+    auto sibs = sibCredit / DISCOVERY_LATENCY.count();
+    sibCredit -= sibs * DISCOVERY_LATENCY.count();
+    // period longer than latency - no point in sending twice to the same UE in one period
+    return std::min<std::uint64_t>(sibs, notAttached);
+}
+
+void SibScheduler::sendSib(IUeConnection &ue, std::optional<CellLoad> load)
+{
+    logger.logDebug("send to: ", ue);
+    ue.sendSib(btsId, load);
+}
+
+void SibScheduler::sendSibs()
+{
+    SyncLock lock(*syncGuard);
+    auto sibs = countSibsForPeriod(ueRelay->countNotAttached());
+    if (sibs == 0)
+    {
+        return;
+    }
+    // the same for all SIB of the period
+    auto load = ueRelay->getLoad();
+    ueRelay->visitNextNotAttachedUe([this, load] (IUeConnection& ue) { sendSib(ue, load); }, sibs);
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include "IComponent.hpp"
+#include "Synchronization.hpp"
+#include "UeRelay/IUeRelay.hpp"
+#include "Messages/BtsId.hpp"
+#include "Logger/PrefixedLogger.hpp"
+
+namespace bts
+{
+
+/**
+ * Sends SIB to not attached UE, so every one of them gets SIB within the discovery latency.
+ * Every period as many UE are visited (round robin, see IUeRelay::visitNextNotAttachedUe) as needed
+ * to keep this rate: number of not attached UE / discovery latency.
+ */
+class SibScheduler : public IComponent
+{
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_DISCOVERY_LATENCY{5000};
+    static constexpr std::chrono::milliseconds DEFAULT_PERIOD{100};
+
+    SibScheduler(std::shared_ptr<IUeRelay> ueRelay,
+                 SyncGuardPtr syncGuard,
+                 BtsId btsId,
+                 common::ILogger& logger,
+                 std::chrono::milliseconds discoveryLatency = DEFAULT_DISCOVERY_LATENCY,
+                 std::chrono::milliseconds period = DEFAULT_PERIOD);
+    ~SibScheduler();
+
+    void start() override;
+    void stop() override;
+private:
+    void run();
+    // returns false when stopped
+    bool waitForPeriod(std::chrono::steady_clock::time_point& periodEnd);
+    void sendSibs();
+    std::size_t countSibsForPeriod(std::size_t notAttached);
+    void sendSib(IUeConnection &ue, std::optional<CellLoad> load);
+
+    std::shared_ptr<IUeRelay> ueRelay;
+    SyncGuardPtr syncGuard;
+    common::PrefixedLogger logger;
+    BtsId btsId;
+    const std::chrono::milliseconds DISCOVERY_LATENCY;
+    const std::chrono::milliseconds PERIOD;
+
+    // SIBs owed, in units of 1/DISCOVERY_LATENCY [ms] of SIB
+    std::uint64_t sibCredit = 0;
+
+    std::mutex runningMutex;
+    std::condition_variable runningChanged;
+    bool running = false;
+    std::thread scheduler;
+};
+
+}
@@ -0,0 +1,86 @@
+#include "MappedFile.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <system_error>
+
+namespace bts
+{
+
+namespace
+{
+
+[[noreturn]] void throwSystemError(const std::string& what, int fd = -1)
+{
+    auto error = errno;
+    if (fd >= 0)
+    {
+        ::close(fd);
+    }
+    throw std::system_error(error, std::generic_category(), what);
+}
+
+}
+
+MappedFile::MappedFile(const std::string &path, std::size_t minSize)
+{
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        throwSystemError("open: " + path);
+    }
+    struct stat status{};
+    if (::fstat(fd, &status) < 0)
+    {
+        throwSystemError("stat: " + path, fd);
+    }
+    length = static_cast<std::size_t>(status.st_size);
+    if (length < minSize)
+    {
+        if (::ftruncate(fd, static_cast<off_t>(minSize)) < 0)
+        {
+            throwSystemError("resize: " + path, fd);
+        }
+        length = minSize;
+    }
+    if (length == 0u)
+    {
+        errno = EINVAL;
+        throwSystemError("empty: " + path, fd);
+    }
+    void* address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED)
+    {
+        throwSystemError("mmap: " + path, fd);
+    }
+    // mapping keeps the file open
+    ::close(fd);
+    mapping = static_cast<std::uint8_t*>(address);
+}
+
+MappedFile::~MappedFile()
+{
+    ::munmap(mapping, length);
+}
+
+std::uint8_t *MappedFile::data() const
+{
+    return mapping;
+}
+
+std::size_t MappedFile::size() const
+{
+    return length;
+}
+
+void MappedFile::sync() const
+{
+    if (::msync(mapping, length, MS_SYNC) < 0)
+    {
+        throwSystemError("msync");
+    }
+}
+
+}
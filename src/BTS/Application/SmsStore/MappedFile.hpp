@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bts
+{
+
+/**
+ * Whole file mapped to memory (shared - writes go to the file), created when it does not exist.
+ * Mapping stays valid when the file is grown, renamed or removed - so a larger mapping of the same file
+ * can be made while this one is still read.
+ */
+class MappedFile
+{
+public:
+    /**
+     * File shorter than minSize is extended with zeros
+     * @throw std::system_error
+     */
+    MappedFile(const std::string& path, std::size_t minSize);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::uint8_t* data() const;
+    std::size_t size() const;
+
+    /**
+     * Waits till the mapped pages are written to the file
+     * @throw std::system_error
+     */
+    void sync() const;
+
+private:
+    std::uint8_t* mapping;
+    std::size_t length;
+};
+
+}
@@ -0,0 +1,403 @@
+#include "SmsStore.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+
+namespace bts
+{
+
+namespace
+{
+
+constexpr char MAGIC[] = "BTS SMS STORE 1";
+constexpr std::size_t LOG_HEADER_SIZE = sizeof(MAGIC);
+constexpr std::size_t INITIAL_SIZE = 1024u * 1024u;
+constexpr std::size_t RECORD_ALIGNMENT = 8u;
+constexpr const char* COMPACTED_SUFFIX = ".compacted";
+
+struct RecordHeader
+{
+    // of whole record, aligned - written last, 0 - end of log
+    std::uint32_t size;
+    std::uint8_t type;
+    std::uint8_t reserved[3];
+    PhoneNumber::Value phoneNumber;
+    // of payload
+    std::uint32_t length;
+    std::uint64_t sequence;
+};
+static_assert(sizeof(RecordHeader) % RECORD_ALIGNMENT == 0u);
+static_assert(LOG_HEADER_SIZE % RECORD_ALIGNMENT == 0u);
+
+std::size_t recordSizeOf(std::size_t length)
+{
+    return (sizeof(RecordHeader) + length + RECORD_ALIGNMENT - 1u) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+}
+
+RecordHeader readHeader(const MappedFile& file, std::size_t offset)
+{
+    RecordHeader header;
+    std::memcpy(&header, file.data() + offset, sizeof(header));
+    return header;
+}
+
+Frame::View payloadOf(const MappedFile& file, std::size_t offset, const RecordHeader& header)
+{
+    return Frame::View(file.data() + offset + sizeof(RecordHeader), header.length);
+}
+
+}
+
+SmsStore::SmsStore(const std::string &path, common::ILogger &logger, Options options)
+    : path(path),
+      logger(logger, "[SMS STORE]"),
+      options(options)
+{
+    // left by compaction interrupted by BTS exit - the log itself is complete
+    std::remove((path + COMPACTED_SUFFIX).c_str());
+    file = std::make_shared<MappedFile>(path, INITIAL_SIZE);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        recover();
+    }
+    compactionThread = std::thread([this] { compactInBackground(); });
+}
+
+SmsStore::~SmsStore()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+    compactionNeeded.notify_one();
+    compactionThread.join();
+}
+
+void SmsStore::addSubscriber(PhoneNumber phoneNumber)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (subscribers.count(phoneNumber.value))
+    {
+        return;
+    }
+    append(RecordType::Subscriber, phoneNumber, 0u);
+    subscribers.emplace(phoneNumber.value, Queue{});
+    liveBytes += recordSizeOf(0u);
+}
+
+bool SmsStore::store(PhoneNumber to, const Frame &sms)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = subscribers.find(to.value);
+    if (found == subscribers.end())
+    {
+        return false;
+    }
+    auto& queue = found->second;
+    if (queue.messages.size() - queue.taken >= options.quota)
+    {
+        logger.logDebug("Quota exceeded for: ", to);
+        return false;
+    }
+    auto offset = end;
+    append(RecordType::Sms, to, nextSequence, sms.view());
+    queue.messages.push_back(Stored{nextSequence++, offset});
+    liveBytes += recordSizeOf(sms.size());
+    ++numberOfStored;
+    return true;
+}
+
+std::vector<SmsStore::StoredSms> SmsStore::peek(PhoneNumber to, std::size_t maxCount) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = subscribers.find(to.value);
+    if (found == subscribers.end())
+    {
+        return {};
+    }
+    auto& queue = found->second;
+    auto count = std::min(maxCount, queue.messages.size() - queue.taken);
+    std::vector<StoredSms> messages;
+    messages.reserve(count);
+    for (std::size_t i = 0u; i < count; ++i)
+    {
+        auto& stored = queue.messages[queue.taken + i];
+        auto payload = payloadOf(*file, stored.offset, readHeader(*file, stored.offset));
+        messages.push_back(StoredSms{stored.sequence, Frame::copyOf(payload)});
+    }
+    return messages;
+}
+
+void SmsStore::acknowledge(PhoneNumber to, std::uint64_t sequence)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = subscribers.find(to.value);
+    if (found == subscribers.end())
+    {
+        return;
+    }
+    auto& queue = found->second;
+    auto notTaken = queue.messages.begin() + queue.taken;
+    auto acknowledged = std::find_if(notTaken, queue.messages.end(),
+                                     [sequence](auto& stored) { return stored.sequence > sequence; });
+    if (acknowledged == notTaken)
+    {
+        return;
+    }
+    append(RecordType::Taken, to, std::prev(acknowledged)->sequence);
+    drop(queue, acknowledged - notTaken);
+    requestCompactionIfNeeded();
+}
+
+std::size_t SmsStore::countStored(PhoneNumber to) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = subscribers.find(to.value);
+    return found == subscribers.end() ? 0u : found->second.messages.size() - found->second.taken;
+}
+
+std::size_t SmsStore::countStored() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return numberOfStored;
+}
+
+std::size_t SmsStore::countSubscribers() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return subscribers.size();
+}
+
+std::size_t SmsStore::getLogSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return end;
+}
+
+void SmsStore::compact()
+{
+    std::lock_guard<std::mutex> compactionLock(compactionMutex);
+
+    std::shared_ptr<MappedFile> source;
+    std::size_t sourceEnd;
+    std::size_t compactedSize;
+    std::vector<PhoneNumber::Value> phoneNumbers;
+    std::vector<std::size_t> offsets;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (deadBytes() == 0u)
+        {
+            return;
+        }
+        source = file;
+        sourceEnd = end;
+        compactedSize = LOG_HEADER_SIZE + liveBytes;
+        phoneNumbers.reserve(subscribers.size());
+        offsets.reserve(numberOfStored);
+        for (auto& [phoneNumber, queue]: subscribers)
+        {
+            phoneNumbers.push_back(phoneNumber);
+            for (auto stored = queue.messages.begin() + queue.taken; stored != queue.messages.end(); ++stored)
+            {
+                offsets.push_back(stored->offset);
+            }
+        }
+    }
+
+    // without lock - log is only appended, so it does not change below sourceEnd
+    std::sort(offsets.begin(), offsets.end());
+    auto compactedPath = path + COMPACTED_SUFFIX;
+    std::remove(compactedPath.c_str());
+    auto target = std::make_shared<MappedFile>(compactedPath, std::max(INITIAL_SIZE, 2u * compactedSize));
+    std::memcpy(target->data(), source->data(), LOG_HEADER_SIZE);
+    std::size_t targetEnd = LOG_HEADER_SIZE;
+    for (auto phoneNumber: phoneNumbers)
+    {
+        RecordHeader header{};
+        header.size = recordSizeOf(0u);
+        header.type = static_cast<std::uint8_t>(RecordType::Subscriber);
+        header.phoneNumber = phoneNumber;
+        std::memcpy(target->data() + targetEnd, &header, sizeof(header));
+        targetEnd += header.size;
+    }
+    // old offset -> new offset, sorted by the old one
+    std::vector<std::pair<std::size_t, std::size_t>> moved;
+    moved.reserve(offsets.size());
+    for (auto offset: offsets)
+    {
+        auto size = readHeader(*source, offset).size;
+        std::memcpy(target->data() + targetEnd, source->data() + offset, size);
+        moved.emplace_back(offset, targetEnd);
+        targetEnd += size;
+    }
+    target->sync();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // appended meanwhile - stored, taken (also of copied SMS) and new subscribers
+    auto tailSize = end - sourceEnd;
+    if (targetEnd + tailSize > target->size())
+    {
+        target = std::make_shared<MappedFile>(compactedPath, std::max(target->size() * 2u, targetEnd + tailSize));
+    }
+    std::memcpy(target->data() + targetEnd, file->data() + sourceEnd, tailSize);
+    target->sync();
+    if (std::rename(compactedPath.c_str(), path.c_str()) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "rename: " + compactedPath);
+    }
+
+    for (auto& [phoneNumber, queue]: subscribers)
+    {
+        queue.messages.erase(queue.messages.begin(), queue.messages.begin() + queue.taken);
+        queue.taken = 0u;
+        for (auto& stored: queue.messages)
+        {
+            if (stored.offset >= sourceEnd)
+            {
+                stored.offset = stored.offset - sourceEnd + targetEnd;
+                continue;
+            }
+            auto found = std::lower_bound(moved.begin(), moved.end(), std::pair{stored.offset, std::size_t{0u}});
+            stored.offset = found->second;
+        }
+    }
+    logger.logInfo("Compacted from: ", end, " to: ", targetEnd + tailSize, " bytes, SMS: ", numberOfStored);
+    file = std::move(target);
+    end = targetEnd + tailSize;
+}
+
+void SmsStore::recover()
+{
+    auto* data = file->data();
+    if (std::all_of(data, data + LOG_HEADER_SIZE, [](auto byte) { return byte == 0u; }))
+    {
+        std::memcpy(data, MAGIC, LOG_HEADER_SIZE);
+    }
+    else if (std::memcmp(data, MAGIC, LOG_HEADER_SIZE) != 0)
+    {
+        throw std::runtime_error("not SMS store: " + path);
+    }
+
+    end = LOG_HEADER_SIZE;
+    while (end + sizeof(RecordHeader) <= file->size())
+    {
+        auto header = readHeader(*file, end);
+        if (header.size == 0u)
+        {
+            break;
+        }
+        if (header.size != recordSizeOf(header.length) or end + header.size > file->size()
+            or header.type < static_cast<std::uint8_t>(RecordType::Subscriber)
+            or header.type > static_cast<std::uint8_t>(RecordType::Taken))
+        {
+            logger.logError("Log corrupted at: ", end, " - the rest of it is dropped");
+            std::fill(data + end, data + file->size(), 0u);
+            break;
+        }
+        auto [subscriber, added] = subscribers.try_emplace(header.phoneNumber);
+        auto& queue = subscriber->second;
+        switch (static_cast<RecordType>(header.type))
+        {
+        case RecordType::Subscriber:
+            liveBytes += added ? header.size : 0u;
+            break;
+        case RecordType::Sms:
+            queue.messages.push_back(Stored{header.sequence, end});
+            liveBytes += header.size;
+            ++numberOfStored;
+            nextSequence = std::max(nextSequence, header.sequence + 1u);
+            break;
+        case RecordType::Taken:
+        {
+            auto notTaken = std::find_if(queue.messages.begin() + queue.taken, queue.messages.end(),
+                                         [&header](auto& stored) { return stored.sequence > header.sequence; });
+            drop(queue, notTaken - (queue.messages.begin() + queue.taken));
+            break;
+        }
+        }
+        end += header.size;
+    }
+    logger.logInfo("Recovered: ", subscribers.size(), " subscribers, ", numberOfStored, " SMS, log: ", end, " bytes");
+}
+
+void SmsStore::append(RecordType type, PhoneNumber phoneNumber, std::uint64_t sequence, Frame::View payload)
+{
+    auto size = recordSizeOf(payload.size());
+    if (end + size > file->size())
+    {
+        // the old mapping stays valid for compaction copying from it
+        file = std::make_shared<MappedFile>(path, std::max(file->size() * 2u, end + size));
+    }
+    RecordHeader header{};
+    header.type = static_cast<std::uint8_t>(type);
+    header.phoneNumber = phoneNumber.value;
+    header.length = payload.size();
+    header.sequence = sequence;
+    auto* record = file->data() + end;
+    std::memcpy(record, &header, sizeof(header));
+    std::copy(payload.begin(), payload.end(), record + sizeof(header));
+    // the last one - record is complete when its size is seen, see recover
+    std::atomic_ref<std::uint32_t>(*reinterpret_cast<std::uint32_t*>(record)).store(size, std::memory_order_release);
+    end += size;
+}
+
+void SmsStore::drop(Queue &queue, std::size_t count)
+{
+    for (std::size_t i = 0u; i < count; ++i)
+    {
+        liveBytes -= readHeader(*file, queue.messages[queue.taken + i].offset).size;
+    }
+    queue.taken += count;
+    numberOfStored -= count;
+    if (queue.taken == queue.messages.size())
+    {
+        queue.messages.clear();
+        queue.taken = 0u;
+    }
+}
+
+std::size_t SmsStore::deadBytes() const
+{
+    return end - LOG_HEADER_SIZE - liveBytes;
+}
+
+void SmsStore::requestCompactionIfNeeded()
+{
+    auto dead = deadBytes();
+    if (dead >= options.compactionThreshold and dead > liveBytes and not compactionRequested)
+    {
+        compactionRequested = true;
+        compactionNeeded.notify_one();
+    }
+}
+
+void SmsStore::compactInBackground()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        compactionNeeded.wait(lock, [this] { return compactionRequested or stopped; });
+        if (stopped)
+        {
+            return;
+        }
+        lock.unlock();
+        try
+        {
+            compact();
+        }
+        catch (std::exception const& ex)
+        {
+            logger.logError("Compaction failed: ", ex.what());
+        }
+        lock.lock();
+        compactionRequested = false;
+    }
+}
+
+}
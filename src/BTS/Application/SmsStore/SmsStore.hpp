@@ -0,0 +1,137 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "MappedFile.hpp"
+#include "Messages/Frame.hpp"
+#include "Messages/PhoneNumber.hpp"
+#include "Logger/PrefixedLogger.hpp"
+
+namespace bts
+{
+
+using common::Frame;
+using common::PhoneNumber;
+
+/**
+ * SMS for known subscribers (attached to this BTS at least once) which are not attached now -
+ * kept till they attach again, also over BTS restart. Removed when acknowledged - see peek()/acknowledge().
+ *
+ * Append-only log in memory mapped file - records of subscribers, stored SMS and delivered (taken) SMS by sequence,
+ * replayed into the index by phone number when opened. Record size is written last - so the record
+ * being written when BTS was killed is ignored. Log is compacted in background when taken records
+ * outweigh the stored ones: live records are copied to a new file, then the ones appended meanwhile,
+ * and the new file replaces the old one. Records are in host byte order - the file is not portable.
+ *
+ * Thread safe.
+ */
+class SmsStore
+{
+public:
+    struct Options
+    {
+        // per subscriber - SMS over it are not stored
+        std::size_t quota = 100u;
+        // log is not compacted till it has that many bytes of taken records
+        std::size_t compactionThreshold = 4u * 1024u * 1024u;
+    };
+
+    /**
+     * @throw std::system_error when file cannot be opened or mapped
+     * @throw std::runtime_error when file is not SMS store
+     */
+    SmsStore(const std::string& path, common::ILogger& logger, Options options);
+    ~SmsStore();
+
+    void addSubscriber(PhoneNumber phoneNumber);
+
+    /**
+     * @return false when recipient is not known subscriber or its quota is exceeded
+     */
+    bool store(PhoneNumber to, const Frame& sms);
+
+    struct StoredSms
+    {
+        std::uint64_t sequence;
+        Frame message;
+    };
+
+    /**
+     * Oldest stored SMS of the subscriber - they stay stored till acknowledged
+     */
+    std::vector<StoredSms> peek(PhoneNumber to, std::size_t maxCount) const;
+    /**
+     * Removes SMS of the subscriber up to the sequence (from peek) - the ones delivered
+     */
+    void acknowledge(PhoneNumber to, std::uint64_t sequence);
+
+    std::size_t countStored(PhoneNumber to) const;
+    std::size_t countStored() const;
+    std::size_t countSubscribers() const;
+    // appended part of the log
+    std::size_t getLogSize() const;
+
+    /**
+     * Compacts the log now, done in background as well - see Options::compactionThreshold
+     */
+    void compact();
+
+private:
+    struct Stored
+    {
+        std::uint64_t sequence;
+        std::size_t offset;
+    };
+    struct Queue
+    {
+        std::vector<Stored> messages;
+        // taken from the front of messages
+        std::size_t taken = 0u;
+    };
+    enum class RecordType : std::uint8_t
+    {
+        Subscriber = 1,
+        Sms,
+        // all SMS of the subscriber up to the sequence
+        Taken
+    };
+
+    // shall be called with mutex locked
+    void recover();
+    void append(RecordType type, PhoneNumber phoneNumber, std::uint64_t sequence, Frame::View payload = {});
+    void drop(Queue& queue, std::size_t count);
+    std::size_t deadBytes() const;
+    void requestCompactionIfNeeded();
+
+    void compactInBackground();
+
+    const std::string path;
+    common::PrefixedLogger logger;
+    const Options options;
+
+    mutable std::mutex mutex;
+    // replaced when grown or compacted - previous one is kept by compaction while it copies from it
+    std::shared_ptr<MappedFile> file;
+    std::size_t end;
+    // of subscriber records and SMS not taken yet
+    std::size_t liveBytes = 0u;
+    std::uint64_t nextSequence = 1u;
+    std::size_t numberOfStored = 0u;
+    std::unordered_map<PhoneNumber::Value, Queue> subscribers;
+
+    // one compaction at a time
+    std::mutex compactionMutex;
+    // requested under mutex
+    std::condition_variable compactionNeeded;
+    bool compactionRequested = false;
+    bool stopped = false;
+    std::thread compactionThread;
+};
+
+}
@@ -0,0 +1,65 @@
+#include "ConstantFrames.hpp"
+#include "Messages/MessageSchema.hpp"
+#include "Messages/NarrowHeader.hpp"
+#include <atomic>
+
+namespace bts
+{
+
+namespace schema = common::schema;
+using common::MessageId;
+using common::PhoneNumber;
+
+namespace
+{
+
+Frame encodeSib(BtsId btsId, std::optional<CellLoad> load)
+{
+    if (not load)
+    {
+        return schema::encode<MessageId::Sib>(PhoneNumber{}, PhoneNumber{}, {btsId});
+    }
+    const std::uint8_t trailing[] = {load->percent};
+    return schema::encode<MessageId::Sib>(PhoneNumber{}, PhoneNumber{}, {btsId}, trailing);
+}
+
+}
+
+ConstantFrames::ConstantFrames(BtsId btsId, std::optional<CellLoad> load)
+    : btsId(btsId),
+      load(load),
+      sib(encodeSib(btsId, load)),
+      // no phone number in SIB - so it always fits narrow header
+      narrowSib(*schema::narrowHeader(sib.view()))
+{}
+
+std::shared_ptr<const ConstantFrames> ConstantFrames::of(BtsId btsId, std::optional<CellLoad> load)
+{
+    // one BTS per process, its load changes once per SIB period at most - so it is created seldom,
+    // concurrent first calls might create it more than once
+    static std::atomic<std::shared_ptr<const ConstantFrames>> last;
+    auto frames = last.load();
+    if (not frames or frames->getBtsId() != btsId or frames->getLoad() != load)
+    {
+        frames = std::make_shared<const ConstantFrames>(btsId, load);
+        last.store(frames);
+    }
+    return frames;
+}
+
+BtsId ConstantFrames::getBtsId() const
+{
+    return btsId;
+}
+
+std::optional<CellLoad> ConstantFrames::getLoad() const
+{
+    return load;
+}
+
+const Frame &ConstantFrames::getSib(bool narrowHeader) const
+{
+    return narrowHeader ? narrowSib : sib;
+}
+
+}
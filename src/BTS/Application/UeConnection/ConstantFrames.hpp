@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include "Messages/BtsId.hpp"
+#include "Messages/CellLoad.hpp"
+#include "Messages/Frame.hpp"
+
+namespace bts
+{
+
+using common::BtsId;
+using common::CellLoad;
+using common::Frame;
+
+/**
+ * Messages with the same bytes for the whole life of BTS (or as long as its load does not change) -
+ * encoded once, then shared (see Frame) by all UE.
+ * AttachResponse is not one of them - its header is addressed to the phone number of the UE.
+ */
+class ConstantFrames
+{
+public:
+    explicit ConstantFrames(BtsId btsId, std::optional<CellLoad> load = std::nullopt);
+
+    /**
+     * Thread safe, frames are created by the first call for given BTS and load
+     */
+    static std::shared_ptr<const ConstantFrames> of(BtsId btsId, std::optional<CellLoad> load = std::nullopt);
+
+    BtsId getBtsId() const;
+    std::optional<CellLoad> getLoad() const;
+    /**
+     * @param narrowHeader - for old UE, see NarrowHeader.hpp
+     */
+    const Frame& getSib(bool narrowHeader) const;
+
+private:
+    BtsId btsId;
+    std::optional<CellLoad> load;
+    Frame sib;
+    Frame narrowSib;
+};
+
+}
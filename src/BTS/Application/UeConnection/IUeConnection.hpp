@@ -3,17 +3,21 @@
 #include <iostream>
 #include <memory>
 #include <functional>
+#include <optional>
 
 #include "Messages.hpp"
 #include "Messages/BtsId.hpp"
+#include "Messages/CellLoad.hpp"
 
 
 namespace bts
 {
 
 using common::BinaryMessage;
+using common::Frame;
 using common::PhoneNumber;
 using common::BtsId;
+using common::CellLoad;
 
 class UeSlot;
 class IUeConnection
@@ -23,10 +27,17 @@ public:
     virtual ~IUeConnection() = default;
 
     virtual void start(UeSlot ueSlot) = 0;
-    virtual void sendMessage(BinaryMessage message) = 0;
-    virtual void sendSib(BtsId btsId) = 0;
+    virtual void sendMessage(Frame message) = 0;
+    /**
+     * @param load - see IUeRelay::getLoad()
+     */
+    virtual void sendSib(BtsId btsId, std::optional<CellLoad> load) = 0;
     virtual PhoneNumber getPhoneNumber() const = 0;
     virtual bool isAttached() const = 0;
+    /**
+     * UE does not keep up with what is sent to it - see ITransport::isCongested()
+     */
+    virtual bool isCongested() const = 0;
     virtual void print(std::ostream&) const = 0;
 };
 
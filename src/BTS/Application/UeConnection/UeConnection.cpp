@@ -1,28 +1,46 @@
 #include "UeConnection.hpp"
-#include "Messages/IncomingMessage.hpp"
-#include "Messages/OutgoingMessage.hpp"
+#include "ConstantFrames.hpp"
+#include "Messages/MessageSchema.hpp"
+#include "Messages/NarrowHeader.hpp"
+#include "Statistics/ForwardingLatency.hpp"
 
 namespace bts
 {
 
 using namespace std::placeholders;
 using common::MessageId;
+using common::ForwardingLatency;
+namespace schema = common::schema;
 
-UeConnection::UeConnection(ITransportPtr transport, common::ILogger &logger, SyncGuardPtr syncGuard)
+UeConnection::UeConnection(ITransportPtr transport, common::ILogger &logger, SyncGuardPtr syncGuard,
+                           common::MetricsRegistry &metricsRegistry, std::shared_ptr<CallSessions> callSessions,
+                           std::shared_ptr<SmsStore> smsStore)
     : syncGuard(syncGuard),
       transport(transport),
-      logger(logger, std::bind(&UeConnection::printPrefix, this, _1))
+      baseLogger(logger),
+      logger(logger, std::bind(&UeConnection::printPrefix, this, _1)),
+      metricsRegistry(metricsRegistry),
+      callSessions(callSessions),
+      callParty(callSessions ? std::make_shared<CallSessions::Party>(*this) : nullptr),
+      smsStore(smsStore)
 {
 }
 
 UeConnection::~UeConnection()
 {
+    if (callParty)
+    {
+        // waits for the peer sending to this UE right now
+        callParty->release();
+        releaseCall();
+    }
     stop();
 }
 
 void UeConnection::start(UeSlot ueSlot)
 {
     this->ueSlot = ueSlot;
+    metrics.emplace(metricsRegistry, transport->addressToString());
     transport->registerDisconnectedCallback(std::bind(&UeConnection::onUeDisconnectedCallback, this));
     transport->registerMessageCallback(std::bind(&UeConnection::onUeMessageCallback, this, _1));
 }
@@ -35,40 +53,82 @@ void UeConnection::stop()
 
 void UeConnection::sendAttachResponse(bool success, PhoneNumber phoneNumber)
 {
-    common::OutgoingMessage messageBuilder(MessageId::AttachResponse, PhoneNumber{}, phoneNumber);
-    messageBuilder.writeNumber<bool>(success);
-    sendMessage(messageBuilder.getMessage());
+    if (metrics)
+    {
+        (success ? metrics->attachAccepted : metrics->attachRejected)->increment();
+    }
+    sendMessage(schema::encode<MessageId::AttachResponse>(PhoneNumber{}, phoneNumber, {success}));
 }
 
-void UeConnection::sendSib(BtsId btsId)
+void UeConnection::sendSib(BtsId btsId, std::optional<CellLoad> load)
 {
-    common::OutgoingMessage messageBuilder(MessageId::Sib, PhoneNumber{}, PhoneNumber{});
-    messageBuilder.writeBtsId(btsId);
-    sendMessage(messageBuilder.getMessage());
+    if (isCongested())
+    {
+        // repeated anyway - not worth queueing behind what UE does not read
+        logger.logDebug("Sib not sent - congested");
+        return;
+    }
+    sendMessage(ConstantFrames::of(btsId, load)->getSib(narrowHeader));
 }
 
 PhoneNumber UeConnection::getPhoneNumber() const
 {
+    SyncLock lock(*syncGuard);
     return ueSlot.getPhoneNumber();
 }
 
-void UeConnection::sendMessage(BinaryMessage messageToSend)
+void UeConnection::sendMessage(Frame messageToSend)
+{
+    trySendMessage(std::move(messageToSend));
+}
+
+bool UeConnection::trySendMessage(Frame messageToSend)
 {
-    transport->sendMessage(std::move(messageToSend));
+    if (narrowHeader and not schema::hasNarrowHeader(messageToSend.view()))
+    {
+        auto narrow = schema::narrowHeader(messageToSend.view());
+        if (not narrow)
+        {
+            // called by other UE connections too - so not prefixed with this one (it would take its lock)
+            baseLogger.logError("Not sent to UE with narrow header: ", transport->addressToString(),
+                                ", ", schema::decodeHeader(messageToSend.view()));
+            return false;
+        }
+        messageToSend = std::move(*narrow);
+    }
+    auto size = messageToSend.size();
+    bool sent = transport->sendMessage(std::move(messageToSend));
+    if (not metrics)
+    {
+        return sent;
+    }
+    if (sent)
+    {
+        metrics->messagesSent->increment();
+        metrics->bytesSent->increment(size);
+    }
+    else
+    {
+        metrics->messagesNotSent->increment();
+    }
+    return sent;
+}
+
+bool UeConnection::isCongested() const
+{
+    return transport->isCongested();
 }
 
 void UeConnection::sendUnknownRecipient(const MessageHeader &messageHeader)
 {
-    common::OutgoingMessage messageBuilder(MessageId::UnknownRecipient, PhoneNumber{}, getPhoneNumber());
-    messageBuilder.writeMessageHeader(messageHeader);
-    sendMessage(messageBuilder.getMessage());
+    metrics->unknownRecipient->increment();
+    sendMessage(schema::encode<MessageId::UnknownRecipient>(PhoneNumber{}, getPhoneNumber(), {messageHeader}));
 }
 
 void UeConnection::sendUnknownSender(const MessageHeader &messageHeader)
 {
-    common::OutgoingMessage messageBuilder(MessageId::UnknownSender, PhoneNumber{}, getPhoneNumber());
-    messageBuilder.writeMessageHeader(messageHeader);
-    sendMessage(messageBuilder.getMessage());
+    metrics->unknownSender->increment();
+    sendMessage(schema::encode<MessageId::UnknownSender>(PhoneNumber{}, getPhoneNumber(), {messageHeader}));
 }
 
 void UeConnection::attach(PhoneNumber phoneNumber)
@@ -84,13 +144,37 @@ void UeConnection::detach()
 
 bool UeConnection::isAttached() const
 {
+    SyncLock lock(*syncGuard);
     return ueSlot.isAttached();
 }
 
-void UeConnection::onUeMessageCallbackBody(BinaryMessage message)
+void UeConnection::onUeMessageCallbackBody(Frame message)
 {
-    common::IncomingMessage incomingMessage(message);
-    MessageHeader messageHeader = incomingMessage.readMessageHeader();
+    const bool withNarrowHeader = schema::hasNarrowHeader(message.view());
+    if (withNarrowHeader)
+    {
+        auto narrowMessageHeader = schema::decodeNarrowHeader(message.view());
+        try
+        {
+            message = schema::widenHeader(message.view());
+        }
+        catch (common::IncomingMessage::ReadEx& ex)
+        {
+            // never forwarded truncated
+            metrics->decodeErrors->increment();
+            logger.logError("Ue message not widened: ", ex.what());
+            sendUnknownRecipient(narrowMessageHeader);
+            return;
+        }
+    }
+    MessageHeader messageHeader = schema::decodeHeader(message.view());
+    ForwardingLatency::setMessageId(messageHeader.messageId);
+
+    // negotiated by AttachRequest - attached UE is answered as it asked to attach, whatever it sends later
+    if (messageHeader.messageId == MessageId::AttachRequest or not isAttached())
+    {
+        narrowHeader = withNarrowHeader;
+    }
 
     if (messageHeader.messageId == MessageId::AttachRequest)
     {
@@ -103,24 +187,41 @@ void UeConnection::onUeMessageCallbackBody(BinaryMessage message)
             logger.logError("Not ready for: ", messageHeader);
             sendUnknownSender(messageHeader);
         }
-        else if (not forwardMessage(std::move(message), messageHeader.to))
+        // copy shares the payload - kept for SMS store
+        else if (not forwardMessage(smsStore ? message : std::move(message), messageHeader.to))
         {
-            logger.logError("Cannot forward: ", messageHeader);
-            sendUnknownRecipient(messageHeader);
+            if (not storeSms(messageHeader, message))
+            {
+                logger.logError("Cannot forward: ", messageHeader);
+                sendUnknownRecipient(messageHeader);
+            }
         }
         else
         {
             logger.logDebug("Forwarded: ", messageHeader);
+            trackCall(messageHeader);
         }
     }
 }
 
-void UeConnection::onUeMessageCallback(BinaryMessage message)
+void UeConnection::onUeMessageCallback(Frame message)
 {
+    if (forwardCallTalk(message))
+    {
+        return;
+    }
     SyncLock lock(*syncGuard);
+    ForwardingLatency::markLocked();
+    metrics->messagesReceived->increment();
+    metrics->bytesReceived->increment(message.size());
     try
     {
-        onUeMessageCallbackBody(message);
+        onUeMessageCallbackBody(std::move(message));
+    }
+    catch (common::IncomingMessage::ReadEx& ex)
+    {
+        metrics->decodeErrors->increment();
+        logger.logError("Ue message not decoded: ", ex.what());
     }
     catch (std::exception& ex)
     {
@@ -150,6 +251,7 @@ void UeConnection::onAttachRequest(PhoneNumber phoneNumber)
         // special case #3
         logger.logError("ReAttach with other number: ", phoneNumber);
         // no we - as, nevertheless, we want to attach
+        releaseCall();
     }
     attach(phoneNumber);
 
@@ -162,16 +264,116 @@ void UeConnection::onAttachRequest(PhoneNumber phoneNumber)
 
     logger.logInfo("Attached");
     sendAttachResponse(true, phoneNumber);
+    deliverStoredSms(phoneNumber);
 }
 
-bool UeConnection::forwardMessage(BinaryMessage message, PhoneNumber to)
+bool UeConnection::forwardMessage(Frame message, PhoneNumber to)
 {
+    ForwardingLatency::StageScope relay(ForwardingLatency::Relay);
     return ueSlot.sendMessage(std::move(message), to);
 }
 
+bool UeConnection::forwardCallTalk(const Frame &message)
+{
+    // established call and wide header only - other CallTalk frames go the generic way, see CallSessions
+    if (not callParty or message.empty() or *message.data() != (common::get(MessageId::CallTalk) | schema::WIDE_HEADER_FLAG))
+    {
+        return false;
+    }
+    ForwardingLatency::setMessageId(MessageId::CallTalk);
+    {
+        ForwardingLatency::StageScope relay(ForwardingLatency::Relay);
+        if (not callParty->talk(message))
+        {
+            return false;
+        }
+    }
+    metrics->messagesReceived->increment();
+    metrics->bytesReceived->increment(message.size());
+    return true;
+}
+
+void UeConnection::trackCall(const MessageHeader &messageHeader)
+{
+    if (not callSessions)
+    {
+        return;
+    }
+    switch (messageHeader.messageId)
+    {
+    case MessageId::CallRequest:
+        callSessions->onCallRequest(messageHeader.from, messageHeader.to, callParty);
+        break;
+    case MessageId::CallAccepted:
+        callSessions->onCallAccepted(messageHeader.from, messageHeader.to, callParty);
+        break;
+    case MessageId::CallDropped:
+        callSessions->onCallDropped(messageHeader.from, messageHeader.to);
+        break;
+    default:
+        break;
+    }
+}
+
+void UeConnection::releaseCall()
+{
+    if (callSessions)
+    {
+        callSessions->release(callParty);
+    }
+}
+
+bool UeConnection::storeSms(const MessageHeader &messageHeader, const Frame &message)
+{
+    if (not smsStore or messageHeader.messageId != MessageId::Sms or not smsStore->store(messageHeader.to, message))
+    {
+        return false;
+    }
+    logger.logDebug("Stored for offline UE: ", messageHeader);
+    return true;
+}
+
+void UeConnection::deliverStoredSms(PhoneNumber phoneNumber)
+{
+    if (not smsStore)
+    {
+        return;
+    }
+    smsStore->addSubscriber(phoneNumber);
+    std::size_t delivered = 0u;
+    // what UE does not keep up with stays stored - till it attaches again;
+    // removed once queued by the transport (not dropped, no overflow) - so rather delivered twice
+    // (BTS killed meanwhile) than lost, but what is queued when the connection breaks is lost
+    while (not isCongested())
+    {
+        auto batch = smsStore->peek(phoneNumber, SMS_DELIVERY_BATCH);
+        std::size_t sent = 0u;
+        while (sent < batch.size() and trySendMessage(batch[sent].message))
+        {
+            ++sent;
+        }
+        if (sent == 0u)
+        {
+            break;
+        }
+        smsStore->acknowledge(phoneNumber, batch[sent - 1u].sequence);
+        delivered += sent;
+        if (sent < batch.size())
+        {
+            break;
+        }
+    }
+    if (delivered > 0u)
+    {
+        logger.logInfo("Stored SMS delivered: ", delivered, ", still stored: ", smsStore->countStored(phoneNumber));
+    }
+}
+
 void UeConnection::onUeDisconnectedCallback()
 {
-    SyncLock lock(*syncGuard);
+    // detach() may destroy this connection - and with it the last owner of its own guard (sharded relay)
+    auto guard = syncGuard;
+    SyncLock lock(*guard);
 
     try
     {
@@ -1,14 +1,19 @@
 #pragma once
 
 #include "IUeConnection.hpp"
+#include "UeConnectionMetrics.hpp"
 #include "ITransport.hpp"
 #include "UeRelay/IUeRelay.hpp"
+#include "Calls/CallSessions.hpp"
+#include "SmsStore/SmsStore.hpp"
 #include "Synchronization.hpp"
 #include "Logger/ILogger.hpp"
 
 #include "Messages/MessageHeader.hpp"
 #include "Messages/IncomingMessage.hpp"
 #include "Logger/PrefixedLogger.hpp"
+#include <atomic>
+#include <optional>
 
 namespace bts
 {
@@ -17,27 +22,47 @@ using common::MessageHeader;
 class UeConnection : public IUeConnection
 {
 public:
-    UeConnection(ITransportPtr transport, common::ILogger& logger, SyncGuardPtr syncGuard);
+    // stored SMS peeked from SmsStore at once
+    static constexpr std::size_t SMS_DELIVERY_BATCH = 32u;
+
+    /**
+     * @param callSessions - calls of this UE are tracked there and its CallTalk frames of established calls
+     *                       are forwarded by the fast path, null - not tracked
+     * @param smsStore - SMS to offline subscribers are stored there and delivered when they attach,
+     *                   null - UnknownRecipient sent back
+     */
+    UeConnection(ITransportPtr transport, common::ILogger& logger, SyncGuardPtr syncGuard,
+                 common::MetricsRegistry& metricsRegistry = common::MetricsRegistry::getGlobal(),
+                 std::shared_ptr<CallSessions> callSessions = nullptr,
+                 std::shared_ptr<SmsStore> smsStore = nullptr);
     ~UeConnection() override;
 
     void start(UeSlot ueSlot) override;
 
-    void sendMessage(BinaryMessage message) override;
-    void sendSib(BtsId btsId) override;
+    void sendMessage(Frame message) override;
+    void sendSib(BtsId btsId, std::optional<CellLoad> load) override;
     PhoneNumber getPhoneNumber() const override;
     bool isAttached() const override;
+    bool isCongested() const override;
 
     void print(std::ostream& os) const override;
 private:
 
-    void onUeMessageCallback(BinaryMessage message);
-    void onUeMessageCallbackBody(BinaryMessage message);
+    void onUeMessageCallback(Frame message);
+    void onUeMessageCallbackBody(Frame message);
     void onAttachRequest(PhoneNumber phoneNumber);
-    bool forwardMessage(BinaryMessage message, PhoneNumber to);
+    bool forwardMessage(Frame message, PhoneNumber to);
+    bool forwardCallTalk(const Frame& message);
+    void trackCall(const MessageHeader& messageHeader);
+    void releaseCall();
+    bool storeSms(const MessageHeader& messageHeader, const Frame& message);
+    void deliverStoredSms(PhoneNumber phoneNumber);
 
     void onUeDisconnectedCallback();
     void stop();
 
+    // @return false when not accepted by the transport or not fitting narrow header
+    bool trySendMessage(Frame message);
     void sendAttachResponse(bool success, PhoneNumber phoneNumber);
     void sendUnknownRecipient(const MessageHeader& messageHeader);
     void sendUnknownSender(const MessageHeader& messageHeader);
@@ -49,8 +74,17 @@ private:
 
     SyncGuardPtr syncGuard;
     UeSlot ueSlot;
+    common::ILogger& baseLogger;
     common::PrefixedLogger logger;
     ITransportPtr transport;
+    common::MetricsRegistry& metricsRegistry;
+    // labelled with transport address - so known since start
+    std::optional<UeConnectionMetrics> metrics;
+    // old UE - as negotiated by AttachRequest, see NarrowHeader.hpp
+    std::atomic<bool> narrowHeader{true};
+    std::shared_ptr<CallSessions> callSessions;
+    CallSessions::PartyPtr callParty;
+    std::shared_ptr<SmsStore> smsStore;
 };
 
 }
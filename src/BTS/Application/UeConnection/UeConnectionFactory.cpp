@@ -5,14 +5,19 @@
 namespace bts
 {
 
-UeConnectionFactory::UeConnectionFactory(common::ILogger &logger, std::shared_ptr<SyncGuard> syncGuard)
+UeConnectionFactory::UeConnectionFactory(common::ILogger &logger, std::shared_ptr<SyncGuard> syncGuard,
+                                         std::shared_ptr<CallSessions> callSessions,
+                                         std::shared_ptr<SmsStore> smsStore)
     : logger(logger),
-      syncGuard(syncGuard)
+      syncGuard(syncGuard),
+      callSessions(callSessions),
+      smsStore(smsStore)
 {}
 
 IUeRelay::UePtr UeConnectionFactory::createConnection(ITransportPtr transport)
 {
-    return std::make_unique<UeConnection>(transport, logger, syncGuard);
+    return std::make_unique<UeConnection>(transport, logger, syncGuard ? syncGuard : std::make_shared<SyncGuard>(),
+                                          common::MetricsRegistry::getGlobal(), callSessions, smsStore);
 }
 
 }
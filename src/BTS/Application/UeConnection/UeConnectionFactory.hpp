@@ -3,6 +3,8 @@
 #include "IUeConnectionFactory.hpp"
 #include "Logger/ILogger.hpp"
 #include "Synchronization.hpp"
+#include "Calls/CallSessions.hpp"
+#include "SmsStore/SmsStore.hpp"
 
 namespace bts
 {
@@ -10,8 +12,16 @@ namespace bts
 class UeConnectionFactory : public IUeConnectionFactory
 {
 public:
+    /**
+     * When syncGuard is null - every connection is guarded by its own SyncGuard,
+     * this is only valid with IUeRelay that is thread safe on its own (see ShardedUeRelay)
+     * @param callSessions - shared by all connections, null - calls not tracked
+     * @param smsStore - shared by all connections, null - SMS to offline UE not stored
+     */
     UeConnectionFactory(common::ILogger& logger,
-                        std::shared_ptr<SyncGuard> syncGuard);
+                        std::shared_ptr<SyncGuard> syncGuard,
+                        std::shared_ptr<CallSessions> callSessions = nullptr,
+                        std::shared_ptr<SmsStore> smsStore = nullptr);
 
     IUeRelay::UePtr createConnection(ITransportPtr transport) override;
 
@@ -19,6 +29,8 @@ private:
     std::shared_ptr<IUeRelay> ueRelay;
     common::ILogger& logger;
     std::shared_ptr<SyncGuard> syncGuard;
+    std::shared_ptr<CallSessions> callSessions;
+    std::shared_ptr<SmsStore> smsStore;
 };
 
 }
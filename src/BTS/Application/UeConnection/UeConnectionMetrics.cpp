@@ -0,0 +1,48 @@
+#include "UeConnectionMetrics.hpp"
+
+namespace bts
+{
+
+using common::MetricDefinition;
+using common::MetricType;
+
+const MetricDefinition UeConnectionMetrics::MESSAGES_RECEIVED{
+    "bts_ue_messages_received_total", "Messages received from UE", MetricType::Counter, "ue"};
+const MetricDefinition UeConnectionMetrics::BYTES_RECEIVED{
+    "bts_ue_bytes_received_total", "Bytes of messages received from UE", MetricType::Counter, "ue"};
+const MetricDefinition UeConnectionMetrics::MESSAGES_SENT{
+    "bts_ue_messages_sent_total", "Messages sent to UE", MetricType::Counter, "ue"};
+const MetricDefinition UeConnectionMetrics::BYTES_SENT{
+    "bts_ue_bytes_sent_total", "Bytes of messages sent to UE", MetricType::Counter, "ue"};
+const MetricDefinition UeConnectionMetrics::MESSAGES_NOT_SENT{
+    "bts_ue_messages_not_sent_total", "Messages to UE dropped or not sent", MetricType::Counter, "ue"};
+const MetricDefinition UeConnectionMetrics::UNKNOWN_RECIPIENT{
+    "bts_unknown_recipient_total", "UnknownRecipient responses", MetricType::Counter};
+const MetricDefinition UeConnectionMetrics::UNKNOWN_SENDER{
+    "bts_unknown_sender_total", "UnknownSender responses", MetricType::Counter};
+const MetricDefinition UeConnectionMetrics::ATTACH_ACCEPTED{
+    "bts_attach_accepted_total", "Attach requests accepted", MetricType::Counter};
+const MetricDefinition UeConnectionMetrics::ATTACH_REJECTED{
+    "bts_attach_rejected_total", "Attach requests rejected", MetricType::Counter};
+const MetricDefinition UeConnectionMetrics::DECODE_ERRORS{
+    "bts_decode_errors_total", "Messages from UE not decoded", MetricType::Counter};
+const MetricDefinition UeConnectionMetrics::CONNECTIONS{
+    "bts_ue_connections", "UE connections", MetricType::Gauge};
+
+UeConnectionMetrics::UeConnectionMetrics(common::MetricsRegistry &registry, const std::string &address)
+    : messagesReceived(registry.addCounter(MESSAGES_RECEIVED, address)),
+      bytesReceived(registry.addCounter(BYTES_RECEIVED, address)),
+      messagesSent(registry.addCounter(MESSAGES_SENT, address)),
+      bytesSent(registry.addCounter(BYTES_SENT, address)),
+      messagesNotSent(registry.addCounter(MESSAGES_NOT_SENT, address)),
+      unknownRecipient(registry.addCounter(UNKNOWN_RECIPIENT)),
+      unknownSender(registry.addCounter(UNKNOWN_SENDER)),
+      attachAccepted(registry.addCounter(ATTACH_ACCEPTED)),
+      attachRejected(registry.addCounter(ATTACH_REJECTED)),
+      decodeErrors(registry.addCounter(DECODE_ERRORS)),
+      connection(registry.addGauge(CONNECTIONS))
+{
+    connection->set(1);
+}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include "Metrics/MetricsRegistry.hpp"
+
+namespace bts
+{
+
+/**
+ * Metrics of one UE connection: traffic labelled with its transport address,
+ * responses and attach results summed up over all connections.
+ */
+struct UeConnectionMetrics
+{
+    static const common::MetricDefinition MESSAGES_RECEIVED;
+    static const common::MetricDefinition BYTES_RECEIVED;
+    static const common::MetricDefinition MESSAGES_SENT;
+    static const common::MetricDefinition BYTES_SENT;
+    static const common::MetricDefinition MESSAGES_NOT_SENT;
+    static const common::MetricDefinition UNKNOWN_RECIPIENT;
+    static const common::MetricDefinition UNKNOWN_SENDER;
+    static const common::MetricDefinition ATTACH_ACCEPTED;
+    static const common::MetricDefinition ATTACH_REJECTED;
+    static const common::MetricDefinition DECODE_ERRORS;
+    static const common::MetricDefinition CONNECTIONS;
+
+    UeConnectionMetrics(common::MetricsRegistry& registry, const std::string& address);
+
+    common::MetricsRegistry::CounterPtr messagesReceived;
+    common::MetricsRegistry::CounterPtr bytesReceived;
+    common::MetricsRegistry::CounterPtr messagesSent;
+    common::MetricsRegistry::CounterPtr bytesSent;
+    // dropped or failed - e.g. congested connection, see SendQueue
+    common::MetricsRegistry::CounterPtr messagesNotSent;
+    common::MetricsRegistry::CounterPtr unknownRecipient;
+    common::MetricsRegistry::CounterPtr unknownSender;
+    common::MetricsRegistry::CounterPtr attachAccepted;
+    common::MetricsRegistry::CounterPtr attachRejected;
+    common::MetricsRegistry::CounterPtr decodeErrors;
+    // 1 while connection exists
+    common::MetricsRegistry::GaugePtr connection;
+};
+
+}
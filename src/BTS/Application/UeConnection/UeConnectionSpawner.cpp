@@ -44,7 +44,7 @@ void UeConnectionSpawner::spawnConnection(ITransportPtr transport)
     SyncLock lock(*syncGuard);
     auto ueSlot = ueRelay->add(std::move(newUe));
     newUePtr->start(ueSlot);
-    newUePtr->sendSib(btsId);
+    newUePtr->sendSib(btsId, ueRelay->getLoad());
 }
 
 
@@ -6,66 +6,67 @@ namespace bts
 class UeSlot::NullImpl : public IImpl
 {
 public:
-    bool sendMessage(BinaryMessage message, PhoneNumber to) override;
-    IImplPtr attach(PhoneNumber phone) override;
-    bool isAttached() const override;
-    PhoneNumber getPhoneNumber() const override;
-    void remove() override;
+    bool sendMessage(Handle, Frame message, PhoneNumber to) override;
+    IImplPtr attach(Handle, PhoneNumber phone) override;
+    bool isAttached(Handle) const override;
+    PhoneNumber getPhoneNumber(Handle) const override;
+    void remove(Handle) override;
 };
 
 UeSlot::UeSlot() : UeSlot(std::make_shared<NullImpl>())
 {}
 
-UeSlot::UeSlot(IImplPtr impl)
-    : impl(impl)
+UeSlot::UeSlot(IImplPtr impl, Handle handle)
+    : impl(impl),
+      handle(handle)
 {}
 
-bool UeSlot::sendMessage(BinaryMessage message, PhoneNumber to)
+bool UeSlot::sendMessage(Frame message, PhoneNumber to)
 {
-    return impl->sendMessage(std::move(message), to);
+    return impl->sendMessage(handle, std::move(message), to);
 }
 
 void UeSlot::attach(PhoneNumber phone)
 {
-    impl = impl->attach(phone);
+    impl = impl->attach(handle, phone);
 }
 
 bool UeSlot::isAttached() const
 {
-    return impl->isAttached();
+    return impl->isAttached(handle);
 }
 
 PhoneNumber UeSlot::getPhoneNumber() const
 {
-    return impl->getPhoneNumber();
+    return impl->getPhoneNumber(handle);
 }
 
 void UeSlot::remove()
 {
-    impl->remove();
+    impl->remove(handle);
 }
 
-bool UeSlot::NullImpl::sendMessage(BinaryMessage message, PhoneNumber to)
+bool UeSlot::NullImpl::sendMessage(Handle, Frame message, PhoneNumber to)
 {
     return false;
 }
 
-UeSlot::IImplPtr UeSlot::NullImpl::attach(PhoneNumber phone)
+UeSlot::IImplPtr UeSlot::NullImpl::attach(Handle, PhoneNumber phone)
 {
     return shared_from_this();
 }
 
-bool UeSlot::NullImpl::isAttached() const
+bool UeSlot::NullImpl::isAttached(Handle) const
 {
     return false;
 }
 
-PhoneNumber UeSlot::NullImpl::getPhoneNumber() const
+PhoneNumber UeSlot::NullImpl::getPhoneNumber(Handle) const
 {
     return {};
 }
 
-void UeSlot::NullImpl::remove()
+void UeSlot::NullImpl::remove(Handle)
 {
 }
 
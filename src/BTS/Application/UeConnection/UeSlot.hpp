@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include "UeConnection/IUeConnection.hpp"
 
@@ -10,22 +11,32 @@ namespace bts
 class UeSlot
 {
 public:
+    /**
+     * Identifies the slot for implementations shared by many slots (see FlatUeRelay),
+     * implementations owned by single slot ignore it
+     */
+    struct Handle
+    {
+        std::uint32_t index;
+        std::uint32_t generation;
+    };
+
     class IImpl;
     using IImplPtr = std::shared_ptr<IImpl>;
     class IImpl : public std::enable_shared_from_this<IImpl>
     {
     public:
         virtual ~IImpl() = default;
-        virtual bool sendMessage(BinaryMessage message, PhoneNumber to) = 0;
-        virtual IImplPtr attach(PhoneNumber phone) = 0;
-        virtual bool isAttached() const = 0;
-        virtual PhoneNumber getPhoneNumber() const = 0;
-        virtual void remove() = 0;
+        virtual bool sendMessage(Handle handle, Frame message, PhoneNumber to) = 0;
+        virtual IImplPtr attach(Handle handle, PhoneNumber phone) = 0;
+        virtual bool isAttached(Handle handle) const = 0;
+        virtual PhoneNumber getPhoneNumber(Handle handle) const = 0;
+        virtual void remove(Handle handle) = 0;
     };
 
     UeSlot();
-    UeSlot(IImplPtr impl);
-    bool sendMessage(BinaryMessage message, PhoneNumber to);
+    UeSlot(IImplPtr impl, Handle handle = {});
+    bool sendMessage(Frame message, PhoneNumber to);
     void attach(PhoneNumber phone);
     bool isAttached() const;
     PhoneNumber getPhoneNumber() const;
@@ -33,6 +44,7 @@ public:
 
 private:
     IImplPtr impl;
+    Handle handle{};
     class NullImpl;
 };
 
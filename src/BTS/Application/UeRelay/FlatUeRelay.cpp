@@ -0,0 +1,368 @@
+#include "FlatUeRelay.hpp"
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace bts
+{
+
+class FlatUeRelay::SlotImpl : public UeSlot::IImpl
+{
+public:
+    SlotImpl(FlatUeRelay& relay);
+
+    bool sendMessage(Handle, Frame message, PhoneNumber to) override;
+    UeSlot::IImplPtr attach(Handle handle, PhoneNumber phone) override;
+    bool isAttached(Handle handle) const override;
+    PhoneNumber getPhoneNumber(Handle handle) const override;
+    void remove(Handle handle) override;
+
+private:
+    FlatUeRelay& relay;
+};
+
+
+FlatUeRelay::FlatUeRelay(common::ILogger &logger, std::size_t capacity)
+    : slotImpl(std::make_shared<SlotImpl>(*this)),
+      logger(logger, "[RELAY]")
+{
+    slots.reserve(capacity);
+    notAttachedUe.reserve(capacity);
+    rehashPhones(std::bit_ceil(std::max<std::size_t>(2u * capacity, 2u)));
+}
+
+UeSlot FlatUeRelay::add(UePtr ue)
+{
+    auto index = allocateSlot(std::move(ue));
+    insertNotAttached(index);
+    return UeSlot(slotImpl, Handle{index, slots[index].generation});
+}
+
+bool FlatUeRelay::sendMessage(Frame message, PhoneNumber to)
+{
+    auto position = findPhone(to);
+    if (position == phoneTable.size())
+    {
+        logger.logError("Connection does not exist for: ", to);
+        return false;
+    }
+    slots[phoneTable[position].slot].ue->sendMessage(std::move(message));
+    return true;
+}
+
+std::size_t FlatUeRelay::broadcast(Frame message, BroadcastScope scope)
+{
+    std::size_t count = 0u;
+    // straight over the slots - no visitor call per UE
+    for (auto& slot: slots)
+    {
+        if (slot.ue and (scope == BroadcastScope::All or slot.phone.isValid() == (scope == BroadcastScope::Attached)))
+        {
+            slot.ue->sendMessage(message);
+            ++count;
+        }
+    }
+    return count;
+}
+
+std::size_t FlatUeRelay::count() const
+{
+    return countAttached() + countNotAttached();
+}
+
+std::size_t FlatUeRelay::countAttached() const
+{
+    return numberOfAttached;
+}
+
+std::size_t FlatUeRelay::countNotAttached() const
+{
+    return notAttachedUe.size();
+}
+
+void FlatUeRelay::visitAttachedUe(IUeRelay::UeVisitor ueVisitor)
+{
+    // by index - the visitor might add UE (so reallocate slots)
+    for (std::size_t index = 0u; index < slots.size(); ++index)
+    {
+        if (slots[index].ue and slots[index].phone.isValid())
+        {
+            ueVisitor(*slots[index].ue);
+        }
+    }
+}
+
+void FlatUeRelay::visitNotAttachedUe(IUeRelay::UeVisitor ueVisitor)
+{
+    for (std::size_t position = 0u; position < notAttachedUe.size(); ++position)
+    {
+        ueVisitor(*slots[notAttachedUe[position]].ue);
+    }
+}
+
+std::size_t FlatUeRelay::visitNextNotAttachedUe(IUeRelay::UeVisitor ueVisitor, std::size_t maxCount)
+{
+    auto numberToVisit = std::min(maxCount, notAttachedUe.size());
+    for (std::size_t i = 0; i < numberToVisit and not notAttachedUe.empty(); ++i)
+    {
+        if (nextNotAttached >= notAttachedUe.size())
+        {
+            nextNotAttached = 0u;
+        }
+        ueVisitor(*slots[notAttachedUe[nextNotAttached++]].ue);
+    }
+    return numberToVisit;
+}
+
+FlatUeRelay::Slot *FlatUeRelay::findSlot(Handle handle)
+{
+    return const_cast<Slot*>(std::as_const(*this).findSlot(handle));
+}
+
+const FlatUeRelay::Slot *FlatUeRelay::findSlot(Handle handle) const
+{
+    if (handle.index >= slots.size())
+    {
+        return nullptr;
+    }
+    auto& slot = slots[handle.index];
+    return slot.ue and slot.generation == handle.generation ? &slot : nullptr;
+}
+
+UeSlot::IImplPtr FlatUeRelay::attach(Handle handle, PhoneNumber phone)
+{
+    auto slot = findSlot(handle);
+    if (not slot)
+    {
+        return slotImpl;
+    }
+
+    if (slot->phone.isValid())
+    {
+        if (phone == slot->phone)
+        {
+            logger.logDebug("Reattached to same phone number ignored: ", *slot->ue);
+            return slotImpl;
+        }
+        erasePhone(slot->phone);
+        slot->phone = PhoneNumber{};
+        if (phone.isValid() and insertPhone(phone, handle.index))
+        {
+            slot->phone = phone;
+            logger.logDebug("Attached: ", *slot->ue);
+            return slotImpl;
+        }
+        insertNotAttached(handle.index);
+        logger.logError("While re-attaching: other connection exists for: ", phone);
+        return slotImpl;
+    }
+
+    if (phone.isValid() and insertPhone(phone, handle.index))
+    {
+        eraseNotAttached(handle.index);
+        slot->phone = phone;
+        logger.logDebug("Attached: ", *slot->ue);
+        return slotImpl;
+    }
+    logger.logError("While attaching: other connection exists for: ", phone);
+    return slotImpl;
+}
+
+void FlatUeRelay::remove(Handle handle)
+{
+    auto slot = findSlot(handle);
+    if (not slot)
+    {
+        return;
+    }
+
+    if (slot->phone.isValid())
+    {
+        logger.logDebug("Removed attached: ", *slot->ue);
+        erasePhone(slot->phone);
+    }
+    else
+    {
+        logger.logDebug("Removed not attached: ", *slot->ue);
+        eraseNotAttached(handle.index);
+    }
+    // destroyed when the relay is consistent again
+    UePtr ue = freeSlot(handle.index);
+}
+
+FlatUeRelay::SlotIndex FlatUeRelay::allocateSlot(UePtr ue)
+{
+    SlotIndex index = firstFreeSlot;
+    if (index != NO_SLOT)
+    {
+        firstFreeSlot = slots[index].position;
+    }
+    else
+    {
+        index = static_cast<SlotIndex>(slots.size());
+        slots.emplace_back();
+    }
+    slots[index].ue = std::move(ue);
+    slots[index].phone = PhoneNumber{};
+    return index;
+}
+
+FlatUeRelay::UePtr FlatUeRelay::freeSlot(SlotIndex index)
+{
+    auto& slot = slots[index];
+    UePtr ue = std::move(slot.ue);
+    slot.phone = PhoneNumber{};
+    ++slot.generation;
+    slot.position = firstFreeSlot;
+    firstFreeSlot = index;
+    return ue;
+}
+
+std::size_t FlatUeRelay::homeOf(PhoneNumber phone) const
+{
+    // Fibonacci hashing - top bits of the product, so consecutive phone numbers spread over the table
+    return (std::uint64_t{phone.value} * 0x9E3779B97F4A7C15ull) >> phoneTableShift;
+}
+
+std::size_t FlatUeRelay::findPhone(PhoneNumber phone) const
+{
+    const auto mask = phoneTable.size() - 1u;
+    for (auto position = homeOf(phone); phoneTable[position].phone.isValid(); position = (position + 1u) & mask)
+    {
+        if (phoneTable[position].phone == phone)
+        {
+            return position;
+        }
+    }
+    return phoneTable.size();
+}
+
+bool FlatUeRelay::insertPhone(PhoneNumber phone, SlotIndex index)
+{
+    if (2u * (numberOfAttached + 1u) > phoneTable.size())
+    {
+        rehashPhones(2u * phoneTable.size());
+    }
+    const auto mask = phoneTable.size() - 1u;
+    auto position = homeOf(phone);
+    for (; phoneTable[position].phone.isValid(); position = (position + 1u) & mask)
+    {
+        if (phoneTable[position].phone == phone)
+        {
+            return false;
+        }
+    }
+    phoneTable[position] = PhoneEntry{phone, index};
+    ++numberOfAttached;
+    return true;
+}
+
+void FlatUeRelay::erasePhone(PhoneNumber phone)
+{
+    auto hole = findPhone(phone);
+    if (hole == phoneTable.size())
+    {
+        return;
+    }
+    // backward shift deletion - no tombstones, so lookups do not degrade with churn
+    const auto mask = phoneTable.size() - 1u;
+    for (auto position = (hole + 1u) & mask; phoneTable[position].phone.isValid(); position = (position + 1u) & mask)
+    {
+        auto distanceFromHome = (position - homeOf(phoneTable[position].phone)) & mask;
+        if (distanceFromHome >= ((position - hole) & mask))
+        {
+            phoneTable[hole] = phoneTable[position];
+            hole = position;
+        }
+    }
+    phoneTable[hole] = PhoneEntry{};
+    --numberOfAttached;
+}
+
+void FlatUeRelay::rehashPhones(std::size_t size)
+{
+    std::vector<PhoneEntry> oldPhoneTable(size);
+    oldPhoneTable.swap(phoneTable);
+    phoneTableShift = 64u - static_cast<unsigned>(std::countr_zero(size));
+
+    const auto mask = phoneTable.size() - 1u;
+    for (auto& entry: oldPhoneTable)
+    {
+        if (entry.phone.isValid())
+        {
+            auto position = homeOf(entry.phone);
+            while (phoneTable[position].phone.isValid())
+            {
+                position = (position + 1u) & mask;
+            }
+            phoneTable[position] = entry;
+        }
+    }
+}
+
+void FlatUeRelay::insertNotAttached(SlotIndex index)
+{
+    notAttachedUe.push_back(index);
+    const auto last = notAttachedUe.size() - 1u;
+    slots[index].position = static_cast<SlotIndex>(last);
+    if (nextNotAttached < last)
+    {
+        // newly added is visited next - the one waiting there goes to the end of the round
+        moveNotAttached(nextNotAttached, last);
+        notAttachedUe[nextNotAttached] = index;
+        slots[index].position = static_cast<SlotIndex>(nextNotAttached);
+    }
+}
+
+void FlatUeRelay::eraseNotAttached(SlotIndex index)
+{
+    std::size_t position = slots[index].position;
+    if (position < nextNotAttached)
+    {
+        // the hole is filled from the end of visited part - so not visited are not skipped in this round
+        --nextNotAttached;
+        moveNotAttached(nextNotAttached, position);
+        position = nextNotAttached;
+    }
+    moveNotAttached(notAttachedUe.size() - 1u, position);
+    notAttachedUe.pop_back();
+}
+
+void FlatUeRelay::moveNotAttached(std::size_t from, std::size_t to)
+{
+    notAttachedUe[to] = notAttachedUe[from];
+    slots[notAttachedUe[to]].position = static_cast<SlotIndex>(to);
+}
+
+FlatUeRelay::SlotImpl::SlotImpl(FlatUeRelay &relay)
+    : relay(relay)
+{}
+
+bool FlatUeRelay::SlotImpl::sendMessage(Handle, Frame message, PhoneNumber to)
+{
+    return relay.sendMessage(std::move(message), to);
+}
+
+UeSlot::IImplPtr FlatUeRelay::SlotImpl::attach(Handle handle, PhoneNumber phone)
+{
+    return relay.attach(handle, phone);
+}
+
+bool FlatUeRelay::SlotImpl::isAttached(Handle handle) const
+{
+    auto slot = relay.findSlot(handle);
+    return slot and slot->phone.isValid();
+}
+
+PhoneNumber FlatUeRelay::SlotImpl::getPhoneNumber(Handle handle) const
+{
+    auto slot = relay.findSlot(handle);
+    return slot ? slot->phone : PhoneNumber{};
+}
+
+void FlatUeRelay::SlotImpl::remove(Handle handle)
+{
+    relay.remove(handle);
+}
+
+}
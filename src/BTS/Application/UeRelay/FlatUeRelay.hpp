@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "IUeRelay.hpp"
+#include "Logger/PrefixedLogger.hpp"
+
+namespace bts
+{
+
+/**
+ * IUeRelay keeping UE in contiguous slot array, addressed by UeSlot::Handle (index + generation),
+ * so the handle of removed UE does not reach the UE reusing its slot.
+ *
+ * Attached UE are found by open addressing phone number table, not attached UE are kept in dense array
+ * (swap-remove). Within the reserved capacity add/attach/remove/sendMessage are O(1) with no allocation.
+ *
+ * Like UeRelay - it shall be used under the global SyncGuard.
+ */
+class FlatUeRelay : public IUeRelay
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 1024u;
+
+    FlatUeRelay(common::ILogger& logger, std::size_t capacity = DEFAULT_CAPACITY);
+
+    UeSlot add(UePtr) override;
+
+    std::size_t count() const override;
+    std::size_t countAttached() const override;
+    std::size_t countNotAttached() const override;
+
+    void visitAttachedUe(UeVisitor) override;
+    void visitNotAttachedUe(UeVisitor) override;
+    /**
+     * Newly added UE is visited next, removing UE does not disturb the round
+     */
+    std::size_t visitNextNotAttachedUe(UeVisitor, std::size_t maxCount) override;
+
+    bool sendMessage(Frame message, PhoneNumber to) override;
+    std::size_t broadcast(Frame message, BroadcastScope scope) override;
+
+private:
+    class SlotImpl;
+    using Handle = UeSlot::Handle;
+    using SlotIndex = std::uint32_t;
+    static constexpr SlotIndex NO_SLOT = std::numeric_limits<SlotIndex>::max();
+
+    struct Slot
+    {
+        UePtr ue;
+        PhoneNumber phone{};
+        std::uint32_t generation = 0u;
+        // position in notAttachedUe when not attached, next free slot when free
+        SlotIndex position = NO_SLOT;
+    };
+
+    struct PhoneEntry
+    {
+        PhoneNumber phone{};
+        SlotIndex slot = NO_SLOT;
+    };
+
+    Slot* findSlot(Handle handle);
+    const Slot* findSlot(Handle handle) const;
+    UeSlot::IImplPtr attach(Handle handle, PhoneNumber phone);
+    void remove(Handle handle);
+
+    SlotIndex allocateSlot(UePtr ue);
+    UePtr freeSlot(SlotIndex index);
+
+    std::size_t homeOf(PhoneNumber phone) const;
+    std::size_t findPhone(PhoneNumber phone) const;
+    bool insertPhone(PhoneNumber phone, SlotIndex index);
+    void erasePhone(PhoneNumber phone);
+    void rehashPhones(std::size_t size);
+
+    void insertNotAttached(SlotIndex index);
+    void eraseNotAttached(SlotIndex index);
+    void moveNotAttached(std::size_t from, std::size_t to);
+
+    std::vector<Slot> slots;
+    SlotIndex firstFreeSlot = NO_SLOT;
+    // power of 2 size, at most half full
+    std::vector<PhoneEntry> phoneTable;
+    unsigned phoneTableShift;
+    std::size_t numberOfAttached = 0u;
+    // [0, nextNotAttached) - already visited in the current round
+    std::vector<SlotIndex> notAttachedUe;
+    std::size_t nextNotAttached = 0u;
+    std::shared_ptr<SlotImpl> slotImpl;
+    common::PrefixedLogger logger;
+};
+
+}
@@ -1 +1,30 @@
 #include "IUeRelay.hpp"
+
+namespace bts
+{
+
+std::size_t IUeRelay::broadcast(Frame message, BroadcastScope scope)
+{
+    std::size_t count = 0u;
+    auto send = [&message, &count](IUeConnection& ue)
+    {
+        ue.sendMessage(message);
+        ++count;
+    };
+    if (scope != BroadcastScope::NotAttached)
+    {
+        visitAttachedUe(send);
+    }
+    if (scope != BroadcastScope::Attached)
+    {
+        visitNotAttachedUe(send);
+    }
+    return count;
+}
+
+std::optional<CellLoad> IUeRelay::getLoad()
+{
+    return std::nullopt;
+}
+
+}
@@ -3,15 +3,19 @@
 #include <memory>
 #include <cstdint>
 #include <functional>
+#include <optional>
 #include "UeConnection/IUeConnection.hpp"
 #include "UeConnection/UeSlot.hpp"
 #include "Messages.hpp"
+#include "Messages/CellLoad.hpp"
 
 namespace bts
 {
 
 using common::BinaryMessage;
+using common::Frame;
 using common::PhoneNumber;
+using common::CellLoad;
 
 class IUeConnection;
 class IUeRelay
@@ -20,6 +24,13 @@ public:
     using UePtr = IUeConnection::UePtr;
     using UeVisitor = std::function<void(IUeConnection&)>;
 
+    enum class BroadcastScope
+    {
+        All,
+        Attached,
+        NotAttached
+    };
+
     virtual ~IUeRelay() = default;
 
     virtual UeSlot add(UePtr) = 0;
@@ -30,8 +41,25 @@ public:
 
     virtual void visitAttachedUe(UeVisitor) = 0;
     virtual void visitNotAttachedUe(UeVisitor) = 0;
+    /**
+     * Visits at most maxCount not attached UE, continuing in round robin manner where the previous call finished,
+     * UE added since then are visited first. Cost is proportional to number of visited UE only.
+     * @return number of visited UE
+     */
+    virtual std::size_t visitNextNotAttachedUe(UeVisitor, std::size_t maxCount) = 0;
 
-    virtual bool sendMessage(BinaryMessage message, PhoneNumber to) = 0;
+    virtual bool sendMessage(Frame message, PhoneNumber to) = 0;
+    /**
+     * Sends the same message to every UE in scope - the frame is shared, not copied nor encoded per UE.
+     * Transports only queue it, so it is written in parallel by the threads serving them.
+     * Default: visits the UE in scope.
+     * @return number of UE the message was sent to
+     */
+    virtual std::size_t broadcast(Frame message, BroadcastScope scope);
+    /**
+     * Load announced in SIB. Default: nothing - relay without limits does not measure its load.
+     */
+    virtual std::optional<CellLoad> getLoad();
 };
 
 
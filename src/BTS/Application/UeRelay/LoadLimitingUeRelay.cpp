@@ -0,0 +1,150 @@
+#include "LoadLimitingUeRelay.hpp"
+
+namespace bts
+{
+
+class LoadLimitingUeRelay::SlotImpl : public UeSlot::IImpl
+{
+public:
+    SlotImpl(UeSlot slot, LoadLimitingUeRelay& relay);
+
+    bool sendMessage(UeSlot::Handle, Frame message, PhoneNumber to) override;
+    UeSlot::IImplPtr attach(UeSlot::Handle, PhoneNumber phone) override;
+    bool isAttached(UeSlot::Handle) const override;
+    PhoneNumber getPhoneNumber(UeSlot::Handle) const override;
+    void remove(UeSlot::Handle) override;
+
+private:
+    UeSlot slot;
+    LoadLimitingUeRelay& relay;
+};
+
+LoadLimitingUeRelay::LoadLimitingUeRelay(std::shared_ptr<IUeRelay> ueRelay, common::ILogger& logger,
+                                         std::size_t maxAttached, double maxForwardRate,
+                                         Clock::time_point start)
+    : ueRelay(ueRelay),
+      logger(logger, "[LOAD]"),
+      maxAttached(maxAttached),
+      maxForwardRate(maxForwardRate),
+      sampleTime(start)
+{}
+
+UeSlot LoadLimitingUeRelay::add(UePtr ue)
+{
+    return UeSlot(std::make_shared<SlotImpl>(ueRelay->add(std::move(ue)), *this));
+}
+
+std::size_t LoadLimitingUeRelay::count() const
+{
+    return ueRelay->count();
+}
+
+std::size_t LoadLimitingUeRelay::countAttached() const
+{
+    return ueRelay->countAttached();
+}
+
+std::size_t LoadLimitingUeRelay::countNotAttached() const
+{
+    return ueRelay->countNotAttached();
+}
+
+void LoadLimitingUeRelay::visitAttachedUe(UeVisitor ueVisitor)
+{
+    ueRelay->visitAttachedUe(std::move(ueVisitor));
+}
+
+void LoadLimitingUeRelay::visitNotAttachedUe(UeVisitor ueVisitor)
+{
+    ueRelay->visitNotAttachedUe(std::move(ueVisitor));
+}
+
+std::size_t LoadLimitingUeRelay::visitNextNotAttachedUe(UeVisitor ueVisitor, std::size_t maxCount)
+{
+    return ueRelay->visitNextNotAttachedUe(std::move(ueVisitor), maxCount);
+}
+
+bool LoadLimitingUeRelay::sendMessage(Frame message, PhoneNumber to)
+{
+    return countForwarded(ueRelay->sendMessage(std::move(message), to));
+}
+
+std::size_t LoadLimitingUeRelay::broadcast(Frame message, BroadcastScope scope)
+{
+    return ueRelay->broadcast(std::move(message), scope);
+}
+
+std::optional<CellLoad> LoadLimitingUeRelay::getLoad()
+{
+    return getLoad(Clock::now());
+}
+
+std::optional<CellLoad> LoadLimitingUeRelay::getLoad(Clock::time_point now)
+{
+    double rate = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(rateMutex);
+        if (now - sampleTime >= RATE_WINDOW)
+        {
+            auto forwardedNow = forwarded.load(std::memory_order_relaxed);
+            forwardRate = (forwardedNow - sampleForwarded) / std::chrono::duration<double>(now - sampleTime).count();
+            sampleForwarded = forwardedNow;
+            sampleTime = now;
+        }
+        rate = forwardRate;
+    }
+    return CellLoad::of(ueRelay->countAttached(), maxAttached, rate, maxForwardRate);
+}
+
+bool LoadLimitingUeRelay::countForwarded(bool forwarded)
+{
+    if (forwarded)
+    {
+        this->forwarded.fetch_add(1u, std::memory_order_relaxed);
+    }
+    return forwarded;
+}
+
+LoadLimitingUeRelay::SlotImpl::SlotImpl(UeSlot slot, LoadLimitingUeRelay& relay)
+    : slot(std::move(slot)),
+      relay(relay)
+{}
+
+bool LoadLimitingUeRelay::SlotImpl::sendMessage(UeSlot::Handle, Frame message, PhoneNumber to)
+{
+    return relay.countForwarded(slot.sendMessage(std::move(message), to));
+}
+
+UeSlot::IImplPtr LoadLimitingUeRelay::SlotImpl::attach(UeSlot::Handle, PhoneNumber phone)
+{
+    if (not slot.isAttached())
+    {
+        auto load = relay.getLoad();
+        if (load->isFull())
+        {
+            relay.logger.logError("Attach not admitted: ", phone, ", load: ", *load);
+            return shared_from_this();
+        }
+    }
+    slot.attach(phone);
+    return shared_from_this();
+}
+
+bool LoadLimitingUeRelay::SlotImpl::isAttached(UeSlot::Handle) const
+{
+    return slot.isAttached();
+}
+
+PhoneNumber LoadLimitingUeRelay::SlotImpl::getPhoneNumber(UeSlot::Handle) const
+{
+    return slot.getPhoneNumber();
+}
+
+void LoadLimitingUeRelay::SlotImpl::remove(UeSlot::Handle)
+{
+    // removed UE owns this slot
+    auto self = shared_from_this();
+    slot.remove();
+}
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include "IUeRelay.hpp"
+#include "Logger/PrefixedLogger.hpp"
+
+namespace bts
+{
+
+/**
+ * IUeRelay decorator measuring load of BTS (see CellLoad) - from the number of attached UE
+ * and the rate of forwarded messages, both relative to their limits (0 - not limited).
+ * Fully loaded BTS admits no more attaches - UE already attached can still reattach.
+ *
+ * Forwarding rate is sampled by getLoad() - over at least RATE_WINDOW since the previous sample.
+ * Shall be used as the decorated relay is (i.e. under the global SyncGuard or not).
+ */
+class LoadLimitingUeRelay : public IUeRelay
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::chrono::seconds RATE_WINDOW{1};
+
+    LoadLimitingUeRelay(std::shared_ptr<IUeRelay> ueRelay, common::ILogger& logger,
+                        std::size_t maxAttached, double maxForwardRate,
+                        Clock::time_point start = Clock::now());
+
+    UeSlot add(UePtr) override;
+
+    std::size_t count() const override;
+    std::size_t countAttached() const override;
+    std::size_t countNotAttached() const override;
+
+    void visitAttachedUe(UeVisitor) override;
+    void visitNotAttachedUe(UeVisitor) override;
+    std::size_t visitNextNotAttachedUe(UeVisitor, std::size_t maxCount) override;
+
+    bool sendMessage(Frame message, PhoneNumber to) override;
+    std::size_t broadcast(Frame message, BroadcastScope scope) override;
+
+    std::optional<CellLoad> getLoad() override;
+    std::optional<CellLoad> getLoad(Clock::time_point now);
+
+private:
+    class SlotImpl;
+
+    bool countForwarded(bool forwarded);
+
+    std::shared_ptr<IUeRelay> ueRelay;
+    common::PrefixedLogger logger;
+    const std::size_t maxAttached;
+    const double maxForwardRate;
+
+    std::atomic<std::uint64_t> forwarded{0u};
+    std::mutex rateMutex;
+    Clock::time_point sampleTime;
+    std::uint64_t sampleForwarded{0u};
+    double forwardRate{0.0};
+};
+
+}
@@ -0,0 +1,385 @@
+#include "ShardedUeRelay.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace bts
+{
+
+class ShardedUeRelay::UeSlotBase : public UeSlot::IImpl
+{
+public:
+    UeSlotBase(ShardedUeRelay& relay);
+    bool sendMessage(UeSlot::Handle, Frame message, PhoneNumber to) override;
+protected:
+    ShardedUeRelay& relay;
+    template <typename ...Arg>
+    void logError(Arg&& ...arg);
+    template <typename ...Arg>
+    void logDebug(Arg&& ...arg);
+};
+
+class ShardedUeRelay::UeSlotAdded : public UeSlotBase
+{
+public:
+    UeSlotAdded(ShardedUeRelay& relay, std::size_t shardIndex, NotAttachedUe::iterator whereAdded);
+
+    UeSlot::IImplPtr attach(UeSlot::Handle, PhoneNumber phone) override;
+    bool isAttached(UeSlot::Handle) const override;
+    PhoneNumber getPhoneNumber(UeSlot::Handle) const override;
+    void remove(UeSlot::Handle) override;
+
+private:
+    std::size_t shardIndex;
+    NotAttachedUe::iterator whereAdded;
+};
+
+class ShardedUeRelay::UeSlotAttached : public UeSlotBase
+{
+public:
+    UeSlotAttached(ShardedUeRelay& relay, PhoneNumber phone);
+
+    UeSlot::IImplPtr attach(UeSlot::Handle, PhoneNumber phone) override;
+    bool isAttached(UeSlot::Handle) const override;
+    PhoneNumber getPhoneNumber(UeSlot::Handle) const override;
+    void remove(UeSlot::Handle) override;
+
+private:
+    PhoneNumber phone;
+};
+
+class ShardedUeRelay::ShardsLock
+{
+public:
+    ShardsLock(ShardedUeRelay& relay, std::size_t firstShard, std::size_t secondShard);
+
+private:
+    std::unique_lock<std::mutex> firstLock;
+    std::unique_lock<std::mutex> secondLock;
+};
+
+
+ShardedUeRelay::ShardedUeRelay(common::ILogger &logger, std::size_t numberOfShards)
+    : shards(numberOfShards),
+      logger(logger, "[RELAY]")
+{
+    if (numberOfShards == 0u)
+    {
+        throw std::invalid_argument("Number of UE relay shards shall be positive");
+    }
+}
+
+UeSlot ShardedUeRelay::add(UePtr ue)
+{
+    auto shardIndex = nextNotAttachedShard++ % shards.size();
+    auto& shard = shards[shardIndex];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto whereAdded = shard.notAttachedUe.insert(shard.notAttachedUe.begin(), SharedUe(std::move(ue)));
+    return UeSlot(std::make_shared<UeSlotAdded>(*this, shardIndex, whereAdded));
+}
+
+bool ShardedUeRelay::sendMessage(Frame message, PhoneNumber to)
+{
+    auto ue = findAttached(to);
+    if (not ue)
+    {
+        logger.logError("Connection does not exist for: ", to);
+        return false;
+    }
+    ue->sendMessage(std::move(message));
+    return true;
+}
+
+std::size_t ShardedUeRelay::count() const
+{
+    return countAttached() + countNotAttached();
+}
+
+std::size_t ShardedUeRelay::countAttached() const
+{
+    std::size_t result = 0u;
+    for (auto& shard: shards)
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.attachedMutex);
+        result += shard.attachedUe.size();
+    }
+    return result;
+}
+
+std::size_t ShardedUeRelay::countNotAttached() const
+{
+    std::size_t result = 0u;
+    for (auto& shard: shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        result += shard.notAttachedUe.size();
+    }
+    return result;
+}
+
+void ShardedUeRelay::visitAttachedUe(IUeRelay::UeVisitor ueVisitor)
+{
+    for (auto& shard: shards)
+    {
+        std::vector<SharedUe> attachedUe;
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.attachedMutex);
+            attachedUe.reserve(shard.attachedUe.size());
+            for (auto& ue: shard.attachedUe)
+            {
+                attachedUe.push_back(ue.second);
+            }
+        }
+        // visited without lock - so the visitor is free to attach/remove UE
+        for (auto& ue: attachedUe)
+        {
+            ueVisitor(*ue);
+        }
+    }
+}
+
+void ShardedUeRelay::visitNotAttachedUe(IUeRelay::UeVisitor ueVisitor)
+{
+    for (auto& shard: shards)
+    {
+        std::vector<SharedUe> notAttachedUe;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            notAttachedUe.assign(shard.notAttachedUe.begin(), shard.notAttachedUe.end());
+        }
+        for (auto& ue: notAttachedUe)
+        {
+            ueVisitor(*ue);
+        }
+    }
+}
+
+std::size_t ShardedUeRelay::visitNextNotAttachedUe(IUeRelay::UeVisitor ueVisitor, std::size_t maxCount)
+{
+    // first pass gives every shard its fair quota, second pass fills up from shards having more UE
+    const auto firstShard = nextVisitedShard++ % shards.size();
+    const auto quota = (maxCount + shards.size() - 1u) / shards.size();
+    std::vector<SharedUe> toVisit;
+    std::vector<std::size_t> rotatedInShard(shards.size(), 0u);
+    for (auto pass: {quota, maxCount})
+    {
+        for (std::size_t i = 0u; i < shards.size() and toVisit.size() < maxCount; ++i)
+        {
+            auto shardIndex = (firstShard + i) % shards.size();
+            auto rotated = rotateNotAttached(shards[shardIndex], rotatedInShard[shardIndex],
+                                             std::min(pass, maxCount - toVisit.size()));
+            rotatedInShard[shardIndex] += rotated.size();
+            toVisit.insert(toVisit.end(), rotated.begin(), rotated.end());
+        }
+    }
+    // visited without lock - so the visitor is free to attach/remove UE
+    for (auto& ue: toVisit)
+    {
+        ueVisitor(*ue);
+    }
+    return toVisit.size();
+}
+
+std::size_t ShardedUeRelay::getNumberOfShards() const
+{
+    return shards.size();
+}
+
+std::size_t ShardedUeRelay::shardIndexOf(PhoneNumber phone) const
+{
+    return std::hash<decltype(phone.value)>{}(phone.value) % shards.size();
+}
+
+ShardedUeRelay::Shard &ShardedUeRelay::shardOf(PhoneNumber phone)
+{
+    return shards[shardIndexOf(phone)];
+}
+
+ShardedUeRelay::SharedUe ShardedUeRelay::findAttached(PhoneNumber phone) const
+{
+    auto& shard = shards[shardIndexOf(phone)];
+    std::shared_lock<std::shared_mutex> lock(shard.attachedMutex);
+    auto whereAttached = shard.attachedUe.find(phone.value);
+    return whereAttached != shard.attachedUe.end() ? whereAttached->second : nullptr;
+}
+
+bool ShardedUeRelay::insertAttached(Shard &shard, PhoneNumber phone, SharedUe ue)
+{
+    std::unique_lock<std::shared_mutex> lock(shard.attachedMutex);
+    return shard.attachedUe.try_emplace(phone.value, std::move(ue)).second;
+}
+
+ShardedUeRelay::SharedUe ShardedUeRelay::eraseAttached(Shard &shard, PhoneNumber phone)
+{
+    std::unique_lock<std::shared_mutex> lock(shard.attachedMutex);
+    auto whereAttached = shard.attachedUe.find(phone.value);
+    if (whereAttached == shard.attachedUe.end())
+    {
+        return {};
+    }
+    SharedUe ue = std::move(whereAttached->second);
+    shard.attachedUe.erase(whereAttached);
+    return ue;
+}
+
+std::vector<ShardedUeRelay::SharedUe> ShardedUeRelay::rotateNotAttached(Shard &shard, std::size_t alreadyRotated, std::size_t maxCount)
+{
+    std::vector<SharedUe> result;
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto notRotated = shard.notAttachedUe.size() - std::min(alreadyRotated, shard.notAttachedUe.size());
+    auto numberToRotate = std::min(maxCount, notRotated);
+    result.reserve(numberToRotate);
+    for (std::size_t i = 0u; i < numberToRotate; ++i)
+    {
+        auto ue = shard.notAttachedUe.begin();
+        result.push_back(*ue);
+        shard.notAttachedUe.splice(shard.notAttachedUe.end(), shard.notAttachedUe, ue);
+    }
+    return result;
+}
+
+ShardedUeRelay::ShardsLock::ShardsLock(ShardedUeRelay &relay, std::size_t firstShard, std::size_t secondShard)
+    : firstLock(relay.shards[firstShard].mutex, std::defer_lock),
+      secondLock(relay.shards[secondShard].mutex, std::defer_lock)
+{
+    if (firstShard == secondShard)
+    {
+        firstLock.lock();
+    }
+    else
+    {
+        std::lock(firstLock, secondLock);
+    }
+}
+
+ShardedUeRelay::UeSlotBase::UeSlotBase(ShardedUeRelay &relay)
+    : relay(relay)
+{}
+
+template <typename ...Arg>
+void ShardedUeRelay::UeSlotBase::logError(Arg&& ...arg)
+{
+    relay.logger.logError(std::forward<Arg>(arg)...);
+}
+
+template <typename ...Arg>
+void ShardedUeRelay::UeSlotBase::logDebug(Arg&& ...arg)
+{
+    relay.logger.logDebug(std::forward<Arg>(arg)...);
+}
+
+bool ShardedUeRelay::UeSlotBase::sendMessage(UeSlot::Handle, Frame message, PhoneNumber to)
+{
+    return relay.sendMessage(std::move(message), to);
+}
+
+ShardedUeRelay::UeSlotAdded::UeSlotAdded(ShardedUeRelay &relay, std::size_t shardIndex, NotAttachedUe::iterator whereAdded)
+    : UeSlotBase(relay),
+      shardIndex(shardIndex),
+      whereAdded(whereAdded)
+{}
+
+UeSlot::IImplPtr ShardedUeRelay::UeSlotAdded::attach(UeSlot::Handle, PhoneNumber phone)
+{
+    SharedUe ue;
+    {
+        ShardsLock lock(relay, shardIndex, relay.shardIndexOf(phone));
+        if (insertAttached(relay.shardOf(phone), phone, *whereAdded))
+        {
+            ue = std::move(*whereAdded);
+            relay.shards[shardIndex].notAttachedUe.erase(whereAdded);
+        }
+    }
+
+    if (ue)
+    {
+        logDebug("Attached: ", *ue);
+        return std::make_shared<UeSlotAttached>(relay, phone);
+    }
+
+    logError("While attaching: other connection exists for: ", phone);
+    return shared_from_this();
+}
+
+bool ShardedUeRelay::UeSlotAdded::isAttached(UeSlot::Handle) const
+{
+    return false;
+}
+
+PhoneNumber ShardedUeRelay::UeSlotAdded::getPhoneNumber(UeSlot::Handle) const
+{
+    return {};
+}
+
+void ShardedUeRelay::UeSlotAdded::remove(UeSlot::Handle)
+{
+    SharedUe ue;
+    {
+        std::lock_guard<std::mutex> lock(relay.shards[shardIndex].mutex);
+        ue = std::move(*whereAdded);
+        relay.shards[shardIndex].notAttachedUe.erase(whereAdded);
+    }
+    logDebug("Removed not attached: ", *ue);
+}
+
+ShardedUeRelay::UeSlotAttached::UeSlotAttached(ShardedUeRelay &relay, PhoneNumber phone)
+    : UeSlotBase(relay),
+      phone(phone)
+{}
+
+UeSlot::IImplPtr ShardedUeRelay::UeSlotAttached::attach(UeSlot::Handle, PhoneNumber phone)
+{
+    if (phone == this->phone)
+    {
+        logDebug("Reattached to same phone number ignored: ", phone);
+        return shared_from_this();
+    }
+
+    auto oldShardIndex = relay.shardIndexOf(this->phone);
+    SharedUe ue;
+    UeSlot::IImplPtr notAttachedSlot;
+    {
+        ShardsLock lock(relay, oldShardIndex, relay.shardIndexOf(phone));
+        ue = eraseAttached(relay.shards[oldShardIndex], this->phone);
+        if (not insertAttached(relay.shardOf(phone), phone, ue))
+        {
+            auto& shard = relay.shards[oldShardIndex];
+            auto whereAdded = shard.notAttachedUe.insert(shard.notAttachedUe.begin(), ue);
+            notAttachedSlot = std::make_shared<UeSlotAdded>(relay, oldShardIndex, whereAdded);
+        }
+    }
+
+    if (notAttachedSlot)
+    {
+        logError("While re-attaching: other connection exists for: ", phone);
+        return notAttachedSlot;
+    }
+
+    logDebug("Attached: ", *ue);
+    return std::make_shared<UeSlotAttached>(relay, phone);
+}
+
+bool ShardedUeRelay::UeSlotAttached::isAttached(UeSlot::Handle) const
+{
+    return true;
+}
+
+PhoneNumber ShardedUeRelay::UeSlotAttached::getPhoneNumber(UeSlot::Handle) const
+{
+    return phone;
+}
+
+void ShardedUeRelay::UeSlotAttached::remove(UeSlot::Handle)
+{
+    SharedUe ue;
+    {
+        std::lock_guard<std::mutex> lock(relay.shardOf(phone).mutex);
+        ue = eraseAttached(relay.shardOf(phone), phone);
+    }
+    if (ue)
+    {
+        logDebug("Removed attached: ", *ue);
+    }
+}
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+#include "IUeRelay.hpp"
+#include "Logger/PrefixedLogger.hpp"
+
+namespace bts
+{
+
+/**
+ * IUeRelay partitioned into shards - every shard with its own lock.
+ * Attached UE are assigned to shard by phone number, not attached - in round robin manner.
+ *
+ * Attached UE of each shard are guarded by a reader-writer lock - sendMessage() only shares it
+ * with other senders while looking up the recipient, attach/remove take it exclusively for one insert/erase.
+ * The recipient is called without any lock held.
+ *
+ * This class is thread safe on its own - it does not need the global SyncGuard.
+ */
+class ShardedUeRelay : public IUeRelay
+{
+public:
+    static constexpr std::size_t DEFAULT_NUMBER_OF_SHARDS = 16u;
+
+    ShardedUeRelay(common::ILogger& logger, std::size_t numberOfShards = DEFAULT_NUMBER_OF_SHARDS);
+
+    UeSlot add(UePtr) override;
+
+    std::size_t count() const override;
+    std::size_t countAttached() const override;
+    std::size_t countNotAttached() const override;
+
+    void visitAttachedUe(UeVisitor) override;
+    void visitNotAttachedUe(UeVisitor) override;
+    std::size_t visitNextNotAttachedUe(UeVisitor, std::size_t maxCount) override;
+
+    bool sendMessage(Frame message, PhoneNumber to) override;
+
+    std::size_t getNumberOfShards() const;
+
+private:
+    class UeSlotBase;
+    class UeSlotAdded;
+    class UeSlotAttached;
+    class ShardsLock;
+
+    using SharedUe = std::shared_ptr<IUeConnection>;
+    using AttachedUe = std::unordered_map<PhoneNumber::Value, SharedUe>;
+    using NotAttachedUe = std::list<SharedUe>;
+
+    // own cache line - so senders to UE of different shards do not share it
+    struct alignas(64) Shard
+    {
+        mutable std::mutex mutex;
+        // locked after mutex when both are needed
+        mutable std::shared_mutex attachedMutex;
+        AttachedUe attachedUe;
+        NotAttachedUe notAttachedUe;
+    };
+
+    std::size_t shardIndexOf(PhoneNumber phone) const;
+    Shard& shardOf(PhoneNumber phone);
+    SharedUe findAttached(PhoneNumber phone) const;
+
+    // shall be called with shard mutex locked
+    static bool insertAttached(Shard& shard, PhoneNumber phone, SharedUe ue);
+    static SharedUe eraseAttached(Shard& shard, PhoneNumber phone);
+    // moves at most maxCount UE (not rotated yet in this visit) from the front to the back of not attached list
+    static std::vector<SharedUe> rotateNotAttached(Shard& shard, std::size_t alreadyRotated, std::size_t maxCount);
+
+    std::vector<Shard> shards;
+    std::atomic<std::size_t> nextNotAttachedShard{0u};
+    std::atomic<std::size_t> nextVisitedShard{0u};
+    common::PrefixedLogger logger;
+};
+
+}
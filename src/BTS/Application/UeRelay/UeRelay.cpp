@@ -1,4 +1,5 @@
 #include "UeRelay.hpp"
+#include <algorithm>
 
 namespace bts
 {
@@ -7,7 +8,7 @@ class UeRelay::UeSlotBase : public UeSlot::IImpl
 {
 public:
     UeSlotBase(UeRelay& relay);
-    bool sendMessage(BinaryMessage message, PhoneNumber to) override;
+    bool sendMessage(UeSlot::Handle, Frame message, PhoneNumber to) override;
 protected:
     UeRelay& relay;
     template <typename ...Arg>
@@ -21,10 +22,10 @@ class UeRelay::UeSlotAdded : public UeSlotBase
 public:
     UeSlotAdded(UeRelay& relay, UePtr ue);
 
-    UeSlot::IImplPtr attach(PhoneNumber phone) override;
-    bool isAttached() const;
-    PhoneNumber getPhoneNumber() const;
-    void remove() override;
+    UeSlot::IImplPtr attach(UeSlot::Handle, PhoneNumber phone) override;
+    bool isAttached(UeSlot::Handle) const override;
+    PhoneNumber getPhoneNumber(UeSlot::Handle) const override;
+    void remove(UeSlot::Handle) override;
 
 private:
     NotAttachedUe::iterator whereAdded;
@@ -35,10 +36,10 @@ class UeRelay::UeSlotAttached : public UeSlotBase
 public:
     UeSlotAttached(UeRelay& relay, AttachedUe::iterator whereAdded);
 
-    UeSlot::IImplPtr attach(PhoneNumber phone) override;
-    bool isAttached() const;
-    PhoneNumber getPhoneNumber() const;
-    void remove() override;
+    UeSlot::IImplPtr attach(UeSlot::Handle, PhoneNumber phone) override;
+    bool isAttached(UeSlot::Handle) const override;
+    PhoneNumber getPhoneNumber(UeSlot::Handle) const override;
+    void remove(UeSlot::Handle) override;
 
 private:
     AttachedUe::iterator whereAdded;
@@ -54,7 +55,7 @@ UeSlot UeRelay::add(UePtr ue)
     return UeSlot(std::make_shared<UeSlotAdded>(*this, std::move(ue)));
 }
 
-bool UeRelay::sendMessage(BinaryMessage message, PhoneNumber to)
+bool UeRelay::sendMessage(Frame message, PhoneNumber to)
 {
     auto ueSlot = attachedUe.find(to);
     if (ueSlot == attachedUe.end())
@@ -62,7 +63,7 @@ bool UeRelay::sendMessage(BinaryMessage message, PhoneNumber to)
         logger.logError("Connection does not exist for: ", to);
         return false;
     }
-    ueSlot->second->sendMessage(message);
+    ueSlot->second->sendMessage(std::move(message));
     return true;
 }
 
@@ -97,6 +98,19 @@ void UeRelay::visitNotAttachedUe(IUeRelay::UeVisitor ueVisitor)
     }
 }
 
+std::size_t UeRelay::visitNextNotAttachedUe(IUeRelay::UeVisitor ueVisitor, std::size_t maxCount)
+{
+    // the front is next to visit - visited UE is moved to the back, new UE are inserted at the front
+    auto numberToVisit = std::min(maxCount, notAttachedUe.size());
+    for (std::size_t i = 0; i < numberToVisit and not notAttachedUe.empty(); ++i)
+    {
+        auto ue = notAttachedUe.begin();
+        notAttachedUe.splice(notAttachedUe.end(), notAttachedUe, ue);
+        ueVisitor(**ue);
+    }
+    return numberToVisit;
+}
+
 UeRelay::UeSlotBase::UeSlotBase(UeRelay &relay)
     : relay(relay)
 {}
@@ -113,7 +127,7 @@ void UeRelay::UeSlotBase::logDebug(Arg&& ...arg)
     relay.logger.logDebug(std::forward<Arg>(arg)...);
 }
 
-bool UeRelay::UeSlotBase::sendMessage(BinaryMessage message, PhoneNumber to)
+bool UeRelay::UeSlotBase::sendMessage(UeSlot::Handle, Frame message, PhoneNumber to)
 {
     return relay.sendMessage(std::move(message), to);
 }
@@ -124,7 +138,7 @@ UeRelay::UeSlotAdded::UeSlotAdded(UeRelay &relay, UePtr ue)
 {
 }
 
-UeSlot::IImplPtr UeRelay::UeSlotAdded::attach(PhoneNumber phone)
+UeSlot::IImplPtr UeRelay::UeSlotAdded::attach(UeSlot::Handle, PhoneNumber phone)
 {
     auto result = relay.attachedUe.insert(AttachedUe::value_type(phone, UePtr{}));
     if (result.second)
@@ -139,17 +153,17 @@ UeSlot::IImplPtr UeRelay::UeSlotAdded::attach(PhoneNumber phone)
     return shared_from_this();
 }
 
-bool UeRelay::UeSlotAdded::isAttached() const
+bool UeRelay::UeSlotAdded::isAttached(UeSlot::Handle) const
 {
     return false;
 }
 
-PhoneNumber UeRelay::UeSlotAdded::getPhoneNumber() const
+PhoneNumber UeRelay::UeSlotAdded::getPhoneNumber(UeSlot::Handle) const
 {
     return {};
 }
 
-void UeRelay::UeSlotAdded::remove()
+void UeRelay::UeSlotAdded::remove(UeSlot::Handle)
 {
     auto ue = std::move(*whereAdded);
     logDebug("Removed not attached: ", *ue);
@@ -162,7 +176,7 @@ UeRelay::UeSlotAttached::UeSlotAttached(UeRelay &relay, AttachedUe::iterator whe
       whereAdded(whereAdded)
 {}
 
-UeSlot::IImplPtr UeRelay::UeSlotAttached::attach(PhoneNumber phone)
+UeSlot::IImplPtr UeRelay::UeSlotAttached::attach(UeSlot::Handle, PhoneNumber phone)
 {
     if (phone == whereAdded->first)
     {
@@ -197,17 +211,17 @@ UeSlot::IImplPtr UeRelay::UeSlotAttached::attach(PhoneNumber phone)
     return std::make_shared<UeSlotAdded>(relay, std::move(ue));
 }
 
-bool UeRelay::UeSlotAttached::isAttached() const
+bool UeRelay::UeSlotAttached::isAttached(UeSlot::Handle) const
 {
     return true;
 }
 
-PhoneNumber UeRelay::UeSlotAttached::getPhoneNumber() const
+PhoneNumber UeRelay::UeSlotAttached::getPhoneNumber(UeSlot::Handle) const
 {
     return whereAdded->first;
 }
 
-void UeRelay::UeSlotAttached::remove()
+void UeRelay::UeSlotAttached::remove(UeSlot::Handle)
 {
     UePtr ue = std::move(whereAdded->second);
     logDebug("Removed attached: ", *ue);
@@ -23,8 +23,9 @@ public:
 
     virtual void visitAttachedUe(UeVisitor) override;
     virtual void visitNotAttachedUe(UeVisitor) override;
+    virtual std::size_t visitNextNotAttachedUe(UeVisitor, std::size_t maxCount) override;
 
-    bool sendMessage(BinaryMessage message, PhoneNumber to) override;
+    bool sendMessage(Frame message, PhoneNumber to) override;
 
 private:
     class UeSlotBase;
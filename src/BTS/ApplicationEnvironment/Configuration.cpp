@@ -0,0 +1,52 @@
+#include "Configuration.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace bts
+{
+
+std::unique_ptr<common::MultiLineConfig> readConfiguration(int argc, char *argv[])
+{
+    auto commandLineConfig = std::make_unique<common::MultiLineConfig>(argc - 1, argv + 1);
+
+    std::string configFile = commandLineConfig->getString("config", "config");
+
+    try
+    {
+        std::ifstream configStream;
+        configStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        configStream.open(configFile);
+
+        common::MultiLineConfig fileConfig(configStream);
+        commandLineConfig->insertFrom(fileConfig);
+    }
+    catch (...)
+    {
+        std::clog << "Note: config file: \"" << configFile << "\" is not present or reading failure.\n\t((only command line arguments are used))" << std::endl;
+    }
+    return commandLineConfig;
+}
+
+common::BtsId generateBtsId()
+{
+    std::srand(time(0));
+    return common::BtsId{static_cast<decltype(common::BtsId::value)>(rand())};
+}
+
+std::string logFilename(common::BtsId btsId, const std::string& extension)
+{
+    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    auto localNow = localtime(&now);
+    char timeBuff[20];
+    strftime(timeBuff, sizeof(timeBuff), "%Y%m%d%H%M%S", localNow);
+
+    std::ostringstream os;
+    os << "bts" << btsId << "_syslog_" << timeBuff << extension;
+    return os.str();
+}
+
+}
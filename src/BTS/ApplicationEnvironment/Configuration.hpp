@@ -0,0 +1,20 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include "Config/MultiLineConfig.hpp"
+#include "Messages/BtsId.hpp"
+
+namespace bts
+{
+
+/**
+ * Command line arguments merged with the config file (named by "config" argument, "config" by default),
+ * command line arguments take precedence
+ */
+std::unique_ptr<common::MultiLineConfig> readConfiguration(int argc, char* argv[]);
+
+common::BtsId generateBtsId();
+std::string logFilename(common::BtsId btsId, const std::string& extension = ".txt");
+
+}
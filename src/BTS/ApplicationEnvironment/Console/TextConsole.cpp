@@ -40,12 +40,15 @@ void TextConsole::addHelpCommand(std::string command, const std::string &command
     commands.push_back({command, commandText, helpCommand});
 }
 
-TextConsole::CommandLine TextConsole::getCommandLine()
+std::optional<TextConsole::CommandLine> TextConsole::getCommandLine()
 {
     do
     {
         std::string line;
-        std::getline(std::cin, line);
+        if (not std::getline(std::cin, line))
+        {
+            return std::nullopt;
+        }
         if (line.empty())
         {
             continue;
@@ -94,11 +97,16 @@ void TextConsole::run()
     printHelp(std::cout);
     while (isRunning)
     {
-        CommandLine commandLine = getCommandLine();
-        auto callback = getCallback(commandLine.command);
+        auto commandLine = getCommandLine();
+        if (not commandLine)
+        {
+            logger.logInfo("End of console input");
+            return;
+        }
+        auto callback = getCallback(commandLine->command);
         if (callback)
         {
-            callback(commandLine.args, std::cout);
+            callback(commandLine->args, std::cout);
         }
         else
         {
@@ -106,7 +114,11 @@ void TextConsole::run()
         }
         std::cout << std::endl;
     }
-    emit quit();
+}
+
+bool TextConsole::isClosed() const
+{
+    return not isRunning;
 }
 
 void TextConsole::printHelp(std::ostream &os)
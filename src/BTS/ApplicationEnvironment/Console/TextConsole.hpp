@@ -1,7 +1,8 @@
 #pragma once
 
 #include <vector>
-#include <QObject>
+#include <atomic>
+#include <optional>
 
 #include "IConsole.hpp"
 #include "Logger/ILogger.hpp"
@@ -9,19 +10,19 @@
 
 namespace bts
 {
-class TextConsole : public QObject, public IConsole
+class TextConsole : public IConsole
 {
-    Q_OBJECT;
 public:
     TextConsole(common::ILogger& logger);
     void addCommand(std::string command, const std::string &commandText, CommandCallback commandCallback) override;
     void addCloseCommand(std::string command, const std::string &commandText, CommandCallback commandCallback) override;
     void addHelpCommand(std::string command, const std::string &commandText) override;
 
+    /**
+     * Reads and executes commands till close command or end of input
+     */
     void run();
-
-signals:
-    void quit();
+    bool isClosed() const;
 
 private:
     common::PrefixedLogger logger;
@@ -41,11 +42,11 @@ private:
 
     void printHelp(std::ostream& os);
     void printCommand(const Command&);
-    static CommandLine getCommandLine();
+    static std::optional<CommandLine> getCommandLine();
     static std::string readArgs(std::istream &is);
     IConsole::CommandCallback getCallback(std::string commandText) const;
 
-    bool isRunning = true;
+    std::atomic<bool> isRunning = true;
 };
 
 }
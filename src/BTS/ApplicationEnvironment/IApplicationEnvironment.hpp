@@ -18,9 +18,15 @@ public:
 
     virtual IConsole& getConsole() = 0;
     virtual void registerUeConnectedCallback(UeConnectedCallback) = 0;
+    /**
+     * Called for links to peer BTS - both accepted and connected, the transport starts receiving after the call
+     */
+    virtual void registerPeerConnectedCallback(PeerConnectedCallback) = 0;
     virtual ILogger& getLogger() = 0;
     virtual BtsId getBtsId() const = 0;
     virtual std::string getAddress() const = 0;
+    virtual std::int32_t getProperty(std::string const& name, std::int32_t defaultValue) const = 0;
+    virtual std::string getProperty(std::string const& name, std::string const& defaultValue) const = 0;
 
     virtual void startMessageLoop() = 0;
 };
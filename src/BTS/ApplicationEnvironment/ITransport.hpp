@@ -10,7 +10,9 @@ namespace bts
 
 using common::ITransport;
 using common::BinaryMessage;
+using common::Frame;
 using ITransportPtr = std::shared_ptr<ITransport>;
 using UeConnectedCallback=std::function<void(ITransportPtr)>;
+using PeerConnectedCallback=std::function<void(ITransportPtr)>;
 
 }
@@ -0,0 +1,61 @@
+#include "AllocationCounting.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace bts
+{
+
+std::atomic<std::size_t> numberOfAllocations{0u};
+std::atomic<std::size_t> numberOfPayloadAllocations{0u};
+std::atomic<std::size_t> payloadAllocationThreshold{static_cast<std::size_t>(-1)};
+
+}
+
+namespace
+{
+
+void* countedAllocation(std::size_t size)
+{
+    bts::numberOfAllocations.fetch_add(1u, std::memory_order_relaxed);
+    if (size >= bts::payloadAllocationThreshold.load(std::memory_order_relaxed))
+    {
+        bts::numberOfPayloadAllocations.fetch_add(1u, std::memory_order_relaxed);
+    }
+    if (void* memory = std::malloc(size ? size : 1u))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+}
+
+void* operator new(std::size_t size)
+{
+    return countedAllocation(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return countedAllocation(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace bts
+{
+
+// counted for the whole benchmark executable - every benchmark reads the difference only
+extern std::atomic<std::size_t> numberOfAllocations;
+// allocations of at least payloadAllocationThreshold bytes
+extern std::atomic<std::size_t> numberOfPayloadAllocations;
+extern std::atomic<std::size_t> payloadAllocationThreshold;
+
+}
@@ -0,0 +1,162 @@
+#include "Tools/Benchmark.hpp"
+#include "Calls/CallSessions.hpp"
+#include "UeConnection/UeConnection.hpp"
+#include "UeRelay/UeRelay.hpp"
+#include "Messages/MessageSchema.hpp"
+#include "Statistics/Histogram.hpp"
+#include <array>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+namespace bts
+{
+
+namespace
+{
+
+using namespace common::benchmark;
+namespace schema = common::schema;
+using common::MessageId;
+
+constexpr std::size_t NUMBER_OF_CALLS = 100u;
+constexpr std::size_t FRAMES_PER_CALL = 20000u;
+// 20 ms of G.711 voice
+constexpr std::size_t VOICE_FRAME_SIZE = 160u;
+
+class NullLogger : public common::ILogger
+{
+public:
+    void log(Level, const std::string&) override {}
+    bool isEnabled(Level) const override { return false; }
+};
+
+// forwarding is synchronous - frame is sent to the peer UE by the thread which received it
+thread_local Clock::time_point receivedAt;
+
+/**
+ * Records latency from receiving CallTalk from its UE till it is sent to the peer UE
+ */
+class TimingTransport : public ITransport
+{
+public:
+    explicit TimingTransport(common::Histogram& latency) : latency(latency) {}
+
+    void registerMessageCallback(MessageCallback callback) override { messageCallback = callback; }
+    void registerDisconnectedCallback(DisconnectedCallback) override {}
+    bool sendMessage(Frame message) override
+    {
+        if (schema::decodeHeader(message.view()).messageId == MessageId::CallTalk)
+        {
+            latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - receivedAt).count());
+        }
+        return true;
+    }
+    bool isCongested() const override { return false; }
+    std::string addressToString() const override { return {}; }
+
+    void receive(Frame message)
+    {
+        receivedAt = Clock::now();
+        messageCallback(std::move(message));
+    }
+
+private:
+    common::Histogram& latency;
+    MessageCallback messageCallback;
+};
+
+PhoneNumber phoneOf(std::size_t ue)
+{
+    return PhoneNumber{static_cast<PhoneNumber::Value>(1000u + ue)};
+}
+
+struct Result
+{
+    double framesPerSecond;
+    common::Histogram latency;
+};
+
+/**
+ * BTS as built by ApplicationFactory with global SyncGuard - UE 2*i calls UE 2*i+1,
+ * both talk in turn, calls are split between sender threads
+ */
+void forwardVoice(bool withCallSessions, std::size_t numberOfThreads, Result& result)
+{
+    NullLogger logger;
+    common::MetricsRegistry metricsRegistry;
+    auto syncGuard = std::make_shared<SyncGuard>();
+    auto callSessions = withCallSessions ? std::make_shared<CallSessions>(logger) : nullptr;
+    UeRelay ueRelay(logger);
+    std::vector<std::shared_ptr<TimingTransport>> transports;
+    for (std::size_t ue = 0u; ue < 2u * NUMBER_OF_CALLS; ++ue)
+    {
+        transports.push_back(std::make_shared<TimingTransport>(result.latency));
+        auto connection = std::make_unique<UeConnection>(transports.back(), logger, syncGuard, metricsRegistry,
+                                                         callSessions);
+        auto& connectionRef = *connection;
+        connectionRef.start(ueRelay.add(std::move(connection)));
+        transports.back()->receive(schema::encode<MessageId::AttachRequest>(phoneOf(ue), PhoneNumber{},
+                                                                            {common::BtsId{1}}));
+    }
+    std::array<std::uint8_t, VOICE_FRAME_SIZE> voice{};
+    std::vector<Frame> frames;
+    for (std::size_t call = 0u; call < NUMBER_OF_CALLS; ++call)
+    {
+        auto caller = phoneOf(2u * call);
+        auto callee = phoneOf(2u * call + 1u);
+        transports[2u * call]->receive(schema::encode<MessageId::CallRequest>(caller, callee));
+        transports[2u * call + 1u]->receive(schema::encode<MessageId::CallAccepted>(callee, caller));
+        frames.push_back(schema::encode<MessageId::CallTalk>(caller, callee, {}, voice));
+        frames.push_back(schema::encode<MessageId::CallTalk>(callee, caller, {}, voice));
+    }
+    result.latency.reset();
+
+    std::vector<std::thread> senders;
+    Stopwatch stopwatch;
+    for (std::size_t thread = 0u; thread < numberOfThreads; ++thread)
+    {
+        senders.emplace_back([&, thread]
+        {
+            for (std::size_t i = 0u; i < FRAMES_PER_CALL; ++i)
+            {
+                for (std::size_t call = thread; call < NUMBER_OF_CALLS; call += numberOfThreads)
+                {
+                    auto ue = 2u * call + i % 2u;
+                    transports[ue]->receive(frames[ue]);
+                }
+            }
+        });
+    }
+    for (auto& sender: senders)
+    {
+        sender.join();
+    }
+    result.framesPerSecond = NUMBER_OF_CALLS * FRAMES_PER_CALL / stopwatch.elapsedSeconds();
+}
+
+}
+
+COMMON_BENCHMARK(CallTalkForwardingLatency)
+{
+    out << std::setw(10) << "path" << std::setw(10) << "threads" << std::setw(14) << "frames/sec"
+        << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" << std::setw(10) << "max ns" << '\n';
+    for (bool withCallSessions: {false, true})
+    {
+        for (std::size_t numberOfThreads: {1u, 4u})
+        {
+            Result result{};
+            forwardVoice(withCallSessions, numberOfThreads, result);
+            out << std::setw(10) << (withCallSessions ? "direct" : "generic")
+                << std::setw(10) << numberOfThreads
+                << std::setw(14) << std::fixed << std::setprecision(0) << result.framesPerSecond
+                << std::setw(10) << result.latency.getPercentile(50.0)
+                << std::setw(10) << result.latency.getPercentile(99.0)
+                << std::setw(10) << result.latency.getMax() << '\n';
+        }
+    }
+    out << "(" << NUMBER_OF_CALLS << " established calls between UE of one BTS, " << VOICE_FRAME_SIZE
+        << " bytes of voice per CallTalk, latency from UE frame received till sent to the peer UE)\n";
+}
+
+}
@@ -0,0 +1,187 @@
+#include "Tools/Benchmark.hpp"
+#include "AllocationCounting.hpp"
+#include "UeConnection/UeConnection.hpp"
+#include "UeRelay/UeRelay.hpp"
+#include "Messages/OutgoingMessage.hpp"
+#include "Messages/IncomingMessage.hpp"
+#include <atomic>
+#include <iomanip>
+#include <vector>
+
+namespace bts
+{
+
+namespace
+{
+
+using namespace common::benchmark;
+
+constexpr std::size_t NUMBER_OF_MESSAGES = 100000u;
+const PhoneNumber FROM{1};
+const PhoneNumber TO{2};
+
+class NullLogger : public common::ILogger
+{
+public:
+    void log(Level, const std::string&) override {}
+};
+
+struct Allocations
+{
+    double all;
+    double payload;
+};
+
+template <typename Forward>
+Allocations allocationsPerMessage(std::size_t payloadLength, Forward&& forward)
+{
+    payloadAllocationThreshold = payloadLength;
+    auto allBefore = numberOfAllocations.load();
+    auto payloadBefore = numberOfPayloadAllocations.load();
+    for (std::size_t i = 0u; i < NUMBER_OF_MESSAGES; ++i)
+    {
+        forward();
+    }
+    Allocations result{ double(numberOfAllocations - allBefore) / NUMBER_OF_MESSAGES,
+                        double(numberOfPayloadAllocations - payloadBefore) / NUMBER_OF_MESSAGES };
+    payloadAllocationThreshold = static_cast<std::size_t>(-1);
+    return result;
+}
+
+std::vector<std::uint8_t> buildFrame(PhoneNumber from, PhoneNumber to, std::size_t textLength)
+{
+    common::OutgoingMessage message(common::MessageId::Sms, from, to);
+    message.writeText(std::string(textLength, 'x'));
+    auto body = message.getMessage();
+    std::vector<std::uint8_t> frame{ static_cast<std::uint8_t>(body.value.size() >> 8),
+                                     static_cast<std::uint8_t>(body.value.size()) };
+    frame.insert(frame.end(), body.value.begin(), body.value.end());
+    return frame;
+}
+
+/**
+ * Forward path with the signatures it had when BinaryMessage was passed by value:
+ * received into size message and message, copied into onUeMessageCallbackBody, copied by UeRelay
+ * into recipient connection, copied (with size prefix) into QByteArray by QtTransport.
+ */
+namespace by_value
+{
+
+void transportSendMessage(BinaryMessage message)
+{
+    common::OutgoingMessage sizeEncoder;
+    sizeEncoder.writeNumber<BinaryMessage::SizeType>(message.value.size());
+    BinaryMessage size = sizeEncoder.getMessage();
+    std::vector<std::uint8_t> array;
+    array.insert(array.end(), size.value.begin(), size.value.end());
+    array.insert(array.end(), message.value.begin(), message.value.end());
+    doNotOptimize(array);
+}
+
+void ueConnectionSendMessage(BinaryMessage message)
+{
+    transportSendMessage(std::move(message));
+}
+
+bool ueRelaySendMessage(BinaryMessage message, PhoneNumber)
+{
+    ueConnectionSendMessage(message);
+    return true;
+}
+
+void onUeMessageCallbackBody(BinaryMessage message)
+{
+    common::IncomingMessage incomingMessage(message);
+    auto messageHeader = incomingMessage.readMessageHeader();
+    ueRelaySendMessage(std::move(message), messageHeader.to);
+}
+
+void onUeMessageCallback(BinaryMessage message)
+{
+    onUeMessageCallbackBody(message);
+}
+
+void receive(const std::vector<std::uint8_t>& frame)
+{
+    const std::size_t sizeSize = sizeof(BinaryMessage::SizeType);
+    BinaryMessage sizeEncoded{ BinaryMessage::Value(sizeSize) };
+    std::copy(frame.begin(), frame.begin() + sizeSize, sizeEncoded.value.begin());
+    common::IncomingMessage sizeDecoder(sizeEncoded);
+    auto messageLength = sizeDecoder.readNumber<BinaryMessage::SizeType>();
+    BinaryMessage message{ BinaryMessage::Value(messageLength) };
+    std::copy(frame.begin() + sizeSize, frame.end(), message.value.begin());
+    onUeMessageCallback(std::move(message));
+}
+
+}
+
+/**
+ * Transport like EpollTransport: frame copied once out of receive buffer, sent straight from it
+ */
+class FrameTransport : public ITransport
+{
+public:
+    void registerMessageCallback(MessageCallback callback) override { messageCallback = callback; }
+    void registerDisconnectedCallback(DisconnectedCallback) override {}
+    bool sendMessage(Frame message) override { doNotOptimize(message); return true; }
+    bool isCongested() const override { return false; }
+    std::string addressToString() const override { return {}; }
+
+    void receive(const std::vector<std::uint8_t>& frame)
+    {
+        messageCallback(Frame::copyOf(Frame::View(frame).subspan(sizeof(BinaryMessage::SizeType))));
+    }
+
+private:
+    MessageCallback messageCallback;
+};
+
+void attach(FrameTransport& transport, PhoneNumber phone)
+{
+    common::OutgoingMessage attachRequest(common::MessageId::AttachRequest, phone, PhoneNumber{});
+    auto body = attachRequest.getMessage();
+    std::vector<std::uint8_t> frame{ 0u, static_cast<std::uint8_t>(body.value.size()) };
+    frame.insert(frame.end(), body.value.begin(), body.value.end());
+    transport.receive(frame);
+}
+
+void printRow(std::ostream& out, std::size_t payloadLength, const std::string& path, Allocations allocations)
+{
+    out << std::setw(10) << payloadLength
+        << std::setw(12) << path
+        << std::setw(14) << std::fixed << std::setprecision(2) << allocations.all
+        << std::setw(14) << allocations.payload << '\n';
+}
+
+}
+
+COMMON_BENCHMARK(AllocationsPerForwardedMessage)
+{
+    NullLogger logger;
+    auto syncGuard = std::make_shared<SyncGuard>();
+    UeRelay ueRelay(logger);
+    auto fromTransport = std::make_shared<FrameTransport>();
+    auto toTransport = std::make_shared<FrameTransport>();
+    for (auto& [transport, phone]: {std::pair{fromTransport, FROM}, std::pair{toTransport, TO}})
+    {
+        auto ue = std::make_unique<UeConnection>(transport, logger, syncGuard);
+        auto& ueRef = *ue;
+        ueRef.start(ueRelay.add(std::move(ue)));
+        attach(*transport, phone);
+    }
+
+    out << std::setw(10) << "payload"
+        << std::setw(12) << "path"
+        << std::setw(14) << "allocs/msg"
+        << std::setw(14) << "payload/msg" << '\n';
+    for (std::size_t textLength: {16u, 256u, 4000u})
+    {
+        auto frame = buildFrame(FROM, TO, textLength);
+        auto payloadLength = frame.size() - sizeof(BinaryMessage::SizeType);
+        printRow(out, payloadLength, "by value", allocationsPerMessage(payloadLength, [&] { by_value::receive(frame); }));
+        printRow(out, payloadLength, "Frame", allocationsPerMessage(payloadLength, [&] { fromTransport->receive(frame); }));
+    }
+    out << "(payload/msg - allocations of at least payload size, for short payloads log texts count as well)\n";
+}
+
+}
@@ -0,0 +1,185 @@
+#include "Tools/Benchmark.hpp"
+#include "Peering/PeerRouter.hpp"
+#include "Peering/PeeringUeRelay.hpp"
+#include "UeRelay/ShardedUeRelay.hpp"
+#include "Messages/MessageSchema.hpp"
+#include "PosixTransport/EpollServer.hpp"
+#include "PosixTransport/EpollTransport.hpp"
+#include <atomic>
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace bts
+{
+
+namespace
+{
+
+using namespace common::benchmark;
+
+constexpr std::size_t UE_PER_NODE = 100u;
+constexpr std::size_t MESSAGES_PER_NODE = 200000u;
+// sent but not received yet - so peer links stay below the send queue watermarks
+constexpr std::size_t MESSAGES_IN_FLIGHT = 4096u;
+
+class NullLogger : public common::ILogger
+{
+public:
+    void log(Level, const std::string&) override {}
+    bool isEnabled(Level) const override { return false; }
+};
+
+class CountingUeConnection : public IUeConnection
+{
+public:
+    CountingUeConnection(std::atomic<std::size_t>& received) : received(received) {}
+
+    void start(UeSlot) override {}
+    void sendMessage(Frame) override { received.fetch_add(1u, std::memory_order_relaxed); }
+    void sendSib(BtsId, std::optional<CellLoad>) override {}
+    PhoneNumber getPhoneNumber() const override { return {}; }
+    bool isAttached() const override { return true; }
+    bool isCongested() const override { return false; }
+    void print(std::ostream&) const override {}
+
+private:
+    std::atomic<std::size_t>& received;
+};
+
+PhoneNumber phoneOf(std::size_t node, std::size_t ue)
+{
+    return PhoneNumber{static_cast<PhoneNumber::Value>(1u + node * UE_PER_NODE + ue)};
+}
+
+/**
+ * BTS as built by ApplicationFactory with peering (sharded relay) - with own loop, without UE connections
+ */
+struct Node
+{
+    Node(std::size_t index, std::atomic<std::size_t>& received)
+        : localRelay(std::make_shared<ShardedUeRelay>(logger)),
+          router(std::make_shared<PeerRouter>(BtsId{static_cast<std::uint32_t>(index)}, logger,
+                                              [localRelay = localRelay](Frame message, PhoneNumber to)
+                                              {
+                                                  return localRelay->sendMessage(std::move(message), to);
+                                              })),
+          relay(localRelay, router),
+          server(std::make_shared<common::EpollServer>(loops, logger))
+    {
+        for (std::size_t ue = 0u; ue < UE_PER_NODE; ++ue)
+        {
+            slots.push_back(relay.add(std::make_unique<CountingUeConnection>(received)));
+            slots.back().attach(phoneOf(index, ue));
+        }
+        server->registerConnectionCallback([router = router](ITransportPtr link) { router->addLink(link); });
+        server->listen(0u);
+    }
+
+    ~Node()
+    {
+        server->registerConnectionCallback(nullptr);
+    }
+
+    void connectTo(Node& other)
+    {
+        auto link = common::EpollTransport::connect(loops.next(), "127.0.0.1", other.server->getPort(), logger);
+        router->addLink(link);
+        link->start();
+    }
+
+    NullLogger logger;
+    common::EpollLoopPool loops{1u};
+    std::shared_ptr<ShardedUeRelay> localRelay;
+    std::shared_ptr<PeerRouter> router;
+    PeeringUeRelay relay;
+    std::shared_ptr<common::EpollServer> server;
+    std::vector<UeSlot> slots;
+};
+
+/**
+ * Every node sends to UE of all nodes in turn - so (nodes - 1)/nodes of messages go over peer links.
+ * @return messages received by UE per second, all nodes together
+ */
+double deliveredPerSecond(std::size_t numberOfNodes)
+{
+    std::atomic<std::size_t> received{0u};
+    std::atomic<std::size_t> sent{0u};
+    std::vector<std::unique_ptr<Node>> nodes;
+    for (std::size_t index = 0u; index < numberOfNodes; ++index)
+    {
+        nodes.push_back(std::make_unique<Node>(index, received));
+    }
+    // full mesh
+    for (std::size_t first = 0u; first < numberOfNodes; ++first)
+    {
+        for (std::size_t second = first + 1u; second < numberOfNodes; ++second)
+        {
+            nodes[first]->connectTo(*nodes[second]);
+        }
+    }
+    for (auto& node: nodes)
+    {
+        while (node->router->countRoutes() < (numberOfNodes - 1u) * UE_PER_NODE)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    std::vector<std::thread> senders;
+    Stopwatch stopwatch;
+    for (std::size_t index = 0u; index < numberOfNodes; ++index)
+    {
+        senders.emplace_back([&, index]
+        {
+            auto& node = *nodes[index];
+            for (std::size_t i = 0u; i < MESSAGES_PER_NODE; ++i)
+            {
+                while (sent - received > MESSAGES_IN_FLIGHT)
+                {
+                    std::this_thread::yield();
+                }
+                auto from = phoneOf(index, i % UE_PER_NODE);
+                auto to = phoneOf((index + i) % numberOfNodes, (i / numberOfNodes) % UE_PER_NODE);
+                ++sent;
+                node.slots[i % UE_PER_NODE].sendMessage(common::schema::encode<common::MessageId::Sms>(from, to), to);
+            }
+        });
+    }
+    for (auto& sender: senders)
+    {
+        sender.join();
+    }
+    while (received < numberOfNodes * MESSAGES_PER_NODE)
+    {
+        std::this_thread::yield();
+    }
+    auto result = received / stopwatch.elapsedSeconds();
+
+    for (auto& node: nodes)
+    {
+        for (auto& slot: node->slots)
+        {
+            slot.remove();
+        }
+    }
+    return result;
+}
+
+}
+
+COMMON_BENCHMARK(DeliveredMessagesPerSecondVsBtsNodes)
+{
+    out << std::setw(10) << "nodes" << std::setw(16) << "msgs/sec" << std::setw(16) << "via peers" << '\n';
+    for (std::size_t numberOfNodes: {1u, 4u})
+    {
+        out << std::setw(10) << numberOfNodes
+            << std::setw(16) << std::fixed << std::setprecision(0) << deliveredPerSecond(numberOfNodes)
+            << std::setw(15) << (numberOfNodes - 1u) * 100u / numberOfNodes << "%\n";
+    }
+    out << "(" << UE_PER_NODE << " UE per node, every node has own loop thread and one sender thread,"
+        << " peer links over localhost TCP)\n";
+}
+
+}
@@ -0,0 +1,112 @@
+#include "Tools/Benchmark.hpp"
+#include "SmsStore/SmsStore.hpp"
+#include "Messages/MessageSchema.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+namespace bts
+{
+
+namespace
+{
+
+using namespace common::benchmark;
+
+constexpr std::size_t NUMBER_OF_SUBSCRIBERS = 10000u;
+constexpr std::size_t SMS_PER_SUBSCRIBER = 100u;
+constexpr std::size_t NUMBER_OF_SMS = NUMBER_OF_SUBSCRIBERS * SMS_PER_SUBSCRIBER;
+const PhoneNumber SENDER{1};
+
+class NullLogger : public common::ILogger
+{
+public:
+    void log(Level, const std::string&) override {}
+    bool isEnabled(Level) const override { return false; }
+};
+
+PhoneNumber subscriberOf(std::size_t index)
+{
+    return PhoneNumber{static_cast<PhoneNumber::Value>(1000u + index)};
+}
+
+void printRow(std::ostream& out, const std::string& what, double seconds, std::size_t count)
+{
+    out << std::setw(26) << what
+        << std::setw(12) << std::fixed << std::setprecision(3) << seconds
+        << std::setw(14) << std::setprecision(0) << count / seconds << '\n';
+}
+
+}
+
+COMMON_BENCHMARK(SmsStoreRestartRecovery)
+{
+    auto path = (std::filesystem::temp_directory_path() / ("sms-store-benchmark-" + std::to_string(::getpid()))).string();
+    std::remove(path.c_str());
+    NullLogger logger;
+    SmsStore::Options options{};
+    options.quota = SMS_PER_SUBSCRIBER;
+    // compacted when measured only
+    options.compactionThreshold = static_cast<std::size_t>(-1);
+    const std::string text(40u, 'x');
+    auto store = std::make_unique<SmsStore>(path, logger, options);
+
+    out << std::setw(26) << "operation" << std::setw(12) << "seconds" << std::setw(14) << "SMS/sec" << '\n';
+    Stopwatch stopwatch;
+    for (std::size_t i = 0u; i < NUMBER_OF_SUBSCRIBERS; ++i)
+    {
+        store->addSubscriber(subscriberOf(i));
+    }
+    // in turn - as senders would do, so SMS of one subscriber are spread over the log
+    for (std::size_t sms = 0u; sms < SMS_PER_SUBSCRIBER; ++sms)
+    {
+        for (std::size_t i = 0u; i < NUMBER_OF_SUBSCRIBERS; ++i)
+        {
+            auto to = subscriberOf(i);
+            store->store(to, common::schema::encode<common::MessageId::Sms>(
+                SENDER, to, {}, Frame::View(reinterpret_cast<const std::uint8_t*>(text.data()), text.size())));
+        }
+    }
+    printRow(out, "store", stopwatch.elapsedSeconds(), NUMBER_OF_SMS);
+    auto logSize = store->getLogSize();
+
+    store.reset();
+    stopwatch.restart();
+    store = std::make_unique<SmsStore>(path, logger, options);
+    printRow(out, "recover after restart", stopwatch.elapsedSeconds(), store->countStored());
+
+    // delivery to half of subscribers - as they attach
+    stopwatch.restart();
+    std::size_t taken = 0u;
+    for (std::size_t i = 0u; i < NUMBER_OF_SUBSCRIBERS; i += 2u)
+    {
+        for (auto batch = store->peek(subscriberOf(i), 32u); not batch.empty(); batch = store->peek(subscriberOf(i), 32u))
+        {
+            store->acknowledge(subscriberOf(i), batch.back().sequence);
+            taken += batch.size();
+            doNotOptimize(batch);
+        }
+    }
+    printRow(out, "peek+ack in batches of 32", stopwatch.elapsedSeconds(), taken);
+
+    stopwatch.restart();
+    store->compact();
+    printRow(out, "compact", stopwatch.elapsedSeconds(), store->countStored());
+    auto compactedSize = store->getLogSize();
+
+    store.reset();
+    stopwatch.restart();
+    store = std::make_unique<SmsStore>(path, logger, options);
+    printRow(out, "recover compacted", stopwatch.elapsedSeconds(), store->countStored());
+
+    out << "(" << NUMBER_OF_SUBSCRIBERS << " subscribers, " << NUMBER_OF_SMS << " SMS with " << text.size()
+        << " bytes of text, log: " << logSize / (1024u * 1024u) << " MiB, compacted: "
+        << compactedSize / (1024u * 1024u) << " MiB, page cache - not synced to disk)\n";
+    store.reset();
+    std::remove(path.c_str());
+}
+
+}
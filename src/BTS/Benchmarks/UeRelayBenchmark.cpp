@@ -0,0 +1,271 @@
+#include "Tools/Benchmark.hpp"
+#include "AllocationCounting.hpp"
+#include "UeRelay/UeRelay.hpp"
+#include "UeRelay/ShardedUeRelay.hpp"
+#include "UeRelay/FlatUeRelay.hpp"
+#include "Synchronization.hpp"
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace bts
+{
+
+namespace
+{
+
+using namespace common::benchmark;
+
+constexpr std::size_t NUMBER_OF_UE = 200u;
+constexpr std::size_t MESSAGES_PER_THREAD = 200000u;
+constexpr std::size_t CHURN_CYCLES = 200000u;
+constexpr std::size_t MESSAGES_PER_CHURN_CYCLE = 4u;
+
+class NullLogger : public common::ILogger
+{
+public:
+    void log(Level, const std::string&) override {}
+    // so debug logs are not even formatted - the relay alone is measured
+    bool isEnabled(Level) const override { return false; }
+};
+
+class CountingUeConnection : public IUeConnection
+{
+public:
+    CountingUeConnection(std::atomic<std::size_t>& received) : received(received) {}
+
+    void start(UeSlot) override {}
+    void sendMessage(Frame) override { received.fetch_add(1u, std::memory_order_relaxed); }
+    void sendSib(BtsId, std::optional<CellLoad>) override {}
+    PhoneNumber getPhoneNumber() const override { return {}; }
+    bool isAttached() const override { return true; }
+    bool isCongested() const override { return false; }
+    void print(std::ostream&) const override {}
+
+private:
+    std::atomic<std::size_t>& received;
+};
+
+class SibCountingUeConnection : public CountingUeConnection
+{
+public:
+    using CountingUeConnection::CountingUeConnection;
+
+    void sendSib(BtsId, std::optional<CellLoad>) override { ++sibs; }
+    bool isAttached() const override { return false; }
+
+    std::size_t sibs = 0u;
+};
+
+/**
+ * One SIB to every not attached UE, one UE at a time - by walking the whole list to the next one
+ * (as SibMolester did) or by continuing from where the previous visit finished.
+ */
+double sibsPerSecond(std::size_t numberOfNotAttached, bool walkWholeList)
+{
+    NullLogger logger;
+    UeRelay relay(logger);
+    std::atomic<std::size_t> received{0u};
+    for (std::size_t i = 0u; i < numberOfNotAttached; ++i)
+    {
+        relay.add(std::make_unique<SibCountingUeConnection>(received));
+    }
+
+    std::size_t sent = 0u;
+    Stopwatch stopwatch;
+    for (std::size_t sibIndex = 0u; sibIndex < numberOfNotAttached; ++sibIndex)
+    {
+        if (walkWholeList)
+        {
+            relay.visitNotAttachedUe([&, i = std::size_t{0u}](IUeConnection& ue) mutable
+            {
+                if (i++ == sibIndex)
+                {
+                    ue.sendSib(BtsId{1}, std::nullopt);
+                    ++sent;
+                }
+            });
+        }
+        else
+        {
+            relay.visitNextNotAttachedUe([&](IUeConnection& ue) { ue.sendSib(BtsId{1}, std::nullopt); ++sent; }, 1u);
+        }
+    }
+    return sent / stopwatch.elapsedSeconds();
+}
+
+/**
+ * Every thread forwards messages to its own subset of UEs, like UeConnection::onUeMessageCallback does:
+ * with the global SyncGuard locked (when given) - otherwise relying on the relay thread safety.
+ */
+double forwardedPerSecond(IUeRelay& relay, SyncGuardPtr syncGuard, std::size_t numberOfThreads)
+{
+    std::atomic<std::size_t> received{0u};
+    std::vector<UeSlot> slots;
+    for (std::size_t i = 1u; i <= NUMBER_OF_UE; ++i)
+    {
+        slots.push_back(relay.add(std::make_unique<CountingUeConnection>(received)));
+        slots.back().attach(PhoneNumber{static_cast<PhoneNumber::Value>(i)});
+    }
+
+    const Frame message{BinaryMessage{{0x05, 0x01, 0x02, 0x00, 'H', 'e', 'l', 'l', 'o'}}};
+    std::vector<std::thread> senders;
+    Stopwatch stopwatch;
+    for (std::size_t thread = 0u; thread < numberOfThreads; ++thread)
+    {
+        senders.emplace_back([&, thread]
+        {
+            for (std::size_t i = 0u; i < MESSAGES_PER_THREAD; ++i)
+            {
+                PhoneNumber to{static_cast<PhoneNumber::Value>(1u + (thread + i * numberOfThreads) % NUMBER_OF_UE)};
+                if (syncGuard)
+                {
+                    SyncLock lock(*syncGuard);
+                    slots[thread].sendMessage(message, to);
+                }
+                else
+                {
+                    slots[thread].sendMessage(message, to);
+                }
+            }
+        });
+    }
+    for (auto& sender: senders)
+    {
+        sender.join();
+    }
+    auto result = received / stopwatch.elapsedSeconds();
+
+    for (auto& slot: slots)
+    {
+        slot.remove();
+    }
+    return result;
+}
+
+struct ChurnResult
+{
+    double cyclesPerSecond;
+    double allocationsPerCycle;
+};
+
+/**
+ * Every cycle one attached UE disconnects, a new one connects and attaches to a new phone number,
+ * then some messages are forwarded to the attached UE. Connections are created before measuring.
+ */
+ChurnResult churn(IUeRelay& relay, std::size_t numberOfAttached)
+{
+    std::atomic<std::size_t> received{0u};
+    std::vector<IUeRelay::UePtr> connections;
+    connections.reserve(numberOfAttached + CHURN_CYCLES);
+    for (std::size_t i = 0u; i < numberOfAttached + CHURN_CYCLES; ++i)
+    {
+        connections.push_back(std::make_unique<CountingUeConnection>(received));
+    }
+    std::vector<UeSlot> slots;
+    std::vector<PhoneNumber> phones;
+    for (std::size_t i = 0u; i < numberOfAttached; ++i)
+    {
+        phones.push_back(PhoneNumber{static_cast<PhoneNumber::Value>(i + 1u)});
+        slots.push_back(relay.add(std::move(connections[i])));
+        slots.back().attach(phones.back());
+    }
+
+    const Frame message{BinaryMessage{{0x05, 0x01, 0x02, 0x00, 'H', 'e', 'l', 'l', 'o'}}};
+    auto allocationsBefore = numberOfAllocations.load();
+    Stopwatch stopwatch;
+    for (std::size_t cycle = 0u; cycle < CHURN_CYCLES; ++cycle)
+    {
+        auto churned = (cycle * 7919u) % numberOfAttached;
+        slots[churned].remove();
+        phones[churned] = PhoneNumber{static_cast<PhoneNumber::Value>(numberOfAttached + cycle + 1u)};
+        slots[churned] = relay.add(std::move(connections[numberOfAttached + cycle]));
+        slots[churned].attach(phones[churned]);
+        for (std::size_t i = 1u; i <= MESSAGES_PER_CHURN_CYCLE; ++i)
+        {
+            slots[churned].sendMessage(message, phones[(churned + i * 104729u) % numberOfAttached]);
+        }
+    }
+    ChurnResult result{CHURN_CYCLES / stopwatch.elapsedSeconds(),
+                       double(numberOfAllocations - allocationsBefore) / CHURN_CYCLES};
+
+    for (auto& slot: slots)
+    {
+        slot.remove();
+    }
+    return result;
+}
+
+void printRow(std::ostream& out, const std::string& relayName, std::size_t numberOfThreads, double rate)
+{
+    out << std::setw(24) << relayName
+        << std::setw(10) << numberOfThreads
+        << std::setw(16) << std::fixed << std::setprecision(0) << rate << '\n';
+}
+
+}
+
+COMMON_BENCHMARK(ForwardedMessagesPerSecondVsShardCount)
+{
+    NullLogger logger;
+    auto hardwareThreads = std::max(2u, std::thread::hardware_concurrency());
+    out << std::setw(24) << "relay" << std::setw(10) << "threads" << std::setw(16) << "msgs/sec" << '\n';
+    for (std::size_t numberOfThreads: {std::size_t{1u}, std::size_t{hardwareThreads}})
+    {
+        UeRelay ueRelay(logger);
+        printRow(out, "UeRelay + SyncGuard", numberOfThreads,
+                 forwardedPerSecond(ueRelay, std::make_shared<SyncGuard>(), numberOfThreads));
+        FlatUeRelay flatUeRelay(logger);
+        printRow(out, "FlatUeRelay + SyncGuard", numberOfThreads,
+                 forwardedPerSecond(flatUeRelay, std::make_shared<SyncGuard>(), numberOfThreads));
+
+        for (std::size_t numberOfShards: {1u, 2u, 4u, 8u, 16u, 32u})
+        {
+            ShardedUeRelay shardedUeRelay(logger, numberOfShards);
+            std::ostringstream relayName;
+            relayName << "ShardedUeRelay(" << numberOfShards << ")";
+            printRow(out, relayName.str(), numberOfThreads,
+                     forwardedPerSecond(shardedUeRelay, nullptr, numberOfThreads));
+        }
+    }
+}
+
+COMMON_BENCHMARK(AttachChurnVsRelay)
+{
+    NullLogger logger;
+    out << std::setw(24) << "relay" << std::setw(10) << "UE" << std::setw(16) << "cycles/sec"
+        << std::setw(16) << "allocs/cycle" << '\n';
+    for (std::size_t numberOfAttached: {1000u, 10000u, 100000u})
+    {
+        auto printChurn = [&](const std::string& relayName, IUeRelay& relay)
+        {
+            auto result = churn(relay, numberOfAttached);
+            out << std::setw(24) << relayName << std::setw(10) << numberOfAttached
+                << std::setw(16) << std::fixed << std::setprecision(0) << result.cyclesPerSecond
+                << std::setw(16) << std::setprecision(2) << result.allocationsPerCycle << '\n';
+        };
+        UeRelay ueRelay(logger);
+        printChurn("UeRelay", ueRelay);
+        ShardedUeRelay shardedUeRelay(logger);
+        printChurn("ShardedUeRelay", shardedUeRelay);
+        FlatUeRelay flatUeRelay(logger, numberOfAttached);
+        printChurn("FlatUeRelay", flatUeRelay);
+    }
+    out << "(cycle: remove attached UE, add and attach new one, forward "
+        << MESSAGES_PER_CHURN_CYCLE << " messages)\n";
+}
+
+COMMON_BENCHMARK(SibsPerSecondVsNotAttachedCount)
+{
+    out << std::setw(12) << "UE" << std::setw(20) << "walk list sibs/s" << std::setw(20) << "cursor sibs/s" << '\n';
+    for (std::size_t numberOfNotAttached: {100u, 1000u, 10000u})
+    {
+        out << std::setw(12) << numberOfNotAttached
+            << std::setw(20) << std::fixed << std::setprecision(0) << sibsPerSecond(numberOfNotAttached, true)
+            << std::setw(20) << sibsPerSecond(numberOfNotAttached, false) << '\n';
+    }
+}
+
+}
@@ -0,0 +1,12 @@
+#include "ApplicationEnvironmentFactory.hpp"
+#include "PosixApplicationEnvironment.hpp"
+
+namespace bts
+{
+
+std::unique_ptr<IApplicationEnvironment> createApplicationEnvironment(int &argc, char* argv[])
+{
+    return std::make_unique<PosixApplicationEnvironment>(argc, argv);
+}
+
+}
@@ -0,0 +1,317 @@
+#include "PosixApplicationEnvironment.hpp"
+#include "Configuration.hpp"
+#include "PosixTransport/EpollTransport.hpp"
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+namespace bts
+{
+
+PosixApplicationEnvironment::PosixApplicationEnvironment(int argc, char* argv[])
+    : terminationSignals(blockTerminationSignals()),
+      configuration(readConfiguration(argc, argv)),
+      btsId(BtsId{configuration->getNumber("id", generateBtsId().value)}),
+      loggerImpl(createLogger()),
+      logger(*loggerImpl),
+      console(logger),
+      port(configuration->getNumber<decltype(port)>("port", 8181)),
+      loops(configuration->getNumber<std::size_t>("io_threads", 1)),
+      server(std::make_shared<common::EpollServer>(loops, logger, createSendQueueOptions())),
+      metricsExporter(createMetricsExporter()),
+      peerPort(configuration->getNumber<decltype(peerPort)>("peer_port", 0)),
+      peerServer(std::make_shared<common::EpollServer>(loops, logger)),
+      peerAddresses(readPeerAddresses()),
+      peerReconnectPeriod(configuration->getNumber<unsigned>("peer_reconnect_ms", 1000))
+{}
+
+std::unique_ptr<ILogger> PosixApplicationEnvironment::createLogger()
+{
+    auto minimumLevel = configuration->getNumber<ILogger::Level>("log_level", ILogger::DEBUG_LEVEL);
+    if (configuration->getNumber<int>("binary_log", 0) != 0)
+    {
+        logFile.open(logFilename(btsId, ".bin"), std::ios::binary);
+        auto binaryLogger = std::make_unique<common::BinaryLogger>(logFile);
+        binaryLogger->setMinimumLevel(minimumLevel);
+        return binaryLogger;
+    }
+
+    logFile.open(logFilename(btsId));
+    common::AsyncLogger::Options options{
+        configuration->getNumber<std::size_t>("log_capacity", 8192),
+        configuration->getNumber<int>("log_drop", 0) != 0 ? common::AsyncLogger::OverflowPolicy::Drop
+                                                          : common::AsyncLogger::OverflowPolicy::Block};
+    auto asyncLogger = std::make_unique<common::AsyncLogger>(logFile, options);
+    asyncLogger->setMinimumLevel(minimumLevel);
+    return asyncLogger;
+}
+
+common::SendQueue::Options PosixApplicationEnvironment::createSendQueueOptions()
+{
+    common::SendQueue::Options defaults;
+    common::SendQueue::Options options{
+        configuration->getNumber<std::size_t>("send_queue_high", defaults.highWatermark),
+        configuration->getNumber<std::size_t>("send_queue_low", defaults.lowWatermark),
+        configuration->getNumber<std::size_t>("send_queue_limit", defaults.limit),
+        configuration->getString("send_queue_overflow", "drop_call_talk") == "disconnect"
+            ? common::SendQueue::OverflowPolicy::Disconnect
+            : common::SendQueue::OverflowPolicy::DropCallTalk};
+    if (options.lowWatermark > options.highWatermark or options.highWatermark > options.limit)
+    {
+        logger.logError("send queue watermarks shall be: low <= high <= limit - defaults used");
+        options = common::SendQueue::Options{defaults.highWatermark, defaults.lowWatermark, defaults.limit,
+                                             options.overflowPolicy};
+    }
+    return options;
+}
+
+std::unique_ptr<common::MetricsExporter> PosixApplicationEnvironment::createMetricsExporter()
+{
+    using common::MetricsExporter;
+    using common::MetricsRegistry;
+    auto file = configuration->getString("metrics_file", "");
+    auto socket = configuration->getString("metrics_socket", "");
+    if (file.empty() and socket.empty())
+    {
+        return nullptr;
+    }
+    auto format = configuration->getString("metrics_format", "prometheus") == "json" ? MetricsRegistry::Format::Json
+                                                                                   : MetricsRegistry::Format::Prometheus;
+    std::chrono::milliseconds period(configuration->getNumber<unsigned>("metrics_period_ms", 1000));
+    try
+    {
+        return std::make_unique<MetricsExporter>(MetricsRegistry::getGlobal(), format,
+                                                 socket.empty() ? MetricsExporter::Target::File : MetricsExporter::Target::UnixSocket,
+                                                 socket.empty() ? file : socket, period, logger);
+    }
+    catch (std::system_error& error)
+    {
+        logger.logError("metrics not exported: ", error.what());
+        return nullptr;
+    }
+}
+
+std::vector<PosixApplicationEnvironment::PeerAddress> PosixApplicationEnvironment::readPeerAddresses()
+{
+    std::vector<PeerAddress> addresses;
+    std::istringstream peers(configuration->getString("peers", ""));
+    std::string peer;
+    while (std::getline(peers, peer, ','))
+    {
+        auto colon = peer.rfind(':');
+        try
+        {
+            if (colon == std::string::npos)
+            {
+                throw std::invalid_argument("no port");
+            }
+            auto port = std::stoul(peer.substr(colon + 1u));
+            if (port == 0u or port > std::numeric_limits<std::uint16_t>::max())
+            {
+                throw std::out_of_range("port out of range");
+            }
+            addresses.push_back(PeerAddress{peer.substr(0u, colon), static_cast<std::uint16_t>(port)});
+        }
+        catch (std::logic_error& error)
+        {
+            logger.logError("peer ignored: ", peer, " - shall be host:port, ", error.what());
+        }
+    }
+    return addresses;
+}
+
+sigset_t PosixApplicationEnvironment::blockTerminationSignals()
+{
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    return signals;
+}
+
+IConsole &PosixApplicationEnvironment::getConsole()
+{
+    return console;
+}
+
+void PosixApplicationEnvironment::registerUeConnectedCallback(UeConnectedCallback newCallback)
+{
+    server->registerConnectionCallback(newCallback);
+}
+
+void PosixApplicationEnvironment::registerPeerConnectedCallback(PeerConnectedCallback newCallback)
+{
+    peerServer->registerConnectionCallback(newCallback);
+    std::lock_guard<std::mutex> lock(peerMutex);
+    peerConnectedCallback = newCallback;
+}
+
+ILogger &PosixApplicationEnvironment::getLogger()
+{
+    return logger;
+}
+
+BtsId PosixApplicationEnvironment::getBtsId() const
+{
+    return btsId;
+}
+
+std::string PosixApplicationEnvironment::getAddress() const
+{
+    std::string result;
+    std::string port = std::to_string(server->getPort());
+    ifaddrs* interfaces = nullptr;
+    if (getifaddrs(&interfaces) != 0)
+    {
+        return result;
+    }
+    for (auto interface = interfaces; interface != nullptr; interface = interface->ifa_next)
+    {
+        if (interface->ifa_addr == nullptr or interface->ifa_addr->sa_family != AF_INET)
+        {
+            continue;
+        }
+        auto address = reinterpret_cast<sockaddr_in*>(interface->ifa_addr)->sin_addr;
+        if (ntohl(address.s_addr) >> 24 == IN_LOOPBACKNET)
+        {
+            continue;
+        }
+        char host[INET_ADDRSTRLEN] = {};
+        inet_ntop(AF_INET, &address, host, sizeof(host));
+        result += std::string("\n") + host + ":" + port;
+    }
+    freeifaddrs(interfaces);
+    return result;
+}
+
+std::int32_t PosixApplicationEnvironment::getProperty(std::string const& name, std::int32_t defaultValue) const
+{
+    return configuration->getNumber<std::int32_t>(name, defaultValue);
+}
+
+std::string PosixApplicationEnvironment::getProperty(std::string const& name, std::string const& defaultValue) const
+{
+    return configuration->getString(name, defaultValue);
+}
+
+void PosixApplicationEnvironment::startMessageLoop()
+{
+    try
+    {
+        server->listen(port);
+    }
+    catch (std::system_error& error)
+    {
+        logger.logError("server could not start, port: ", port, ", ", error.what());
+        return;
+    }
+    startPeering();
+
+    std::thread consoleThread([this] {
+        logger.logDebug("Console loop started");
+        console.run();
+        logger.logDebug("Console loop finished");
+        if (console.isClosed())
+        {
+            // signal is blocked in all threads - so it is pending till sigwait() below
+            kill(getpid(), SIGTERM);
+        }
+        else
+        {
+            logger.logInfo("End of console input - running till SIGINT/SIGTERM");
+        }
+    });
+
+    logger.logDebug("Application loop started");
+    int signal = 0;
+    sigwait(&terminationSignals, &signal);
+    logger.logDebug("Application loop finished, signal: ", signal);
+
+    if (console.isClosed() or std::cin.eof())
+    {
+        consoleThread.join();
+    }
+    else
+    {
+        // blocked on reading stdin - nothing can interrupt it
+        consoleThread.detach();
+    }
+    stopPeering();
+}
+
+void PosixApplicationEnvironment::startPeering()
+{
+    if (peerPort != 0u)
+    {
+        try
+        {
+            peerServer->listen(peerPort);
+            logger.logInfo("Listening to peer BTS on port: ", peerPort);
+        }
+        catch (std::system_error& error)
+        {
+            logger.logError("peer links not accepted, port: ", peerPort, ", ", error.what());
+        }
+    }
+    if (not peerAddresses.empty())
+    {
+        peerConnector = std::thread([this] { connectPeers(); });
+    }
+}
+
+void PosixApplicationEnvironment::stopPeering()
+{
+    if (peerConnector.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(peerMutex);
+            peeringStopped = true;
+        }
+        peerReconnect.notify_all();
+        peerConnector.join();
+    }
+}
+
+void PosixApplicationEnvironment::connectPeers()
+{
+    std::unique_lock<std::mutex> lock(peerMutex);
+    while (not peeringStopped)
+    {
+        auto callback = peerConnectedCallback;
+        if (callback)
+        {
+            // connecting takes time - callback might be changed meanwhile, the copy is used till next round
+            lock.unlock();
+            for (auto& peer: peerAddresses)
+            {
+                if (not peer.link.expired())
+                {
+                    continue;
+                }
+                try
+                {
+                    auto link = common::EpollTransport::connect(loops.next(), peer.host, peer.port, logger);
+                    callback(link);
+                    link->start();
+                    peer.link = link;
+                }
+                catch (std::system_error& error)
+                {
+                    logger.logDebug("peer not connected: ", peer.host, ":", peer.port, ", ", error.what());
+                }
+            }
+            lock.lock();
+        }
+        peerReconnect.wait_for(lock, peerReconnectPeriod, [this] { return peeringStopped; });
+    }
+}
+
+}
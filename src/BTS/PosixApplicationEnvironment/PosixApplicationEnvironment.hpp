@@ -0,0 +1,91 @@
+#pragma once
+
+#include "IApplicationEnvironment.hpp"
+#include "Console/TextConsole.hpp"
+#include "Logger/AsyncLogger.hpp"
+#include "Logger/BinaryLogger.hpp"
+#include "Config/MultiLineConfig.hpp"
+#include "Metrics/MetricsExporter.hpp"
+#include "PosixTransport/EpollLoop.hpp"
+#include "PosixTransport/EpollServer.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bts
+{
+
+/**
+ * BTS environment without Qt: connections are served by EpollServer on "io_threads" loops,
+ * message loop lasts till console close command or SIGINT/SIGTERM.
+ * Log is written by own thread ("log_capacity" lines queued), lines are dropped on overflow when "log_drop" is 1.
+ * With "binary_log" = 1 log is written in binary form (see logdecode tool) instead.
+ * Metrics are exported to "metrics_file" (every "metrics_period_ms") or served on "metrics_socket" (unix),
+ * as Prometheus text or JSON ("metrics_format").
+ * Each connection queues at most "send_queue_limit" bytes, it is congested above "send_queue_high" till
+ * "send_queue_low" - then CallTalk is dropped or, with "send_queue_overflow" = disconnect, connection is closed.
+ * Links to peer BTS are accepted on "peer_port" (0 - no peering) and connected to "peers" (host:port,host:port...),
+ * these are reconnected every "peer_reconnect_ms" while lost - it is enough to configure one side of each link.
+ */
+class PosixApplicationEnvironment : public IApplicationEnvironment
+{
+public:
+    PosixApplicationEnvironment(int argc, char* argv[]);
+    IConsole& getConsole() override;
+    void registerUeConnectedCallback(UeConnectedCallback) override;
+    void registerPeerConnectedCallback(PeerConnectedCallback) override;
+    ILogger& getLogger() override;
+    BtsId getBtsId() const override;
+    std::string getAddress() const override;
+    std::int32_t getProperty(std::string const& name, std::int32_t defaultValue) const override;
+    std::string getProperty(std::string const& name, std::string const& defaultValue) const override;
+
+    void startMessageLoop() override;
+
+private:
+    struct PeerAddress
+    {
+        std::string host;
+        std::uint16_t port;
+        std::weak_ptr<ITransport> link{};
+    };
+
+    static sigset_t blockTerminationSignals();
+    std::unique_ptr<common::ILogger> createLogger();
+    common::SendQueue::Options createSendQueueOptions();
+    std::unique_ptr<common::MetricsExporter> createMetricsExporter();
+    std::vector<PeerAddress> readPeerAddresses();
+    void startPeering();
+    void stopPeering();
+    void connectPeers();
+
+    // blocked before any thread is started - so all threads inherit it
+    sigset_t terminationSignals;
+    std::unique_ptr<common::MultiLineConfig> configuration;
+    BtsId btsId;
+    std::ofstream logFile;
+    std::unique_ptr<common::ILogger> loggerImpl;
+    common::ILogger& logger;
+
+    TextConsole console;
+    std::uint16_t port;
+    common::EpollLoopPool loops;
+    std::shared_ptr<common::EpollServer> server;
+    std::unique_ptr<common::MetricsExporter> metricsExporter;
+
+    std::uint16_t peerPort;
+    std::shared_ptr<common::EpollServer> peerServer;
+    std::vector<PeerAddress> peerAddresses;
+    std::chrono::milliseconds peerReconnectPeriod;
+    std::mutex peerMutex;
+    std::condition_variable peerReconnect;
+    bool peeringStopped = false;
+    PeerConnectedCallback peerConnectedCallback;
+    std::thread peerConnector;
+};
+
+}
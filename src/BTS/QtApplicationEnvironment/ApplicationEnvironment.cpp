@@ -1,19 +1,16 @@
 #include <ApplicationEnvironment.hpp>
 #include <string>
 #include <iostream>
-#include <chrono>
-#include <ctime>
-#include <cstdlib>
-#include <iomanip>
 #include <fstream>
 #include <thread>
+#include "Configuration.hpp"
 #include "Messages.hpp"
 
 namespace bts
 {
 
 ApplicationEnvironment::ApplicationEnvironment(int& argc, char* argv[])
-    : configuration(ApplicationEnvironment::readConfiguration(argc, argv)),
+    : configuration(readConfiguration(argc, argv)),
       btsId(BtsId{configuration->getNumber("id", generateBtsId().value)}),
       logFile(logFilename(btsId)),
       logger(logFile),
@@ -21,7 +18,7 @@ ApplicationEnvironment::ApplicationEnvironment(int& argc, char* argv[])
       console(logger),
       transportEnvironment(logger, *configuration)
 {
-    QObject::connect(&console, SIGNAL(quit()), &qApplication, SLOT(quit()));
+    logger.setMinimumLevel(configuration->getNumber<ILogger::Level>("log_level", ILogger::DEBUG_LEVEL));
 }
 
 IConsole &ApplicationEnvironment::getConsole()
@@ -34,6 +31,14 @@ void ApplicationEnvironment::registerUeConnectedCallback(UeConnectedCallback new
     transportEnvironment.registerUeConnectedCallback(newCallback);
 }
 
+void ApplicationEnvironment::registerPeerConnectedCallback(PeerConnectedCallback newCallback)
+{
+    if (newCallback)
+    {
+        logger.logError("Peering is supported by posix environment only - no peer links");
+    }
+}
+
 ILogger &ApplicationEnvironment::getLogger()
 {
     return logger;
@@ -49,12 +54,23 @@ std::string ApplicationEnvironment::getAddress() const
     return transportEnvironment.getAddress();
 }
 
+std::int32_t ApplicationEnvironment::getProperty(std::string const& name, std::int32_t defaultValue) const
+{
+    return configuration->getNumber<std::int32_t>(name, defaultValue);
+}
+
+std::string ApplicationEnvironment::getProperty(std::string const& name, std::string const& defaultValue) const
+{
+    return configuration->getString(name, defaultValue);
+}
+
 void ApplicationEnvironment::startMessageLoop()
 {
     std::thread consoleThread([this] {
         logger.logDebug("Console loop started");
         console.run();
         logger.logDebug("Console loop finished");
+        QMetaObject::invokeMethod(&qApplication, "quit", Qt::QueuedConnection);
     });
     logger.logDebug("Application loop started");
     transportEnvironment.exec();
@@ -63,44 +79,4 @@ void ApplicationEnvironment::startMessageLoop()
     consoleThread.join();
 }
 
-std::unique_ptr<common::MultiLineConfig> ApplicationEnvironment::readConfiguration(int argc, char *argv[])
-{
-    auto commandLineConfig = std::make_unique<common::MultiLineConfig>(argc - 1, argv + 1);
-
-    std::string configFile = commandLineConfig->getString("config", "config");
-
-    try
-    {
-        std::ifstream configStream;
-        configStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-        configStream.open(configFile);
-
-        common::MultiLineConfig fileConfig(configStream);
-        commandLineConfig->insertFrom(fileConfig);
-    }
-    catch (...)
-    {
-        std::clog << "Note: config file: \"" << configFile << "\" is not present or reading failure.\n\t((only command line arguments are used))" << std::endl;
-    }
-    return commandLineConfig;
-}
-
-BtsId ApplicationEnvironment::generateBtsId()
-{
-    std::srand(time(0));
-    return BtsId{static_cast<decltype(BtsId::value)>(rand())};
-}
-
-std::string ApplicationEnvironment::logFilename(BtsId btsId)
-{
-    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-    auto localNow = localtime(&now);
-    char timeBuff[20];
-    strftime(timeBuff, sizeof(timeBuff), "%Y%m%d%H%M%S", localNow);
-
-    std::ostringstream os;
-    os << "bts" << btsId << "_syslog_" << timeBuff << ".txt";
-    return os.str();
-}
-
 }
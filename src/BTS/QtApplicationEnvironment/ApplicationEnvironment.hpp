@@ -17,9 +17,12 @@ public:
     ApplicationEnvironment(int& argc, char* argv[]);
     IConsole& getConsole() override;
     void registerUeConnectedCallback(UeConnectedCallback) override;
+    void registerPeerConnectedCallback(PeerConnectedCallback) override;
     ILogger& getLogger() override;
     BtsId getBtsId() const override;
     std::string getAddress() const override;
+    std::int32_t getProperty(std::string const& name, std::int32_t defaultValue) const override;
+    std::string getProperty(std::string const& name, std::string const& defaultValue) const override;
 
 
     void startMessageLoop() override;
@@ -33,10 +36,6 @@ private:
     QCoreApplication qApplication;
     TextConsole console;
     QtTransportEnvironment transportEnvironment;
-
-    static std::unique_ptr<common::MultiLineConfig> readConfiguration(int argc, char* argv[]);
-    static BtsId generateBtsId();
-    static std::string logFilename(BtsId btsId);
 };
 
 }
@@ -0,0 +1,51 @@
+#include "QtIoThreadPool.hpp"
+#include <QThread>
+#include <QObject>
+#include <QMetaObject>
+
+namespace bts
+{
+
+QtIoThreadPool::QtIoThreadPool(common::ILogger &logger, std::size_t numberOfThreads)
+    : logger(logger),
+      threads(numberOfThreads)
+{
+    for (std::size_t i = 0u; i < threads.size(); ++i)
+    {
+        auto& ioThread = threads[i];
+        ioThread.thread = std::make_unique<QThread>();
+        ioThread.thread->setObjectName(QString("bts-io-%1").arg(i));
+        ioThread.context = std::make_unique<QObject>();
+        ioThread.context->moveToThread(ioThread.thread.get());
+        ioThread.thread->start();
+    }
+    logger.logInfo("IO threads started: ", threads.size());
+}
+
+QtIoThreadPool::~QtIoThreadPool()
+{
+    for (auto& ioThread: threads)
+    {
+        ioThread.thread->quit();
+    }
+    for (auto& ioThread: threads)
+    {
+        ioThread.thread->wait();
+        // thread finished - so it is safe to delete its objects here
+        ioThread.context.reset();
+    }
+    logger.logInfo("IO threads stopped: ", threads.size());
+}
+
+void QtIoThreadPool::post(Task task)
+{
+    auto& ioThread = threads[nextThread++ % threads.size()];
+    QMetaObject::invokeMethod(ioThread.context.get(), std::move(task), Qt::QueuedConnection);
+}
+
+std::size_t QtIoThreadPool::size() const
+{
+    return threads.size();
+}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Logger/ILogger.hpp"
+
+class QThread;
+class QObject;
+
+namespace bts
+{
+
+/**
+ * Pool of threads - each running its own Qt event loop.
+ * QObjects created by tasks posted to the pool live (and get their events) in the thread that created them.
+ * Ones deleted later (deleteLater) are deleted when the pool is destroyed at the latest - not the ones
+ * released after that, so they shall be released first.
+ */
+class QtIoThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    QtIoThreadPool(common::ILogger& logger, std::size_t numberOfThreads);
+    ~QtIoThreadPool();
+
+    /**
+     * Executes task in the event loop of the next thread (round robin)
+     */
+    void post(Task task);
+    std::size_t size() const;
+
+private:
+    struct IoThread
+    {
+        std::unique_ptr<QThread> thread;
+        std::unique_ptr<QObject> context;
+    };
+
+    common::ILogger& logger;
+    std::vector<IoThread> threads;
+    std::atomic<std::size_t> nextThread{0u};
+};
+
+}
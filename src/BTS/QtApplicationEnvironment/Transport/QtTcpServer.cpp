@@ -0,0 +1,15 @@
+#include "QtTcpServer.hpp"
+
+namespace bts
+{
+
+QtTcpServer::QtTcpServer(IncomingConnectionHandler incomingConnectionHandler)
+    : incomingConnectionHandler(incomingConnectionHandler)
+{}
+
+void QtTcpServer::incomingConnection(qintptr socketDescriptor)
+{
+    incomingConnectionHandler(socketDescriptor);
+}
+
+}
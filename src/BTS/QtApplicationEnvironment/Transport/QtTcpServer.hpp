@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QTcpServer>
+#include <functional>
+
+namespace bts
+{
+
+/**
+ * QTcpServer that does not create sockets by itself - it hands over the descriptors of accepted connections,
+ * so sockets can be created in the thread that is going to serve them
+ */
+class QtTcpServer : public QTcpServer
+{
+public:
+    using IncomingConnectionHandler = std::function<void(qintptr socketDescriptor)>;
+
+    QtTcpServer(IncomingConnectionHandler incomingConnectionHandler);
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override;
+
+private:
+    IncomingConnectionHandler incomingConnectionHandler;
+};
+
+}
@@ -1,25 +1,29 @@
 #include "QtTransport.hpp"
 #include <QTcpSocket>
 #include <QHostAddress>
-#include "Messages/OutgoingMessage.hpp"
-#include "Messages/IncomingMessage.hpp"
+#include "Statistics/ForwardingLatency.hpp"
+#include <array>
+#include <stdexcept>
 
 namespace bts
 {
 
-QtTransport::QtTransport(common::ILogger &logger, QAbstractSocket *socket)
+QtTransport::QtTransport(common::ILogger &logger, QAbstractSocket *socket, common::SendQueue::Options sendQueueOptions)
     : logger(logger),
-      socket(socket)
+      socket(socket),
+      sendQueue(sendQueueOptions)
 {
+    socket->setParent(this);
     QObject::connect(socket, &QAbstractSocket::readyRead, std::bind(&QtTransport::readMessageFromSocket, this));
+    QObject::connect(socket, &QAbstractSocket::bytesWritten, std::bind(&QtTransport::flushSendQueue, this));
     QObject::connect(socket, &QAbstractSocket::disconnected, std::bind(&QtTransport::handleClosingConnection, this));
-    QObject::connect(this, SIGNAL(sendMessageSignal(QByteArray)), this, SLOT(sendMessageSlot(QByteArray)));
 }
 
 QtTransport::~QtTransport()
 {
     QObject::disconnect(socket, &QAbstractSocket::readyRead, 0, 0);
     QObject::disconnect(socket, &QAbstractSocket::disconnected, 0, 0);
+    QObject::disconnect(socket, &QAbstractSocket::bytesWritten, 0, 0);
     logger.logDebug("QtTransport: bye");
 }
 
@@ -33,24 +37,81 @@ void QtTransport::registerDisconnectedCallback(ITransport::DisconnectedCallback
     this->disconnectedCallback = disconnectedCallback;
 }
 
-bool QtTransport::sendMessage(BinaryMessage message)
+bool QtTransport::sendMessage(Frame message)
 {
-    common::OutgoingMessage sizeEncoder;
-    sizeEncoder.writeNumber<BinaryMessage::SizeType>(message.value.size());
-    BinaryMessage size = sizeEncoder.getMessage();
-
-    QByteArray array{};
-    array.append(reinterpret_cast<char*>(size.value.data()), size.value.size());
-    array.append(reinterpret_cast<char*>(message.value.data()), message.value.size());
-    return emit sendMessageSignal(std::move(array));
+    bool flushNeeded = false;
+    common::SendQueue::PushResult result;
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        flushNeeded = sendQueue.empty();
+        result = sendQueue.push(std::move(message));
+        congested = sendQueue.isCongested();
+    }
+
+    switch (result)
+    {
+    case common::SendQueue::PushResult::Queued:
+        break;
+    case common::SendQueue::PushResult::Dropped:
+        metrics.sendDropped->increment();
+        return false;
+    case common::SendQueue::PushResult::Overflow:
+        metrics.sendOverflows->increment();
+        QMetaObject::invokeMethod(this, [this]
+        {
+            logger.logError("Send queue overflow, disconnecting: ", addressToString());
+            socket->abort();
+        }, Qt::QueuedConnection);
+        return false;
+    }
+
+    if (flushNeeded)
+    {
+        // frames queued by the rest of this event loop iteration are written together
+        QMetaObject::invokeMethod(this, [this] { flushSendQueue(); }, Qt::QueuedConnection);
+    }
+    using common::ForwardingLatency;
+    if (auto trace = ForwardingLatency::getTrace())
+    {
+        // till handed over to the socket thread
+        QMetaObject::invokeMethod(this, [forwarded = *trace, queuedAt = ForwardingLatency::Clock::now()]
+        {
+            auto now = ForwardingLatency::Clock::now();
+            ForwardingLatency::record(ForwardingLatency::SendQueue, forwarded.messageId, now - queuedAt);
+            ForwardingLatency::record(ForwardingLatency::Total, forwarded.messageId, now - forwarded.receivedAt);
+        }, Qt::QueuedConnection);
+    }
+    return true;
 }
 
-bool QtTransport::sendMessageSlot(QByteArray message)
+bool QtTransport::isCongested() const
 {
-    logger.logDebug("Send message to: ", addressToString());
-    socket->write(std::move(message));
-    socket->flush();
-    return true;
+    return congested;
+}
+
+void QtTransport::flushSendQueue()
+{
+    std::lock_guard<std::mutex> lock(sendMutex);
+    // socket buffer is not limited - next write waits till it is written out (bytesWritten)
+    if (sendQueue.empty() or socket->bytesToWrite() > 0)
+    {
+        return;
+    }
+    std::array<common::SendQueue::Segment, 64u> segments;
+    std::size_t written = 0u;
+    auto count = sendQueue.pending(segments);
+    for (std::size_t i = 0u; i < count; ++i)
+    {
+        auto length = socket->write(reinterpret_cast<const char*>(segments[i].data()),
+                                    static_cast<qint64>(segments[i].size()));
+        if (length <= 0)
+        {
+            break;
+        }
+        written += static_cast<std::size_t>(length);
+    }
+    sendQueue.consume(written);
+    congested = sendQueue.isCongested();
 }
 
 std::string QtTransport::addressToString() const
@@ -58,8 +119,14 @@ std::string QtTransport::addressToString() const
     return socket->peerAddress().toString().toStdString() + "-" + std::to_string(socket->peerPort());
 }
 
+void QtTransport::close()
+{
+    socket->abort();
+}
+
 void QtTransport::handleClosingConnection()
 {
+    metrics.disconnects->increment();
     if (disconnectedCallback)
     {
         logger.logDebug("Connection lost from: ", addressToString());
@@ -73,35 +140,41 @@ void QtTransport::handleClosingConnection()
 
 void QtTransport::readMessageFromSocket()
 {
-    const std::size_t sizeSize = sizeof(BinaryMessage::SizeType);
-    quint64 bytesAvailable;
-    while ((bytesAvailable = socket->bytesAvailable()) >= sizeSize)
+    try
     {
-        BinaryMessage sizeEncoded{ BinaryMessage::Value(sizeSize) };
-        socket->read(reinterpret_cast<char*>(sizeEncoded.value.data()), sizeSize);
-        common::IncomingMessage sizeDecoder(sizeEncoded);
-        BinaryMessage::SizeType messageLength = sizeDecoder.readNumber<BinaryMessage::SizeType>();
-
-        if (bytesAvailable < sizeSize + messageLength)
+        while (socket->bytesAvailable() > 0)
         {
-            logger.logError("Wrong size: ", std::size_t(messageLength),
-                            " - available bytes: ", bytesAvailable);
-            continue;
-        }
+            auto space = receiveBuffer.writableSpace();
+            auto length = socket->read(reinterpret_cast<char*>(space.data()), space.size());
+            if (length <= 0)
+            {
+                break;
+            }
+            receiveBuffer.commit(length);
 
-        BinaryMessage message{ BinaryMessage::Value(messageLength) };
-        socket->read(reinterpret_cast<char*>(message.value.data()), messageLength);
-        logger.logDebug("Message received from: ", addressToString(), " body: ", message);
+            while (auto frame = receiveBuffer.nextFrame())
+            {
+                Frame message = Frame::copyOf(*frame);
+                logger.logDebug("Message received from: ", addressToString(), " body: ", message);
 
-        if (messageCallback)
-        {
-            messageCallback(std::move(message));
-        }
-        else
-        {
-            logger.logError("Message received from: ", addressToString(), " - application not interested");
+                if (messageCallback)
+                {
+                    common::ForwardingLatency::ReceivedFrame received;
+                    messageCallback(std::move(message));
+                }
+                else
+                {
+                    logger.logError("Message received from: ", addressToString(), " - application not interested");
+                }
+            }
         }
     }
+    catch (std::length_error& error)
+    {
+        metrics.decodeErrors->increment();
+        logger.logError(error.what(), " from: ", addressToString());
+        socket->abort();
+    }
 }
 
 }
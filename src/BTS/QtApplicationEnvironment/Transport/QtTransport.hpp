@@ -1,43 +1,58 @@
 #pragma once
 
 #include <QObject>
-#include <QByteArray>
+#include <atomic>
+#include <mutex>
 #include "ITransport.hpp"
 #include "Logger/ILogger.hpp"
+#include "CommonEnvironment/FrameBuffer.hpp"
+#include "CommonEnvironment/SendQueue.hpp"
+#include "Metrics/TransportMetrics.hpp"
 
 class QAbstractSocket;
 
 namespace bts
 {
 
+/**
+ * Frames sent from any thread are queued (SendQueue, by reference) at once - so sendMessage() tells dropped ones,
+ * and written to the socket by the socket thread when it has written all before - so the queue,
+ * not the socket buffer, takes the backlog.
+ */
 class QtTransport : public QObject, public ITransport
 {
     Q_OBJECT;
 public:
-    QtTransport(common::ILogger& logger, QAbstractSocket* socket);
+    QtTransport(common::ILogger& logger, QAbstractSocket* socket, common::SendQueue::Options sendQueueOptions = {});
     ~QtTransport();
 
     void registerMessageCallback(MessageCallback messageCallback) override;
     void registerDisconnectedCallback(DisconnectedCallback disconnectedCallback) override;
-    bool sendMessage(BinaryMessage message) override;
+    bool sendMessage(Frame message) override;
+    bool isCongested() const override;
 
     std::string addressToString() const override;
+
+    /**
+     * Aborts the connection - disconnected callback is called. Shall be called in the socket thread.
+     */
+    void close();
 private:
     void readMessageFromSocket();
     void handleClosingConnection();
+    // socket thread
+    void flushSendQueue();
 
     common::ILogger& logger;
     QAbstractSocket* socket;
+    common::FrameBuffer receiveBuffer;
+    common::TransportMetrics metrics;
+    std::mutex sendMutex;
+    common::SendQueue sendQueue;
+    std::atomic<bool> congested{false};
 
     MessageCallback messageCallback;
     DisconnectedCallback disconnectedCallback;
-
-private slots:
-    bool sendMessageSlot(QByteArray message);
-
-signals:
-    bool sendMessageSignal(QByteArray message);
-
 };
 
 }
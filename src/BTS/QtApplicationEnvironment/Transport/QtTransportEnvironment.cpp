@@ -1,5 +1,7 @@
 #include "QtTransportEnvironment.hpp"
 #include "QtTransport.hpp"
+#include "QtTcpServer.hpp"
+#include "QtIoThreadPool.hpp"
 #include <QTcpSocket>
 #include <QtNetwork>
 #include <QByteArray>
@@ -7,21 +9,73 @@
 namespace bts
 {
 
+using namespace std::placeholders;
+
 QtTransportEnvironment::QtTransportEnvironment(common::ILogger& logger, common::MultiLineConfig &config)
     : logger(logger),
-      port(config.getNumber<decltype(port)>("port", 8181))
+      port(config.getNumber<decltype(port)>("port", 8181)),
+      numberOfIoThreads(config.getNumber<decltype(numberOfIoThreads)>("io_threads", 0)),
+      sendQueueOptions(readSendQueueOptions(logger, config))
 {}
 
+common::SendQueue::Options QtTransportEnvironment::readSendQueueOptions(common::ILogger& logger, common::MultiLineConfig &config)
+{
+    common::SendQueue::Options defaults;
+    common::SendQueue::Options options{
+        config.getNumber<std::size_t>("send_queue_high", defaults.highWatermark),
+        config.getNumber<std::size_t>("send_queue_low", defaults.lowWatermark),
+        config.getNumber<std::size_t>("send_queue_limit", defaults.limit),
+        config.getString("send_queue_overflow", "drop_call_talk") == "disconnect"
+            ? common::SendQueue::OverflowPolicy::Disconnect
+            : common::SendQueue::OverflowPolicy::DropCallTalk};
+    if (options.lowWatermark > options.highWatermark or options.highWatermark > options.limit)
+    {
+        logger.logError("send queue watermarks shall be: low <= high <= limit - defaults used");
+        options = common::SendQueue::Options{defaults.highWatermark, defaults.lowWatermark, defaults.limit,
+                                             options.overflowPolicy};
+    }
+    return options;
+}
+
 QtTransportEnvironment::~QtTransportEnvironment()
 {
     if (session)
         QObject::disconnect(session.get(), &QNetworkSession::opened, 0, 0);
     if (server)
         server->close();
+    closeTransports();
+    // finished threads delete what was deleted later in them
+    ioThreads.reset();
+}
+
+void QtTransportEnvironment::closeTransports()
+{
+    std::vector<std::weak_ptr<QtTransport>> toClose;
+    {
+        std::lock_guard<std::mutex> lock(transportsMutex);
+        toClose.swap(transports);
+    }
+    for (auto& weakTransport: toClose)
+    {
+        auto transport = weakTransport.lock();
+        if (not transport)
+        {
+            continue;
+        }
+        // application releases the transport when told it is disconnected - kept alive here till then
+        QMetaObject::invokeMethod(transport.get(), [raw = transport.get()] { raw->close(); },
+                                  ioThreads ? Qt::BlockingQueuedConnection : Qt::DirectConnection);
+    }
+    logger.logDebug("Connections closed: ", toClose.size());
 }
 
 void QtTransportEnvironment::exec()
 {
+    if (numberOfIoThreads > 0)
+    {
+        ioThreads = std::make_unique<QtIoThreadPool>(logger, numberOfIoThreads);
+    }
+
     QNetworkConfigurationManager manager{};
     if (manager.capabilities() & QNetworkConfigurationManager::NetworkSessionRequired)
     {
@@ -34,13 +88,12 @@ void QtTransportEnvironment::exec()
     {
         sessionOpened();
     }
-    QObject::connect(server.get(), &QTcpServer::newConnection, std::bind(&QtTransportEnvironment::handleNewConnection, this));
 }
 
 void QtTransportEnvironment::sessionOpened()
 {
     logger.logDebug("Session opened");
-    server.reset(new QTcpServer());
+    server.reset(new QtTcpServer(std::bind(&QtTransportEnvironment::handleNewConnection, this, _1)));
     server->listen(QHostAddress::Any, port)
             ? logger.logInfo("server started, port: ", port)
             : logger.logError("server could not start, port: ", port);
@@ -48,6 +101,7 @@ void QtTransportEnvironment::sessionOpened()
 
 void bts::QtTransportEnvironment::registerUeConnectedCallback(UeConnectedCallback ueConnectedCallback)
 {
+    std::lock_guard<std::mutex> lock(ueConnectedCallbackMutex);
     this->ueConnectedCallback = ueConnectedCallback;
 }
 
@@ -70,25 +124,55 @@ std::string QtTransportEnvironment::getAddress() const
     return result;
 }
 
-void QtTransportEnvironment::handleNewConnection()
+void QtTransportEnvironment::handleNewConnection(qintptr socketDescriptor)
 {
-    QAbstractSocket* socket = server->nextPendingConnection();
-    if (socket)
+    if (ioThreads)
     {
-        auto ueTransport = std::make_shared<QtTransport>(logger, socket);
-        logger.logDebug("New connection from: ", ueTransport->addressToString());
-        if (ueConnectedCallback)
-        {
-            ueConnectedCallback(ueTransport);
-        }
-        else
+        ioThreads->post([this, socketDescriptor] { createTransport(socketDescriptor); });
+    }
+    else
+    {
+        createTransport(socketDescriptor);
+    }
+}
+
+void QtTransportEnvironment::createTransport(qintptr socketDescriptor)
+{
+    // socket is created in the thread that serves it - and QtTransport takes ownership of it
+    auto socket = new QTcpSocket();
+    if (not socket->setSocketDescriptor(socketDescriptor))
+    {
+        logger.logError("No new socket for new connection: ", socket->errorString().toStdString());
+        delete socket;
+        return;
+    }
+
+    // transport can be released from any thread, but it shall be deleted in its own one
+    auto ueTransport = std::shared_ptr<QtTransport>(new QtTransport(logger, socket, sendQueueOptions),
+                                                    [](QtTransport* transport) { transport->deleteLater(); });
+    logger.logDebug("New connection from: ", ueTransport->addressToString());
+    {
+        std::lock_guard<std::mutex> lock(transportsMutex);
+        // disconnected ones dropped only when it would grow - amortized O(1)
+        if (transports.size() == transports.capacity())
         {
-            logger.logError("New connection from: ", ueTransport->addressToString(), " discarded, application not interested!");
+            std::erase_if(transports, [](auto& transport) { return transport.expired(); });
         }
+        transports.push_back(ueTransport);
+    }
+
+    UeConnectedCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(ueConnectedCallbackMutex);
+        callback = ueConnectedCallback;
+    }
+    if (callback)
+    {
+        callback(ueTransport);
     }
     else
     {
-        logger.logError("No new socked for new connection!");
+        logger.logError("New connection from: ", ueTransport->addressToString(), " discarded, application not interested!");
     }
 }
 
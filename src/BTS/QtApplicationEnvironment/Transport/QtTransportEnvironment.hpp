@@ -1,15 +1,23 @@
 #pragma once
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <QtGlobal>
 #include "ITransport.hpp"
 #include "Logger/ILogger.hpp"
 #include "Config/MultiLineConfig.hpp"
+#include "CommonEnvironment/SendQueue.hpp"
 
-class QTcpServer;
 class QNetworkSession;
 class QAbstractSocket;
 
 namespace bts
 {
 
+class QtTcpServer;
+class QtIoThreadPool;
+class QtTransport;
+
 class QtTransportEnvironment
 {
 public:
@@ -22,13 +30,23 @@ public:
 
 private:
     void sessionOpened();
-    void handleNewConnection();
+    void handleNewConnection(qintptr socketDescriptor);
+    void createTransport(qintptr socketDescriptor);
+    void closeTransports();
+    static common::SendQueue::Options readSendQueueOptions(common::ILogger& logger, common::MultiLineConfig& config);
 
     common::ILogger& logger;
     std::uint32_t port;
-    std::unique_ptr<QTcpServer> server;
+    std::size_t numberOfIoThreads;
+    common::SendQueue::Options sendQueueOptions;
+    std::unique_ptr<QtIoThreadPool> ioThreads;
+    std::unique_ptr<QtTcpServer> server;
     std::unique_ptr<QNetworkSession> session;
+    std::mutex ueConnectedCallbackMutex;
     UeConnectedCallback ueConnectedCallback;
+    // closed before IO threads are stopped - so they are deleted (deleteLater) in still running threads
+    std::mutex transportsMutex;
+    std::vector<std::weak_ptr<QtTransport>> transports;
 };
 
 }
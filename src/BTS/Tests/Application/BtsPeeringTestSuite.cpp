@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <thread>
+
+#include "Peering/PeerRouter.hpp"
+#include "Peering/PeeringUeRelay.hpp"
+#include "UeRelay/ShardedUeRelay.hpp"
+#include "Messages/MessageSchema.hpp"
+#include "PosixTransport/EpollServer.hpp"
+#include "PosixTransport/EpollTransport.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+namespace schema = common::schema;
+using common::MessageId;
+
+namespace
+{
+
+const BtsId BTS_ID{17};
+const BtsId PEER_BTS_ID{18};
+const PhoneNumber PHONE{100};
+const PhoneNumber PEER_PHONE{70000};
+
+class DisabledLogger : public common::ILogger
+{
+public:
+    void log(Level, const std::string&) override {}
+    bool isEnabled(Level) const override { return false; }
+};
+
+class CountingUeConnection : public IUeConnection
+{
+public:
+    CountingUeConnection(std::atomic<std::size_t>& received) : received(received) {}
+
+    void start(UeSlot) override {}
+    void sendMessage(Frame) override { ++received; }
+    void sendSib(BtsId, std::optional<CellLoad>) override {}
+    PhoneNumber getPhoneNumber() const override { return {}; }
+    bool isAttached() const override { return true; }
+    bool isCongested() const override { return false; }
+    void print(std::ostream&) const override {}
+
+private:
+    std::atomic<std::size_t>& received;
+};
+
+template <typename Condition>
+bool waitUntil(Condition condition)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (not condition())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * BTS without UE connections - just relay, router and one attached UE
+ */
+class PeerBts
+{
+public:
+    PeerBts(BtsId btsId, PhoneNumber phone)
+        : localRelay(std::make_shared<ShardedUeRelay>(logger)),
+          router(std::make_shared<PeerRouter>(btsId, logger, [localRelay = localRelay](Frame message, PhoneNumber to)
+          {
+              return localRelay->sendMessage(std::move(message), to);
+          })),
+          relay(localRelay, router)
+    {
+        ueSlot = relay.add(std::make_unique<CountingUeConnection>(received));
+        ueSlot.attach(phone);
+    }
+
+    DisabledLogger logger;
+    common::EpollLoopPool loops{1u};
+    std::atomic<std::size_t> received{0u};
+    std::shared_ptr<ShardedUeRelay> localRelay;
+    std::shared_ptr<PeerRouter> router;
+    PeeringUeRelay relay;
+    UeSlot ueSlot;
+};
+
+// exit code of peer BTS process
+int runPeerBts(int portPipe)
+{
+    std::uint16_t port = 0u;
+    if (read(portPipe, &port, sizeof(port)) != sizeof(port))
+    {
+        return 2;
+    }
+    PeerBts bts(PEER_BTS_ID, PEER_PHONE);
+    auto link = common::EpollTransport::connect(bts.loops.next(), "127.0.0.1", port, bts.logger);
+    bts.router->addLink(link);
+    link->start();
+
+    if (not waitUntil([&bts] { return bts.router->countRoutes() == 1u; }))
+    {
+        return 3;
+    }
+    if (not bts.relay.sendMessage(schema::encode<MessageId::Sms>(PEER_PHONE, PHONE), PHONE))
+    {
+        return 4;
+    }
+    return waitUntil([&bts] { return bts.received == 1u; }) ? 0 : 5;
+}
+
+}
+
+/**
+ * Two BTS processes on localhost - each with one UE, linked by peer link
+ */
+class BtsPeeringTestSuite : public Test
+{
+protected:
+    ~BtsPeeringTestSuite()
+    {
+        if (child > 0)
+        {
+            kill(child, SIGKILL);
+            waitpid(child, nullptr, 0);
+        }
+    }
+
+    void forkPeerBts()
+    {
+        int portPipe[2];
+        ASSERT_EQ(0, pipe(portPipe));
+        child = fork();
+        ASSERT_NE(-1, child);
+        if (child == 0)
+        {
+            close(portPipe[1]);
+            // not to outlive the test process, however it ends
+            alarm(10u);
+            _exit(runPeerBts(portPipe[0]));
+        }
+        close(portPipe[0]);
+        portPipeWriteEnd = portPipe[1];
+    }
+
+    int waitForPeerBts()
+    {
+        int status = 0;
+        waitpid(child, &status, 0);
+        child = -1;
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+
+    pid_t child = -1;
+    int portPipeWriteEnd = -1;
+};
+
+TEST_F(BtsPeeringTestSuite, shallForwardBetweenBtsProcesses)
+{
+    // forked before any thread is started here
+    forkPeerBts();
+
+    PeerBts bts(BTS_ID, PHONE);
+    auto server = std::make_shared<common::EpollServer>(bts.loops, bts.logger);
+    server->registerConnectionCallback([&bts](ITransportPtr link) { bts.router->addLink(link); });
+    server->listen(0u);
+    auto port = server->getPort();
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(port)), write(portPipeWriteEnd, &port, sizeof(port)));
+    close(portPipeWriteEnd);
+
+    ASSERT_TRUE(waitUntil([&bts] { return bts.received == 1u; }));
+    ASSERT_EQ(1u, bts.router->countPeers());
+    ASSERT_TRUE(bts.relay.sendMessage(schema::encode<MessageId::Sms>(PHONE, PEER_PHONE), PEER_PHONE));
+    ASSERT_EQ(0, waitForPeerBts());
+    server->registerConnectionCallback(nullptr);
+}
+
+}
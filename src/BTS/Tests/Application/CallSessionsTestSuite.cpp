@@ -0,0 +1,227 @@
+#include "CallSessionsTestSuite.hpp"
+#include "UeConnection/UeConnection.hpp"
+#include "UeRelay/UeRelay.hpp"
+#include <future>
+#include <thread>
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+namespace bts
+{
+
+namespace schema = common::schema;
+using common::MessageId;
+
+CallSessionsTestSuite::CallSessionsTestSuite()
+    : callerParty(std::make_shared<CallSessions::Party>(callerMock)),
+      calleeParty(std::make_shared<CallSessions::Party>(calleeMock))
+{}
+
+void CallSessionsTestSuite::establishCall()
+{
+    objectUnderTest.onCallRequest(CALLER, CALLEE, callerParty);
+    objectUnderTest.onCallAccepted(CALLEE, CALLER, calleeParty);
+}
+
+Frame CallSessionsTestSuite::callTalk(PhoneNumber from, PhoneNumber to)
+{
+    const std::uint8_t voice[] = {1, 2, 3};
+    return schema::encode<MessageId::CallTalk>(from, to, {}, voice);
+}
+
+TEST_F(CallSessionsTestSuite, shallNotLinkPartiesTillCallAccepted)
+{
+    objectUnderTest.onCallRequest(CALLER, CALLEE, callerParty);
+    ASSERT_EQ(1u, objectUnderTest.countPending());
+    ASSERT_FALSE(callerParty->talk(callTalk(CALLER, CALLEE)));
+}
+
+TEST_F(CallSessionsTestSuite, shallLinkPartiesOfEstablishedCall)
+{
+    establishCall();
+    ASSERT_EQ(1u, objectUnderTest.countEstablished());
+    ASSERT_EQ(0u, objectUnderTest.countPending());
+
+    auto toCallee = callTalk(CALLER, CALLEE);
+    EXPECT_CALL(calleeMock, sendMessage(toCallee));
+    ASSERT_TRUE(callerParty->talk(toCallee));
+
+    EXPECT_CALL(callerMock, sendMessage(_));
+    ASSERT_TRUE(calleeParty->talk(callTalk(CALLEE, CALLER)));
+}
+
+TEST_F(CallSessionsTestSuite, shallNotTalkWithHeaderOtherThanOfCall)
+{
+    establishCall();
+    ASSERT_FALSE(callerParty->talk(callTalk(CALLER, OTHER_PHONE)));
+    ASSERT_FALSE(callerParty->talk(callTalk(OTHER_PHONE, CALLEE)));
+    ASSERT_FALSE(callerParty->talk(schema::encode<MessageId::Sms>(CALLER, CALLEE)));
+}
+
+TEST_F(CallSessionsTestSuite, shallNotEstablishCallNotRequested)
+{
+    objectUnderTest.onCallRequest(CALLER, OTHER_PHONE, callerParty);
+    objectUnderTest.onCallAccepted(CALLEE, CALLER, calleeParty);
+    ASSERT_EQ(0u, objectUnderTest.countEstablished());
+    ASSERT_FALSE(calleeParty->isInCall());
+}
+
+TEST_F(CallSessionsTestSuite, shallUnlinkPartiesWhenCallDroppedByEither)
+{
+    establishCall();
+    objectUnderTest.onCallDropped(CALLEE, CALLER);
+    ASSERT_EQ(0u, objectUnderTest.countEstablished());
+    ASSERT_FALSE(callerParty->isInCall());
+    ASSERT_FALSE(calleeParty->isInCall());
+}
+
+TEST_F(CallSessionsTestSuite, shallForgetCallRejected)
+{
+    objectUnderTest.onCallRequest(CALLER, CALLEE, callerParty);
+    objectUnderTest.onCallDropped(CALLEE, CALLER);
+    ASSERT_EQ(0u, objectUnderTest.countPending());
+}
+
+TEST_F(CallSessionsTestSuite, shallReplaceCallOfCallerByNewRequest)
+{
+    establishCall();
+    objectUnderTest.onCallRequest(CALLER, OTHER_PHONE, callerParty);
+    ASSERT_EQ(0u, objectUnderTest.countEstablished());
+    ASSERT_EQ(1u, objectUnderTest.countPending());
+    ASSERT_FALSE(calleeParty->isInCall());
+}
+
+TEST_F(CallSessionsTestSuite, shallDropCallOnBehalfOfReleasedParty)
+{
+    establishCall();
+    Frame callDropped = schema::encode<MessageId::CallDropped>(CALLER, CALLEE);
+    EXPECT_CALL(calleeMock, sendMessage(callDropped));
+    callerParty->release();
+    objectUnderTest.release(callerParty);
+    ASSERT_EQ(0u, objectUnderTest.countEstablished());
+    ASSERT_FALSE(calleeParty->isInCall());
+}
+
+TEST_F(CallSessionsTestSuite, shallNotSendToReleasedUe)
+{
+    establishCall();
+    calleeParty->release();
+    ASSERT_FALSE(callerParty->talk(callTalk(CALLER, CALLEE)));
+}
+
+namespace
+{
+
+class LoopbackTransport : public ITransport
+{
+public:
+    void registerMessageCallback(MessageCallback callback) override { messageCallback = std::move(callback); }
+    void registerDisconnectedCallback(DisconnectedCallback callback) override { disconnectedCallback = std::move(callback); }
+    bool sendMessage(Frame message) override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(std::move(message));
+        return true;
+    }
+    bool isCongested() const override { return false; }
+    std::string addressToString() const override { return "ue"; }
+
+    void receive(Frame message) { messageCallback(std::move(message)); }
+    void disconnect()
+    {
+        // connection unregisters its callbacks when destroyed by this call
+        auto callback = disconnectedCallback;
+        callback();
+    }
+    std::vector<MessageId> receivedIds()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<MessageId> ids;
+        for (auto& message: received)
+        {
+            ids.push_back(schema::decodeHeader(message.view()).messageId);
+        }
+        return ids;
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<Frame> received;
+    MessageCallback messageCallback;
+    DisconnectedCallback disconnectedCallback;
+};
+
+}
+
+class UeConnectionCallTestSuite : public Test
+{
+protected:
+    UeConnectionCallTestSuite()
+    {
+        for (auto& [transport, phone]: {std::pair{callerTransport, CALLER}, std::pair{calleeTransport, CALLEE}})
+        {
+            auto ue = std::make_unique<UeConnection>(transport, loggerMock, syncGuard, metricsRegistry, callSessions);
+            auto& ueRef = *ue;
+            ueRef.start(ueRelay.add(std::move(ue)));
+            transport->receive(schema::encode<MessageId::AttachRequest>(phone, PhoneNumber{}, {common::BtsId{1}}));
+        }
+    }
+
+    void establishCall()
+    {
+        callerTransport->receive(schema::encode<MessageId::CallRequest>(CALLER, CALLEE));
+        calleeTransport->receive(schema::encode<MessageId::CallAccepted>(CALLEE, CALLER));
+    }
+
+    const PhoneNumber CALLER{100};
+    const PhoneNumber CALLEE{101};
+
+    NiceMock<common::ILoggerMock> loggerMock;
+    common::MetricsRegistry metricsRegistry;
+    SyncGuardPtr syncGuard = std::make_shared<SyncGuard>();
+    std::shared_ptr<CallSessions> callSessions = std::make_shared<CallSessions>(loggerMock);
+    UeRelay ueRelay{loggerMock};
+    std::shared_ptr<LoopbackTransport> callerTransport = std::make_shared<LoopbackTransport>();
+    std::shared_ptr<LoopbackTransport> calleeTransport = std::make_shared<LoopbackTransport>();
+};
+
+TEST_F(UeConnectionCallTestSuite, shallEstablishCallForwardedBetweenUe)
+{
+    establishCall();
+    ASSERT_EQ(1u, callSessions->countEstablished());
+    calleeTransport->receive(schema::encode<MessageId::CallDropped>(CALLEE, CALLER));
+    ASSERT_EQ(0u, callSessions->countEstablished());
+}
+
+TEST_F(UeConnectionCallTestSuite, shallForwardCallTalkWithoutSyncGuard)
+{
+    establishCall();
+
+    std::promise<void> guardTaken;
+    std::promise<void> talked;
+    bool talkedWhileGuardTaken = false;
+    std::thread guardHolder([&]
+    {
+        SyncLock lock(*syncGuard);
+        guardTaken.set_value();
+        talkedWhileGuardTaken = talked.get_future().wait_for(5s) == std::future_status::ready;
+    });
+    guardTaken.get_future().wait();
+    callerTransport->receive(schema::encode<MessageId::CallTalk>(CALLER, CALLEE));
+    talked.set_value();
+    guardHolder.join();
+
+    ASSERT_TRUE(talkedWhileGuardTaken);
+    ASSERT_THAT(calleeTransport->receivedIds(), Contains(MessageId::CallTalk));
+}
+
+TEST_F(UeConnectionCallTestSuite, shallDropCallOfDisconnectedUe)
+{
+    establishCall();
+    callerTransport->disconnect();
+    ASSERT_EQ(0u, callSessions->countEstablished());
+    ASSERT_EQ(MessageId::CallDropped, calleeTransport->receivedIds().back());
+}
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "Calls/CallSessions.hpp"
+
+#include "Mocks/ILoggerMock.hpp"
+#include "Mocks/IUeConnectionMock.hpp"
+
+namespace bts
+{
+
+class CallSessionsTestSuite : public ::testing::Test
+{
+protected:
+    CallSessionsTestSuite();
+
+    void establishCall();
+    static Frame callTalk(PhoneNumber from, PhoneNumber to);
+
+    const PhoneNumber CALLER{100};
+    const PhoneNumber CALLEE{70000};
+    const PhoneNumber OTHER_PHONE{101};
+
+    ::testing::NiceMock<common::ILoggerMock> loggerMock;
+    ::testing::StrictMock<IUeConnectionMock> callerMock;
+    ::testing::StrictMock<IUeConnectionMock> calleeMock;
+    CallSessions::PartyPtr callerParty;
+    CallSessions::PartyPtr calleeParty;
+    CallSessions objectUnderTest{loggerMock};
+};
+
+}
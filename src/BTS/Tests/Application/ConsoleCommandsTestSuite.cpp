@@ -1,5 +1,8 @@
 #include "ConsoleCommandsTestSuite.hpp"
 #include <sstream>
+#include "Statistics/ForwardingLatency.hpp"
+#include "Metrics/MetricsRegistry.hpp"
+#include "Messages/MessageSchema.hpp"
 
 using namespace ::testing;
 
@@ -29,6 +32,10 @@ void ConsoleCommandsTestSuite::expectRegisterCallbacks()
     EXPECT_CALL(consoleMock, addCloseCommand(_, _, _));
     EXPECT_CALL(consoleMock, addHelpCommand(_, _));
     expectRegisterCallback(consoleMock, "t", testCommandsCallback);
+    expectRegisterCallback(consoleMock, "f", testCommandsFromFileCallback);
+    expectRegisterCallback(consoleMock, "p", showLatencyCallback);
+    expectRegisterCallback(consoleMock, "m", showMetricsCallback);
+    expectRegisterCallback(consoleMock, "b", broadcastSmsCallback);
 }
 
 TEST_F(ConsoleCommandsTestSuite, shallRegisterCommandsOnStart)
@@ -145,4 +152,58 @@ TEST_F(ConsoleCommandsAfterStartTestSuite, shallListAttached)
     assertResultContainsAttachedPrintouts();
 }
 
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallRunTestCommandsAndPrintStatistics)
+{
+    EXPECT_CALL(*ueRelayMock, sendMessage(_, PhoneNumber{2})).Times(3).WillRepeatedly(Return(true));
+
+    onCallback(testCommandsCallback, "repeat 3 send Sms 1 2 hello");
+
+    ASSERT_THAT(result, HasSubstr("sent: 3 messages"));
+    ASSERT_THAT(result, HasSubstr("Sms: 3"));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallBroadcastSmsToAttached)
+{
+    const Frame EXPECTED_SMS = common::schema::encode<common::MessageId::Sms>(
+                PhoneNumber{}, PhoneNumber{}, {}, Frame::View(reinterpret_cast<const std::uint8_t*>("alert"), 5u));
+    EXPECT_CALL(*ueRelayMock, broadcast(EXPECTED_SMS, IUeRelay::BroadcastScope::Attached)).WillOnce(Return(COUNT_ATTACHED));
+
+    onCallback(broadcastSmsCallback, " alert");
+
+    ASSERT_THAT(result, HasSubstr(std::to_string(COUNT_ATTACHED)));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallPrintErrorOfMissingTestCommandsFile)
+{
+    onCallback(testCommandsFromFileCallback, "/not/existing/scenario");
+
+    ASSERT_THAT(result, HasSubstr("file error"));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallShowAndResetForwardingLatency)
+{
+    common::ForwardingLatency::getHistograms().record(common::ForwardingLatency::Total, common::MessageId::Sms,
+                                                      std::chrono::microseconds(7));
+
+    onCallback(showLatencyCallback, "reset");
+    ASSERT_THAT(result, HasSubstr("total"));
+    ASSERT_THAT(result, HasSubstr("Sms"));
+
+    onCallback(showLatencyCallback);
+    ASSERT_THAT(result, Not(HasSubstr("Sms")));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallShowMetrics)
+{
+    const common::MetricDefinition METRIC{"console_test_total", "Test", common::MetricType::Counter};
+    auto counter = common::MetricsRegistry::getGlobal().addCounter(METRIC);
+    counter->increment(3u);
+
+    onCallback(showMetricsCallback);
+    ASSERT_THAT(result, HasSubstr("console_test_total 3\n"));
+
+    onCallback(showMetricsCallback, "json");
+    ASSERT_THAT(result, HasSubstr("\"console_test_total\":{\"type\":\"counter\",\"value\":3}"));
+}
+
 }
@@ -31,6 +31,10 @@ protected:
     IConsole::CommandCallback showStatusCallback;
     IConsole::CommandCallback listAttachedUeCallback;
     IConsole::CommandCallback testCommandsCallback;
+    IConsole::CommandCallback testCommandsFromFileCallback;
+    IConsole::CommandCallback showLatencyCallback;
+    IConsole::CommandCallback showMetricsCallback;
+    IConsole::CommandCallback broadcastSmsCallback;
 };
 
 class ConsoleCommandsAfterStartTestSuite : public ConsoleCommandsTestSuite
@@ -0,0 +1,110 @@
+#include "FlatUeRelayTestSuite.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+FlatUeRelayTestSuite::FlatUeRelayTestSuite()
+    : objectUnderTest(std::make_unique<FlatUeRelay>(loggerMock, CAPACITY))
+{}
+
+IUeConnectionMock &FlatUeRelayTestSuite::addConnection()
+{
+    auto connectionMock = new StrictMock<IUeConnectionMock>();
+    EXPECT_CALL(*connectionMock, print(_)).Times(AnyNumber());
+    connectionMocks.push_back(connectionMock);
+    connectionSlots.push_back(objectUnderTest->add(IUeRelay::UePtr(connectionMock)));
+    return *connectionMock;
+}
+
+UeSlot &FlatUeRelayTestSuite::attachConnection(PhoneNumber phoneNumber)
+{
+    addConnection();
+    connectionSlots.back().attach(phoneNumber);
+    return connectionSlots.back();
+}
+
+IUeRelay::UeVisitor FlatUeRelayTestSuite::sendSib()
+{
+    return [this](IUeConnection& ue) { ue.sendSib(BTS_ID, std::nullopt); };
+}
+
+TEST_F(FlatUeRelayTestSuite, shallNotReachUeReusingSlotOfRemovedOne)
+{
+    auto removedSlot = attachConnection(PhoneNumber{1});
+    removedSlot.remove();
+    attachConnection(PhoneNumber{2});
+
+    ASSERT_FALSE(removedSlot.isAttached());
+    ASSERT_EQ(PhoneNumber{}, removedSlot.getPhoneNumber());
+    removedSlot.attach(PhoneNumber{3});
+    removedSlot.remove();
+
+    ASSERT_EQ(PhoneNumber{2}, connectionSlots.back().getPhoneNumber());
+    ASSERT_EQ(1u, objectUnderTest->count());
+}
+
+TEST_F(FlatUeRelayTestSuite, shallForwardToAttachedBeyondCapacityAfterChurn)
+{
+    constexpr std::uint32_t NUMBER_OF_UE = 20u * CAPACITY;
+    for (std::uint32_t phone = 1u; phone <= NUMBER_OF_UE; ++phone)
+    {
+        attachConnection(PhoneNumber{phone});
+    }
+    for (std::uint32_t phone = 1u; phone <= NUMBER_OF_UE; phone += 2u)
+    {
+        connectionSlots[phone - 1u].remove();
+    }
+
+    for (std::uint32_t phone = 2u; phone <= NUMBER_OF_UE; phone += 2u)
+    {
+        EXPECT_CALL(*connectionMocks[phone - 1u], sendMessage(ElementsAreArray(MESSAGE.value)));
+        ASSERT_TRUE(objectUnderTest->sendMessage(MESSAGE, PhoneNumber{phone})) << phone;
+        ASSERT_FALSE(objectUnderTest->sendMessage(MESSAGE, PhoneNumber{phone - 1u})) << phone - 1u;
+    }
+    ASSERT_EQ(NUMBER_OF_UE / 2u, objectUnderTest->countAttached());
+}
+
+TEST_F(FlatUeRelayTestSuite, shallVisitNextEveryNotAttachedOnceWhenOthersRemoved)
+{
+    for (std::size_t i = 0u; i < 4u; ++i)
+    {
+        addConnection();
+    }
+    EXPECT_CALL(*connectionMocks[3], sendSib(BTS_ID, _));
+    ASSERT_EQ(1u, objectUnderTest->visitNextNotAttachedUe(sendSib(), 1u));
+
+    connectionSlots[3].remove();
+    connectionSlots[0].remove();
+
+    EXPECT_CALL(*connectionMocks[1], sendSib(BTS_ID, _));
+    EXPECT_CALL(*connectionMocks[2], sendSib(BTS_ID, _));
+    ASSERT_EQ(2u, objectUnderTest->visitNextNotAttachedUe(sendSib(), 2u));
+}
+
+TEST_F(FlatUeRelayTestSuite, shallVisitNextNewlyAddedFirst)
+{
+    addConnection();
+    addConnection();
+    EXPECT_CALL(*connectionMocks[1], sendSib(BTS_ID, _));
+    objectUnderTest->visitNextNotAttachedUe(sendSib(), 1u);
+
+    auto& newConnection = addConnection();
+    EXPECT_CALL(newConnection, sendSib(BTS_ID, _));
+    ASSERT_EQ(1u, objectUnderTest->visitNextNotAttachedUe(sendSib(), 1u));
+}
+
+TEST_F(FlatUeRelayTestSuite, shallBeNotAttachedAfterFailedReattach)
+{
+    attachConnection(PhoneNumber{1});
+    auto& reattachedSlot = attachConnection(PhoneNumber{2});
+    reattachedSlot.attach(PhoneNumber{1});
+
+    ASSERT_FALSE(reattachedSlot.isAttached());
+    ASSERT_EQ(1u, objectUnderTest->countAttached());
+    ASSERT_EQ(1u, objectUnderTest->countNotAttached());
+    ASSERT_FALSE(objectUnderTest->sendMessage(MESSAGE, PhoneNumber{2}));
+}
+
+}
@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "UeRelay/FlatUeRelay.hpp"
+
+#include "Mocks/IUeConnectionMock.hpp"
+#include "Mocks/ILoggerMock.hpp"
+
+namespace bts
+{
+
+class FlatUeRelayTestSuite : public ::testing::Test
+{
+protected:
+    FlatUeRelayTestSuite();
+
+    IUeConnectionMock& addConnection();
+    UeSlot& attachConnection(PhoneNumber phoneNumber);
+    IUeRelay::UeVisitor sendSib();
+
+    static constexpr std::size_t CAPACITY = 4u;
+    const BinaryMessage MESSAGE{{1,2,3,4,5,6}};
+    const BtsId BTS_ID{1};
+
+    ::testing::NiceMock<common::ILoggerMock> loggerMock{};
+    std::vector<IUeConnectionMock*> connectionMocks;
+    std::vector<UeSlot> connectionSlots;
+
+    std::unique_ptr<FlatUeRelay> objectUnderTest;
+};
+
+
+}
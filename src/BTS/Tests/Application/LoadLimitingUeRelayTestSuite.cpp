@@ -0,0 +1,85 @@
+#include "LoadLimitingUeRelayTestSuite.hpp"
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+namespace bts
+{
+
+constexpr std::size_t LoadLimitingUeRelayTestSuite::MAX_ATTACHED;
+constexpr double LoadLimitingUeRelayTestSuite::MAX_FORWARD_RATE;
+
+LoadLimitingUeRelayTestSuite::LoadLimitingUeRelayTestSuite()
+    : ueRelayMock(std::make_shared<StrictMock<IUeRelayMock>>()),
+      ueSlotMock(std::make_shared<StrictMock<IUeSlotImplMock>>()),
+      objectUnderTest(ueRelayMock, loggerMock, MAX_ATTACHED, MAX_FORWARD_RATE, START)
+{}
+
+UeSlot LoadLimitingUeRelayTestSuite::addUe()
+{
+    EXPECT_CALL(*ueRelayMock, add(_)).WillOnce(Return(UeSlot(ueSlotMock)));
+    return objectUnderTest.add(nullptr);
+}
+
+void LoadLimitingUeRelayTestSuite::forward(std::size_t messages)
+{
+    EXPECT_CALL(*ueRelayMock, sendMessage(_, PHONE)).Times(messages).WillRepeatedly(Return(true));
+    for (std::size_t i = 0u; i < messages; ++i)
+    {
+        ASSERT_TRUE(objectUnderTest.sendMessage(Frame{}, PHONE));
+    }
+}
+
+TEST_F(LoadLimitingUeRelayTestSuite, shallReportLoadOfAttachedUe)
+{
+    EXPECT_CALL(*ueRelayMock, countAttached()).WillOnce(Return(1u));
+    ASSERT_EQ(CellLoad{25u}, objectUnderTest.getLoad(START));
+}
+
+TEST_F(LoadLimitingUeRelayTestSuite, shallReportLoadOfForwardingRateSampledOverWindow)
+{
+    EXPECT_CALL(*ueRelayMock, countAttached()).WillRepeatedly(Return(0u));
+    forward(50u);
+    ASSERT_EQ(CellLoad{0u}, objectUnderTest.getLoad(START + 500ms));
+    ASSERT_EQ(CellLoad{50u}, objectUnderTest.getLoad(START + 1s));
+    ASSERT_EQ(CellLoad{50u}, objectUnderTest.getLoad(START + 1500ms));
+    ASSERT_EQ(CellLoad{0u}, objectUnderTest.getLoad(START + 2s));
+}
+
+TEST_F(LoadLimitingUeRelayTestSuite, shallCountMessagesForwardedFromUeSlot)
+{
+    auto ueSlot = addUe();
+    EXPECT_CALL(*ueSlotMock, sendMessage(_, _, PHONE)).WillOnce(Return(true)).WillOnce(Return(false));
+    ASSERT_TRUE(ueSlot.sendMessage(Frame{}, PHONE));
+    ASSERT_FALSE(ueSlot.sendMessage(Frame{}, PHONE));
+
+    EXPECT_CALL(*ueRelayMock, countAttached()).WillOnce(Return(0u));
+    ASSERT_EQ(CellLoad{1u}, objectUnderTest.getLoad(START + 1s));
+}
+
+TEST_F(LoadLimitingUeRelayTestSuite, shallAdmitAttachBelowLimit)
+{
+    auto ueSlot = addUe();
+    EXPECT_CALL(*ueSlotMock, isAttached(_)).WillOnce(Return(false));
+    EXPECT_CALL(*ueRelayMock, countAttached()).WillOnce(Return(MAX_ATTACHED - 1u));
+    EXPECT_CALL(*ueSlotMock, attach(_, PHONE)).WillOnce([this](auto&&...) { return ueSlotMock; });
+    ueSlot.attach(PHONE);
+}
+
+TEST_F(LoadLimitingUeRelayTestSuite, shallNotAdmitAttachWhenFull)
+{
+    auto ueSlot = addUe();
+    EXPECT_CALL(*ueSlotMock, isAttached(_)).WillOnce(Return(false));
+    EXPECT_CALL(*ueRelayMock, countAttached()).WillOnce(Return(MAX_ATTACHED));
+    ueSlot.attach(PHONE);
+}
+
+TEST_F(LoadLimitingUeRelayTestSuite, shallAdmitReattachWhenFull)
+{
+    auto ueSlot = addUe();
+    EXPECT_CALL(*ueSlotMock, isAttached(_)).WillOnce(Return(true));
+    EXPECT_CALL(*ueSlotMock, attach(_, OTHER_PHONE)).WillOnce([this](auto&&...) { return ueSlotMock; });
+    ueSlot.attach(OTHER_PHONE);
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "UeRelay/LoadLimitingUeRelay.hpp"
+
+#include "Mocks/ILoggerMock.hpp"
+#include "Mocks/IUeRelayMock.hpp"
+#include "Mocks/UeSlotMock.hpp"
+
+namespace bts
+{
+
+class LoadLimitingUeRelayTestSuite : public ::testing::Test
+{
+protected:
+    LoadLimitingUeRelayTestSuite();
+
+    UeSlot addUe();
+    void forward(std::size_t messages);
+
+    static constexpr std::size_t MAX_ATTACHED = 4u;
+    static constexpr double MAX_FORWARD_RATE = 100.0;
+    const PhoneNumber PHONE{100};
+    const PhoneNumber OTHER_PHONE{101};
+    const LoadLimitingUeRelay::Clock::time_point START{};
+
+    ::testing::NiceMock<common::ILoggerMock> loggerMock;
+    std::shared_ptr<::testing::StrictMock<IUeRelayMock>> ueRelayMock;
+    std::shared_ptr<::testing::StrictMock<IUeSlotImplMock>> ueSlotMock;
+    LoadLimitingUeRelay objectUnderTest;
+};
+
+}
@@ -14,9 +14,12 @@ public:
 
     MOCK_METHOD(IConsole&, getConsole, (), (final));
     MOCK_METHOD(void, registerUeConnectedCallback, (UeConnectedCallback), (final));
+    MOCK_METHOD(void, registerPeerConnectedCallback, (PeerConnectedCallback), (final));
     MOCK_METHOD(ILogger&, getLogger, (), (final));
     MOCK_METHOD(BtsId, getBtsId, (), (const, final));
     MOCK_METHOD(std::string, getAddress, (), (const, final));
+    MOCK_METHOD(std::int32_t, getProperty, (const std::string &name, std::int32_t defaultValue), (const, final));
+    MOCK_METHOD(std::string, getProperty, (const std::string &name, const std::string &defaultValue), (const, final));
     MOCK_METHOD(void, startMessageLoop, (), (final));
 };
 
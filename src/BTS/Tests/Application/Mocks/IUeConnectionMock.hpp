@@ -14,10 +14,11 @@ public:
     ~IUeConnectionMock() override;
 
     MOCK_METHOD(void, start, (UeSlot ueSlot), (final));
-    MOCK_METHOD(void, sendMessage, (BinaryMessage message), (final));
-    MOCK_METHOD(void, sendSib, (BtsId btsId), (final));
+    MOCK_METHOD(void, sendMessage, (Frame message), (final));
+    MOCK_METHOD(void, sendSib, (BtsId btsId, std::optional<CellLoad> load), (final));
     MOCK_METHOD(PhoneNumber, getPhoneNumber, (), (const, final));
     MOCK_METHOD(bool, isAttached, (), (const, final));
+    MOCK_METHOD(bool, isCongested, (), (const, final));
     MOCK_METHOD(void, print, (std::ostream&), (const, final));
 };
 
@@ -21,8 +21,11 @@ public:
 
     MOCK_METHOD(void, visitAttachedUe, (UeVisitor), (final));
     MOCK_METHOD(void, visitNotAttachedUe, (UeVisitor), (final));
+    MOCK_METHOD(std::size_t, visitNextNotAttachedUe, (UeVisitor, std::size_t maxCount), (final));
 
-    MOCK_METHOD(bool, sendMessage, (BinaryMessage message, PhoneNumber to), (final));
+    MOCK_METHOD(bool, sendMessage, (Frame message, PhoneNumber to), (final));
+    MOCK_METHOD(std::size_t, broadcast, (Frame message, BroadcastScope scope), (final));
+    MOCK_METHOD(std::optional<CellLoad>, getLoad, (), (final));
 
 
 };
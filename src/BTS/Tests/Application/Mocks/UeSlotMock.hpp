@@ -13,11 +13,11 @@ public:
     IUeSlotImplMock();
     ~IUeSlotImplMock() override;
 
-    MOCK_METHOD(bool, sendMessage, (BinaryMessage message, PhoneNumber to), (final));
-    MOCK_METHOD(UeSlot::IImplPtr, attach, (PhoneNumber phone), (final));
-    MOCK_METHOD(bool, isAttached, (), (const, final));
-    MOCK_METHOD(PhoneNumber, getPhoneNumber, (), (const, final));
-    MOCK_METHOD(void, remove, (), (final));
+    MOCK_METHOD(bool, sendMessage, (UeSlot::Handle handle, Frame message, PhoneNumber to), (final));
+    MOCK_METHOD(UeSlot::IImplPtr, attach, (UeSlot::Handle handle, PhoneNumber phone), (final));
+    MOCK_METHOD(bool, isAttached, (UeSlot::Handle handle), (const, final));
+    MOCK_METHOD(PhoneNumber, getPhoneNumber, (UeSlot::Handle handle), (const, final));
+    MOCK_METHOD(void, remove, (UeSlot::Handle handle), (final));
 };
 
 
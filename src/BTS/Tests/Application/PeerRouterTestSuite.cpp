@@ -0,0 +1,270 @@
+#include "PeerRouterTestSuite.hpp"
+#include "Messages/MessageSchema.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+using common::MessageId;
+
+PeerRouterTestSuite::Bytes PeerRouterTestSuite::peerMessage(std::uint8_t messageId, std::uint32_t value)
+{
+    return { messageId,
+             static_cast<std::uint8_t>(value >> 24), static_cast<std::uint8_t>(value >> 16),
+             static_cast<std::uint8_t>(value >> 8), static_cast<std::uint8_t>(value) };
+}
+
+PeerRouterTestSuite::PeerRouterTestSuite()
+{
+    objectUnderTest = std::make_shared<PeerRouter>(BTS_ID, loggerMock, localDeliveryMock.AsStdFunction());
+}
+
+void PeerRouterTestSuite::addLink()
+{
+    transportMock = std::make_shared<NiceMock<common::ITransportMock>>();
+    ON_CALL(*transportMock, addressToString()).WillByDefault(Return(TRANSPORT_ADDRESS));
+    ON_CALL(*transportMock, sendMessage(_)).WillByDefault([this](Frame message) { sent.push_back(message); return true; });
+    // unregistered when router is destroyed
+    EXPECT_CALL(*transportMock, registerMessageCallback(_)).WillOnce(SaveArg<0>(&messageCallback)).WillRepeatedly(Return());
+    EXPECT_CALL(*transportMock, registerDisconnectedCallback(_)).WillOnce(SaveArg<0>(&disconnectedCallback)).WillRepeatedly(Return());
+    objectUnderTest->addLink(transportMock);
+    ASSERT_TRUE(messageCallback);
+    ASSERT_TRUE(disconnectedCallback);
+}
+
+void PeerRouterTestSuite::receive(Bytes message)
+{
+    messageCallback(Frame::copyOf(Frame::View(message)));
+}
+
+void PeerRouterTestSuite::receiveHello(BtsId peer)
+{
+    receive(hello(peer));
+}
+
+void PeerRouterTestSuite::receiveAttached(PhoneNumber phone)
+{
+    receive(attached(phone));
+}
+
+void PeerRouterTestSuite::receiveDetached(PhoneNumber phone)
+{
+    receive(detached(phone));
+}
+
+PeerRouterTestSuite::Bytes PeerRouterTestSuite::hello(BtsId btsId)
+{
+    return peerMessage(0x40, btsId.value);
+}
+
+PeerRouterTestSuite::Bytes PeerRouterTestSuite::attached(PhoneNumber phone)
+{
+    return peerMessage(0x41, phone.value);
+}
+
+PeerRouterTestSuite::Bytes PeerRouterTestSuite::detached(PhoneNumber phone)
+{
+    return peerMessage(0x42, phone.value);
+}
+
+std::vector<PeerRouterTestSuite::Bytes> PeerRouterTestSuite::sentBytes() const
+{
+    std::vector<Bytes> result;
+    for (auto& message: sent)
+    {
+        result.emplace_back(message.view().begin(), message.view().end());
+    }
+    return result;
+}
+
+TEST_F(PeerRouterTestSuite, shallSendHelloOverNewLink)
+{
+    addLink();
+    ASSERT_THAT(sentBytes(), ElementsAre(hello(BTS_ID)));
+}
+
+TEST_F(PeerRouterTestSuite, shallAnnounceLocalPhonesOverNewLink)
+{
+    objectUnderTest->announceAttached(LOCAL_PHONE);
+    addLink();
+    ASSERT_THAT(sentBytes(), ElementsAre(hello(BTS_ID), attached(LOCAL_PHONE)));
+}
+
+TEST_F(PeerRouterTestSuite, shallAnnounceAttachedAndDetachedOverLinks)
+{
+    addLink();
+    objectUnderTest->announceAttached(LOCAL_PHONE);
+    objectUnderTest->announceDetached(LOCAL_PHONE);
+    ASSERT_THAT(sentBytes(), ElementsAre(hello(BTS_ID), attached(LOCAL_PHONE), detached(LOCAL_PHONE)));
+}
+
+TEST_F(PeerRouterTestSuite, shallForwardToPhoneAttachedAtPeer)
+{
+    addLink();
+    receiveHello(PEER_BTS_ID);
+    receiveAttached(PEER_PHONE);
+    ASSERT_EQ(1u, objectUnderTest->countPeers());
+    ASSERT_EQ(1u, objectUnderTest->countRoutes());
+
+    auto sms = common::schema::encode<MessageId::Sms>(LOCAL_PHONE, PEER_PHONE);
+    ASSERT_TRUE(objectUnderTest->forward(sms, PEER_PHONE));
+    ASSERT_EQ(2u, sent.size());
+    ASSERT_EQ(Frame(sms).view().size(), sent.back().view().size());
+}
+
+TEST_F(PeerRouterTestSuite, shallNotForwardToUnknownPhone)
+{
+    addLink();
+    receiveHello(PEER_BTS_ID);
+    ASSERT_FALSE(objectUnderTest->forward(common::schema::encode<MessageId::Sms>(LOCAL_PHONE, PEER_PHONE), PEER_PHONE));
+    ASSERT_EQ(1u, sent.size());
+}
+
+TEST_F(PeerRouterTestSuite, shallIgnoreAnnouncementsBeforeHello)
+{
+    addLink();
+    receiveAttached(PEER_PHONE);
+    ASSERT_EQ(0u, objectUnderTest->countRoutes());
+}
+
+TEST_F(PeerRouterTestSuite, shallForgetDetachedPhone)
+{
+    addLink();
+    receiveHello(PEER_BTS_ID);
+    receiveAttached(PEER_PHONE);
+    receiveDetached(PEER_PHONE);
+    ASSERT_EQ(0u, objectUnderTest->countRoutes());
+    ASSERT_FALSE(objectUnderTest->forward(common::schema::encode<MessageId::Sms>(LOCAL_PHONE, PEER_PHONE), PEER_PHONE));
+}
+
+TEST_F(PeerRouterTestSuite, shallForgetRoutesOfDisconnectedPeer)
+{
+    addLink();
+    receiveHello(PEER_BTS_ID);
+    receiveAttached(PEER_PHONE);
+    disconnectedCallback();
+    ASSERT_EQ(0u, objectUnderTest->countPeers());
+    ASSERT_EQ(0u, objectUnderTest->countRoutes());
+}
+
+TEST_F(PeerRouterTestSuite, shallKeepRoutesWhileOtherLinkToPeerExists)
+{
+    addLink();
+    receiveHello(PEER_BTS_ID);
+    receiveAttached(PEER_PHONE);
+    auto firstDisconnectedCallback = disconnectedCallback;
+    addLink();
+    receiveHello(PEER_BTS_ID);
+    receiveAttached(PEER_PHONE);
+
+    firstDisconnectedCallback();
+    ASSERT_EQ(1u, objectUnderTest->countPeers());
+    ASSERT_TRUE(objectUnderTest->forward(common::schema::encode<MessageId::Sms>(LOCAL_PHONE, PEER_PHONE), PEER_PHONE));
+}
+
+TEST_F(PeerRouterTestSuite, shallDeliverForwardedMessageLocally)
+{
+    addLink();
+    receiveHello(PEER_BTS_ID);
+    EXPECT_CALL(localDeliveryMock, Call(_, LOCAL_PHONE)).WillOnce(Return(true));
+    Frame sms = common::schema::encode<MessageId::Sms>(PEER_PHONE, LOCAL_PHONE);
+    messageCallback(sms);
+    ASSERT_EQ(1u, sent.size());
+}
+
+TEST_F(PeerRouterTestSuite, shallCorrectStaleRouteAndAnswerUnknownRecipient)
+{
+    addLink();
+    receiveHello(PEER_BTS_ID);
+    EXPECT_CALL(localDeliveryMock, Call(_, LOCAL_PHONE)).WillOnce(Return(false));
+    const common::MessageHeader smsHeader{MessageId::Sms, PEER_PHONE, LOCAL_PHONE};
+    messageCallback(common::schema::encode<MessageId::Sms>(PEER_PHONE, LOCAL_PHONE));
+
+    ASSERT_EQ(3u, sent.size());
+    ASSERT_THAT(sentBytes()[1], ElementsAreArray(detached(LOCAL_PHONE)));
+    ASSERT_EQ(Frame(common::schema::encode<MessageId::UnknownRecipient>(PhoneNumber{}, PEER_PHONE, {smsHeader})),
+              sent[2]);
+}
+
+TEST_F(PeerRouterTestSuite, shallNotAnswerUndeliveredUnknownRecipient)
+{
+    addLink();
+    receiveHello(PEER_BTS_ID);
+    EXPECT_CALL(localDeliveryMock, Call(_, LOCAL_PHONE)).WillOnce(Return(false));
+    const common::MessageHeader smsHeader{MessageId::Sms, LOCAL_PHONE, PEER_PHONE};
+    messageCallback(common::schema::encode<MessageId::UnknownRecipient>(PhoneNumber{}, LOCAL_PHONE, {smsHeader}));
+
+    ASSERT_THAT(sentBytes(), ElementsAre(hello(BTS_ID), detached(LOCAL_PHONE)));
+}
+
+
+PeeringUeRelayTestSuite::PeeringUeRelayTestSuite()
+{
+    localRelayMock = std::make_shared<StrictMock<IUeRelayMock>>();
+    localSlotMock = std::make_shared<StrictMock<IUeSlotImplMock>>();
+    peeringRelay = std::make_unique<PeeringUeRelay>(localRelayMock, objectUnderTest);
+    addLink();
+    receiveHello(PEER_BTS_ID);
+    sent.clear();
+}
+
+UeSlot PeeringUeRelayTestSuite::addUe()
+{
+    EXPECT_CALL(*localRelayMock, add(_)).WillOnce(Return(UeSlot(localSlotMock)));
+    return peeringRelay->add(nullptr);
+}
+
+TEST_F(PeeringUeRelayTestSuite, shallSendToLocalUeFirst)
+{
+    EXPECT_CALL(*localRelayMock, sendMessage(_, PEER_PHONE)).WillOnce(Return(true));
+    receiveAttached(PEER_PHONE);
+    ASSERT_TRUE(peeringRelay->sendMessage(common::schema::encode<MessageId::Sms>(LOCAL_PHONE, PEER_PHONE), PEER_PHONE));
+    ASSERT_THAT(sent, IsEmpty());
+}
+
+TEST_F(PeeringUeRelayTestSuite, shallForwardWhenNotAttachedLocally)
+{
+    EXPECT_CALL(*localRelayMock, sendMessage(_, PEER_PHONE)).WillOnce(Return(false));
+    receiveAttached(PEER_PHONE);
+    ASSERT_TRUE(peeringRelay->sendMessage(common::schema::encode<MessageId::Sms>(LOCAL_PHONE, PEER_PHONE), PEER_PHONE));
+    ASSERT_EQ(1u, sent.size());
+}
+
+TEST_F(PeeringUeRelayTestSuite, shallForwardFromUeSlot)
+{
+    auto ueSlot = addUe();
+    EXPECT_CALL(*localSlotMock, sendMessage(_, _, PEER_PHONE)).WillOnce(Return(false));
+    receiveAttached(PEER_PHONE);
+    ASSERT_TRUE(ueSlot.sendMessage(common::schema::encode<MessageId::Sms>(LOCAL_PHONE, PEER_PHONE), PEER_PHONE));
+    ASSERT_EQ(1u, sent.size());
+}
+
+TEST_F(PeeringUeRelayTestSuite, shallAnnounceAttachedUe)
+{
+    auto ueSlot = addUe();
+    EXPECT_CALL(*localSlotMock, getPhoneNumber(_)).WillOnce(Return(PhoneNumber{})).WillOnce(Return(LOCAL_PHONE));
+    EXPECT_CALL(*localSlotMock, attach(_, LOCAL_PHONE)).WillOnce([this](auto&&...) { return localSlotMock; });
+    ueSlot.attach(LOCAL_PHONE);
+    ASSERT_THAT(sentBytes(), ElementsAre(attached(LOCAL_PHONE)));
+}
+
+TEST_F(PeeringUeRelayTestSuite, shallNotAnnounceWhenLocalAttachFailed)
+{
+    auto ueSlot = addUe();
+    EXPECT_CALL(*localSlotMock, getPhoneNumber(_)).Times(2).WillRepeatedly(Return(PhoneNumber{}));
+    EXPECT_CALL(*localSlotMock, attach(_, LOCAL_PHONE)).WillOnce([this](auto&&...) { return localSlotMock; });
+    ueSlot.attach(LOCAL_PHONE);
+    ASSERT_THAT(sent, IsEmpty());
+}
+
+TEST_F(PeeringUeRelayTestSuite, shallAnnounceDetachedWhenUeRemoved)
+{
+    auto ueSlot = addUe();
+    EXPECT_CALL(*localSlotMock, getPhoneNumber(_)).WillOnce(Return(LOCAL_PHONE));
+    EXPECT_CALL(*localSlotMock, remove(_));
+    ueSlot.remove();
+    ASSERT_THAT(sentBytes(), ElementsAre(detached(LOCAL_PHONE)));
+}
+
+}
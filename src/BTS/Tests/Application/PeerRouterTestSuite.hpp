@@ -0,0 +1,66 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+#include "Peering/PeerRouter.hpp"
+#include "Peering/PeeringUeRelay.hpp"
+
+#include "Mocks/ILoggerMock.hpp"
+#include "Mocks/ITransportMock.hpp"
+#include "Mocks/IUeRelayMock.hpp"
+#include "Mocks/UeSlotMock.hpp"
+
+namespace bts
+{
+
+class PeerRouterTestSuite : public ::testing::Test
+{
+protected:
+    using Bytes = std::vector<BinaryMessage::ValueType>;
+
+    PeerRouterTestSuite();
+
+    void addLink();
+    void receive(Bytes message);
+    void receiveHello(BtsId peer);
+    void receiveAttached(PhoneNumber phone);
+    void receiveDetached(PhoneNumber phone);
+
+    // kind byte and 4 bytes value
+    static Bytes peerMessage(std::uint8_t messageId, std::uint32_t value);
+    static Bytes hello(BtsId btsId);
+    static Bytes attached(PhoneNumber phone);
+    static Bytes detached(PhoneNumber phone);
+    std::vector<Bytes> sentBytes() const;
+
+    const BtsId BTS_ID{17};
+    const BtsId PEER_BTS_ID{18};
+    const PhoneNumber LOCAL_PHONE{100};
+    const PhoneNumber PEER_PHONE{70000};
+    const std::string TRANSPORT_ADDRESS = "PEER";
+
+    ::testing::NiceMock<common::ILoggerMock> loggerMock;
+    ::testing::StrictMock<::testing::MockFunction<bool(Frame, PhoneNumber)>> localDeliveryMock;
+    std::shared_ptr<::testing::NiceMock<common::ITransportMock>> transportMock;
+    ITransport::MessageCallback messageCallback;
+    ITransport::DisconnectedCallback disconnectedCallback;
+    std::vector<Frame> sent;
+
+    std::shared_ptr<PeerRouter> objectUnderTest;
+};
+
+class PeeringUeRelayTestSuite : public PeerRouterTestSuite
+{
+protected:
+    PeeringUeRelayTestSuite();
+
+    UeSlot addUe();
+
+    std::shared_ptr<::testing::StrictMock<IUeRelayMock>> localRelayMock;
+    std::shared_ptr<::testing::StrictMock<IUeSlotImplMock>> localSlotMock;
+    std::unique_ptr<PeeringUeRelay> peeringRelay;
+};
+
+}
@@ -0,0 +1,179 @@
+#include "ShardedUeRelayTestSuite.hpp"
+#include "UeConnection/UeConnection.hpp"
+#include "Messages/MessageSchema.hpp"
+#include "Mocks/ITransportMock.hpp"
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace ::testing;
+
+namespace bts
+{
+
+ShardedUeRelayTestSuite::ShardedUeRelayTestSuite()
+    : objectUnderTest(std::make_unique<ShardedUeRelay>(loggerMock, NUMBER_OF_SHARDS))
+{
+    connectionSlots.reserve(2 * NUMBER_OF_THREADS);
+}
+
+IUeConnectionMock &ShardedUeRelayTestSuite::addConnection()
+{
+    auto connectionMock = new StrictMock<IUeConnectionMock>();
+    EXPECT_CALL(*connectionMock, print(_)).Times(AnyNumber());
+    connectionMocks.push_back(connectionMock);
+    connectionSlots.push_back(objectUnderTest->add(IUeRelay::UePtr(connectionMock)));
+    return *connectionMock;
+}
+
+UeSlot &ShardedUeRelayTestSuite::attachConnection(PhoneNumber phoneNumber)
+{
+    addConnection();
+    connectionSlots.back().attach(phoneNumber);
+    return connectionSlots.back();
+}
+
+TEST_F(ShardedUeRelayTestSuite, shallNotAcceptZeroShards)
+{
+    ASSERT_THROW(ShardedUeRelay(loggerMock, 0u), std::invalid_argument);
+}
+
+TEST_F(ShardedUeRelayTestSuite, shallKeepAttachedInManyShards)
+{
+    for (std::uint8_t phone = 1u; phone <= 2 * NUMBER_OF_SHARDS; ++phone)
+    {
+        ASSERT_TRUE(attachConnection(PhoneNumber{phone}).isAttached());
+    }
+    ASSERT_EQ(2 * NUMBER_OF_SHARDS, objectUnderTest->countAttached());
+    ASSERT_EQ(0u, objectUnderTest->countNotAttached());
+}
+
+TEST_F(ShardedUeRelayTestSuite, shallDestroyConnectionsWithOwnGuardWhenDisconnected)
+{
+    common::MetricsRegistry metricsRegistry;
+    std::vector<ITransport::DisconnectedCallback> disconnectedCallbacks;
+    std::atomic<std::size_t> destroyedLocked{0u};
+    // mutex locked by this thread cannot be taken by other one
+    auto guardDeleter = [&destroyedLocked](SyncGuard* guard)
+    {
+        auto unlocked = std::async(std::launch::async, [guard]
+        {
+            if (not guard->try_lock())
+            {
+                return false;
+            }
+            guard->unlock();
+            return true;
+        });
+        if (not unlocked.get())
+        {
+            // leaked - it is unlocked later
+            ++destroyedLocked;
+            return;
+        }
+        delete guard;
+    };
+    for (bool attached: {true, false})
+    {
+        auto transportMock = std::make_shared<NiceMock<common::ITransportMock>>();
+        ITransport::MessageCallback messageCallback;
+        ON_CALL(*transportMock, sendMessage(_)).WillByDefault(Return(true));
+        EXPECT_CALL(*transportMock, registerMessageCallback(_)).WillOnce(SaveArg<0>(&messageCallback)).WillRepeatedly(Return());
+        EXPECT_CALL(*transportMock, registerDisconnectedCallback(_))
+                .WillOnce([&](auto callback) { disconnectedCallbacks.push_back(callback); }).WillRepeatedly(Return());
+        // as made by UeConnectionFactory for sharded relay - connection is the only owner of its guard
+        auto connection = std::make_unique<UeConnection>(transportMock, loggerMock,
+                                                         SyncGuardPtr(new SyncGuard, guardDeleter), metricsRegistry);
+        auto& connectionRef = *connection;
+        connectionRef.start(objectUnderTest->add(std::move(connection)));
+        if (attached)
+        {
+            messageCallback(common::schema::encode<common::MessageId::AttachRequest>(PhoneNumber{1}, PhoneNumber{},
+                                                                                     {common::BtsId{1}}));
+        }
+    }
+    ASSERT_EQ(1u, objectUnderTest->countAttached());
+
+    for (auto& disconnectedCallback: disconnectedCallbacks)
+    {
+        disconnectedCallback();
+    }
+    ASSERT_EQ(0u, objectUnderTest->count());
+    ASSERT_EQ(0u, destroyedLocked);
+}
+
+TEST_F(ShardedUeRelayTestSuite, shallAllowVisitorToRemoveVisitedUe)
+{
+    attachConnection(PhoneNumber{1});
+    attachConnection(PhoneNumber{2});
+    addConnection();
+
+    objectUnderTest->visitAttachedUe([this](IUeConnection&) { connectionSlots[0].remove(); });
+    objectUnderTest->visitNotAttachedUe([this](IUeConnection&) { connectionSlots[2].remove(); });
+
+    ASSERT_EQ(1u, objectUnderTest->count());
+}
+
+TEST_F(ShardedUeRelayTestSuite, shallVisitNextEveryNotAttachedOnceFromUnevenShards)
+{
+    constexpr std::size_t NUMBER_OF_NOT_ATTACHED = NUMBER_OF_SHARDS + 2u;
+    for (std::size_t i = 0u; i < NUMBER_OF_NOT_ATTACHED; ++i)
+    {
+        EXPECT_CALL(addConnection(), sendSib(BtsId{1}, _));
+    }
+
+    ASSERT_EQ(NUMBER_OF_NOT_ATTACHED,
+              objectUnderTest->visitNextNotAttachedUe([](IUeConnection& ue) { ue.sendSib(BtsId{1}, std::nullopt); },
+                                                      NUMBER_OF_NOT_ATTACHED + 1u));
+}
+
+TEST_F(ShardedUeRelayTestSuite, shallForwardMessagesFromManyThreads)
+{
+    for (std::uint8_t phone = 1u; phone <= NUMBER_OF_THREADS; ++phone)
+    {
+        attachConnection(PhoneNumber{phone});
+        EXPECT_CALL(*connectionMocks.back(), sendMessage(ElementsAreArray(MESSAGE.value)))
+                .Times(NUMBER_OF_MESSAGES);
+    }
+
+    std::vector<std::thread> senders;
+    for (std::uint8_t phone = 1u; phone <= NUMBER_OF_THREADS; ++phone)
+    {
+        senders.emplace_back([this, phone]
+        {
+            for (std::size_t i = 0; i < NUMBER_OF_MESSAGES; ++i)
+            {
+                objectUnderTest->sendMessage(MESSAGE, PhoneNumber{phone});
+            }
+        });
+    }
+    for (auto& sender: senders)
+    {
+        sender.join();
+    }
+}
+
+TEST_F(ShardedUeRelayTestSuite, shallForwardWhileOtherUeAttachAndDetach)
+{
+    const PhoneNumber RECIPIENT{1};
+    attachConnection(RECIPIENT);
+    EXPECT_CALL(*connectionMocks.back(), sendMessage(_)).Times(NUMBER_OF_MESSAGES);
+    auto& churningSlot = attachConnection(PhoneNumber{2});
+
+    std::thread sender([this, RECIPIENT]
+    {
+        for (std::size_t i = 0; i < NUMBER_OF_MESSAGES; ++i)
+        {
+            ASSERT_TRUE(objectUnderTest->sendMessage(MESSAGE, RECIPIENT));
+        }
+    });
+    for (std::uint8_t phone = 3u; phone < 100u; ++phone)
+    {
+        churningSlot.attach(PhoneNumber{phone});
+    }
+    sender.join();
+
+    ASSERT_EQ(2u, objectUnderTest->countAttached());
+}
+
+}
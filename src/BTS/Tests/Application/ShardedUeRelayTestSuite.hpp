@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "UeRelay/ShardedUeRelay.hpp"
+
+#include "Mocks/IUeConnectionMock.hpp"
+#include "Mocks/ILoggerMock.hpp"
+
+namespace bts
+{
+
+class ShardedUeRelayTestSuite : public ::testing::Test
+{
+protected:
+    ShardedUeRelayTestSuite();
+
+    IUeConnectionMock& addConnection();
+    UeSlot& attachConnection(PhoneNumber phoneNumber);
+
+    static constexpr std::size_t NUMBER_OF_SHARDS = 4u;
+    static constexpr std::size_t NUMBER_OF_THREADS = 4u;
+    static constexpr std::size_t NUMBER_OF_MESSAGES = 1000u;
+    const BinaryMessage MESSAGE{{1,2,3,4,5,6}};
+
+    ::testing::NiceMock<common::ILoggerMock> loggerMock{};
+    std::vector<IUeConnectionMock*> connectionMocks;
+    std::vector<UeSlot> connectionSlots;
+
+    std::unique_ptr<ShardedUeRelay> objectUnderTest;
+};
+
+
+}
@@ -0,0 +1,131 @@
+#include "SibSchedulerTestSuite.hpp"
+#include <future>
+
+using namespace ::testing;
+
+namespace bts
+{
+
+constexpr BtsId SibSchedulerTestSuite::BTS_ID;
+constexpr std::chrono::milliseconds SibSchedulerTestSuite::PERIOD;
+constexpr std::chrono::milliseconds SibSchedulerTestSuite::DISCOVERY_LATENCY;
+constexpr std::chrono::milliseconds SibSchedulerTestSuite::MARGIN;
+constexpr std::size_t SibSchedulerTestSuite::UE_NOT_ATTACHED_COUNT;
+
+SibSchedulerTestSuite::SibSchedulerTestSuite()
+{
+    syncGuard = std::make_shared<SyncGuard>();
+    ueRelayMock = std::make_shared<StrictMock<IUeRelayMock>>();
+    objectUnderTest = std::make_unique<SibScheduler>(ueRelayMock, syncGuard, BTS_ID, loggerMock,
+                                                     DISCOVERY_LATENCY, PERIOD);
+    EXPECT_CALL(*ueRelayMock, getLoad()).WillRepeatedly(Return(std::nullopt));
+    for (auto& ue : ueNotAttachedMock)
+        EXPECT_CALL(ue, print(_)).Times(AnyNumber());
+}
+
+TEST_F(SibSchedulerTestSuite, shallDoNothingWhenNotStarted)
+{
+    std::this_thread::sleep_for(DISCOVERY_LATENCY + MARGIN);
+}
+
+TEST_F(SibSchedulerTestSuite, shallNotAcceptZeroDiscoveryLatency)
+{
+    ASSERT_THROW(SibScheduler(ueRelayMock, syncGuard, BTS_ID, loggerMock, std::chrono::milliseconds(0), PERIOD),
+                 std::invalid_argument);
+}
+
+TEST_F(SibSchedulerTestSuite, shallStopWithoutWaitingForEndOfPeriod)
+{
+    constexpr std::chrono::seconds LONG_PERIOD{10};
+    SibScheduler objectUnderTest(ueRelayMock, syncGuard, BTS_ID, loggerMock, 2 * LONG_PERIOD, LONG_PERIOD);
+    objectUnderTest.start();
+
+    auto stopBegin = std::chrono::steady_clock::now();
+    objectUnderTest.stop();
+    ASSERT_LT(std::chrono::steady_clock::now() - stopBegin, LONG_PERIOD / 10);
+}
+
+void SibSchedulerStartedTestSuite::TearDown()
+{
+    objectUnderTest->stop();
+    SibSchedulerTestSuite::TearDown();
+}
+
+void SibSchedulerStartedTestSuite::start(std::size_t notAttachedCount)
+{
+    EXPECT_CALL(*ueRelayMock, countNotAttached()).WillRepeatedly(Return(notAttachedCount));
+    objectUnderTest->start();
+}
+
+std::size_t SibSchedulerStartedTestSuite::visitNext(IUeRelay::UeVisitor visitor, std::size_t maxCount)
+{
+    for (std::size_t i = 0; i < maxCount; ++i)
+        visitor(ueNotAttachedMock[nextUeIndex++ % UE_NOT_ATTACHED_COUNT]);
+    return maxCount;
+}
+
+TEST_F(SibSchedulerStartedTestSuite, shallNotVisitWhenNoUeWaiting)
+{
+    start(0);
+    std::this_thread::sleep_for(2 * PERIOD + MARGIN);
+}
+
+TEST_F(SibSchedulerStartedTestSuite, shallSendOneSibPerPeriodToKeepDiscoveryLatency)
+{
+    EXPECT_CALL(*ueRelayMock, visitNextNotAttachedUe(_, 1u))
+            .WillRepeatedly([this](IUeRelay::UeVisitor visitor, std::size_t maxCount)
+            {
+                return visitNext(visitor, maxCount);
+            });
+
+    // following rounds
+    for (auto& ue : ueNotAttachedMock)
+        EXPECT_CALL(ue, sendSib(BTS_ID, _)).Times(AnyNumber());
+
+    std::promise<void> lastUeDiscovered;
+    Sequence firstRound;
+    EXPECT_CALL(ueNotAttachedMock[0], sendSib(BTS_ID, _)).InSequence(firstRound).RetiresOnSaturation();
+    EXPECT_CALL(ueNotAttachedMock[1], sendSib(BTS_ID, _)).InSequence(firstRound).RetiresOnSaturation();
+    EXPECT_CALL(ueNotAttachedMock[2], sendSib(BTS_ID, _)).InSequence(firstRound)
+            .WillOnce(InvokeWithoutArgs([&] { lastUeDiscovered.set_value(); })).RetiresOnSaturation();
+
+    start(UE_NOT_ATTACHED_COUNT);
+    ASSERT_EQ(std::future_status::ready, lastUeDiscovered.get_future().wait_for(10 * DISCOVERY_LATENCY));
+}
+
+TEST_F(SibSchedulerStartedTestSuite, shallSendManySibsPerPeriodWhenManyUeWaiting)
+{
+    constexpr std::size_t MANY_NOT_ATTACHED = 30;
+    constexpr std::size_t SIBS_PER_PERIOD = MANY_NOT_ATTACHED * PERIOD / DISCOVERY_LATENCY;
+    static_assert(SIBS_PER_PERIOD == 10, "Expected to be 10 SIBs per period");
+
+    std::promise<void> visited;
+    EXPECT_CALL(*ueRelayMock, visitNextNotAttachedUe(_, SIBS_PER_PERIOD))
+            .WillOnce(InvokeWithoutArgs([&] { visited.set_value(); return SIBS_PER_PERIOD; }))
+            .WillRepeatedly(Return(SIBS_PER_PERIOD));
+
+    start(MANY_NOT_ATTACHED);
+    ASSERT_EQ(std::future_status::ready, visited.get_future().wait_for(10 * PERIOD));
+}
+
+TEST_F(SibSchedulerStartedTestSuite, shallSendSibWithLoadOfRelay)
+{
+    const CellLoad LOAD{42u};
+    EXPECT_CALL(*ueRelayMock, getLoad()).WillRepeatedly(Return(LOAD));
+    EXPECT_CALL(*ueRelayMock, visitNextNotAttachedUe(_, 1u))
+            .WillRepeatedly([this](IUeRelay::UeVisitor visitor, std::size_t maxCount)
+            {
+                return visitNext(visitor, maxCount);
+            });
+
+    for (auto& ue : ueNotAttachedMock)
+        EXPECT_CALL(ue, sendSib(BTS_ID, Optional(LOAD))).Times(AnyNumber());
+    std::promise<void> sibSent;
+    EXPECT_CALL(ueNotAttachedMock[0], sendSib(BTS_ID, Optional(LOAD)))
+            .WillOnce(InvokeWithoutArgs([&] { sibSent.set_value(); })).RetiresOnSaturation();
+
+    start(UE_NOT_ATTACHED_COUNT);
+    ASSERT_EQ(std::future_status::ready, sibSent.get_future().wait_for(10 * DISCOVERY_LATENCY));
+}
+
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <array>
+
+#include "SibScheduler.hpp"
+
+#include "Mocks/ILoggerMock.hpp"
+#include "Mocks/IUeRelayMock.hpp"
+#include "Mocks/IUeConnectionMock.hpp"
+
+namespace bts
+{
+
+class SibSchedulerTestSuite : public ::testing::Test
+{
+protected:
+    SibSchedulerTestSuite();
+
+    static constexpr BtsId BTS_ID{17};
+    static constexpr std::chrono::milliseconds PERIOD{20};
+    static constexpr std::chrono::milliseconds DISCOVERY_LATENCY{3 * PERIOD};
+    static constexpr std::chrono::milliseconds MARGIN{PERIOD / 2};
+    static constexpr std::size_t UE_NOT_ATTACHED_COUNT = 3;
+
+    SyncGuardPtr syncGuard;
+    std::shared_ptr<IUeRelayMock> ueRelayMock;
+    testing::NiceMock<common::ILoggerMock> loggerMock;
+
+    using UeNotAttached = std::array<testing::StrictMock<IUeConnectionMock>, UE_NOT_ATTACHED_COUNT>;
+    UeNotAttached ueNotAttachedMock;
+
+    std::unique_ptr<SibScheduler> objectUnderTest;
+};
+
+class SibSchedulerStartedTestSuite : public SibSchedulerTestSuite
+{
+protected:
+    void TearDown() override;
+    void start(std::size_t notAttachedCount);
+    std::size_t visitNext(IUeRelay::UeVisitor visitor, std::size_t maxCount);
+
+    std::size_t nextUeIndex = 0;
+};
+
+}
@@ -0,0 +1,427 @@
+#include "SmsStoreTestSuite.hpp"
+#include "UeConnection/UeConnection.hpp"
+#include "UeRelay/UeRelay.hpp"
+#include "Messages/MessageSchema.hpp"
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+namespace bts
+{
+
+namespace schema = common::schema;
+using common::MessageId;
+
+namespace
+{
+
+std::string temporaryPath()
+{
+    auto testName = UnitTest::GetInstance()->current_test_info()->name();
+    return (std::filesystem::temp_directory_path() / (std::string("sms-store-") + testName + "-"
+                                                      + std::to_string(::getpid()))).string();
+}
+
+}
+
+SmsStoreTestSuite::SmsStoreTestSuite()
+    : path(temporaryPath())
+{
+    std::remove(path.c_str());
+    objectUnderTest = std::make_unique<SmsStore>(path, loggerMock, options);
+}
+
+SmsStoreTestSuite::~SmsStoreTestSuite()
+{
+    objectUnderTest.reset();
+    std::remove(path.c_str());
+}
+
+void SmsStoreTestSuite::reopen()
+{
+    objectUnderTest.reset();
+    objectUnderTest = std::make_unique<SmsStore>(path, loggerMock, options);
+}
+
+Frame SmsStoreTestSuite::sms(PhoneNumber from, PhoneNumber to, const std::string& text)
+{
+    return schema::encode<MessageId::Sms>(from, to, {}, Frame::View(reinterpret_cast<const std::uint8_t*>(text.data()),
+                                                                    text.size()));
+}
+
+std::vector<Frame> SmsStoreTestSuite::take(PhoneNumber to, std::size_t maxCount)
+{
+    std::vector<Frame> messages;
+    auto stored = objectUnderTest->peek(to, maxCount);
+    for (auto& sms: stored)
+    {
+        messages.push_back(sms.message);
+    }
+    if (not stored.empty())
+    {
+        objectUnderTest->acknowledge(to, stored.back().sequence);
+    }
+    return messages;
+}
+
+TEST_F(SmsStoreTestSuite, shallNotStoreForNotSubscriber)
+{
+    ASSERT_FALSE(objectUnderTest->store(NOT_SUBSCRIBER, sms(SENDER, NOT_SUBSCRIBER, "hello")));
+    ASSERT_EQ(0u, objectUnderTest->countStored());
+}
+
+TEST_F(SmsStoreTestSuite, shallTakeStoredInOrder)
+{
+    objectUnderTest->addSubscriber(SUBSCRIBER);
+    objectUnderTest->addSubscriber(OTHER_SUBSCRIBER);
+    ASSERT_TRUE(objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, "first")));
+    ASSERT_TRUE(objectUnderTest->store(OTHER_SUBSCRIBER, sms(SENDER, OTHER_SUBSCRIBER, "other")));
+    ASSERT_TRUE(objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, "second")));
+    ASSERT_EQ(3u, objectUnderTest->countStored());
+
+    ASSERT_THAT(take(SUBSCRIBER, 1u), ElementsAre(sms(SENDER, SUBSCRIBER, "first")));
+    ASSERT_THAT(take(SUBSCRIBER, 10u), ElementsAre(sms(SENDER, SUBSCRIBER, "second")));
+    ASSERT_THAT(take(SUBSCRIBER, 10u), IsEmpty());
+    ASSERT_EQ(1u, objectUnderTest->countStored(OTHER_SUBSCRIBER));
+}
+
+TEST_F(SmsStoreTestSuite, shallKeepSmsTillAcknowledged)
+{
+    objectUnderTest->addSubscriber(SUBSCRIBER);
+    for (auto text: {"1", "2", "3"})
+    {
+        objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, text));
+    }
+    auto peeked = objectUnderTest->peek(SUBSCRIBER, 10u);
+    ASSERT_EQ(3u, peeked.size());
+    ASSERT_EQ(3u, objectUnderTest->peek(SUBSCRIBER, 10u).size());
+
+    objectUnderTest->acknowledge(SUBSCRIBER, peeked[0].sequence);
+    ASSERT_EQ(2u, objectUnderTest->countStored(SUBSCRIBER));
+    reopen();
+    ASSERT_THAT(take(SUBSCRIBER, 10u), ElementsAre(sms(SENDER, SUBSCRIBER, "2"), sms(SENDER, SUBSCRIBER, "3")));
+}
+
+TEST_F(SmsStoreTestSuite, shallKeepQuotaOfSubscriber)
+{
+    options.quota = 2u;
+    reopen();
+    objectUnderTest->addSubscriber(SUBSCRIBER);
+    objectUnderTest->addSubscriber(OTHER_SUBSCRIBER);
+    ASSERT_TRUE(objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, "1")));
+    ASSERT_TRUE(objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, "2")));
+    ASSERT_FALSE(objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, "3")));
+    ASSERT_TRUE(objectUnderTest->store(OTHER_SUBSCRIBER, sms(SENDER, OTHER_SUBSCRIBER, "1")));
+
+    take(SUBSCRIBER, 1u);
+    ASSERT_TRUE(objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, "3")));
+}
+
+TEST_F(SmsStoreTestSuite, shallRecoverAfterRestart)
+{
+    objectUnderTest->addSubscriber(SUBSCRIBER);
+    objectUnderTest->addSubscriber(OTHER_SUBSCRIBER);
+    for (auto text: {"1", "2", "3"})
+    {
+        objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, text));
+    }
+    take(SUBSCRIBER, 2u);
+
+    reopen();
+    ASSERT_EQ(2u, objectUnderTest->countSubscribers());
+    ASSERT_EQ(1u, objectUnderTest->countStored());
+    ASSERT_TRUE(objectUnderTest->store(OTHER_SUBSCRIBER, sms(SENDER, OTHER_SUBSCRIBER, "4")));
+    ASSERT_THAT(take(SUBSCRIBER, 10u), ElementsAre(sms(SENDER, SUBSCRIBER, "3")));
+
+    reopen();
+    ASSERT_EQ(0u, objectUnderTest->countStored(SUBSCRIBER));
+    ASSERT_THAT(take(OTHER_SUBSCRIBER, 10u), ElementsAre(sms(SENDER, OTHER_SUBSCRIBER, "4")));
+}
+
+TEST_F(SmsStoreTestSuite, shallRecoverGrownLog)
+{
+    options.quota = 100000u;
+    reopen();
+    objectUnderTest->addSubscriber(SUBSCRIBER);
+    const std::string text(1000u, 'x');
+    for (std::size_t i = 0u; i < 5000u; ++i)
+    {
+        ASSERT_TRUE(objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, text)));
+    }
+    reopen();
+    ASSERT_EQ(5000u, objectUnderTest->countStored());
+    ASSERT_THAT(take(SUBSCRIBER, 1u), ElementsAre(sms(SENDER, SUBSCRIBER, text)));
+}
+
+TEST_F(SmsStoreTestSuite, shallDropTornRecordAtEnd)
+{
+    objectUnderTest->addSubscriber(SUBSCRIBER);
+    objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, "1"));
+    auto tornRecord = objectUnderTest->getLogSize();
+    objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, "2"));
+    objectUnderTest.reset();
+    {
+        // size not matching the payload
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(tornRecord);
+        std::uint32_t size = 8u;
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    }
+
+    reopen();
+    ASSERT_EQ(1u, objectUnderTest->countStored());
+    ASSERT_TRUE(objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, "3")));
+    reopen();
+    ASSERT_THAT(take(SUBSCRIBER, 10u),
+                ElementsAre(sms(SENDER, SUBSCRIBER, "1"), sms(SENDER, SUBSCRIBER, "3")));
+}
+
+TEST_F(SmsStoreTestSuite, shallRejectFileOtherThanSmsStore)
+{
+    objectUnderTest.reset();
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << "not SMS store";
+    }
+    ASSERT_THROW(reopen(), std::runtime_error);
+}
+
+TEST_F(SmsStoreTestSuite, shallCompactKeepingNotTaken)
+{
+    options.quota = 1000u;
+    reopen();
+    objectUnderTest->addSubscriber(SUBSCRIBER);
+    objectUnderTest->addSubscriber(OTHER_SUBSCRIBER);
+    for (std::size_t i = 0u; i < 1000u; ++i)
+    {
+        objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, std::to_string(i)));
+    }
+    objectUnderTest->store(OTHER_SUBSCRIBER, sms(SENDER, OTHER_SUBSCRIBER, "other"));
+    take(SUBSCRIBER, 999u);
+    auto logSize = objectUnderTest->getLogSize();
+
+    objectUnderTest->compact();
+    ASSERT_LT(objectUnderTest->getLogSize(), logSize / 10u);
+    ASSERT_TRUE(objectUnderTest->store(OTHER_SUBSCRIBER, sms(SENDER, OTHER_SUBSCRIBER, "after")));
+
+    reopen();
+    ASSERT_EQ(2u, objectUnderTest->countSubscribers());
+    ASSERT_THAT(take(SUBSCRIBER, 10u), ElementsAre(sms(SENDER, SUBSCRIBER, "999")));
+    ASSERT_THAT(take(OTHER_SUBSCRIBER, 10u),
+                ElementsAre(sms(SENDER, OTHER_SUBSCRIBER, "other"), sms(SENDER, OTHER_SUBSCRIBER, "after")));
+}
+
+TEST_F(SmsStoreTestSuite, shallCompactInBackground)
+{
+    options.quota = 1000u;
+    options.compactionThreshold = 1024u;
+    reopen();
+    objectUnderTest->addSubscriber(SUBSCRIBER);
+    for (std::size_t i = 0u; i < 1000u; ++i)
+    {
+        objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, std::to_string(i)));
+    }
+    take(SUBSCRIBER, 1000u);
+    auto logSize = objectUnderTest->getLogSize();
+    for (int wait = 0; wait < 500 and objectUnderTest->getLogSize() >= logSize; ++wait)
+    {
+        std::this_thread::sleep_for(10ms);
+    }
+    ASSERT_LT(objectUnderTest->getLogSize(), logSize);
+}
+
+TEST_F(SmsStoreTestSuite, shallKeepSmsStoredAndTakenWhileCompacting)
+{
+    options.quota = 10000u;
+    reopen();
+    objectUnderTest->addSubscriber(SUBSCRIBER);
+    std::atomic<bool> done{false};
+    std::thread compacting([&]
+    {
+        while (not done)
+        {
+            objectUnderTest->compact();
+        }
+    });
+    std::size_t expectedFirst = 0u;
+    for (std::size_t i = 0u; i < 4000u; ++i)
+    {
+        objectUnderTest->store(SUBSCRIBER, sms(SENDER, SUBSCRIBER, std::to_string(i)));
+        if (i % 2u == 1u)
+        {
+            ASSERT_THAT(take(SUBSCRIBER, 1u),
+                        ElementsAre(sms(SENDER, SUBSCRIBER, std::to_string(expectedFirst++))));
+        }
+    }
+    done = true;
+    compacting.join();
+
+    reopen();
+    ASSERT_EQ(2000u, objectUnderTest->countStored());
+    ASSERT_THAT(take(SUBSCRIBER, 1u),
+                ElementsAre(sms(SENDER, SUBSCRIBER, std::to_string(expectedFirst))));
+}
+
+namespace
+{
+
+class LoopbackTransport : public ITransport
+{
+public:
+    LoopbackTransport(std::size_t accepted = std::numeric_limits<std::size_t>::max()) : accepted(accepted) {}
+
+    void registerMessageCallback(MessageCallback callback) override { messageCallback = std::move(callback); }
+    void registerDisconnectedCallback(DisconnectedCallback callback) override { disconnectedCallback = std::move(callback); }
+    bool sendMessage(Frame message) override
+    {
+        if (received.size() == accepted)
+        {
+            return false;
+        }
+        received.push_back(std::move(message));
+        return true;
+    }
+    bool isCongested() const override { return false; }
+    std::string addressToString() const override { return "ue"; }
+
+    void receive(Frame message) { messageCallback(std::move(message)); }
+    void disconnect()
+    {
+        // connection unregisters its callbacks when destroyed by this call
+        auto callback = disconnectedCallback;
+        callback();
+    }
+
+    std::vector<Frame> received;
+
+private:
+    // messages - then send fails, as on overflow
+    const std::size_t accepted;
+    MessageCallback messageCallback;
+    DisconnectedCallback disconnectedCallback;
+};
+
+}
+
+class UeConnectionSmsStoreTestSuite : public SmsStoreTestSuite
+{
+protected:
+    std::shared_ptr<LoopbackTransport> connect(PhoneNumber phoneNumber,
+                                               std::shared_ptr<LoopbackTransport> transport = std::make_shared<LoopbackTransport>())
+    {
+        attach(transport, schema::encode<MessageId::AttachRequest>(phoneNumber, PhoneNumber{}, {common::BtsId{1}}));
+        return transport;
+    }
+    // old UE - AttachRequest with narrow header
+    std::shared_ptr<LoopbackTransport> connectNarrow(PhoneNumber phoneNumber)
+    {
+        auto transport = std::make_shared<LoopbackTransport>();
+        const std::vector<std::uint8_t> attachRequest{common::get(MessageId::AttachRequest),
+                                                      static_cast<std::uint8_t>(phoneNumber.value), 0, 0, 0, 0, 1};
+        attach(transport, Frame::copyOf(Frame::View(attachRequest)));
+        return transport;
+    }
+    void attach(const std::shared_ptr<LoopbackTransport>& transport, Frame attachRequest)
+    {
+        auto ue = std::make_unique<UeConnection>(transport, loggerMock, syncGuard, metricsRegistry, nullptr, smsStore);
+        auto& ueRef = *ue;
+        ueRef.start(ueRelay.add(std::move(ue)));
+        transport->receive(std::move(attachRequest));
+    }
+
+    std::vector<MessageId> receivedIds(LoopbackTransport& transport)
+    {
+        std::vector<MessageId> ids;
+        for (auto& message: transport.received)
+        {
+            ids.push_back(schema::decodeHeader(message.view()).messageId);
+        }
+        return ids;
+    }
+
+    std::shared_ptr<SmsStore> smsStore{std::move(objectUnderTest)};
+    common::MetricsRegistry metricsRegistry;
+    SyncGuardPtr syncGuard = std::make_shared<SyncGuard>();
+    UeRelay ueRelay{loggerMock};
+};
+
+TEST_F(UeConnectionSmsStoreTestSuite, shallDeliverSmsStoredWhileSubscriberOffline)
+{
+    auto sender = connect(SENDER);
+    connect(SUBSCRIBER)->disconnect();
+
+    sender->receive(sms(SENDER, SUBSCRIBER, "are you there?"));
+    ASSERT_THAT(receivedIds(*sender), Not(Contains(MessageId::UnknownRecipient)));
+    ASSERT_EQ(1u, smsStore->countStored(SUBSCRIBER));
+
+    auto subscriber = connect(SUBSCRIBER);
+    ASSERT_THAT(receivedIds(*subscriber), ElementsAre(MessageId::AttachResponse, MessageId::Sms));
+    ASSERT_EQ(subscriber->received.back(), sms(SENDER, SUBSCRIBER, "are you there?"));
+    ASSERT_EQ(0u, smsStore->countStored());
+}
+
+TEST_F(UeConnectionSmsStoreTestSuite, shallSendUnknownRecipientForNotSubscriber)
+{
+    auto sender = connect(SENDER);
+    sender->receive(sms(SENDER, NOT_SUBSCRIBER, "hello?"));
+    ASSERT_THAT(receivedIds(*sender), Contains(MessageId::UnknownRecipient));
+    ASSERT_EQ(0u, smsStore->countStored());
+}
+
+TEST_F(UeConnectionSmsStoreTestSuite, shallDeliverStoredSmsInBatches)
+{
+    const std::size_t numberOfSms = 3u * UeConnection::SMS_DELIVERY_BATCH + 1u;
+    ASSERT_LE(numberOfSms, options.quota);
+    auto sender = connect(SENDER);
+    connect(SUBSCRIBER)->disconnect();
+    for (std::size_t i = 0u; i < numberOfSms; ++i)
+    {
+        sender->receive(sms(SENDER, SUBSCRIBER, std::to_string(i)));
+    }
+
+    auto subscriber = connect(SUBSCRIBER);
+    ASSERT_EQ(numberOfSms + 1u, subscriber->received.size());
+    ASSERT_EQ(subscriber->received.back(), sms(SENDER, SUBSCRIBER, std::to_string(numberOfSms - 1u)));
+}
+
+TEST_F(UeConnectionSmsStoreTestSuite, shallKeepStoredSmsNotFittingNarrowHeader)
+{
+    auto sender = connect(SUBSCRIBER);
+    connectNarrow(OTHER_SUBSCRIBER)->disconnect();
+    sender->receive(sms(SUBSCRIBER, OTHER_SUBSCRIBER, "wide sender"));
+    ASSERT_EQ(1u, smsStore->countStored(OTHER_SUBSCRIBER));
+
+    auto subscriber = connectNarrow(OTHER_SUBSCRIBER);
+    ASSERT_EQ(1u, subscriber->received.size());
+    ASSERT_EQ(1u, smsStore->countStored(OTHER_SUBSCRIBER));
+}
+
+TEST_F(UeConnectionSmsStoreTestSuite, shallKeepStoredSmsNotAcceptedByTransport)
+{
+    auto sender = connect(SENDER);
+    connect(SUBSCRIBER)->disconnect();
+    for (std::size_t i = 0u; i < 5u; ++i)
+    {
+        sender->receive(sms(SENDER, SUBSCRIBER, std::to_string(i)));
+    }
+
+    // AttachResponse and 2 SMS
+    auto failing = connect(SUBSCRIBER, std::make_shared<LoopbackTransport>(3u));
+    ASSERT_EQ(3u, smsStore->countStored(SUBSCRIBER));
+    failing->disconnect();
+
+    auto subscriber = connect(SUBSCRIBER);
+    ASSERT_EQ(4u, subscriber->received.size());
+    ASSERT_EQ(subscriber->received[1], sms(SENDER, SUBSCRIBER, "2"));
+    ASSERT_EQ(0u, smsStore->countStored());
+}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "SmsStore/SmsStore.hpp"
+
+#include "Mocks/ILoggerMock.hpp"
+
+namespace bts
+{
+
+class SmsStoreTestSuite : public ::testing::Test
+{
+protected:
+    SmsStoreTestSuite();
+    ~SmsStoreTestSuite() override;
+
+    // as after BTS restart
+    void reopen();
+    static Frame sms(PhoneNumber from, PhoneNumber to, const std::string& text);
+    // peeked and acknowledged
+    std::vector<Frame> take(PhoneNumber to, std::size_t maxCount);
+
+    const PhoneNumber SENDER{100};
+    const PhoneNumber SUBSCRIBER{70000};
+    const PhoneNumber OTHER_SUBSCRIBER{101};
+    const PhoneNumber NOT_SUBSCRIBER{102};
+
+    const std::string path;
+    SmsStore::Options options{};
+    ::testing::NiceMock<common::ILoggerMock> loggerMock;
+    std::unique_ptr<SmsStore> objectUnderTest;
+};
+
+}
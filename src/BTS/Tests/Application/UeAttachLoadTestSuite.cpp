@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "UeConnection/UeConnection.hpp"
+#include "UeRelay/UeRelay.hpp"
+#include "Messages/MessageSchema.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+namespace schema = common::schema;
+using common::MessageId;
+
+namespace
+{
+
+class DisabledLogger : public common::ILogger
+{
+public:
+    void log(Level, const std::string&) override {}
+    bool isEnabled(Level) const override { return false; }
+};
+
+class LoopbackTransport : public ITransport
+{
+public:
+    explicit LoopbackTransport(std::size_t index) : index(index) {}
+
+    void registerMessageCallback(MessageCallback callback) override { messageCallback = std::move(callback); }
+    void registerDisconnectedCallback(DisconnectedCallback callback) override { disconnectedCallback = std::move(callback); }
+    bool sendMessage(Frame message) override
+    {
+        received.push_back(std::move(message));
+        return true;
+    }
+    bool isCongested() const override { return false; }
+    std::string addressToString() const override { return "ue-" + std::to_string(index); }
+
+    void receive(Frame message)
+    {
+        messageCallback(std::move(message));
+    }
+    void disconnect()
+    {
+        // connection unregisters its callbacks when destroyed by this call
+        auto callback = disconnectedCallback;
+        callback();
+    }
+
+    std::vector<Frame> received;
+
+private:
+    std::size_t index;
+    MessageCallback messageCallback;
+    DisconnectedCallback disconnectedCallback;
+};
+
+}
+
+/**
+ * Whole BTS side of many UEs - far more than 1 byte phone numbers could address
+ */
+class UeAttachLoadTestSuite : public Test
+{
+protected:
+    static constexpr std::size_t NUMBER_OF_UE = 100000u;
+    const PhoneNumber FIRST_PHONE{1000};
+    const BtsId BTS_ID{17};
+
+    DisabledLogger logger;
+    common::MetricsRegistry metricsRegistry;
+    SyncGuardPtr syncGuard = std::make_shared<SyncGuard>();
+    std::vector<std::shared_ptr<LoopbackTransport>> transports;
+    UeRelay relay{logger};
+
+    PhoneNumber phoneOf(std::size_t index) const
+    {
+        return PhoneNumber{static_cast<PhoneNumber::Value>(FIRST_PHONE.value + index)};
+    }
+
+    void connectAll()
+    {
+        transports.reserve(NUMBER_OF_UE);
+        for (std::size_t i = 0u; i < NUMBER_OF_UE; ++i)
+        {
+            transports.push_back(std::make_shared<LoopbackTransport>(i));
+            auto ue = std::make_unique<UeConnection>(transports.back(), logger, syncGuard, metricsRegistry);
+            auto& connection = *ue;
+            connection.start(relay.add(std::move(ue)));
+            connection.sendSib(BTS_ID, std::nullopt);
+        }
+    }
+};
+
+TEST_F(UeAttachLoadTestSuite, shallAttachHundredThousandUe)
+{
+    connectAll();
+    for (std::size_t i = 0u; i < NUMBER_OF_UE; ++i)
+    {
+        transports[i]->receive(schema::encode<MessageId::AttachRequest>(phoneOf(i), PhoneNumber{}, {BTS_ID}));
+    }
+    ASSERT_EQ(NUMBER_OF_UE, relay.countAttached());
+    ASSERT_EQ(0u, relay.countNotAttached());
+
+    for (std::size_t i = 0u; i < NUMBER_OF_UE; ++i)
+    {
+        auto& received = transports[i]->received;
+        ASSERT_EQ(2u, received.size());
+        ASSERT_TRUE(schema::decode<MessageId::AttachResponse>(received[1].view()).get<0>()) << phoneOf(i);
+        received.clear();
+    }
+
+    for (std::size_t i = 0u; i < NUMBER_OF_UE; ++i)
+    {
+        transports[i]->receive(schema::encode<MessageId::Sms>(phoneOf(i), phoneOf((i + 1u) % NUMBER_OF_UE)));
+    }
+    for (std::size_t i = 0u; i < NUMBER_OF_UE; ++i)
+    {
+        auto& received = transports[(i + 1u) % NUMBER_OF_UE]->received;
+        ASSERT_EQ(1u, received.size());
+        ASSERT_EQ(phoneOf(i), schema::decodeHeader(received[0].view()).from);
+    }
+
+    for (auto& transport: transports)
+    {
+        transport->disconnect();
+    }
+    ASSERT_EQ(0u, relay.count());
+}
+
+}
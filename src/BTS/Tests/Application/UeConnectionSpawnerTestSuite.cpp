@@ -74,7 +74,8 @@ void UeConnectionStartedSpawnerTestSuite::expectUeAddedToRelay()
 
 void UeConnectionStartedSpawnerTestSuite::expectSibSent()
 {
-    EXPECT_CALL(*ueConnectionMock, sendSib(BTS_ID));
+    EXPECT_CALL(*ueRelayMock, getLoad()).WillOnce(Return(LOAD));
+    EXPECT_CALL(*ueConnectionMock, sendSib(BTS_ID, Optional(LOAD)));
 }
 
 void UeConnectionStartedSpawnerTestSuite::onNewConnectionCallback()
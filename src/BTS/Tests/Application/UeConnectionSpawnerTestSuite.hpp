@@ -23,6 +23,7 @@ protected:
 
     SyncGuardPtr syncGuard;
     const BtsId BTS_ID{17};
+    const CellLoad LOAD{42u};
 
     ::testing::StrictMock<IApplicationEnvironmentMock> environmentMock;
     ::testing::NiceMock<common::ILoggerMock> loggerMock;
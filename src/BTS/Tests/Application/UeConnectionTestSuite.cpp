@@ -1,6 +1,7 @@
 #include "UeConnectionTestSuite.hpp"
 #include "Messages/IncomingMessage.hpp"
 #include "Messages/OutgoingMessage.hpp"
+#include "Messages/MessageSchema.hpp"
 #include "Mocks/UeSlotMock.hpp"
 
 using namespace ::testing;
@@ -55,7 +56,7 @@ UeConnectionTestSuite::UeConnectionTestSuite()
     ueSlotReattachedMock = std::make_shared<StrictMock<IUeSlotImplMock>>();
     syncGuard = std::make_shared<SyncGuard>();
     transportMock = std::make_shared<StrictMock<common::ITransportMock>>();
-    objectUnderTest = std::make_unique<UeConnection>(transportMock, loggerMock, syncGuard);
+    objectUnderTest = std::make_unique<UeConnection>(transportMock, loggerMock, syncGuard, metricsRegistry);
     verifyAndClearExpectations();
 }
 
@@ -65,19 +66,23 @@ UeConnectionTestSuite::~UeConnectionTestSuite()
 void UeConnectionTestSuite::SetUp()
 {
     EXPECT_CALL(*transportMock, addressToString()).WillRepeatedly(Return(TRANSPORT_ADDRESS));
-    EXPECT_CALL(*ueSlotNotAttachedMock, isAttached()).WillRepeatedly(Return(false));
-    EXPECT_CALL(*ueSlotFailedAttachedMock, isAttached()).WillRepeatedly(Return(false));
-    EXPECT_CALL(*ueSlotAttachedMock, isAttached()).WillRepeatedly(Return(true));
-    EXPECT_CALL(*ueSlotReattachedMock, isAttached()).WillRepeatedly(Return(true));
+    EXPECT_CALL(*ueSlotNotAttachedMock, isAttached(_)).WillRepeatedly(Return(false));
+    EXPECT_CALL(*ueSlotFailedAttachedMock, isAttached(_)).WillRepeatedly(Return(false));
+    EXPECT_CALL(*ueSlotAttachedMock, isAttached(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*ueSlotReattachedMock, isAttached(_)).WillRepeatedly(Return(true));
 
-    EXPECT_CALL(*ueSlotNotAttachedMock, getPhoneNumber()).WillRepeatedly(Return(PhoneNumber{}));
-    EXPECT_CALL(*ueSlotFailedAttachedMock, getPhoneNumber()).WillRepeatedly(Return(PhoneNumber{}));
-    EXPECT_CALL(*ueSlotAttachedMock, getPhoneNumber()).WillRepeatedly(Return(PHONE));
-    EXPECT_CALL(*ueSlotReattachedMock, getPhoneNumber()).WillRepeatedly(Return(OTHER_PHONE));
+    EXPECT_CALL(*ueSlotNotAttachedMock, getPhoneNumber(_)).WillRepeatedly(Return(PhoneNumber{}));
+    EXPECT_CALL(*ueSlotFailedAttachedMock, getPhoneNumber(_)).WillRepeatedly(Return(PhoneNumber{}));
+    EXPECT_CALL(*ueSlotAttachedMock, getPhoneNumber(_)).WillRepeatedly(Return(PHONE));
+    EXPECT_CALL(*ueSlotReattachedMock, getPhoneNumber(_)).WillRepeatedly(Return(OTHER_PHONE));
 }
 
 void UeConnectionTestSuite::assertDestruction()
 {
+    if (not objectUnderTest)
+    {
+        return;
+    }
     expectRegisterCallbacks();
     objectUnderTest.reset();
     ASSERT_FALSE(ueDisconnectedCallback);
@@ -103,23 +108,57 @@ void UeConnectionTestSuite::verifyAndClearExpectations()
     Mock::VerifyAndClearExpectations(&loggerMock);
 }
 
+std::string UeConnectionTestSuite::metricsText() const
+{
+    std::ostringstream os;
+    metricsRegistry.write(os, common::MetricsRegistry::Format::Prometheus);
+    return os.str();
+}
+
 TEST_F(UeConnectionTestSuite, shallSendMessage)
 {
     BinaryMessage EXPECTED_MESSAGE = { {1,2,3,4,5,6} };
-    auto matchMessage = Field(&BinaryMessage::value,
-                              ContainerEq(EXPECTED_MESSAGE.value));
+    auto matchMessage = ElementsAreArray(EXPECTED_MESSAGE.value);
 
     EXPECT_CALL(*transportMock, sendMessage(matchMessage));
 
     objectUnderTest->sendMessage(EXPECTED_MESSAGE);
 }
 
-TEST_F(UeConnectionTestSuite, shallSendSibWithBtsId)
+TEST_F(UeConnectionTestSuite, shallSendSibWithBtsIdInNarrowHeader)
 {
-    auto EqSib = AllOf(EqMessageHeader(0, MessageId::Sib, NO_PHONE, NO_PHONE),
-                       EqMessageBtsId(HEADER_SIZE, BTS_ID));
-    EXPECT_CALL(*transportMock, sendMessage(EqSib));
-    objectUnderTest->sendSib(BTS_ID);
+    // UE might be old one - till it sends anything
+    EXPECT_CALL(*transportMock, isCongested()).WillOnce(Return(false));
+    EXPECT_CALL(*transportMock, sendMessage(ElementsAre(common::get(MessageId::Sib), 0, 0, 0, 0, 0, BTS_ID.value)));
+    objectUnderTest->sendSib(BTS_ID, std::nullopt);
+}
+
+TEST_F(UeConnectionTestSuite, shallSendSibWithLoadInNarrowHeader)
+{
+    // old UE ignore what follows BtsId
+    EXPECT_CALL(*transportMock, isCongested()).WillOnce(Return(false));
+    EXPECT_CALL(*transportMock, sendMessage(ElementsAre(common::get(MessageId::Sib), 0, 0, 0, 0, 0, BTS_ID.value, 42u)));
+    objectUnderTest->sendSib(BTS_ID, CellLoad{42u});
+}
+
+TEST_F(UeConnectionTestSuite, shallSendSibEncodedOnce)
+{
+    std::vector<Frame> sent;
+    EXPECT_CALL(*transportMock, isCongested()).Times(2).WillRepeatedly(Return(false));
+    EXPECT_CALL(*transportMock, sendMessage(_)).Times(2).WillRepeatedly(DoAll(
+        Invoke([&sent](Frame frame) { sent.push_back(frame); }), Return(true)));
+
+    objectUnderTest->sendSib(BTS_ID, std::nullopt);
+    objectUnderTest->sendSib(BTS_ID, std::nullopt);
+
+    ASSERT_EQ(2u, sent.size());
+    ASSERT_EQ(sent[0].data(), sent[1].data());
+}
+
+TEST_F(UeConnectionTestSuite, shallNotSendSibToCongestedUe)
+{
+    EXPECT_CALL(*transportMock, isCongested()).WillOnce(Return(true));
+    objectUnderTest->sendSib(BTS_ID, std::nullopt);
 }
 
 
@@ -132,6 +171,7 @@ TEST_F(UeConnectionTestSuite, shallConnectToTransportOnStart)
 UeConnectionWithConnectedTransportTestSuite::UeConnectionWithConnectedTransportTestSuite()
 {
     expectRegisterCallbacks();
+    EXPECT_CALL(*transportMock, addressToString()).WillRepeatedly(Return(TRANSPORT_ADDRESS));
     objectUnderTest->start(UeSlot(ueSlotNotAttachedMock));
     verifyAndClearExpectations();
 }
@@ -181,7 +221,7 @@ BinaryMessage UeConnectionWithConnectedTransportTestSuite::buildOtherThanAttachR
 TEST_F(UeConnectionWithConnectedTransportTestSuite, shallAcceptAttachOnRequestFromUe)
 {
     InSequence seq;
-    EXPECT_CALL(*ueSlotNotAttachedMock, attach(PHONE)).WillOnce(Return(ueSlotAttachedMock));
+    EXPECT_CALL(*ueSlotNotAttachedMock, attach(_, PHONE)).WillOnce(Return(ueSlotAttachedMock));
     EXPECT_CALL(*transportMock, sendMessage(eqAttachResponseMessage(true)));
 
     handleAttachRequest(PHONE);
@@ -202,7 +242,7 @@ TEST_F(UeConnectionWithConnectedTransportTestSuite, shallRejectAttachOnRequestFr
 
 TEST_F(UeConnectionWithConnectedTransportTestSuite, shallHandleExceptionWhenAttaching)
 {
-    EXPECT_CALL(*ueSlotNotAttachedMock, attach(PHONE)).WillOnce(Throw(std::runtime_error("..it happens")));
+    EXPECT_CALL(*ueSlotNotAttachedMock, attach(_, PHONE)).WillOnce(Throw(std::runtime_error("..it happens")));
     handleAttachRequest(PHONE);
 }
 
@@ -215,6 +255,108 @@ TEST_F(UeConnectionWithConnectedTransportTestSuite, shallIndicateUnknownSenderFo
     ueMessageCallback(otherThanAttachRequestMessage);
 }
 
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallCountMessagesAndAttachResults)
+{
+    EXPECT_CALL(*ueSlotNotAttachedMock, attach(_, PHONE)).WillOnce(Return(ueSlotFailedAttachedMock));
+    EXPECT_CALL(*transportMock, sendMessage(_)).Times(2).WillRepeatedly(Return(true));
+    handleAttachRequest(NO_PHONE);
+    handleAttachRequest(PHONE);
+
+    ASSERT_THAT(metricsText(), AllOf(
+                    HasSubstr("bts_ue_messages_received_total{ue=\"CDEF\"} 2\n"),
+                    HasSubstr("bts_ue_messages_sent_total{ue=\"CDEF\"} 2\n"),
+                    HasSubstr("bts_attach_rejected_total 2\n"),
+                    HasSubstr("bts_attach_accepted_total 0\n"),
+                    HasSubstr("bts_ue_connections 1\n")));
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallCountUnknownSender)
+{
+    EXPECT_CALL(*transportMock, sendMessage(_));
+    ueMessageCallback(buildOtherThanAttachRequestMessage());
+
+    ASSERT_THAT(metricsText(), HasSubstr("bts_unknown_sender_total 1\n"));
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallCountMessagesNotSent)
+{
+    EXPECT_CALL(*transportMock, sendMessage(_)).WillOnce(Return(false));
+    objectUnderTest->sendMessage(BinaryMessage{{1, 2, 3}});
+
+    ASSERT_THAT(metricsText(), AllOf(
+                    HasSubstr("bts_ue_messages_not_sent_total{ue=\"CDEF\"} 1\n"),
+                    HasSubstr("bts_ue_messages_sent_total{ue=\"CDEF\"} 0\n")));
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallCountMessageNotDecoded)
+{
+    ueMessageCallback(BinaryMessage{{1, 2}});
+
+    ASSERT_THAT(metricsText(), HasSubstr("bts_decode_errors_total 1\n"));
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallKeepCountersOfDestroyedConnection)
+{
+    EXPECT_CALL(*transportMock, sendMessage(_));
+    ueMessageCallback(buildOtherThanAttachRequestMessage());
+    assertDestruction();
+
+    ASSERT_THAT(metricsText(), AllOf(
+                    HasSubstr("bts_ue_messages_received_total{ue=\"closed\"} 1\n"),
+                    Not(HasSubstr(TRANSPORT_ADDRESS)),
+                    HasSubstr("bts_unknown_sender_total 1\n"),
+                    HasSubstr("bts_ue_connections 0\n")));
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallAnswerInNarrowHeaderAttachRequestWithNarrowHeader)
+{
+    const auto phone = static_cast<std::uint8_t>(PHONE.value);
+    const BinaryMessage narrowAttachRequest{{common::get(MessageId::AttachRequest), phone, 0, 0, 0, 0,
+                                             static_cast<std::uint8_t>(BTS_ID.value)}};
+    InSequence seq;
+    EXPECT_CALL(*ueSlotNotAttachedMock, attach(_, PHONE)).WillOnce(Return(ueSlotAttachedMock));
+    EXPECT_CALL(*transportMock, sendMessage(ElementsAre(common::get(MessageId::AttachResponse), 0, phone, 1)));
+
+    ueMessageCallback(narrowAttachRequest);
+    ASSERT_TRUE(objectUnderTest->isAttached());
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallKeepNarrowHeaderNegotiatedByAttachRequest)
+{
+    const auto phone = static_cast<std::uint8_t>(PHONE.value);
+    const auto otherPhone = static_cast<std::uint8_t>(OTHER_PHONE.value);
+    const BinaryMessage narrowAttachRequest{{common::get(MessageId::AttachRequest), phone, 0, 0, 0, 0,
+                                             static_cast<std::uint8_t>(BTS_ID.value)}};
+    EXPECT_CALL(*ueSlotNotAttachedMock, attach(_, PHONE)).WillOnce(Return(ueSlotAttachedMock));
+    EXPECT_CALL(*transportMock, sendMessage(_)).WillOnce(Return(true));
+    ueMessageCallback(narrowAttachRequest);
+
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(_, _, OTHER_PHONE)).WillOnce(Return(false));
+    EXPECT_CALL(*transportMock, sendMessage(ElementsAre(common::get(MessageId::UnknownRecipient), 0, phone,
+                                                        common::get(MessageId::Sms), phone, otherPhone)));
+    ueMessageCallback(common::schema::encode<MessageId::Sms>(PHONE, OTHER_PHONE));
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallRejectNarrowHeaderMessageTooLongToWiden)
+{
+    const auto phone = static_cast<std::uint8_t>(PHONE.value);
+    std::vector<std::uint8_t> tooLong(BinaryMessage::MAX_SIZE, 'x');
+    tooLong[0] = common::get(MessageId::Sms);
+    tooLong[1] = phone;
+    tooLong[2] = phone;
+    EXPECT_CALL(*transportMock, sendMessage(ElementsAre(common::get(MessageId::UnknownRecipient), _, _,
+                                                        common::get(MessageId::Sms), phone, phone)));
+
+    ueMessageCallback(common::Frame::copyOf(common::Frame::View(tooLong)));
+    ASSERT_THAT(metricsText(), HasSubstr("bts_decode_errors_total 1\n"));
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallNotSendWideNumberToUeWithNarrowHeader)
+{
+    const PhoneNumber WIDE_PHONE{70000};
+    objectUnderTest->sendMessage(common::schema::encode<MessageId::Sms>(WIDE_PHONE, PHONE));
+}
+
 TEST_F(UeConnectionWithConnectedTransportTestSuite, shallPrintAsNotAttached)
 {
     std::ostringstream os;
@@ -229,7 +371,7 @@ TEST_F(UeConnectionWithConnectedTransportTestSuite, shallPrintAsNotAttached)
 UeConnectionAttachedTestSuite::UeConnectionAttachedTestSuite()
 {
     UeConnectionWithConnectedTransportTestSuite::SetUp();
-    EXPECT_CALL(*ueSlotNotAttachedMock, attach(PHONE)).WillOnce(Return(ueSlotAttachedMock));
+    EXPECT_CALL(*ueSlotNotAttachedMock, attach(_, PHONE)).WillOnce(Return(ueSlotAttachedMock));
     EXPECT_CALL(*transportMock, sendMessage(eqAttachResponseMessage(true)));
     handleAttachRequest(PHONE);
     verifyAndClearExpectations();
@@ -237,19 +379,19 @@ UeConnectionAttachedTestSuite::UeConnectionAttachedTestSuite()
 
 TEST_F(UeConnectionAttachedTestSuite, shallCloseConnectionOnDisconnect)
 {
-    EXPECT_CALL(*ueSlotAttachedMock, remove());
+    EXPECT_CALL(*ueSlotAttachedMock, remove(_));
     handleDisconnect();
 }
 
 TEST_F(UeConnectionAttachedTestSuite, shallHandleExceptionWhenClosing)
 {
-    EXPECT_CALL(*ueSlotAttachedMock, remove()).WillOnce(Throw(std::runtime_error("..it happens")));
+    EXPECT_CALL(*ueSlotAttachedMock, remove(_)).WillOnce(Throw(std::runtime_error("..it happens")));
     handleDisconnect();
 }
 
 TEST_F(UeConnectionAttachedTestSuite, shallReattachOnRequestWithNewPhone)
 {
-    EXPECT_CALL(*ueSlotAttachedMock, attach(OTHER_PHONE)).WillOnce(Return(ueSlotReattachedMock));
+    EXPECT_CALL(*ueSlotAttachedMock, attach(_, OTHER_PHONE)).WillOnce(Return(ueSlotReattachedMock));
     EXPECT_CALL(*transportMock, sendMessage(eqAttachResponseMessage(true, OTHER_PHONE)));
 
     handleAttachRequest(OTHER_PHONE);
@@ -260,7 +402,7 @@ TEST_F(UeConnectionAttachedTestSuite, shallReattachOnRequestWithNewPhone)
 
 TEST_F(UeConnectionAttachedTestSuite, shallFailReattachOnRequestWithNewPhoneIfSlotDoesNotSucceedToReAttach)
 {
-    EXPECT_CALL(*ueSlotAttachedMock, attach(OTHER_PHONE)).WillOnce(Return(ueSlotFailedAttachedMock));
+    EXPECT_CALL(*ueSlotAttachedMock, attach(_, OTHER_PHONE)).WillOnce(Return(ueSlotFailedAttachedMock));
     EXPECT_CALL(*transportMock, sendMessage(eqAttachResponseMessage(false, OTHER_PHONE)));
 
     handleAttachRequest(OTHER_PHONE);
@@ -280,8 +422,16 @@ TEST_F(UeConnectionAttachedTestSuite, shallStayAttachedOnRequestWithSamePhone)
 TEST_F(UeConnectionAttachedTestSuite, shallForwardMessage)
 {
     auto otherThanAttachRequestMessage = buildOtherThanAttachRequestMessage();
-    auto matchMessage = Field(&BinaryMessage::value, ContainerEq(otherThanAttachRequestMessage.value));
-    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(matchMessage, OTHER_PHONE))
+    auto matchMessage = ElementsAreArray(otherThanAttachRequestMessage.value);
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(_, matchMessage, OTHER_PHONE))
+            .WillOnce(Return(true));
+    ueMessageCallback(otherThanAttachRequestMessage);
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallForwardMessageWithoutCopyingIt)
+{
+    Frame otherThanAttachRequestMessage = buildOtherThanAttachRequestMessage();
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(_, Property(&Frame::data, otherThanAttachRequestMessage.data()), OTHER_PHONE))
             .WillOnce(Return(true));
     ueMessageCallback(otherThanAttachRequestMessage);
 }
@@ -289,9 +439,9 @@ TEST_F(UeConnectionAttachedTestSuite, shallForwardMessage)
 TEST_F(UeConnectionAttachedTestSuite, shallIndicateUnknownRecipientForMessageThatCannotBeForwarded)
 {
     auto otherThanAttachRequestMessage = buildOtherThanAttachRequestMessage();
-    auto matchMessage = Field(&BinaryMessage::value, otherThanAttachRequestMessage.value);
+    auto matchMessage = ElementsAreArray(otherThanAttachRequestMessage.value);
     InSequence seq;
-    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(matchMessage, OTHER_PHONE))
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(_, matchMessage, OTHER_PHONE))
             .WillOnce(Return(false));
 
     auto matchUnknownRecipientMessage = AllOf(EqMessageHeader(0, MessageId::UnknownRecipient, NO_PHONE, PHONE),
@@ -312,9 +462,9 @@ TEST_F(UeConnectionAttachedTestSuite, shallIndicateUnknownSenderForMessageThatHa
 TEST_F(UeConnectionAttachedTestSuite, shallHandleExceptionWhenHandlingMessage)
 {
     auto otherThanAttachRequestMessage = buildOtherThanAttachRequestMessage();
-    auto matchMessage = Field(&BinaryMessage::value, otherThanAttachRequestMessage.value);
+    auto matchMessage = ElementsAreArray(otherThanAttachRequestMessage.value);
     InSequence seq;
-    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(matchMessage, OTHER_PHONE))
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(_, matchMessage, OTHER_PHONE))
             .WillOnce(Throw(std::runtime_error("..it happens")));
     ueMessageCallback(otherThanAttachRequestMessage);
 }
@@ -330,4 +480,20 @@ TEST_F(UeConnectionAttachedTestSuite, shallPrintAsAttached)
                     ));
 }
 
+TEST_F(UeConnectionAttachedTestSuite, shallSendSibWithLoadToUeWithWideHeader)
+{
+    EXPECT_CALL(*transportMock, isCongested()).WillOnce(Return(false));
+    EXPECT_CALL(*transportMock, sendMessage(ElementsAre(common::get(MessageId::Sib) | common::schema::WIDE_HEADER_FLAG,
+                                                        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, BTS_ID.value, 42u)));
+    objectUnderTest->sendSib(BTS_ID, CellLoad{42u});
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallSendWideNumberToUeAttachedWithWideHeader)
+{
+    const PhoneNumber WIDE_PHONE{70000};
+    auto sms = common::schema::encode<MessageId::Sms>(WIDE_PHONE, PHONE);
+    EXPECT_CALL(*transportMock, sendMessage(ElementsAreArray(sms.value)));
+    objectUnderTest->sendMessage(sms);
+}
+
 }
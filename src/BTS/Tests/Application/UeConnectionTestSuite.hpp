@@ -25,6 +25,7 @@ protected:
 
     void expectRegisterCallbacks();
     void verifyAndClearExpectations();
+    std::string metricsText() const;
 
     SyncGuardPtr syncGuard;
     const BtsId BTS_ID{17};
@@ -45,6 +46,7 @@ protected:
     ITransport::MessageCallback ueMessageCallback;
     ITransport::DisconnectedCallback ueDisconnectedCallback;
 
+    common::MetricsRegistry metricsRegistry;
     std::unique_ptr<UeConnection> objectUnderTest;
 };
 
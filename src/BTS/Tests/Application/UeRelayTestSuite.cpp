@@ -1,4 +1,7 @@
 #include "UeRelayTestSuite.hpp"
+#include "UeRelay/UeRelay.hpp"
+#include "UeRelay/ShardedUeRelay.hpp"
+#include "UeRelay/FlatUeRelay.hpp"
 
 using namespace ::testing;
 
@@ -8,7 +11,7 @@ namespace bts
 
 UeRelayTestSuite::UeRelayTestSuite()
 {
-    objectUnderTest = std::make_unique<UeRelay>(loggerMock);
+    objectUnderTest = GetParam()(loggerMock);
     verifyAndClearExpectations();
 
     connectionAdded.add(*objectUnderTest);
@@ -44,7 +47,7 @@ void UeRelayTestSuite::expectAction(UeRelayTestSuite::ConnectionMock &connnectio
 
 IUeRelay::UeVisitor UeRelayTestSuite::getAction()
 {
-    return [this](IUeConnection& ue) { ue.sendSib(BTS_ID); };
+    return [this](IUeConnection& ue) { ue.sendSib(BTS_ID, std::nullopt); };
 }
 
 UeRelayTestSuite::ConnectionMock::ConnectionMock()
@@ -77,31 +80,31 @@ void UeRelayTestSuite::ConnectionMock::remove()
 
 void UeRelayTestSuite::ConnectionMock::expectSendMessage(const BinaryMessage& message)
 {
-    auto matchMessage = Field(&BinaryMessage::value, (message.value));
+    auto matchMessage = ElementsAreArray(message.value);
     EXPECT_CALL(*connectionMock, sendMessage(matchMessage));
 }
 
 void UeRelayTestSuite::ConnectionMock::expectSendSib(BtsId btsId)
 {
-    EXPECT_CALL(*connectionMock, sendSib(btsId));
+    EXPECT_CALL(*connectionMock, sendSib(btsId, _));
 }
 
-TEST_F(UeRelayTestSuite, shallNewlyAddedBeNotAttached)
+TEST_P(UeRelayTestSuite, shallNewlyAddedBeNotAttached)
 {
     ASSERT_FALSE(connectionAdded.connectionSlot.isAttached());
 }
 
-TEST_F(UeRelayTestSuite, shallAttachedBeReportedAsAttached)
+TEST_P(UeRelayTestSuite, shallAttachedBeReportedAsAttached)
 {
     ASSERT_TRUE(connectionAttached.connectionSlot.isAttached());
 }
 
-TEST_F(UeRelayTestSuite, shallReAttachedBeReportedAsAttached)
+TEST_P(UeRelayTestSuite, shallReAttachedBeReportedAsAttached)
 {
     ASSERT_TRUE(connectionReAttached.connectionSlot.isAttached());
 }
 
-TEST_F(UeRelayTestSuite, shallRemovedPhoneBeAvailableToUse)
+TEST_P(UeRelayTestSuite, shallRemovedPhoneBeAvailableToUse)
 {
     connectionAttached.connectionSlot.remove();
 
@@ -112,7 +115,7 @@ TEST_F(UeRelayTestSuite, shallRemovedPhoneBeAvailableToUse)
     ASSERT_TRUE(someNewConnection.connectionSlot.isAttached());
 }
 
-TEST_F(UeRelayTestSuite, shallAttachedPhoneBeUnavailableToUse)
+TEST_P(UeRelayTestSuite, shallAttachedPhoneBeUnavailableToUse)
 {
     ConnectionMock someNewConnection;
     someNewConnection.add(*objectUnderTest);
@@ -121,7 +124,7 @@ TEST_F(UeRelayTestSuite, shallAttachedPhoneBeUnavailableToUse)
     ASSERT_FALSE(someNewConnection.connectionSlot.isAttached());
 }
 
-TEST_F(UeRelayTestSuite, shallReAttachedToAttachedPhoneCauseDeattaching)
+TEST_P(UeRelayTestSuite, shallReAttachedToAttachedPhoneCauseDeattaching)
 {
     ConnectionMock someNewConnection;
     someNewConnection.add(*objectUnderTest);
@@ -131,49 +134,95 @@ TEST_F(UeRelayTestSuite, shallReAttachedToAttachedPhoneCauseDeattaching)
     ASSERT_FALSE(someNewConnection.connectionSlot.isAttached());
 }
 
-TEST_F(UeRelayTestSuite, shallNotForwardMessageToNotAttachedUe)
+TEST_P(UeRelayTestSuite, shallNotForwardMessageToNotAttachedUe)
 {
     shallNotForwardMessage(NOT_ATTACHED_PHONE);
 }
 
-TEST_F(UeRelayTestSuite, shallForwardMessageToAttachedUe)
+TEST_P(UeRelayTestSuite, shallForwardMessageToAttachedUe)
 {
     shallForwardMessage(connectionAttached);
 }
 
-TEST_F(UeRelayTestSuite, shallForwardMessageToReAttachedUe)
+TEST_P(UeRelayTestSuite, shallForwardMessageToReAttachedUe)
 {
     shallForwardMessage(connectionReAttached);
 }
 
-TEST_F(UeRelayTestSuite, shallCountNotAttachedConnections)
+TEST_P(UeRelayTestSuite, shallCountNotAttachedConnections)
 {
     ASSERT_EQ(connectionAdded.count(), objectUnderTest->countNotAttached());
 }
 
-TEST_F(UeRelayTestSuite, shallCountAttachedConnections)
+TEST_P(UeRelayTestSuite, shallCountAttachedConnections)
 {
     ASSERT_EQ(connectionAttached.count() + connectionReAttached.count(),
               objectUnderTest->countAttached());
 }
 
-TEST_F(UeRelayTestSuite, shallCountConnections)
+TEST_P(UeRelayTestSuite, shallCountConnections)
 {
     ASSERT_EQ(connectionAdded.count() + connectionAttached.count() + connectionReAttached.count(),
               objectUnderTest->count());
 }
 
-TEST_F(UeRelayTestSuite, shallVisitNotAttachedConnections)
+TEST_P(UeRelayTestSuite, shallVisitNotAttachedConnections)
 {
     expectAction(connectionAdded);
     objectUnderTest->visitNotAttachedUe(getAction());
 }
 
-TEST_F(UeRelayTestSuite, shallVisitAttachedConnections)
+TEST_P(UeRelayTestSuite, shallVisitNextNotAttachedConnectionsNoMoreThanWaiting)
+{
+    expectAction(connectionAdded);
+    ASSERT_EQ(connectionAdded.count(), objectUnderTest->visitNextNotAttachedUe(getAction(), 5u));
+}
+
+TEST_P(UeRelayTestSuite, shallVisitAttachedConnections)
 {
     expectAction(connectionAttached);
     expectAction(connectionReAttached);
     objectUnderTest->visitAttachedUe(getAction());
 }
 
+TEST_P(UeRelayTestSuite, shallBroadcastToAttachedConnections)
+{
+    connectionAttached.expectSendMessage(MESSAGE);
+    connectionReAttached.expectSendMessage(MESSAGE);
+    ASSERT_EQ(2u, objectUnderTest->broadcast(MESSAGE, IUeRelay::BroadcastScope::Attached));
+}
+
+TEST_P(UeRelayTestSuite, shallBroadcastToNotAttachedConnections)
+{
+    connectionAdded.expectSendMessage(MESSAGE);
+    ASSERT_EQ(1u, objectUnderTest->broadcast(MESSAGE, IUeRelay::BroadcastScope::NotAttached));
+}
+
+TEST_P(UeRelayTestSuite, shallBroadcastToAllConnections)
+{
+    connectionAdded.expectSendMessage(MESSAGE);
+    connectionAttached.expectSendMessage(MESSAGE);
+    connectionReAttached.expectSendMessage(MESSAGE);
+    ASSERT_EQ(3u, objectUnderTest->broadcast(MESSAGE, IUeRelay::BroadcastScope::All));
+}
+
+INSTANTIATE_TEST_SUITE_P(UeRelayImplementations,
+                         UeRelayTestSuite,
+                         Values([](common::ILogger& logger) -> std::unique_ptr<IUeRelay>
+                                {
+                                    return std::make_unique<UeRelay>(logger);
+                                },
+                                [](common::ILogger& logger) -> std::unique_ptr<IUeRelay>
+                                {
+                                    return std::make_unique<ShardedUeRelay>(logger, 1u);
+                                },
+                                [](common::ILogger& logger) -> std::unique_ptr<IUeRelay>
+                                {
+                                    return std::make_unique<ShardedUeRelay>(logger, 4u);
+                                },
+                                [](common::ILogger& logger) -> std::unique_ptr<IUeRelay>
+                                {
+                                    return std::make_unique<FlatUeRelay>(logger, 1u);
+                                }));
+
 }
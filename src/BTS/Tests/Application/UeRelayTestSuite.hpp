@@ -1,7 +1,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
-#include "UeRelay/UeRelay.hpp"
+#include "UeRelay/IUeRelay.hpp"
 
 #include "Mocks/IUeConnectionMock.hpp"
 #include "Mocks/ILoggerMock.hpp"
@@ -9,7 +9,9 @@
 namespace bts
 {
 
-class UeRelayTestSuite : public ::testing::Test
+using UeRelayFactory = std::function<std::unique_ptr<IUeRelay>(common::ILogger&)>;
+
+class UeRelayTestSuite : public ::testing::TestWithParam<UeRelayFactory>
 {
 protected:
     struct ConnectionMock;
@@ -56,7 +58,7 @@ protected:
     ConnectionMock connectionAttached;
     ConnectionMock connectionReAttached;
 
-    std::unique_ptr<UeRelay> objectUnderTest;
+    std::unique_ptr<IUeRelay> objectUnderTest;
 };
 
 
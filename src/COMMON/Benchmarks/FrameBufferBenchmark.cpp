@@ -0,0 +1,130 @@
+#include "Tools/Benchmark.hpp"
+#include "CommonEnvironment/FrameBuffer.hpp"
+#include "Messages/IncomingMessage.hpp"
+#include "Messages/Frame.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <vector>
+
+namespace common
+{
+
+namespace
+{
+
+using namespace common::benchmark;
+
+using Bytes = std::vector<BinaryMessage::ValueType>;
+
+constexpr std::size_t STREAM_LENGTH = 4u * 1024u * 1024u;
+constexpr std::size_t READ_LENGTH = 16u * 1024u; // what a single read from socket gives
+
+Bytes makeStream(std::size_t messageLength, std::size_t& numberOfFrames)
+{
+    Bytes stream;
+    numberOfFrames = 0u;
+    while (stream.size() + FrameBuffer::SIZE_PREFIX_LENGTH + messageLength <= STREAM_LENGTH)
+    {
+        stream.push_back(static_cast<std::uint8_t>(messageLength >> 8));
+        stream.push_back(static_cast<std::uint8_t>(messageLength));
+        stream.insert(stream.end(), messageLength, static_cast<std::uint8_t>(numberOfFrames));
+        ++numberOfFrames;
+    }
+    return stream;
+}
+
+/**
+ * Per frame: size read into its own message and decoded by IncomingMessage, then message read into another one
+ * - like QtTransport did before FrameBuffer
+ */
+std::size_t decodeLikeBefore(const Bytes& stream)
+{
+    const std::size_t sizeSize = sizeof(BinaryMessage::SizeType);
+    std::size_t frames = 0u;
+    std::size_t position = 0u;
+    while (stream.size() - position >= sizeSize)
+    {
+        BinaryMessage sizeEncoded{ BinaryMessage::Value(sizeSize) };
+        std::memcpy(sizeEncoded.value.data(), stream.data() + position, sizeSize);
+        position += sizeSize;
+        IncomingMessage sizeDecoder(sizeEncoded);
+        auto messageLength = sizeDecoder.readNumber<BinaryMessage::SizeType>();
+
+        BinaryMessage message{ BinaryMessage::Value(messageLength) };
+        std::memcpy(message.value.data(), stream.data() + position, messageLength);
+        position += messageLength;
+        doNotOptimize(message);
+        ++frames;
+    }
+    return frames;
+}
+
+template <typename FrameHandler>
+std::size_t decodeWithFrameBuffer(const Bytes& stream, FrameHandler&& handleFrame)
+{
+    FrameBuffer frameBuffer;
+    std::size_t frames = 0u;
+    std::size_t position = 0u;
+    while (position < stream.size())
+    {
+        auto space = frameBuffer.writableSpace();
+        auto length = std::min({space.size(), READ_LENGTH, stream.size() - position});
+        std::memcpy(space.data(), stream.data() + position, length);
+        position += length;
+        frameBuffer.commit(length);
+        while (auto frame = frameBuffer.nextFrame())
+        {
+            handleFrame(*frame);
+            ++frames;
+        }
+    }
+    return frames;
+}
+
+template <typename Decoder>
+double framesPerSecond(const Bytes& stream, std::size_t numberOfFrames, Decoder&& decode)
+{
+    constexpr std::size_t REPETITIONS = 20u;
+    Stopwatch stopwatch;
+    std::size_t frames = 0u;
+    for (std::size_t i = 0u; i < REPETITIONS; ++i)
+    {
+        frames += decode(stream);
+    }
+    auto rate = frames / stopwatch.elapsedSeconds();
+    return frames == REPETITIONS * numberOfFrames ? rate : 0.0;
+}
+
+}
+
+COMMON_BENCHMARK(DecodedFramesPerSecondVsPayloadSize)
+{
+    out << std::setw(10) << "payload"
+        << std::setw(20) << "before"
+        << std::setw(20) << "views"
+        << std::setw(20) << "views->Frame" << '\n';
+    for (std::size_t messageLength: {16u, 256u, 5000u})
+    {
+        std::size_t numberOfFrames = 0u;
+        auto stream = makeStream(messageLength, numberOfFrames);
+
+        auto before = framesPerSecond(stream, numberOfFrames, decodeLikeBefore);
+        auto views = framesPerSecond(stream, numberOfFrames, [](const Bytes& stream) {
+            return decodeWithFrameBuffer(stream, [](FrameBuffer::FrameView frame) { doNotOptimize(frame); });
+        });
+        auto messages = framesPerSecond(stream, numberOfFrames, [](const Bytes& stream) {
+            return decodeWithFrameBuffer(stream, [](FrameBuffer::FrameView frame) {
+                auto message = Frame::copyOf(frame);
+                doNotOptimize(message);
+            });
+        });
+
+        out << std::setw(10) << messageLength << std::fixed << std::setprecision(0)
+            << std::setw(20) << before
+            << std::setw(20) << views
+            << std::setw(20) << messages << '\n';
+    }
+}
+
+}
@@ -0,0 +1,67 @@
+#include "Tools/Benchmark.hpp"
+#include "Statistics/LatencyHistograms.hpp"
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+namespace common
+{
+
+namespace
+{
+
+using namespace common::benchmark;
+
+constexpr std::size_t REPETITIONS = 2000000u;
+
+/**
+ * Records per second of all threads - each thread records into shared or own histogram
+ */
+template <typename Record>
+double recordsPerSecond(std::size_t numberOfThreads, Record record)
+{
+    std::vector<std::thread> threads;
+    Stopwatch stopwatch;
+    for (std::size_t t = 0u; t < numberOfThreads; ++t)
+    {
+        threads.emplace_back([&record, t]
+        {
+            for (std::size_t i = 0u; i < REPETITIONS; ++i)
+            {
+                record(std::chrono::nanoseconds(1000u + (i * 7919u + t) % 100000u));
+            }
+        });
+    }
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+    return numberOfThreads * REPETITIONS / stopwatch.elapsedSeconds();
+}
+
+}
+
+COMMON_BENCHMARK(LatencyRecordsPerSecond)
+{
+    out << std::setw(10) << "threads"
+        << std::setw(24) << "shared Histogram/s"
+        << std::setw(24) << "LatencyHistograms/s" << '\n';
+    for (std::size_t numberOfThreads: {1u, 2u, 4u})
+    {
+        Histogram shared;
+        LatencyHistograms sharded({"stage"});
+        auto sharedRate = recordsPerSecond(numberOfThreads, [&shared](std::chrono::nanoseconds latency)
+        {
+            shared.record(latency.count());
+        });
+        auto shardedRate = recordsPerSecond(numberOfThreads, [&sharded](std::chrono::nanoseconds latency)
+        {
+            sharded.record(0u, MessageId::Sms, latency);
+        });
+        out << std::setw(10) << numberOfThreads << std::fixed << std::setprecision(0)
+            << std::setw(24) << sharedRate
+            << std::setw(24) << shardedRate << '\n';
+    }
+}
+
+}
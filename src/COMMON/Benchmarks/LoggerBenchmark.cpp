@@ -0,0 +1,178 @@
+#include "Tools/Benchmark.hpp"
+#include "Logger/AsyncLogger.hpp"
+#include "Logger/BinaryLogger.hpp"
+#include "Logger/Logger.hpp"
+#include "Logger/PrefixedLogger.hpp"
+#include "Messages.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace common
+{
+
+namespace
+{
+
+using namespace common::benchmark;
+
+constexpr std::size_t REPETITIONS = 100000u;
+
+/**
+ * Debug line of the forwarding path - like QtTransport prints for every received message
+ */
+double debugLinesPerSecond(ILogger::Level minimumLevel, std::size_t bodyLength)
+{
+    std::ostream nullStream(nullptr);
+    Logger logger{{"[DEBUG]", {&nullStream}}, {"", {&nullStream}}, {"[ERROR]", {&nullStream}}};
+    logger.setMinimumLevel(minimumLevel);
+    PrefixedLogger prefixedLogger(logger, "[UE-CONNECTION]");
+
+    const std::string address = "127.0.0.1:50000";
+    const BinaryMessage message{BinaryMessage::Value(static_cast<BinaryMessage::SizeType>(bodyLength), 0xAB)};
+    return measureRate(REPETITIONS, [&] {
+        prefixedLogger.logDebug("Message received from: ", address, " body: ", message);
+    });
+}
+
+struct LoggingResult
+{
+    double linesPerSecond;
+    double callNanoseconds;
+};
+
+/**
+ * Lines logged by many threads (like UE connections served by many loops) - till all are written
+ */
+template <typename LoggerType, typename ...Option>
+LoggingResult logInThreads(std::size_t numberOfThreads, Option ...option)
+{
+    constexpr std::size_t LINES_PER_THREAD = 20000u;
+    const std::string logFilename = "LinesPerSecondVsLogger.log";
+    std::ofstream logFile(logFilename);
+    LoggerType logger({{"[DEBUG]", {&logFile}}, {"", {&logFile}}, {"[ERROR]", {&logFile}}}, option...);
+    PrefixedLogger prefixedLogger(logger, "[UE-CONNECTION]");
+
+    std::vector<std::thread> threads;
+    std::vector<double> callNanoseconds(numberOfThreads);
+    Stopwatch stopwatch;
+    for (std::size_t i = 0u; i < numberOfThreads; ++i)
+    {
+        threads.emplace_back([&prefixedLogger, &callNanoseconds, i] {
+            Stopwatch callStopwatch;
+            for (std::size_t j = 0u; j < LINES_PER_THREAD; ++j)
+            {
+                prefixedLogger.logDebug("Forwarded: ", j, " to: ", i);
+            }
+            callNanoseconds[i] = callStopwatch.elapsed().count() / double(LINES_PER_THREAD);
+        });
+    }
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+    if constexpr (std::is_same_v<LoggerType, AsyncLogger>)
+    {
+        logger.flush();
+    }
+    LoggingResult result{ numberOfThreads * LINES_PER_THREAD / stopwatch.elapsedSeconds(),
+                          *std::max_element(callNanoseconds.begin(), callNanoseconds.end()) };
+    std::remove(logFilename.c_str());
+    return result;
+}
+
+void printRow(std::ostream& out, const std::string& logger, std::size_t numberOfThreads, LoggingResult result)
+{
+    out << std::setw(14) << logger
+        << std::setw(10) << numberOfThreads
+        << std::setw(16) << std::fixed << std::setprecision(0) << result.linesPerSecond
+        << std::setw(12) << result.callNanoseconds << '\n';
+}
+
+struct LogSize
+{
+    double bytesPerLine;
+    double linesPerSecond;
+};
+
+/**
+ * Lines of forwarding path: received message (with body) and its forwarding
+ */
+LogSize logForwarding(ILogger& logger, std::ostringstream& logStream, std::size_t bodyLength)
+{
+    constexpr std::size_t MESSAGES = 20000u;
+    PrefixedLogger prefixedLogger(logger, "[UE:127.0.0.1:50000,123]");
+
+    const std::string address = "127.0.0.1:50000";
+    BinaryMessage message{BinaryMessage::Value(static_cast<BinaryMessage::SizeType>(bodyLength), 0xAB)};
+    const MessageHeader header{MessageId::Sms, PhoneNumber{123}, PhoneNumber{45}};
+    auto rate = measureRate(MESSAGES, [&] {
+        prefixedLogger.logDebug("Message received from: ", address, " body: ", message);
+        prefixedLogger.logDebug("Forwarded: ", header);
+    });
+    return LogSize{ double(logStream.tellp()) / (2u * MESSAGES), 2u * rate };
+}
+
+void printRow(std::ostream& out, const std::string& logger, std::size_t bodyLength, LogSize result)
+{
+    out << std::setw(10) << logger
+        << std::setw(8) << bodyLength
+        << std::setw(14) << std::fixed << std::setprecision(1) << result.bytesPerLine
+        << std::setw(14) << std::setprecision(0) << result.linesPerSecond << '\n';
+}
+
+}
+
+COMMON_BENCHMARK(LogBytesPerLineVsFormat)
+{
+    out << std::setw(10) << "format"
+        << std::setw(8) << "body"
+        << std::setw(14) << "bytes/line"
+        << std::setw(14) << "lines/sec" << '\n';
+    for (std::size_t bodyLength: {16u, 256u, 1024u})
+    {
+        std::ostringstream textStream, binaryStream;
+        Logger textLogger{{"[DEBUG]", {&textStream}}, {"", {&textStream}}, {"[ERROR]", {&textStream}}};
+        BinaryLogger binaryLogger{binaryStream};
+        printRow(out, "text", bodyLength, logForwarding(textLogger, textStream, bodyLength));
+        printRow(out, "binary", bodyLength, logForwarding(binaryLogger, binaryStream, bodyLength));
+    }
+}
+
+COMMON_BENCHMARK(LinesPerSecondVsLogger)
+{
+    out << std::setw(14) << "logger"
+        << std::setw(10) << "threads"
+        << std::setw(16) << "lines/sec"
+        << std::setw(12) << "ns/call" << '\n';
+    auto hardwareThreads = std::max(2u, std::thread::hardware_concurrency());
+    for (std::size_t numberOfThreads: {std::size_t{1u}, std::size_t{hardwareThreads}})
+    {
+        printRow(out, "sync", numberOfThreads, logInThreads<Logger>(numberOfThreads));
+        printRow(out, "async-block", numberOfThreads,
+                 logInThreads<AsyncLogger>(numberOfThreads, AsyncLogger::Options{}));
+        printRow(out, "async-drop", numberOfThreads,
+                 logInThreads<AsyncLogger>(numberOfThreads,
+                                           AsyncLogger::Options{8192u, AsyncLogger::OverflowPolicy::Drop}));
+    }
+}
+
+COMMON_BENCHMARK(DebugLinesPerSecondVsMinimumLevel)
+{
+    out << std::setw(8) << "length"
+        << std::setw(18) << "debug/sec"
+        << std::setw(18) << "info/sec" << '\n';
+    for (std::size_t length: {8u, 64u, 1024u})
+    {
+        out << std::setw(8) << length
+            << std::setw(18) << std::fixed << std::setprecision(0) << debugLinesPerSecond(ILogger::DEBUG_LEVEL, length)
+            << std::setw(18) << debugLinesPerSecond(ILogger::INFO_LEVEL, length) << '\n';
+    }
+}
+
+}
@@ -0,0 +1,86 @@
+#include "Tools/Benchmark.hpp"
+#include "Messages/BinaryMessage.hpp"
+#include "Messages/MessagePool.hpp"
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace common
+{
+
+namespace
+{
+
+using namespace common::benchmark;
+
+constexpr std::size_t REPETITIONS = 1000000u;
+
+using HeapValue = LimitedVector<BinaryMessage::ValueType, BinaryMessage::SizeType, BinaryMessage::MAX_SIZE>;
+using PoolValue = LimitedVector<BinaryMessage::ValueType, BinaryMessage::SizeType, BinaryMessage::MAX_SIZE,
+                                PoolAllocator<BinaryMessage::ValueType>>;
+using PoolInlineValue = BinaryMessage::Value;
+
+/**
+ * Message built like OutgoingMessage does - value by value
+ */
+template <typename Value>
+double builtPerSecond(std::size_t length)
+{
+    return measureRate(REPETITIONS, [length] {
+        Value value;
+        for (std::size_t i = 0u; i < length; ++i)
+        {
+            value.push_back(static_cast<BinaryMessage::ValueType>(i));
+        }
+        doNotOptimize(value);
+    });
+}
+
+/**
+ * Messages built in one thread, released in the other one - like received by one UE, sent to other
+ */
+template <typename Value>
+double handedOverPerSecond(std::size_t length)
+{
+    constexpr std::size_t BATCH = 1000u;
+    Stopwatch stopwatch;
+    for (std::size_t i = 0u; i < REPETITIONS / BATCH; ++i)
+    {
+        auto batch = std::make_unique<std::vector<Value>>();
+        batch->reserve(BATCH);
+        for (std::size_t j = 0u; j < BATCH; ++j)
+        {
+            batch->emplace_back(static_cast<BinaryMessage::SizeType>(length), BinaryMessage::ValueType{});
+        }
+        std::thread([batch = std::move(batch)] {}).join();
+    }
+    return REPETITIONS / stopwatch.elapsedSeconds();
+}
+
+void printRow(std::ostream& out, std::size_t length, const std::string& value, double built, double handedOver)
+{
+    out << std::setw(8) << length
+        << std::setw(14) << value
+        << std::setw(16) << std::fixed << std::setprecision(0) << built
+        << std::setw(16) << handedOver << '\n';
+}
+
+}
+
+COMMON_BENCHMARK(MessagesPerSecondVsAllocator)
+{
+    out << std::setw(8) << "length"
+        << std::setw(14) << "value"
+        << std::setw(16) << "built/sec"
+        << std::setw(16) << "handed/sec" << '\n';
+    for (std::size_t length: {3u, 16u, 64u, 256u, 5000u})
+    {
+        printRow(out, length, "heap", builtPerSecond<HeapValue>(length), handedOverPerSecond<HeapValue>(length));
+        printRow(out, length, "pool", builtPerSecond<PoolValue>(length), handedOverPerSecond<PoolValue>(length));
+        printRow(out, length, "pool+inline", builtPerSecond<PoolInlineValue>(length), handedOverPerSecond<PoolInlineValue>(length));
+    }
+}
+
+}
@@ -0,0 +1,86 @@
+#include "Tools/Benchmark.hpp"
+#include "Messages/IncomingMessage.hpp"
+#include "Messages/MessageSchema.hpp"
+#include "Messages/OutgoingMessage.hpp"
+#include <iomanip>
+#include <string>
+
+namespace common
+{
+
+namespace
+{
+
+using namespace common::benchmark;
+
+constexpr std::size_t REPETITIONS = 10000000u;
+
+const PhoneNumber FROM{1};
+const PhoneNumber TO{2};
+
+Frame::View viewOf(const BinaryMessage& message)
+{
+    return Frame::View(message.value.data(), message.value.size());
+}
+
+// what UE BtsPort/BTS UeConnection did before schema
+double readPerSecond(const BinaryMessage& message)
+{
+    return measureRate(REPETITIONS, [view = viewOf(message)] {
+        IncomingMessage reader(view);
+        auto header = reader.readMessageHeader();
+        doNotOptimize(header);
+        switch (header.messageId)
+        {
+        case MessageId::Sib:
+            doNotOptimize(reader.readBtsId());
+            break;
+        case MessageId::AttachResponse:
+            doNotOptimize(reader.readNumber<bool>());
+            break;
+        default:
+            doNotOptimize(reader.readRemainingText());
+            break;
+        }
+    });
+}
+
+template <MessageId Id>
+double decodedPerSecond(const BinaryMessage& message)
+{
+    return measureRate(REPETITIONS, [view = viewOf(message)] {
+        auto decoded = schema::decode<Id>(view);
+        doNotOptimize(decoded);
+    });
+}
+
+void printRow(std::ostream& out, MessageId id, double read, double decoded)
+{
+    out << std::setw(16) << to_string(id)
+        << std::setw(18) << std::fixed << std::setprecision(0) << read
+        << std::setw(18) << decoded << '\n';
+}
+
+}
+
+COMMON_BENCHMARK(DecodedMessagesPerSecondVsDecoder)
+{
+    OutgoingMessage sib{MessageId::Sib, FROM, TO};
+    sib.writeBtsId(BtsId{1234u});
+    OutgoingMessage attachResponse{MessageId::AttachResponse, FROM, TO};
+    attachResponse.writeNumber(true);
+    OutgoingMessage callRequest{MessageId::CallRequest, FROM, TO};
+    callRequest.writeNumber<std::uint8_t>(0u);
+
+    out << std::setw(16) << "message"
+        << std::setw(18) << "incoming/sec"
+        << std::setw(18) << "schema/sec" << '\n';
+    printRow(out, MessageId::Sib, readPerSecond(sib.getMessage()),
+             decodedPerSecond<MessageId::Sib>(sib.getMessage()));
+    printRow(out, MessageId::AttachResponse, readPerSecond(attachResponse.getMessage()),
+             decodedPerSecond<MessageId::AttachResponse>(attachResponse.getMessage()));
+    printRow(out, MessageId::CallRequest, readPerSecond(callRequest.getMessage()),
+             decodedPerSecond<MessageId::CallRequest>(callRequest.getMessage()));
+}
+
+}
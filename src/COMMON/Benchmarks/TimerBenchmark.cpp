@@ -0,0 +1,161 @@
+#include "Tools/Benchmark.hpp"
+#include "Timers/TimingWheel.hpp"
+#include "Timers/TimerService.hpp"
+#include <iomanip>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace common
+{
+
+namespace
+{
+
+using namespace common::benchmark;
+using Ticks = TimingWheel::Ticks;
+
+constexpr std::size_t REPETITIONS = 1000000u;
+constexpr Ticks MAX_DELAY = 100000u;
+
+/**
+ * Ordered timer queue - as timers are usually done with std::multimap or priority queue, for comparison
+ */
+class OrderedTimers
+{
+public:
+    using Timer = std::multimap<Ticks, TimingWheel::Callback>::iterator;
+
+    Timer schedule(Ticks expiry, TimingWheel::Callback callback)
+    {
+        return timers.emplace(expiry, std::move(callback));
+    }
+    void cancel(Timer timer)
+    {
+        timers.erase(timer);
+    }
+    std::size_t advance(Ticks now)
+    {
+        std::size_t expired = 0u;
+        while (not timers.empty() and timers.begin()->first <= now)
+        {
+            auto callback = std::move(timers.begin()->second);
+            timers.erase(timers.begin());
+            callback();
+            ++expired;
+        }
+        return expired;
+    }
+
+private:
+    std::multimap<Ticks, TimingWheel::Callback> timers;
+};
+
+std::vector<Ticks> randomExpiries(std::size_t count)
+{
+    std::mt19937_64 random(7u);
+    std::uniform_int_distribution<Ticks> delay(1u, MAX_DELAY);
+    std::vector<Ticks> expiries(count);
+    for (auto& expiry: expiries)
+    {
+        expiry = delay(random);
+    }
+    return expiries;
+}
+
+/**
+ * One timer armed and cancelled - while given number of other timers is pending
+ */
+double armedAndCancelledPerSecond(TimingWheel& wheel, std::size_t pending)
+{
+    auto expiries = randomExpiries(pending + 1u);
+    std::vector<TimingWheel::Timer> timers(pending);
+    for (std::size_t i = 0u; i < pending; ++i)
+    {
+        wheel.schedule(timers[i], expiries[i], [] {});
+    }
+    TimingWheel::Timer timer;
+    std::size_t i = 0u;
+    return measureRate(REPETITIONS, [&] {
+        wheel.schedule(timer, expiries[i++ % expiries.size()], [] {});
+        wheel.cancel(timer);
+    });
+}
+
+double armedAndCancelledPerSecond(OrderedTimers& ordered, std::size_t pending)
+{
+    auto expiries = randomExpiries(pending + 1u);
+    for (std::size_t i = 0u; i < pending; ++i)
+    {
+        ordered.schedule(expiries[i], [] {});
+    }
+    std::size_t i = 0u;
+    return measureRate(REPETITIONS, [&] {
+        ordered.cancel(ordered.schedule(expiries[i++ % expiries.size()], [] {}));
+    });
+}
+
+double armedAndCancelledPerSecond(TimerService& service)
+{
+    TimerService::Timer timer;
+    return measureRate(REPETITIONS, [&] {
+        service.schedule(timer, std::chrono::milliseconds(500), [] {});
+        service.cancel(timer);
+    });
+}
+
+template <typename Timers>
+double expiredPerSecond(Timers& timers, std::size_t pending)
+{
+    auto expiries = randomExpiries(pending);
+    std::vector<TimingWheel::Timer> wheelTimers(pending);
+    for (std::size_t i = 0u; i < pending; ++i)
+    {
+        if constexpr (std::is_same_v<Timers, TimingWheel>)
+        {
+            timers.schedule(wheelTimers[i], expiries[i], [] {});
+        }
+        else
+        {
+            timers.schedule(expiries[i], [] {});
+        }
+    }
+    Stopwatch stopwatch;
+    auto expired = timers.advance(MAX_DELAY);
+    return expired / stopwatch.elapsedSeconds();
+}
+
+void printRow(std::ostream& out, const std::string& timers, std::size_t pending, double armedAndCancelled, double expired)
+{
+    out << std::setw(16) << timers
+        << std::setw(10) << pending
+        << std::setw(20) << std::fixed << std::setprecision(0) << armedAndCancelled
+        << std::setw(16) << expired << '\n';
+}
+
+}
+
+COMMON_BENCHMARK(TimersArmedAndCancelledPerSecond)
+{
+    out << std::setw(16) << "timers"
+        << std::setw(10) << "pending"
+        << std::setw(20) << "armed+cancelled/s"
+        << std::setw(16) << "expired/s" << '\n';
+    for (std::size_t pending: {1000u, 100000u})
+    {
+        {
+            TimingWheel armed, expiring;
+            printRow(out, "TimingWheel", pending,
+                     armedAndCancelledPerSecond(armed, pending), expiredPerSecond(expiring, pending));
+        }
+        {
+            OrderedTimers armed, expiring;
+            printRow(out, "std::multimap", pending,
+                     armedAndCancelledPerSecond(armed, pending), expiredPerSecond(expiring, pending));
+        }
+    }
+    TimerService service;
+    printRow(out, "TimerService", 0u, armedAndCancelledPerSecond(service), 0.0);
+}
+
+}
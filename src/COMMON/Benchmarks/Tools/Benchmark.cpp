@@ -0,0 +1,87 @@
+#include "Benchmark.hpp"
+#include <iostream>
+#include <vector>
+#include <utility>
+
+namespace common::benchmark
+{
+
+namespace
+{
+
+using Benchmarks = std::vector<std::pair<std::string, BenchmarkFunction>>;
+
+Benchmarks& getBenchmarks()
+{
+    static Benchmarks benchmarks;
+    return benchmarks;
+}
+
+bool isSelected(const std::string& name, int argc, char* argv[])
+{
+    if (argc <= 1)
+    {
+        return true;
+    }
+    for (int i = 1; i < argc; ++i)
+    {
+        if (name.find(argv[i]) != std::string::npos)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+bool registerBenchmark(const std::string& name, BenchmarkFunction function)
+{
+    getBenchmarks().emplace_back(name, std::move(function));
+    return true;
+}
+
+int runBenchmarks(int argc, char* argv[])
+{
+    int result = 0;
+    for (auto& [name, function] : getBenchmarks())
+    {
+        if (not isSelected(name, argc, argv))
+        {
+            continue;
+        }
+        std::cout << "[ BENCHMARK ] " << name << std::endl;
+        try
+        {
+            function(std::cout);
+            std::cout << "[      DONE ] " << name << std::endl;
+        }
+        catch (std::exception& ex)
+        {
+            std::cout << "[    FAILED ] " << name << ": " << ex.what() << std::endl;
+            result = 1;
+        }
+    }
+    return result;
+}
+
+Stopwatch::Stopwatch()
+    : start(Clock::now())
+{}
+
+void Stopwatch::restart()
+{
+    start = Clock::now();
+}
+
+double Stopwatch::elapsedSeconds() const
+{
+    return std::chrono::duration<double>(elapsed()).count();
+}
+
+std::chrono::nanoseconds Stopwatch::elapsed() const
+{
+    return Clock::now() - start;
+}
+
+}
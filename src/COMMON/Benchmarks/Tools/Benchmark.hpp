@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace common::benchmark
+{
+
+using Clock = std::chrono::steady_clock;
+using BenchmarkFunction = std::function<void(std::ostream&)>;
+
+/**
+ * @return always true - so it can be used to initialize static variable, see COMMON_BENCHMARK
+ */
+bool registerBenchmark(const std::string& name, BenchmarkFunction function);
+
+/**
+ * Runs all registered benchmarks whose names contain any of the command line arguments
+ * (all of them - when no arguments given)
+ */
+int runBenchmarks(int argc, char* argv[]);
+
+class Stopwatch
+{
+public:
+    Stopwatch();
+    void restart();
+    double elapsedSeconds() const;
+    std::chrono::nanoseconds elapsed() const;
+
+private:
+    Clock::time_point start;
+};
+
+/**
+ * Prevents compiler from optimizing away computations which results are not used otherwise
+ */
+template <typename T>
+inline void doNotOptimize(T const& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @return how many operations per second were done
+ */
+template <typename Operation>
+double measureRate(std::size_t repetitions, Operation&& operation)
+{
+    Stopwatch stopwatch;
+    for (std::size_t i = 0u; i < repetitions; ++i)
+    {
+        operation();
+    }
+    return repetitions / stopwatch.elapsedSeconds();
+}
+
+}
+
+#define COMMON_BENCHMARK(name) \
+    static void name(std::ostream&); \
+    static const bool name##Registered = ::common::benchmark::registerBenchmark(#name, name); \
+    static void name(std::ostream& out)
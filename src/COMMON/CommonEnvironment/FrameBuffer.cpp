@@ -0,0 +1,65 @@
+#include "FrameBuffer.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace common
+{
+
+FrameBuffer::FrameBuffer(std::size_t capacity)
+    : buffer(std::max(capacity, MAX_FRAME_LENGTH))
+{}
+
+std::span<BinaryMessage::ValueType> FrameBuffer::writableSpace()
+{
+    if (begin == end)
+    {
+        begin = end = 0u;
+    }
+    else if (end == buffer.size())
+    {
+        // only partial frame left - it is shorter than MAX_FRAME_LENGTH, so it fits at the beginning
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0u;
+    }
+    return std::span<BinaryMessage::ValueType>(buffer.data() + end, buffer.size() - end);
+}
+
+void FrameBuffer::commit(std::size_t length)
+{
+    end = std::min(end + length, buffer.size());
+}
+
+std::optional<FrameBuffer::FrameView> FrameBuffer::nextFrame()
+{
+    if (end - begin < SIZE_PREFIX_LENGTH)
+    {
+        return std::nullopt;
+    }
+    const BinaryMessage::ValueType* frame = buffer.data() + begin;
+    std::size_t messageLength = (std::size_t{frame[0]} << 8) | frame[1];
+    if (messageLength > BinaryMessage::MAX_SIZE)
+    {
+        throw std::length_error("Wrong frame size: " + std::to_string(messageLength));
+    }
+    if (end - begin < SIZE_PREFIX_LENGTH + messageLength)
+    {
+        return std::nullopt;
+    }
+    begin += SIZE_PREFIX_LENGTH + messageLength;
+    return FrameView(frame + SIZE_PREFIX_LENGTH, messageLength);
+}
+
+std::size_t FrameBuffer::bufferedLength() const
+{
+    return end - begin;
+}
+
+std::size_t FrameBuffer::capacity() const
+{
+    return buffer.size();
+}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "Messages/BinaryMessage.hpp"
+
+namespace common
+{
+
+/**
+ * Receive buffer of the transport protocol - frames of size (2 bytes, big endian) followed by message.
+ * Data is read straight into writableSpace(), complete frames are decoded in place and handed out as views,
+ * partial frame stays in buffer till the rest of it is received.
+ */
+class FrameBuffer
+{
+public:
+    using FrameView = std::span<const BinaryMessage::ValueType>;
+
+    static constexpr std::size_t SIZE_PREFIX_LENGTH = sizeof(BinaryMessage::SizeType);
+    static constexpr std::size_t MAX_FRAME_LENGTH = SIZE_PREFIX_LENGTH + BinaryMessage::MAX_SIZE;
+    static constexpr std::size_t DEFAULT_CAPACITY = 64u * 1024u;
+
+    /**
+     * @param capacity - extended to MAX_FRAME_LENGTH when smaller
+     */
+    explicit FrameBuffer(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * Space to receive data into - never empty as long as all complete frames are taken (see nextFrame()).
+     * Invalidates frames returned so far.
+     */
+    std::span<BinaryMessage::ValueType> writableSpace();
+    /**
+     * @param length - how much was written into writableSpace()
+     */
+    void commit(std::size_t length);
+
+    /**
+     * @return next complete frame (message without size) valid till next writableSpace() call,
+     *         nullopt when there is no complete frame buffered
+     * @throw std::length_error when frame is longer than BinaryMessage::MAX_SIZE - stream cannot be decoded further
+     */
+    std::optional<FrameView> nextFrame();
+
+    std::size_t bufferedLength() const;
+    std::size_t capacity() const;
+
+private:
+    std::vector<BinaryMessage::ValueType> buffer;
+    std::size_t begin = 0u;
+    std::size_t end = 0u;
+};
+
+}
@@ -9,7 +9,7 @@ namespace common
 class ITransport
 {
 public:
-    using MessageCallback=std::function<void (BinaryMessage)>;
+    using MessageCallback=std::function<void (Frame)>;
     using DisconnectedCallback=std::function<void()>;
 
     virtual ~ITransport() = default;
@@ -17,7 +17,15 @@ public:
     virtual void registerMessageCallback(MessageCallback) = 0;
     virtual void registerDisconnectedCallback(DisconnectedCallback) = 0;
 
-    virtual bool sendMessage(BinaryMessage) = 0;
+    /**
+     * @return true when queued for writing, false when it will not be written - dropped (see SendQueue),
+     *         send queue overflow (connection is closed then) or disconnected already
+     */
+    virtual bool sendMessage(Frame) = 0;
+    /**
+     * Peer does not keep up with what is sent to it - see SendQueue watermarks
+     */
+    virtual bool isCongested() const = 0;
 
     virtual std::string addressToString() const = 0;
 };
@@ -0,0 +1,114 @@
+#include "SendQueue.hpp"
+#include "FrameBuffer.hpp"
+#include "Messages/MessageSchema.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace common
+{
+
+SendQueue::SendQueue(Options options)
+    : options(options)
+{
+    if (options.lowWatermark > options.highWatermark or options.highWatermark > options.limit)
+    {
+        throw std::invalid_argument("Send queue watermarks shall be: low <= high <= limit");
+    }
+}
+
+SendQueue::SendQueue()
+    : SendQueue(Options{})
+{}
+
+SendQueue::PushResult SendQueue::push(Frame message)
+{
+    if (congested and options.overflowPolicy == OverflowPolicy::DropCallTalk and isDroppable(message.view()))
+    {
+        return PushResult::Dropped;
+    }
+    const std::size_t frameLength = FrameBuffer::SIZE_PREFIX_LENGTH + message.size();
+    if (size() + frameLength > options.limit or (congested and options.overflowPolicy == OverflowPolicy::Disconnect))
+    {
+        return PushResult::Overflow;
+    }
+
+    decltype(Queued::sizePrefix) sizePrefix{static_cast<std::uint8_t>(message.size() >> 8),
+                                            static_cast<std::uint8_t>(message.size())};
+    frames.push_back(Queued{sizePrefix, std::move(message)});
+    queuedBytes += frameLength;
+    if (size() > options.highWatermark)
+    {
+        congested = true;
+    }
+    return PushResult::Queued;
+}
+
+std::size_t SendQueue::pending(std::span<Segment> segments) const
+{
+    std::size_t count = 0u;
+    std::size_t written = frontWritten;
+    for (auto& queued: frames)
+    {
+        for (Segment segment: {Segment(queued.sizePrefix), queued.frame.view()})
+        {
+            if (written >= segment.size())
+            {
+                written -= segment.size();
+                continue;
+            }
+            if (count == segments.size())
+            {
+                return count;
+            }
+            segments[count++] = segment.subspan(written);
+            written = 0u;
+        }
+    }
+    return count;
+}
+
+void SendQueue::consume(std::size_t length)
+{
+    length = std::min(length, size());
+    queuedBytes -= length;
+    length += frontWritten;
+    while (not frames.empty())
+    {
+        const std::size_t frameLength = FrameBuffer::SIZE_PREFIX_LENGTH + frames.front().frame.size();
+        if (length < frameLength)
+        {
+            break;
+        }
+        length -= frameLength;
+        frames.pop_front();
+    }
+    frontWritten = length;
+    if (size() <= options.lowWatermark)
+    {
+        congested = false;
+    }
+}
+
+bool SendQueue::empty() const
+{
+    return size() == 0u;
+}
+
+std::size_t SendQueue::size() const
+{
+    return queuedBytes;
+}
+
+bool SendQueue::isCongested() const
+{
+    return congested;
+}
+
+bool SendQueue::isDroppable(Frame::View message)
+{
+    // voice - late frame is worthless, control messages are never dropped
+    return not message.empty()
+       and (message[0] & ~schema::WIDE_HEADER_FLAG) == get(MessageId::CallTalk);
+}
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <span>
+#include "Messages/BinaryMessage.hpp"
+#include "Messages/Frame.hpp"
+
+namespace common
+{
+
+/**
+ * Send buffer of the transport protocol - frames (size prefixed, see FrameBuffer) waiting for one connection.
+ * Frames are queued by reference (payload is not copied) and written by one gather write (see pending()).
+ *
+ * Queued bytes above high watermark make the connection congested till they drain down to low watermark.
+ * While congested the OverflowPolicy decides about next frames, above the limit the connection shall be closed
+ * whatever the policy - so one slow receiver cannot take unbounded memory.
+ *
+ * Not thread safe.
+ */
+class SendQueue
+{
+public:
+    enum class OverflowPolicy
+    {
+        DropCallTalk, // CallTalk frames are dropped, control messages still queued
+        Disconnect    // connection shall be closed
+    };
+
+    struct Options
+    {
+        std::size_t highWatermark = 1024u * 1024u;
+        std::size_t lowWatermark = 256u * 1024u;
+        std::size_t limit = 16u * 1024u * 1024u;
+        OverflowPolicy overflowPolicy = OverflowPolicy::DropCallTalk;
+    };
+
+    enum class PushResult
+    {
+        Queued,
+        Dropped,
+        Overflow // not queued - connection shall be closed
+    };
+
+    /**
+     * @throw std::invalid_argument when watermarks are not ordered: low <= high <= limit
+     */
+    explicit SendQueue(Options options);
+    SendQueue();
+
+    using Segment = std::span<const std::uint8_t>;
+
+    PushResult push(Frame message);
+
+    /**
+     * Fills segments with queued bytes not written yet, in order - size prefixes and payloads of frames
+     * @return number of segments filled - all of them when there is more queued, valid till next consume()
+     */
+    std::size_t pending(std::span<Segment> segments) const;
+    /**
+     * @param length - how much of pending() was written
+     */
+    void consume(std::size_t length);
+
+    bool empty() const;
+    std::size_t size() const;
+    bool isCongested() const;
+
+    /**
+     * @return true for frames dropped while congested under OverflowPolicy::DropCallTalk
+     */
+    static bool isDroppable(Frame::View message);
+
+private:
+    struct Queued
+    {
+        std::array<std::uint8_t, sizeof(BinaryMessage::SizeType)> sizePrefix;
+        Frame frame;
+    };
+
+    const Options options;
+    // deque - so queued prefixes stay in place when more is pushed
+    std::deque<Queued> frames;
+    // bytes of the front frame written already
+    std::size_t frontWritten = 0u;
+    std::size_t queuedBytes = 0u;
+    bool congested = false;
+};
+
+}
@@ -0,0 +1,66 @@
+#include "Config/MultiLineConfig.hpp"
+#include "Logger/BinaryLogReader.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/**
+ * Prints binary log (see BinaryLogger) as text log.
+ *
+ * @example
+ *   logdecode file=bts123_syslog_20250101120000.bin phone=101 message=Sms time=1
+ */
+int main(int argc, char* argv[])
+{
+    using namespace common;
+    MultiLineConfig arguments(argc - 1, argv + 1);
+
+    std::string filename = arguments.getString("file", "");
+    if (filename.empty())
+    {
+        std::cerr << "Usage: " << argv[0] << " file=<binary log> [phone=<number>] [message=<MessageId>] [time=1]\n";
+        return 1;
+    }
+
+    BinaryLogReader::Filter filter;
+    if (auto phone = arguments.getNumber<PhoneNumber::Value>("phone", PhoneNumber::INVALID_VALUE);
+        phone != PhoneNumber::INVALID_VALUE)
+    {
+        filter.phoneNumber = PhoneNumber{phone};
+    }
+    if (auto message = arguments.getString("message", ""); not message.empty())
+    {
+        std::istringstream messageStream(message);
+        MessageId messageId;
+        if (not (messageStream >> messageId))
+        {
+            std::cerr << "Unknown message: " << message << '\n';
+            return 1;
+        }
+        filter.messageId = messageId;
+    }
+    filter.printTime = arguments.getNumber<int>("time", 0) != 0;
+
+    std::ifstream input(filename, std::ios::binary);
+    if (not input)
+    {
+        std::cerr << "Cannot open: " << filename << '\n';
+        return 1;
+    }
+
+    try
+    {
+        BinaryLogReader reader(input, filter);
+        while (auto line = reader.readLine())
+        {
+            std::cout << *line << '\n';
+        }
+    }
+    catch (BinaryLogReader::ReadEx& ex)
+    {
+        std::cout.flush();
+        std::cerr << filename << ": " << ex.what() << '\n';
+        return 2;
+    }
+    return 0;
+}
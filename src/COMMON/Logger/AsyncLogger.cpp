@@ -0,0 +1,258 @@
+#include "AsyncLogger.hpp"
+#include <algorithm>
+#include <bit>
+#include <sstream>
+
+namespace common
+{
+
+namespace
+{
+constexpr std::size_t MAX_BATCH = 1024u;
+}
+
+AsyncLogger::AsyncLogger(std::ostream& logfile)
+    : AsyncLogger(logfile, Options{})
+{}
+
+AsyncLogger::AsyncLogger(std::ostream& logfile, Options options)
+    : AsyncLogger(
+        {
+            {"[DEBUG]", {&logfile}},
+            {"", {&std::cout, &logfile}},
+            {"[ERROR]", {&std::cerr, &logfile}}
+        },
+        options)
+{
+    static_assert(DEBUG_LEVEL == 0, "In this constructor DEBUG is assumed to be 0");
+    static_assert(INFO_LEVEL == 1, "In this constructor INFO is assumed to be 1");
+    static_assert(ERROR_LEVEL == 2, "In this constructor ERROR is assumed to be 2");
+}
+
+AsyncLogger::AsyncLogger(std::initializer_list<LevelInfo> streamsForLevels)
+    : AsyncLogger(streamsForLevels, Options{})
+{}
+
+AsyncLogger::AsyncLogger(std::initializer_list<LevelInfo> streamsForLevels, Options options)
+    : streamsForLevels(streamsForLevels),
+      overflowPolicy(options.overflowPolicy),
+      mask(std::bit_ceil(std::max<std::size_t>(options.capacity, 2u)) - 1u),
+      slots(std::make_unique<Slot[]>(mask + 1u))
+{
+    for (std::size_t i = 0u; i <= mask; ++i)
+    {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    for (auto& levelInfo: this->streamsForLevels)
+    {
+        for (auto stream: levelInfo.streams)
+        {
+            if (std::find(allStreams.begin(), allStreams.end(), stream) == allStreams.end())
+            {
+                allStreams.push_back(stream);
+            }
+        }
+    }
+    buffers.resize(allStreams.size());
+    writer = std::thread(&AsyncLogger::writerLoop, this);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    stopping.store(true);
+    pushed.fetch_add(1u);
+    pushed.notify_one();
+    writer.join();
+}
+
+void AsyncLogger::log(Level level, const std::string &message)
+{
+    if (not isEnabled(level))
+    {
+        return;
+    }
+    auto& levelInfo = streamsForLevels.at(level);
+    auto number = ++printoutNumber;
+    auto thisThreadId = std::this_thread::get_id();
+
+    std::ostringstream ostr;
+    ostr << "#" << number
+         << ",tid:" << thisThreadId
+         << levelInfo.prefix
+         << ":" << message;
+    Record record{level, std::move(ostr).str()};
+
+    while (not tryPush(record))
+    {
+        if (overflowPolicy == OverflowPolicy::Drop)
+        {
+            droppedCount.fetch_add(1u, std::memory_order_relaxed);
+            return;
+        }
+        pushed.fetch_add(1u);
+        pushed.notify_one();
+        std::this_thread::yield();
+    }
+
+    pushed.fetch_add(1u);
+    if (writerSleeping.load())
+    {
+        pushed.notify_one();
+    }
+}
+
+bool AsyncLogger::isEnabled(Level level) const
+{
+    return level >= minimumLevel.load(std::memory_order_relaxed);
+}
+
+void AsyncLogger::setMinimumLevel(Level level)
+{
+    minimumLevel.store(level, std::memory_order_relaxed);
+}
+
+ILogger::Level AsyncLogger::getMinimumLevel() const
+{
+    return minimumLevel.load(std::memory_order_relaxed);
+}
+
+void AsyncLogger::flush()
+{
+    const auto target = pushPosition.load(std::memory_order_acquire);
+    pushed.fetch_add(1u);
+    pushed.notify_one();
+
+    auto written = writtenPosition.load(std::memory_order_acquire);
+    while (written < target)
+    {
+        writtenPosition.wait(written, std::memory_order_acquire);
+        written = writtenPosition.load(std::memory_order_acquire);
+    }
+}
+
+std::uint64_t AsyncLogger::getDroppedCount() const
+{
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+bool AsyncLogger::tryPush(Record &record)
+{
+    auto position = pushPosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Slot& slot = slots[position & mask];
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::int64_t>(sequence - position);
+        if (difference == 0)
+        {
+            if (pushPosition.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed))
+            {
+                slot.record = std::move(record);
+                slot.sequence.store(position + 1u, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            // full - writer has not taken the record pushed one lap ago
+            return false;
+        }
+        else
+        {
+            position = pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool AsyncLogger::tryPop(Record &record)
+{
+    // single consumer - the writer thread
+    auto position = popPosition.load(std::memory_order_relaxed);
+    Slot& slot = slots[position & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1u)
+    {
+        return false;
+    }
+    record = std::move(slot.record);
+    slot.sequence.store(position + mask + 1u, std::memory_order_release);
+    popPosition.store(position + 1u, std::memory_order_relaxed);
+    return true;
+}
+
+void AsyncLogger::writerLoop()
+{
+    std::vector<Record> batch;
+    batch.reserve(MAX_BATCH);
+    Record record;
+    while (true)
+    {
+        while (batch.size() < MAX_BATCH and tryPop(record))
+        {
+            batch.push_back(std::move(record));
+        }
+        if (not batch.empty() or reportedDroppedCount != getDroppedCount())
+        {
+            writeBatch(batch);
+            batch.clear();
+            continue;
+        }
+
+        writerSleeping.store(true);
+        auto seen = pushed.load();
+        if (tryPop(record))
+        {
+            batch.push_back(std::move(record));
+        }
+        else if (stopping.load())
+        {
+            break;
+        }
+        else
+        {
+            pushed.wait(seen);
+        }
+        writerSleeping.store(false);
+    }
+}
+
+void AsyncLogger::writeBatch(std::vector<Record> &batch)
+{
+    auto append = [this](const Record& record)
+    {
+        for (auto stream: streamsForLevels[record.level].streams)
+        {
+            auto index = std::find(allStreams.begin(), allStreams.end(), stream) - allStreams.begin();
+            buffers[index].append(record.line).push_back('\n');
+        }
+    };
+
+    auto dropped = getDroppedCount();
+    if (dropped != reportedDroppedCount and streamsForLevels.size() > ERROR_LEVEL)
+    {
+        std::ostringstream ostr;
+        ostr << "#-,tid:" << std::this_thread::get_id()
+             << streamsForLevels[ERROR_LEVEL].prefix
+             << ":[LOGGER] lines dropped: " << dropped - reportedDroppedCount;
+        append(Record{ERROR_LEVEL, std::move(ostr).str()});
+    }
+    reportedDroppedCount = dropped;
+
+    for (auto& record: batch)
+    {
+        append(record);
+    }
+    for (std::size_t i = 0u; i < allStreams.size(); ++i)
+    {
+        if (not buffers[i].empty())
+        {
+            allStreams[i]->write(buffers[i].data(), buffers[i].size());
+            allStreams[i]->flush();
+            buffers[i].clear();
+        }
+    }
+
+    writtenPosition.store(popPosition.load(std::memory_order_relaxed), std::memory_order_release);
+    writtenPosition.notify_all();
+}
+
+} // namespace common
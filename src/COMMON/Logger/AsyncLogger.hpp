@@ -0,0 +1,99 @@
+#pragma once
+
+#include "ILogger.hpp"
+#include "Logger.hpp"
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace common
+{
+
+/**
+ * Logger which only formats the line in the calling thread - the line is pushed into bounded
+ * lock-free queue (many producers, one consumer), streams are written by own writer thread,
+ * in batches: one write and one flush per stream for all lines taken at once.
+ *
+ * Printout is the same as of Logger.
+ */
+class AsyncLogger : public ILogger
+{
+public:
+    using LevelInfo = Logger::LevelInfo;
+
+    enum class OverflowPolicy
+    {
+        Block, // caller waits till writer makes room
+        Drop   // line is dropped and counted, number of dropped lines is printed by writer
+    };
+
+    struct Options
+    {
+        std::size_t capacity = 8192u; // rounded up to power of 2
+        OverflowPolicy overflowPolicy = OverflowPolicy::Block;
+    };
+
+    AsyncLogger(std::ostream& logfile);
+    AsyncLogger(std::ostream& logfile, Options options);
+    AsyncLogger(std::initializer_list<LevelInfo> streamsForLevels);
+    AsyncLogger(std::initializer_list<LevelInfo> streamsForLevels, Options options);
+    // all lines logged before are written
+    ~AsyncLogger() override;
+
+    void log(Level level, const std::string& message) override;
+    bool isEnabled(Level level) const override;
+
+    void setMinimumLevel(Level level);
+    Level getMinimumLevel() const;
+
+    // waits till all lines logged before are written and flushed
+    void flush();
+    std::uint64_t getDroppedCount() const;
+
+private:
+    struct Record
+    {
+        Level level;
+        std::string line;
+    };
+
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence;
+        Record record;
+    };
+
+    bool tryPush(Record& record);
+    bool tryPop(Record& record);
+    void writerLoop();
+    void writeBatch(std::vector<Record>& batch);
+
+    const std::vector<LevelInfo> streamsForLevels;
+    std::vector<std::ostream*> allStreams;
+    // writer thread only - one buffer per stream
+    std::vector<std::string> buffers;
+    const OverflowPolicy overflowPolicy;
+    const std::size_t mask;
+    std::unique_ptr<Slot[]> slots;
+
+    alignas(64) std::atomic<std::uint64_t> pushPosition{0u};
+    alignas(64) std::atomic<std::uint64_t> popPosition{0u};
+    // positions below were written and flushed
+    alignas(64) std::atomic<std::uint64_t> writtenPosition{0u};
+    std::atomic<std::uint32_t> pushed{0u};
+    std::atomic<bool> writerSleeping{false};
+    std::atomic<bool> stopping{false};
+
+    std::atomic<Level> minimumLevel{DEBUG_LEVEL};
+    std::atomic_size_t printoutNumber{};
+    std::atomic<std::uint64_t> droppedCount{0u};
+    std::uint64_t reportedDroppedCount{0u};
+
+    std::thread writer;
+};
+
+} // namespace common
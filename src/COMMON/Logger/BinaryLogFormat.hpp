@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace common::binary_log
+{
+
+/**
+ * Binary log file: MAGIC, then records, every starting with RecordKind.
+ * Numbers are little endian.
+ *
+ * LevelName: level(u8), length(u16), text
+ * String:    id(u32), length(u16), text - defined before first use, for prefixes, formats, thread ids
+ * Line:      level(u8), number(u64), timestamp(u64, ns since epoch), thread(u32), prefix(u32), format(u32),
+ *            length(u32), arguments - see LogRecord
+ */
+constexpr std::string_view MAGIC{"PKBLOG1\n"};
+
+enum class RecordKind : std::uint8_t
+{
+    LevelName = 'L',
+    String = 'S',
+    Line = 'R'
+};
+
+using StringId = std::uint32_t;
+
+template <typename T>
+void writeNumber(std::vector<std::uint8_t>& out, T value)
+{
+    for (std::size_t i = 0u; i < sizeof(T); ++i)
+    {
+        out.push_back(static_cast<std::uint8_t>(static_cast<std::uint64_t>(value) >> (8u * i)));
+    }
+}
+
+template <typename T>
+T readNumber(const std::uint8_t* in)
+{
+    std::uint64_t value = 0u;
+    for (std::size_t i = 0u; i < sizeof(T); ++i)
+    {
+        value |= std::uint64_t{in[i]} << (8u * i);
+    }
+    return static_cast<T>(value);
+}
+
+}
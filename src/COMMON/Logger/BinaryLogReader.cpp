@@ -0,0 +1,135 @@
+#include "BinaryLogReader.hpp"
+#include "LogRecord.hpp"
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace common
+{
+
+using namespace binary_log;
+
+BinaryLogReader::BinaryLogReader(std::istream &input)
+    : BinaryLogReader(input, Filter{})
+{}
+
+BinaryLogReader::BinaryLogReader(std::istream &input, Filter filter)
+    : input(input),
+      filter(filter)
+{
+    if (readText(MAGIC.size()) != MAGIC)
+    {
+        throw ReadEx("Not a binary log");
+    }
+}
+
+std::optional<std::string> BinaryLogReader::readLine()
+{
+    while (input.peek() != std::istream::traits_type::eof())
+    {
+        switch (static_cast<RecordKind>(read<std::uint8_t>()))
+        {
+        case RecordKind::LevelName:
+        {
+            auto level = read<std::uint8_t>();
+            levelNames[level] = readText(read<std::uint16_t>());
+            break;
+        }
+        case RecordKind::String:
+        {
+            auto id = read<StringId>();
+            if (id != strings.size())
+            {
+                throw ReadEx("String defined out of order: " + std::to_string(id));
+            }
+            strings.push_back(readText(read<std::uint16_t>()));
+            break;
+        }
+        case RecordKind::Line:
+            if (auto line = readLineRecord())
+            {
+                return line;
+            }
+            break;
+        default:
+            throw ReadEx("Unknown record kind");
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string> BinaryLogReader::readLineRecord()
+{
+    auto level = read<std::uint8_t>();
+    auto number = read<std::uint64_t>();
+    auto timestamp = read<std::uint64_t>();
+    auto& thread = getString(read<StringId>());
+    auto& prefix = getString(read<StringId>());
+    auto& format = getString(read<StringId>());
+    arguments.resize(read<std::uint32_t>());
+    if (not input.read(reinterpret_cast<char*>(arguments.data()), arguments.size()))
+    {
+        throw ReadEx("Unexpected end of log");
+    }
+
+    try
+    {
+        if (not LogRecord::refersTo(arguments, filter.phoneNumber, filter.messageId))
+        {
+            return std::nullopt;
+        }
+
+        std::ostringstream ostr;
+        if (filter.printTime)
+        {
+            using namespace std::chrono;
+            auto time = system_clock::time_point(duration_cast<system_clock::duration>(nanoseconds(timestamp)));
+            auto timeT = system_clock::to_time_t(time);
+            ostr << std::put_time(std::localtime(&timeT), "%Y-%m-%d %H:%M:%S")
+                 << '.' << std::setfill('0') << std::setw(6) << (timestamp / 1000u) % 1000000u << ' ';
+        }
+        auto levelName = levelNames.find(level);
+        ostr << "#" << number
+             << ",tid:" << thread
+             << (levelName != levelNames.end() ? levelName->second : "[LEVEL" + std::to_string(level) + "]")
+             << ":" << LogRecord::render(prefix, format, arguments);
+        return std::move(ostr).str();
+    }
+    catch (std::out_of_range& ex)
+    {
+        throw ReadEx(ex.what());
+    }
+}
+
+template <typename T>
+T BinaryLogReader::read()
+{
+    std::uint8_t bytes[sizeof(T)];
+    if (not input.read(reinterpret_cast<char*>(bytes), sizeof(T)))
+    {
+        throw ReadEx("Unexpected end of log");
+    }
+    return readNumber<T>(bytes);
+}
+
+std::string BinaryLogReader::readText(std::size_t length)
+{
+    std::string text(length, '\0');
+    if (not input.read(text.data(), length))
+    {
+        throw ReadEx("Unexpected end of log");
+    }
+    return text;
+}
+
+const std::string &BinaryLogReader::getString(StringId id) const
+{
+    if (id >= strings.size())
+    {
+        throw ReadEx("String not defined: " + std::to_string(id));
+    }
+    return strings[id];
+}
+
+}
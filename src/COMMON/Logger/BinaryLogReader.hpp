@@ -0,0 +1,63 @@
+#pragma once
+
+#include "BinaryLogFormat.hpp"
+#include "Messages/MessageId.hpp"
+#include "Messages/PhoneNumber.hpp"
+#include <istream>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace common
+{
+
+/**
+ * Reads binary log (see BinaryLogger) - lines are printed as Logger prints them
+ */
+class BinaryLogReader
+{
+public:
+    class ReadEx : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    struct Filter
+    {
+        // lines having given phone number/message id as value (also in message header)
+        std::optional<PhoneNumber> phoneNumber;
+        std::optional<MessageId> messageId;
+        // line starts with local time of logging
+        bool printTime = false;
+    };
+
+    /**
+     * @throw ReadEx when it is not a binary log
+     */
+    BinaryLogReader(std::istream& input);
+    BinaryLogReader(std::istream& input, Filter filter);
+
+    /**
+     * @return next line passing filter or nothing at end of log
+     * @throw ReadEx when log is corrupted
+     */
+    std::optional<std::string> readLine();
+
+private:
+    template <typename T>
+    T read();
+    std::string readText(std::size_t length);
+    const std::string& getString(binary_log::StringId id) const;
+    std::optional<std::string> readLineRecord();
+
+    std::istream& input;
+    Filter filter;
+    std::map<std::uint8_t, std::string> levelNames;
+    std::vector<std::string> strings;
+    std::vector<std::uint8_t> arguments;
+};
+
+}
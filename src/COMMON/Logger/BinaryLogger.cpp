@@ -0,0 +1,131 @@
+#include "BinaryLogger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace common
+{
+
+using namespace binary_log;
+
+BinaryLogger::BinaryLogger(std::ostream& logfile)
+    : BinaryLogger(logfile, {"[DEBUG]", "", "[ERROR]"})
+{
+    static_assert(DEBUG_LEVEL == 0, "In this constructor DEBUG is assumed to be 0");
+    static_assert(INFO_LEVEL == 1, "In this constructor INFO is assumed to be 1");
+    static_assert(ERROR_LEVEL == 2, "In this constructor ERROR is assumed to be 2");
+}
+
+BinaryLogger::BinaryLogger(std::ostream& logfile, std::initializer_list<std::string> levelNames)
+    : logfile(logfile)
+{
+    logfile.write(MAGIC.data(), MAGIC.size());
+    std::uint8_t level = 0u;
+    for (auto& levelName: levelNames)
+    {
+        buffer.push_back(static_cast<std::uint8_t>(RecordKind::LevelName));
+        writeNumber<std::uint8_t>(buffer, level++);
+        writeNumber<std::uint16_t>(buffer, levelName.size());
+        buffer.insert(buffer.end(), levelName.begin(), levelName.end());
+    }
+    writeBuffer();
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    flush();
+}
+
+void BinaryLogger::log(Level level, const std::string &message)
+{
+    if (not isEnabled(level))
+    {
+        return;
+    }
+    LogRecord record;
+    record.add(message);
+    logRecord(level, record);
+}
+
+bool BinaryLogger::isEnabled(Level level) const
+{
+    return level >= minimumLevel.load(std::memory_order_relaxed);
+}
+
+bool BinaryLogger::acceptsRecords() const
+{
+    return true;
+}
+
+void BinaryLogger::logRecord(Level level, LogRecord &record)
+{
+    thread_local const std::string thisThreadId = [] {
+        std::ostringstream ostr;
+        ostr << std::this_thread::get_id();
+        return std::move(ostr).str();
+    }();
+    auto number = ++printoutNumber;
+    auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    auto arguments = record.getArguments();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    auto threadId = intern(thisThreadId);
+    auto prefixId = intern(record.getPrefix());
+    auto formatId = intern(record.getFormat());
+
+    buffer.push_back(static_cast<std::uint8_t>(RecordKind::Line));
+    writeNumber<std::uint8_t>(buffer, level);
+    writeNumber<std::uint64_t>(buffer, number);
+    writeNumber<std::uint64_t>(buffer, timestamp);
+    writeNumber<StringId>(buffer, threadId);
+    writeNumber<StringId>(buffer, prefixId);
+    writeNumber<StringId>(buffer, formatId);
+    writeNumber<std::uint32_t>(buffer, arguments.size());
+    buffer.insert(buffer.end(), arguments.begin(), arguments.end());
+    writeBuffer();
+}
+
+void BinaryLogger::setMinimumLevel(Level level)
+{
+    minimumLevel.store(level, std::memory_order_relaxed);
+}
+
+ILogger::Level BinaryLogger::getMinimumLevel() const
+{
+    return minimumLevel.load(std::memory_order_relaxed);
+}
+
+void BinaryLogger::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    logfile.flush();
+}
+
+StringId BinaryLogger::intern(const std::string &text)
+{
+    auto found = strings.find(text);
+    if (found != strings.end())
+    {
+        return found->second;
+    }
+    StringId id = strings.size();
+    strings.emplace(text, id);
+
+    auto length = std::min<std::size_t>(text.size(), std::numeric_limits<std::uint16_t>::max());
+    buffer.push_back(static_cast<std::uint8_t>(RecordKind::String));
+    writeNumber<StringId>(buffer, id);
+    writeNumber<std::uint16_t>(buffer, length);
+    buffer.insert(buffer.end(), text.begin(), text.begin() + length);
+    return id;
+}
+
+void BinaryLogger::writeBuffer()
+{
+    logfile.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    buffer.clear();
+}
+
+} // namespace common
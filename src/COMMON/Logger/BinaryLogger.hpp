@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ILogger.hpp"
+#include "BinaryLogFormat.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace common
+{
+
+/**
+ * Logger writing binary records - see BinaryLogFormat.hpp.
+ * Prefixes, formats (string literals of the line) and thread ids are written once,
+ * values are written in binary form, e.g. messages are not printed as hex.
+ *
+ * Use logdecode tool to get text log.
+ */
+class BinaryLogger : public ILogger
+{
+public:
+    BinaryLogger(std::ostream& logfile);
+    BinaryLogger(std::ostream& logfile, std::initializer_list<std::string> levelNames);
+    ~BinaryLogger() override;
+
+    void log(Level level, const std::string& message) override;
+    bool isEnabled(Level level) const override;
+    bool acceptsRecords() const override;
+    void logRecord(Level level, LogRecord& record) override;
+
+    void setMinimumLevel(Level level);
+    Level getMinimumLevel() const;
+
+    void flush();
+
+private:
+    // shall be called with mutex locked
+    binary_log::StringId intern(const std::string& text);
+    void writeBuffer();
+
+    std::ostream& logfile;
+    std::mutex mutex;
+    std::unordered_map<std::string, binary_log::StringId> strings;
+    std::vector<std::uint8_t> buffer;
+
+    std::atomic<Level> minimumLevel{DEBUG_LEVEL};
+    std::atomic<std::uint64_t> printoutNumber{};
+};
+
+} // namespace common
@@ -6,6 +6,7 @@
 #include <sstream>
 #include <type_traits>
 #include <tuple>
+#include "LogRecord.hpp"
 
 namespace common
 {
@@ -30,7 +31,25 @@ public:
     static constexpr Level ERROR_LEVEL = 2;
     // user might define more levels, these are just predefined...
 
+    // build with COMMON_LOGGER_STRIP_DEBUG (cmake -DSTRIP_DEBUG_LOGS=ON) to remove all logDebug() calls
+#ifdef COMMON_LOGGER_STRIP_DEBUG
+    static constexpr bool DEBUG_COMPILED = false;
+#else
+    static constexpr bool DEBUG_COMPILED = true;
+#endif
+
     virtual void log(Level level, const std::string& message) = 0;
+    /**
+     * Checked before message is formatted - values of disabled levels are not printed at all
+     */
+    virtual bool isEnabled(Level level) const;
+
+    /**
+     * Loggers accepting records get values not formatted yet - see LogRecord, BinaryLogger
+     */
+    virtual bool acceptsRecords() const;
+    // by default - record is formatted as text
+    virtual void logRecord(Level level, LogRecord& record);
 
     // shortcuts machinery
     template <typename ...Value>
@@ -51,13 +70,27 @@ inline void ILogger::logInfo(Value&& ...value)
 template <typename ...Value>
 inline void ILogger::logDebug(Value&& ...value)
 {
-    log(DEBUG_LEVEL, std::forward<Value>(value)...);
+    if constexpr (DEBUG_COMPILED)
+    {
+        log(DEBUG_LEVEL, std::forward<Value>(value)...);
+    }
 }
 
 // shortcuts machinery
 template <typename ...Value>
 inline void ILogger::log(Level level, Value&& ...value)
 {
+    if (not isEnabled(level))
+    {
+        return;
+    }
+    if (acceptsRecords())
+    {
+        LogRecord record;
+        (record.add(value), ...);
+        logRecord(level, record);
+        return;
+    }
     std::ostringstream os;
     ((os << std::forward<Value>(value)), ...);
     const std::string message = std::move(os).str();
@@ -66,7 +99,25 @@ inline void ILogger::log(Level level, Value&& ...value)
 
 inline void ILogger::log(Level level, std::string_view value)
 {
-    log(level, std::string(value));
+    if (isEnabled(level))
+    {
+        log(level, std::string(value));
+    }
+}
+
+inline bool ILogger::isEnabled(Level) const
+{
+    return true;
+}
+
+inline bool ILogger::acceptsRecords() const
+{
+    return false;
+}
+
+inline void ILogger::logRecord(Level level, LogRecord& record)
+{
+    log(level, record.toText());
 }
 
 } // namespace common
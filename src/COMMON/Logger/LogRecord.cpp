@@ -0,0 +1,267 @@
+#include "LogRecord.hpp"
+#include "BinaryLogFormat.hpp"
+#include "Messages/BinaryMessage.hpp"
+#include "Messages/Frame.hpp"
+#include "Messages/MessageHeader.hpp"
+#include <algorithm>
+#include <bit>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+namespace common
+{
+
+namespace
+{
+
+using binary_log::writeNumber;
+
+class ArgumentReader
+{
+public:
+    ArgumentReader(std::span<const std::uint8_t> arguments)
+        : arguments(arguments)
+    {}
+
+    bool atEnd() const
+    {
+        return position == arguments.size();
+    }
+
+    template <typename T>
+    T readNumber()
+    {
+        return binary_log::readNumber<T>(take(sizeof(T)).data());
+    }
+
+    std::span<const std::uint8_t> readSized()
+    {
+        return take(readNumber<std::uint16_t>());
+    }
+
+    PhoneNumber readPhoneNumber()
+    {
+        return PhoneNumber{ static_cast<PhoneNumber::Value>(readNumber<std::uint32_t>()) };
+    }
+
+    MessageHeader readMessageHeader()
+    {
+        MessageHeader header;
+        header.messageId = static_cast<MessageId>(readNumber<std::uint8_t>());
+        header.from = readPhoneNumber();
+        header.to = readPhoneNumber();
+        return header;
+    }
+
+private:
+    std::span<const std::uint8_t> take(std::size_t length)
+    {
+        if (arguments.size() - position < length)
+        {
+            throw std::out_of_range("Log record arguments corrupted");
+        }
+        auto result = arguments.subspan(position, length);
+        position += length;
+        return result;
+    }
+
+    std::span<const std::uint8_t> arguments;
+    std::size_t position = 0u;
+};
+
+void renderArgument(std::ostream& os, ArgumentReader& reader)
+{
+    using ArgumentType = LogRecord::ArgumentType;
+    switch (static_cast<ArgumentType>(reader.readNumber<std::uint8_t>()))
+    {
+    case ArgumentType::Text:
+    {
+        auto text = reader.readSized();
+        os.write(reinterpret_cast<const char*>(text.data()), text.size());
+        break;
+    }
+    case ArgumentType::Signed:
+        os << reader.readNumber<std::int64_t>();
+        break;
+    case ArgumentType::Unsigned:
+        os << reader.readNumber<std::uint64_t>();
+        break;
+    case ArgumentType::Floating:
+        os << std::bit_cast<double>(reader.readNumber<std::uint64_t>());
+        break;
+    case ArgumentType::PhoneNumber:
+        os << reader.readPhoneNumber();
+        break;
+    case ArgumentType::MessageId:
+        os << static_cast<MessageId>(reader.readNumber<std::uint8_t>());
+        break;
+    case ArgumentType::MessageHeader:
+        os << reader.readMessageHeader();
+        break;
+    case ArgumentType::Bytes:
+    {
+        // as BinaryMessage is printed
+        std::ios originalState(nullptr);
+        originalState.copyfmt(os);
+        for (auto b: reader.readSized())
+        {
+            os << std::hex << std::setfill('0') << std::setw(2) << static_cast<std::uint32_t>(b);
+        }
+        os.copyfmt(originalState);
+        break;
+    }
+    default:
+        throw std::out_of_range("Log record argument type unknown");
+    }
+}
+
+}
+
+void LogRecord::add(const PhoneNumber &value)
+{
+    addArgument(ArgumentType::PhoneNumber);
+    writeNumber<std::uint32_t>(arguments, value.value);
+}
+
+void LogRecord::add(MessageId value)
+{
+    addArgument(ArgumentType::MessageId);
+    writeNumber<std::uint8_t>(arguments, get(value));
+}
+
+void LogRecord::add(const MessageHeader &value)
+{
+    addArgument(ArgumentType::MessageHeader);
+    writeNumber<std::uint8_t>(arguments, get(value.messageId));
+    writeNumber<std::uint32_t>(arguments, value.from.value);
+    writeNumber<std::uint32_t>(arguments, value.to.value);
+}
+
+void LogRecord::add(const BinaryMessage &value)
+{
+    addBytes(std::span<const std::uint8_t>(value.value.data(), value.value.size()));
+}
+
+void LogRecord::add(const Frame &value)
+{
+    addBytes(value.view());
+}
+
+void LogRecord::addPrefix(std::string_view prefix)
+{
+    this->prefix.insert(0u, prefix);
+}
+
+std::string LogRecord::toText() const
+{
+    return render(prefix, format, arguments);
+}
+
+std::string LogRecord::render(std::string_view prefix, std::string_view format,
+                              std::span<const std::uint8_t> arguments)
+{
+    std::ostringstream os;
+    os << prefix;
+    ArgumentReader reader(arguments);
+    for (auto c: format)
+    {
+        if (c == PLACEHOLDER)
+        {
+            renderArgument(os, reader);
+        }
+        else
+        {
+            os.put(c);
+        }
+    }
+    return std::move(os).str();
+}
+
+bool LogRecord::refersTo(std::span<const std::uint8_t> arguments,
+                         std::optional<PhoneNumber> phoneNumber,
+                         std::optional<MessageId> messageId)
+{
+    bool phoneNumberFound = not phoneNumber.has_value();
+    bool messageIdFound = not messageId.has_value();
+    ArgumentReader reader(arguments);
+    while (not reader.atEnd())
+    {
+        switch (static_cast<ArgumentType>(reader.readNumber<std::uint8_t>()))
+        {
+        case ArgumentType::Text:
+        case ArgumentType::Bytes:
+            reader.readSized();
+            break;
+        case ArgumentType::Signed:
+        case ArgumentType::Unsigned:
+        case ArgumentType::Floating:
+            reader.readNumber<std::uint64_t>();
+            break;
+        case ArgumentType::PhoneNumber:
+        {
+            auto value = reader.readPhoneNumber();
+            phoneNumberFound = phoneNumberFound or value == *phoneNumber;
+            break;
+        }
+        case ArgumentType::MessageId:
+        {
+            auto value = static_cast<MessageId>(reader.readNumber<std::uint8_t>());
+            messageIdFound = messageIdFound or value == *messageId;
+            break;
+        }
+        case ArgumentType::MessageHeader:
+        {
+            auto header = reader.readMessageHeader();
+            phoneNumberFound = phoneNumberFound or header.from == *phoneNumber or header.to == *phoneNumber;
+            messageIdFound = messageIdFound or header.messageId == *messageId;
+            break;
+        }
+        default:
+            throw std::out_of_range("Log record argument type unknown");
+        }
+    }
+    return phoneNumberFound and messageIdFound;
+}
+
+void LogRecord::addText(std::string_view value)
+{
+    addArgument(ArgumentType::Text);
+    value = value.substr(0u, std::numeric_limits<std::uint16_t>::max());
+    writeNumber<std::uint16_t>(arguments, value.size());
+    arguments.insert(arguments.end(), value.begin(), value.end());
+}
+
+void LogRecord::addSigned(std::int64_t value)
+{
+    addArgument(ArgumentType::Signed);
+    writeNumber(arguments, value);
+}
+
+void LogRecord::addUnsigned(std::uint64_t value)
+{
+    addArgument(ArgumentType::Unsigned);
+    writeNumber(arguments, value);
+}
+
+void LogRecord::addFloating(double value)
+{
+    addArgument(ArgumentType::Floating);
+    writeNumber(arguments, std::bit_cast<std::uint64_t>(value));
+}
+
+void LogRecord::addBytes(std::span<const std::uint8_t> value)
+{
+    addArgument(ArgumentType::Bytes);
+    value = value.first(std::min<std::size_t>(value.size(), std::numeric_limits<std::uint16_t>::max()));
+    writeNumber<std::uint16_t>(arguments, value.size());
+    arguments.insert(arguments.end(), value.begin(), value.end());
+}
+
+void LogRecord::addArgument(ArgumentType type)
+{
+    format.push_back(PLACEHOLDER);
+    arguments.push_back(static_cast<std::uint8_t>(type));
+}
+
+}
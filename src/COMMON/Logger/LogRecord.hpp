@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace common
+{
+
+struct PhoneNumber;
+enum class MessageId : std::uint8_t;
+struct MessageHeader;
+struct BinaryMessage;
+class Frame;
+
+/**
+ * Log line not formatted yet: string literals make its format, other values are kept as typed arguments.
+ * Used by loggers which store lines in binary form - see ILogger::acceptsRecords(), BinaryLogger.
+ */
+class LogRecord
+{
+public:
+    // marks place of argument in format
+    static constexpr char PLACEHOLDER = '\x1f';
+
+    enum class ArgumentType : std::uint8_t
+    {
+        Text,
+        Signed,
+        Unsigned,
+        Floating,
+        PhoneNumber,
+        MessageId,
+        MessageHeader,
+        Bytes
+    };
+
+    template <std::size_t N>
+    void add(const char (&literal)[N])
+    {
+        format.append(std::string_view(literal));
+    }
+    void add(const PhoneNumber& value);
+    void add(MessageId value);
+    void add(const MessageHeader& value);
+    void add(const BinaryMessage& value);
+    void add(const Frame& value);
+    template <typename T>
+    void add(const T& value);
+
+    // prefix of PrefixedLogger - outer prefixes are added before inner ones
+    void addPrefix(std::string_view prefix);
+
+    const std::string& getPrefix() const { return prefix; }
+    const std::string& getFormat() const { return format; }
+    std::span<const std::uint8_t> getArguments() const { return arguments; }
+
+    std::string toText() const;
+
+    /**
+     * @throw std::out_of_range when arguments are corrupted
+     */
+    static std::string render(std::string_view prefix, std::string_view format,
+                              std::span<const std::uint8_t> arguments);
+    /**
+     * @return true if any argument is/contains given phone number and message id (if given)
+     */
+    static bool refersTo(std::span<const std::uint8_t> arguments,
+                         std::optional<PhoneNumber> phoneNumber,
+                         std::optional<MessageId> messageId);
+
+private:
+    void addText(std::string_view value);
+    void addSigned(std::int64_t value);
+    void addUnsigned(std::uint64_t value);
+    void addFloating(double value);
+    void addBytes(std::span<const std::uint8_t> value);
+    void addArgument(ArgumentType type);
+
+    std::string prefix;
+    std::string format;
+    std::vector<std::uint8_t> arguments;
+};
+
+template <typename T>
+void LogRecord::add(const T& value)
+{
+    if constexpr (std::is_same_v<T, char> or std::is_same_v<T, signed char> or std::is_same_v<T, unsigned char>)
+    {
+        // printed as character by std::ostream
+        addText(std::string_view(reinterpret_cast<const char*>(&value), 1u));
+    }
+    else if constexpr (std::is_same_v<T, bool>)
+    {
+        addUnsigned(value ? 1u : 0u);
+    }
+    else if constexpr (std::is_integral_v<T> and std::is_signed_v<T>)
+    {
+        addSigned(value);
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        addUnsigned(value);
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        addFloating(value);
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+    {
+        addText(value);
+    }
+    else
+    {
+        std::ostringstream os;
+        os << value;
+        addText(std::move(os).str());
+    }
+}
+
+}
@@ -28,6 +28,10 @@ Logger::~Logger()
 
 void Logger::log(Level level, const std::string &message)
 {
+    if (not isEnabled(level))
+    {
+        return;
+    }
     auto& levelInfo = streamsForLevels.at(level);
     auto number = ++printoutNumber;
     auto thisThreadId = std::this_thread::get_id();
@@ -47,4 +51,19 @@ void Logger::log(Level level, const std::string &message)
     }
 }
 
+bool Logger::isEnabled(Level level) const
+{
+    return level >= minimumLevel.load(std::memory_order_relaxed);
+}
+
+void Logger::setMinimumLevel(Level level)
+{
+    minimumLevel.store(level, std::memory_order_relaxed);
+}
+
+ILogger::Level Logger::getMinimumLevel() const
+{
+    return minimumLevel.load(std::memory_order_relaxed);
+}
+
 } // namespace ue
@@ -23,9 +23,15 @@ public:
     ~Logger() override;
 
     void log(Level level, const std::string& message) override;
+    bool isEnabled(Level level) const override;
+
+    // levels below are not printed, might be changed while logging
+    void setMinimumLevel(Level level);
+    Level getMinimumLevel() const;
 
 private:
     std::vector<LevelInfo> streamsForLevels;
+    std::atomic<Level> minimumLevel{DEBUG_LEVEL};
     std::mutex printoutGuard;
     std::atomic_size_t printoutNumber{};
 };
@@ -26,4 +26,22 @@ void PrefixedLogger::log(Level level, const std::string &message)
     adaptee.log(level, prefix, message);
 }
 
+bool PrefixedLogger::isEnabled(Level level) const
+{
+    return adaptee.isEnabled(level);
+}
+
+bool PrefixedLogger::acceptsRecords() const
+{
+    return adaptee.acceptsRecords();
+}
+
+void PrefixedLogger::logRecord(Level level, LogRecord &record)
+{
+    std::ostringstream os;
+    prefix(os);
+    record.addPrefix(std::move(os).str());
+    adaptee.logRecord(level, record);
+}
+
 } // namespace common
@@ -36,6 +36,9 @@ public:
     PrefixedLogger(ILogger& adaptee, const std::string& prefix);
 
     void log(Level level, const std::string& message) override;
+    bool isEnabled(Level level) const override;
+    bool acceptsRecords() const override;
+    void logRecord(Level level, LogRecord& record) override;
 
 private:
     ILogger& adaptee;
@@ -2,3 +2,4 @@
 
 #include "Messages/MessageHeader.hpp"
 #include "Messages/BinaryMessage.hpp"
+#include "Messages/Frame.hpp"
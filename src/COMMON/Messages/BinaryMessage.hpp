@@ -4,6 +4,7 @@
 #include <iostream>
 #include <limits>
 #include "LimitedVector.hpp"
+#include "MessagePool.hpp"
 
 namespace common
 {
@@ -19,8 +20,10 @@ struct BinaryMessage
     using SizeType = std::uint16_t; // used in transport
     // for bigger types than uint8_t - consider to use other value than max (lower)
     static constexpr std::size_t MAX_SIZE = max_size_min(5000, std::numeric_limits<SizeType>::max());
+    // most of messages (header and a few bytes) are not allocated at all
+    static constexpr std::size_t INLINE_SIZE = 64;
 
-    using Value = LimitedVector<ValueType, SizeType, MAX_SIZE>;
+    using Value = LimitedVector<ValueType, SizeType, MAX_SIZE, PoolAllocator<ValueType>, INLINE_SIZE>;
 
     Value value;
 };
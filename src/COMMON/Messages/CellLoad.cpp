@@ -0,0 +1,35 @@
+#include "CellLoad.hpp"
+#include <algorithm>
+
+namespace common
+{
+
+CellLoad CellLoad::of(std::size_t attached, std::size_t attachedLimit, double forwardRate, double forwardRateLimit)
+{
+    double load = 0.0;
+    if (attachedLimit > 0u)
+    {
+        load = std::max(load, static_cast<double>(attached) / attachedLimit);
+    }
+    if (forwardRateLimit > 0.0)
+    {
+        load = std::max(load, forwardRate / forwardRateLimit);
+    }
+    return CellLoad{static_cast<std::uint8_t>(std::min(load * FULL, static_cast<double>(FULL)))};
+}
+
+std::optional<CellLoad> CellLoad::decode(Frame::View sibTrailing)
+{
+    if (sibTrailing.empty())
+    {
+        return std::nullopt;
+    }
+    return CellLoad{std::min(sibTrailing[0], FULL)};
+}
+
+std::ostream& operator << (std::ostream& os, const CellLoad& obj)
+{
+    return os << static_cast<unsigned>(obj.percent) << "%";
+}
+
+}
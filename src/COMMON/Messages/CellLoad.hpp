@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include "Messages/Frame.hpp"
+
+namespace common
+{
+
+/**
+ * How much of its capacity BTS uses: 0 - idle .. FULL - no more attaches admitted.
+ * Optionally sent in SIB (1 byte after BtsId), so UE can choose the least loaded BTS.
+ * Old UE read SIB fields without checking its length - so SIB with narrow header carries it too.
+ */
+struct CellLoad
+{
+    static constexpr std::uint8_t FULL = 100u;
+
+    std::uint8_t percent;
+
+    constexpr bool isFull() const { return percent >= FULL; }
+
+    /**
+     * @return load of the more loaded resource - both in range [0, limit], limit 0 means not limited
+     */
+    static CellLoad of(std::size_t attached, std::size_t attachedLimit, double forwardRate, double forwardRateLimit);
+
+    /**
+     * @return nothing for SIB without load (sent by BTS not measuring its load)
+     */
+    static std::optional<CellLoad> decode(Frame::View sibTrailing);
+};
+
+inline bool operator == (const CellLoad& lhs, const CellLoad& rhs)
+{
+    return lhs.percent == rhs.percent;
+}
+inline bool operator != (const CellLoad& lhs, const CellLoad& rhs)
+{
+    return !(lhs == rhs);
+}
+
+std::ostream& operator << (std::ostream& os, const CellLoad& obj);
+
+}
@@ -0,0 +1,100 @@
+#include "Frame.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <stdexcept>
+
+namespace common
+{
+
+Frame::Frame(BinaryMessage message)
+{
+    if (message.value.empty())
+    {
+        return;
+    }
+    auto holder = std::allocate_shared<const BinaryMessage>(PoolAllocator<BinaryMessage>(), std::move(message));
+    length = holder->value.size();
+    payload = std::shared_ptr<const ValueType>(holder, holder->value.data());
+}
+
+Frame::Frame(std::shared_ptr<const ValueType> payload, std::size_t length)
+    : payload(std::move(payload)),
+      length(length)
+{}
+
+Frame Frame::copyOf(View view)
+{
+    if (view.empty())
+    {
+        return Frame();
+    }
+    std::shared_ptr<ValueType[]> payload = std::allocate_shared_for_overwrite<ValueType[]>(PoolAllocator<ValueType>(), view.size());
+    std::memcpy(payload.get(), view.data(), view.size());
+    return Frame(std::shared_ptr<const ValueType>(payload, payload.get()), view.size());
+}
+
+const Frame::ValueType *Frame::data() const
+{
+    return payload.get();
+}
+
+std::size_t Frame::size() const
+{
+    return length;
+}
+
+bool Frame::empty() const
+{
+    return length == 0u;
+}
+
+Frame::const_iterator Frame::begin() const
+{
+    return data();
+}
+
+Frame::const_iterator Frame::end() const
+{
+    return data() + length;
+}
+
+Frame::View Frame::view() const
+{
+    return View(data(), length);
+}
+
+Frame Frame::slice(std::size_t offset, std::size_t length) const
+{
+    if (offset > this->length or length > this->length - offset)
+    {
+        throw std::out_of_range("Frame slice out of range");
+    }
+    return Frame(std::shared_ptr<const ValueType>(payload, data() + offset), length);
+}
+
+BinaryMessage Frame::toMessage() const
+{
+    return BinaryMessage{ BinaryMessage::Value(begin(), end()) };
+}
+
+bool operator == (const Frame& lhs, const Frame& rhs)
+{
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+std::ostream& operator << (std::ostream& os, const Frame& frame)
+{
+    std::ios originalState(nullptr);
+    originalState.copyfmt(os);
+
+    for (auto&& b: frame)
+    {
+        os << std::hex << std::setfill('0') << std::setw(2) << static_cast<std::uint32_t>(b);
+    }
+
+    os.copyfmt(originalState);
+    return os;
+}
+
+}
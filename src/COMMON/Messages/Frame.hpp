@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <span>
+#include "BinaryMessage.hpp"
+
+namespace common
+{
+
+/**
+ * Immutable message shared by reference counting - copying Frame never copies the payload.
+ * So a message received from one UE can be forwarded (through relay, to the other UE transport)
+ * without being copied at all.
+ */
+class Frame
+{
+public:
+    using ValueType = BinaryMessage::ValueType;
+    using value_type = ValueType;
+    using View = std::span<const ValueType>;
+    using const_iterator = const ValueType*;
+
+    Frame() = default;
+    /**
+     * Takes over the message - payload is not copied unless it is kept inline (see BinaryMessage::INLINE_SIZE)
+     */
+    Frame(BinaryMessage message);
+    /**
+     * Single allocation for both - the payload and the reference counter
+     */
+    static Frame copyOf(View view);
+
+    const ValueType* data() const;
+    std::size_t size() const;
+    bool empty() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    View view() const;
+
+    /**
+     * @return frame sharing this frame payload
+     */
+    Frame slice(std::size_t offset, std::size_t length) const;
+    BinaryMessage toMessage() const;
+
+private:
+    Frame(std::shared_ptr<const ValueType> payload, std::size_t length);
+
+    std::shared_ptr<const ValueType> payload;
+    std::size_t length = 0u;
+};
+
+bool operator == (const Frame& lhs, const Frame& rhs);
+inline bool operator != (const Frame& lhs, const Frame& rhs)
+{
+    return !(lhs == rhs);
+}
+
+std::ostream& operator << (std::ostream& os, const Frame& frame);
+
+}
@@ -1,12 +1,21 @@
 #include "IncomingMessage.hpp"
+#include "MessageSchema.hpp"
 #include <algorithm>
 
 namespace common
 {
 
 IncomingMessage::IncomingMessage(const BinaryMessage &message)
-    : cursor(message.value.begin()),
-      end(message.value.end())
+    : IncomingMessage(Frame::View(message.value.data(), message.value.size()))
+{}
+
+IncomingMessage::IncomingMessage(Frame::View message)
+    : cursor(message.data()),
+      end(message.data() + message.size())
+{}
+
+IncomingMessage::IncomingMessage(const Frame &message)
+    : IncomingMessage(message.view())
 {}
 
 MessageHeader IncomingMessage::readMessageHeader()
@@ -23,16 +32,7 @@ MessageId IncomingMessage::readMessageId()
 {
     using MessageIdType = std::underlying_type_t<MessageId>;
     MessageIdType value = readNumber<MessageIdType>();
-
-#define MESSAGE_ID_CASE(X) case get(MessageId::X): return MessageId::X;
-    switch (value)
-    {
-        FOR_ALL_MESSAGE_IDS(MESSAGE_ID_CASE)
-    default:
-        throw ReadEx("MessageId value out of range: "
-                     + std::to_string(static_cast<std::uint32_t>(value)));
-    }
-#undef MESSAGE_ID_CASE
+    return schema::FieldCodec<MessageId>::decode(&value);
 }
 
 template <>
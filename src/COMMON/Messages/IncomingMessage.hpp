@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Messages/BinaryMessage.hpp"
+#include "Messages/Frame.hpp"
 #include "Messages/MessageHeader.hpp"
 #include "Messages/BtsId.hpp"
 #include <stdexcept>
@@ -20,6 +21,11 @@ public:
     };
 
     IncomingMessage(const BinaryMessage& message);
+    /**
+     * Reads in place - message shall outlive this object
+     */
+    IncomingMessage(Frame::View message);
+    IncomingMessage(const Frame& message);
 
     template<typename T>
     static std::enable_if_t<not std::is_pointer<T>::value, IncomingMessage> create(const T& message)
@@ -51,7 +57,7 @@ public:
 
     void checkEndOfMessage();
 private:
-    using Cursor = BinaryMessage::Value::const_iterator;
+    using Cursor = const BinaryMessage::ValueType*;
     std::string readTextTo(Cursor position);
 
     Cursor cursor;
@@ -2,14 +2,27 @@
 
 #include <vector>
 #include <algorithm> // for std::min
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include "SmallVector.hpp"
 
 namespace common
 {
 
-template <typename ValueType, typename SizeType, SizeType MaxSize>
-class LimitedVector : private std::vector<ValueType>
+/**
+ * @tparam Allocator - e.g. PoolAllocator, see MessagePool
+ * @tparam InlineCapacity - that many values are kept inline (no allocation), zero means std::vector is used
+ */
+template <typename ValueType, typename SizeType, SizeType MaxSize,
+          typename Allocator = std::allocator<ValueType>, std::size_t InlineCapacity = 0u>
+class LimitedVector : private std::conditional_t<InlineCapacity == 0u,
+                                                 std::vector<ValueType, Allocator>,
+                                                 SmallVector<ValueType, InlineCapacity, Allocator>>
 {
-    using Impl = std::vector<ValueType>;
+    using Impl = std::conditional_t<InlineCapacity == 0u,
+                                    std::vector<ValueType, Allocator>,
+                                    SmallVector<ValueType, InlineCapacity, Allocator>>;
 public:
     using value_type = typename Impl::value_type;
     using Impl::pointer;
@@ -56,6 +69,11 @@ public:
         : Impl(values.begin(),
                values.size() > max_size() ? values.begin() + max_size() : values.end())
     {}
+    template <std::forward_iterator Iterator>
+    LimitedVector(Iterator first, Iterator last)
+        : Impl(first,
+               std::distance(first, last) > max_size() ? std::next(first, max_size()) : last)
+    {}
     void push_back(const value_type& value) noexcept
     {
         if (size() == max_size())
@@ -27,6 +27,10 @@ enum class MessageId : std::uint8_t
 };
 #undef MESSAGE_ID_ENTRY
 
+#define MESSAGE_ID_COUNT(X) + 1u
+constexpr std::size_t NUMBER_OF_MESSAGE_IDS = 0u FOR_ALL_MESSAGE_IDS(MESSAGE_ID_COUNT);
+#undef MESSAGE_ID_COUNT
+
 constexpr auto get(MessageId messageId)
 {
     return static_cast<std::underlying_type_t<MessageId>>(messageId);
@@ -0,0 +1,209 @@
+#include "MessagePool.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace common
+{
+
+constexpr std::array<std::size_t, 4> MessagePool::SIZE_CLASSES;
+
+namespace
+{
+
+constexpr std::size_t NUMBER_OF_CLASSES = MessagePool::SIZE_CLASSES.size();
+
+struct ThreadCache;
+
+struct alignas(std::max_align_t) BlockHeader
+{
+    ThreadCache* owner;
+};
+
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+struct ThreadCache
+{
+    struct FreeList
+    {
+        FreeBlock* head = nullptr;
+        std::size_t count = 0u;
+    };
+
+    std::array<FreeList, NUMBER_OF_CLASSES> local;
+    // pushed by other threads, taken at once by the owner - so no ABA problem
+    std::array<std::atomic<FreeBlock*>, NUMBER_OF_CLASSES> remote{};
+    // owner thread finished - cache waits for the next thread
+    std::atomic<bool> orphaned{false};
+};
+
+/**
+ * Caches are never destroyed - blocks might be on their way back from other threads.
+ * Cache of finished thread is taken over by the next new thread.
+ */
+class ThreadCacheRegistry
+{
+public:
+    ThreadCache* acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& cache: caches)
+        {
+            bool orphaned = true;
+            if (cache->orphaned.compare_exchange_strong(orphaned, false))
+            {
+                return cache.get();
+            }
+        }
+        caches.push_back(std::make_unique<ThreadCache>());
+        return caches.back().get();
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadCache>> caches;
+};
+
+ThreadCacheRegistry& registry()
+{
+    // intentionally never destroyed - thread caches shall outlive all pooled blocks
+    static auto& instance = *new ThreadCacheRegistry();
+    return instance;
+}
+
+enum class CacheState { NotStarted, Active, Finished };
+thread_local CacheState cacheState = CacheState::NotStarted;
+thread_local ThreadCache* currentCache = nullptr;
+
+struct ThreadCacheRelease
+{
+    ~ThreadCacheRelease()
+    {
+        cacheState = CacheState::Finished;
+        currentCache->orphaned = true;
+        currentCache = nullptr;
+    }
+};
+
+ThreadCache* threadCache()
+{
+    if (cacheState == CacheState::NotStarted)
+    {
+        thread_local ThreadCacheRelease release;
+        currentCache = registry().acquire();
+        cacheState = CacheState::Active;
+    }
+    return currentCache;
+}
+
+std::size_t classOf(std::size_t size)
+{
+    std::size_t sizeClass = 0u;
+    while (sizeClass < NUMBER_OF_CLASSES and size > MessagePool::SIZE_CLASSES[sizeClass])
+    {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+BlockHeader* headerOf(void* memory)
+{
+    return static_cast<BlockHeader*>(memory) - 1;
+}
+
+void pushRemote(ThreadCache& cache, std::size_t sizeClass, FreeBlock* block)
+{
+    auto& remote = cache.remote[sizeClass];
+    block->next = remote.load(std::memory_order_relaxed);
+    while (not remote.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+    {}
+}
+
+}
+
+void* MessagePool::allocate(std::size_t size)
+{
+    auto sizeClass = classOf(size);
+    if (sizeClass == NUMBER_OF_CLASSES)
+    {
+        return ::operator new(size);
+    }
+
+    ThreadCache* cache = threadCache();
+    if (cache)
+    {
+        auto& freeList = cache->local[sizeClass];
+        if (not freeList.head)
+        {
+            for (auto block = cache->remote[sizeClass].exchange(nullptr, std::memory_order_acquire); block; )
+            {
+                auto next = block->next;
+                block->next = freeList.head;
+                freeList.head = block;
+                ++freeList.count;
+                block = next;
+            }
+        }
+        if (auto block = freeList.head)
+        {
+            freeList.head = block->next;
+            --freeList.count;
+            return block;
+        }
+    }
+
+    auto header = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + SIZE_CLASSES[sizeClass]));
+    header->owner = cache;
+    return header + 1;
+}
+
+void MessagePool::deallocate(void* memory, std::size_t size) noexcept
+{
+    if (not memory)
+    {
+        return;
+    }
+    auto sizeClass = classOf(size);
+    if (sizeClass == NUMBER_OF_CLASSES)
+    {
+        ::operator delete(memory);
+        return;
+    }
+
+    auto header = headerOf(memory);
+    auto block = static_cast<FreeBlock*>(memory);
+    ThreadCache* owner = header->owner;
+    if (not owner)
+    {
+        // allocated when its thread had already finished
+        ::operator delete(header);
+    }
+    else if (cacheState != CacheState::Finished and owner == threadCache())
+    {
+        auto& freeList = owner->local[sizeClass];
+        if (freeList.count >= MAX_CACHED_PER_CLASS)
+        {
+            ::operator delete(header);
+            return;
+        }
+        block->next = freeList.head;
+        freeList.head = block;
+        ++freeList.count;
+    }
+    else
+    {
+        pushRemote(*owner, sizeClass, block);
+    }
+}
+
+std::size_t MessagePool::cachedInThisThread(std::size_t sizeClass)
+{
+    auto cache = threadCache();
+    return cache ? cache->local.at(sizeClass).count : 0u;
+}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <new>
+
+namespace common
+{
+
+/**
+ * Size class pool for message payloads - payloads are mostly tiny and never bigger than BinaryMessage::MAX_SIZE.
+ * Every thread has its own free lists, so allocation and deallocation in the same thread take no lock.
+ * Memory released by other thread goes back to the free lists of the thread that allocated it (lock free).
+ * Bigger than the biggest size class goes to global heap.
+ */
+class MessagePool
+{
+public:
+    static constexpr std::array<std::size_t, 4> SIZE_CLASSES{ 64u, 256u, 1024u, 8192u };
+    static constexpr std::size_t MAX_CACHED_PER_CLASS = 1024u;
+
+    static void* allocate(std::size_t size);
+    static void deallocate(void* memory, std::size_t size) noexcept;
+
+    /**
+     * @return number of blocks in free lists of this thread for given size class (remotely returned not included)
+     */
+    static std::size_t cachedInThisThread(std::size_t sizeClass);
+};
+
+template <typename T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Pool blocks are aligned as std::max_align_t");
+        return static_cast<T*>(MessagePool::allocate(n * sizeof(T)));
+    }
+    void deallocate(T* memory, std::size_t n) noexcept
+    {
+        MessagePool::deallocate(memory, n * sizeof(T));
+    }
+
+    template <typename U>
+    friend bool operator == (const PoolAllocator&, const PoolAllocator<U>&) noexcept
+    {
+        return true;
+    }
+    template <typename U>
+    friend bool operator != (const PoolAllocator&, const PoolAllocator<U>&) noexcept
+    {
+        return false;
+    }
+};
+
+}
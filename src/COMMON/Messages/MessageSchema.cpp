@@ -0,0 +1,55 @@
+#include "MessageSchema.hpp"
+
+namespace common::schema
+{
+
+MessageId FieldCodec<MessageId>::decode(const std::uint8_t *in)
+{
+    auto value = Codec::decode(in);
+    if ((value & WIDE_HEADER_FLAG) == 0u)
+    {
+        throw IncomingMessage::ReadEx("Narrow message header, MessageId: "
+                                      + std::to_string(static_cast<std::uint32_t>(value)));
+    }
+    value &= ~WIDE_HEADER_FLAG;
+#define MESSAGE_ID_CASE(X) case get(MessageId::X): return MessageId::X;
+    switch (value)
+    {
+        FOR_ALL_MESSAGE_IDS(MESSAGE_ID_CASE)
+    default:
+        throw IncomingMessage::ReadEx("MessageId value out of range: "
+                                      + std::to_string(static_cast<std::uint32_t>(value)));
+    }
+#undef MESSAGE_ID_CASE
+}
+
+void FieldCodec<MessageHeader>::encode(const MessageHeader &value, std::uint8_t *out)
+{
+    FieldCodec<MessageId>::encode(value.messageId, out);
+    out += FieldCodec<MessageId>::SIZE;
+    FieldCodec<PhoneNumber>::encode(value.from, out);
+    out += FieldCodec<PhoneNumber>::SIZE;
+    FieldCodec<PhoneNumber>::encode(value.to, out);
+}
+
+MessageHeader FieldCodec<MessageHeader>::decode(const std::uint8_t *in)
+{
+    MessageHeader header;
+    header.messageId = FieldCodec<MessageId>::decode(in);
+    in += FieldCodec<MessageId>::SIZE;
+    header.from = FieldCodec<PhoneNumber>::decode(in);
+    in += FieldCodec<PhoneNumber>::SIZE;
+    header.to = FieldCodec<PhoneNumber>::decode(in);
+    return header;
+}
+
+MessageHeader decodeHeader(Frame::View message)
+{
+    if (message.size() < HEADER_SIZE)
+    {
+        throw IncomingMessage::ReadEx("Message shorter than header: " + std::to_string(message.size()));
+    }
+    return FieldCodec<MessageHeader>::decode(message.data());
+}
+
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "Messages/BinaryMessage.hpp"
+#include "Messages/BtsId.hpp"
+#include "Messages/Frame.hpp"
+#include "Messages/IncomingMessage.hpp"
+#include "Messages/MessageHeader.hpp"
+
+namespace common::schema
+{
+
+/**
+ * How a field is put into message: always SIZE bytes, big endian, see specification.
+ */
+template <typename T, typename Enable = void>
+struct FieldCodec;
+
+template <typename T>
+struct FieldCodec<T, std::enable_if_t<std::is_unsigned<T>::value and not std::is_same<T, bool>::value>>
+{
+    static constexpr std::size_t SIZE = sizeof(T);
+
+    static void encode(T value, std::uint8_t* out)
+    {
+        encode(value, out, std::make_index_sequence<SIZE>{});
+    }
+    static T decode(const std::uint8_t* in)
+    {
+        return decode(in, std::make_index_sequence<SIZE>{});
+    }
+
+private:
+    template <std::size_t ...I>
+    static void encode(T value, std::uint8_t* out, std::index_sequence<I...>)
+    {
+        ((out[I] = static_cast<std::uint8_t>(value >> (8u * (SIZE - 1u - I)))), ...);
+    }
+    template <std::size_t ...I>
+    static T decode(const std::uint8_t* in, std::index_sequence<I...>)
+    {
+        return static_cast<T>((T{} | ... | (static_cast<T>(in[I]) << (8u * (SIZE - 1u - I)))));
+    }
+};
+
+template <>
+struct FieldCodec<bool>
+{
+    static constexpr std::size_t SIZE = 1u;
+    static void encode(bool value, std::uint8_t* out) { out[0] = value ? 1u : 0u; }
+    static bool decode(const std::uint8_t* in) { return in[0] != 0u; }
+};
+
+template <>
+struct FieldCodec<PhoneNumber>
+{
+    using Codec = FieldCodec<PhoneNumber::Value>;
+    static constexpr std::size_t SIZE = Codec::SIZE;
+    static void encode(PhoneNumber value, std::uint8_t* out) { Codec::encode(value.value, out); }
+    static PhoneNumber decode(const std::uint8_t* in) { return PhoneNumber{ Codec::decode(in) }; }
+};
+
+template <>
+struct FieldCodec<BtsId>
+{
+    using Codec = FieldCodec<decltype(BtsId::value)>;
+    static constexpr std::size_t SIZE = Codec::SIZE;
+    static void encode(BtsId value, std::uint8_t* out) { Codec::encode(value.value, out); }
+    static BtsId decode(const std::uint8_t* in) { return BtsId{ Codec::decode(in) }; }
+};
+
+/**
+ * Set in MessageId of header with 4 byte phone numbers.
+ * Old UE sends (and expects) narrow header - 1 byte numbers, no flag - see NarrowHeader.hpp
+ */
+constexpr std::uint8_t WIDE_HEADER_FLAG = 0x80u;
+
+template <>
+struct FieldCodec<MessageId>
+{
+    using Codec = FieldCodec<std::underlying_type_t<MessageId>>;
+    static constexpr std::size_t SIZE = Codec::SIZE;
+    static void encode(MessageId value, std::uint8_t* out) { Codec::encode(get(value) | WIDE_HEADER_FLAG, out); }
+    /**
+     * @throw IncomingMessage::ReadEx for value out of range or without WIDE_HEADER_FLAG
+     */
+    static MessageId decode(const std::uint8_t* in);
+};
+
+template <>
+struct FieldCodec<MessageHeader>
+{
+    static constexpr std::size_t SIZE = FieldCodec<MessageId>::SIZE + 2u * FieldCodec<PhoneNumber>::SIZE;
+    static void encode(const MessageHeader& value, std::uint8_t* out);
+    static MessageHeader decode(const std::uint8_t* in);
+};
+
+constexpr std::size_t HEADER_SIZE = FieldCodec<MessageHeader>::SIZE;
+
+/**
+ * What follows fixed size fields: nothing or any number of bytes till the end of message
+ * (e.g. encryption and text of Sms - interpreted by UE only)
+ */
+enum class Trailing { None, Bytes };
+
+template <Trailing TrailingBytes, typename ...Field>
+struct Layout
+{
+    using Body = std::tuple<Field...>;
+    static constexpr Trailing TRAILING = TrailingBytes;
+    static constexpr std::size_t FIXED_SIZE = HEADER_SIZE + (std::size_t{0u} + ... + FieldCodec<Field>::SIZE);
+    static constexpr std::array<std::size_t, sizeof...(Field)> OFFSETS = [] {
+        std::array<std::size_t, sizeof...(Field)> offsets{};
+        [[maybe_unused]] std::size_t offset = HEADER_SIZE, i = 0u;
+        ((offsets[i++] = offset, offset += FieldCodec<Field>::SIZE), ...);
+        return offsets;
+    }();
+};
+
+/**
+ * Message body (after header) of every MessageId - see specification
+ */
+template <MessageId Id>
+struct MessageSchema;
+
+// trailing: optional CellLoad
+template <> struct MessageSchema<MessageId::Sib> : Layout<Trailing::Bytes, BtsId> {};
+template <> struct MessageSchema<MessageId::AttachRequest> : Layout<Trailing::None, BtsId> {};
+template <> struct MessageSchema<MessageId::AttachResponse> : Layout<Trailing::None, bool> {};
+template <> struct MessageSchema<MessageId::UnknownRecipient> : Layout<Trailing::None, MessageHeader> {};
+template <> struct MessageSchema<MessageId::UnknownSender> : Layout<Trailing::None, MessageHeader> {};
+template <> struct MessageSchema<MessageId::Sms> : Layout<Trailing::Bytes> {};
+template <> struct MessageSchema<MessageId::CallRequest> : Layout<Trailing::Bytes> {};
+template <> struct MessageSchema<MessageId::CallAccepted> : Layout<Trailing::Bytes> {};
+template <> struct MessageSchema<MessageId::CallDropped> : Layout<Trailing::None> {};
+template <> struct MessageSchema<MessageId::CallTalk> : Layout<Trailing::Bytes> {};
+
+#define MESSAGE_SCHEMA_DEFINED(X) \
+    static_assert(MessageSchema<MessageId::X>::FIXED_SIZE >= HEADER_SIZE, "MessageSchema missing for: " #X);
+FOR_ALL_MESSAGE_IDS(MESSAGE_SCHEMA_DEFINED)
+#undef MESSAGE_SCHEMA_DEFINED
+
+template <MessageId Id>
+struct Message
+{
+    using Schema = MessageSchema<Id>;
+    static constexpr MessageId ID = Id;
+
+    MessageHeader header;
+    typename Schema::Body body;
+    // view into decoded message
+    Frame::View trailing;
+
+    template <std::size_t I>
+    const auto& get() const
+    {
+        return std::get<I>(body);
+    }
+};
+
+/**
+ * @throw IncomingMessage::ReadEx when message is shorter than header or MessageId is out of range
+ */
+MessageHeader decodeHeader(Frame::View message);
+
+/**
+ * Message length is checked once, then all fields are read from their fixed offsets
+ * @throw IncomingMessage::ReadEx when message is not of Id or its length does not match
+ */
+template <MessageId Id>
+Message<Id> decode(Frame::View message)
+{
+    using Schema = MessageSchema<Id>;
+    const bool wrongSize = Schema::TRAILING == Trailing::None ? message.size() != Schema::FIXED_SIZE
+                                                              : message.size() < Schema::FIXED_SIZE;
+    if (wrongSize or message[0] != (get(Id) | WIDE_HEADER_FLAG))
+    {
+        throw IncomingMessage::ReadEx("Not a " + to_string(Id) + " message of size: " + std::to_string(message.size()));
+    }
+
+    const std::uint8_t* in = message.data();
+    return Message<Id>{
+        FieldCodec<MessageHeader>::decode(in),
+        [in]<std::size_t ...I>(std::index_sequence<I...>) {
+            return typename Schema::Body{
+                FieldCodec<std::tuple_element_t<I, typename Schema::Body>>::decode(in + Schema::OFFSETS[I])... };
+        }(std::make_index_sequence<std::tuple_size<typename Schema::Body>::value>{}),
+        message.subspan(Schema::FIXED_SIZE)
+    };
+}
+
+/**
+ * Single allocation (if any - see BinaryMessage::INLINE_SIZE) of exact message length.
+ * Like OutgoingMessage - trailing bytes beyond BinaryMessage::MAX_SIZE are dropped.
+ */
+template <MessageId Id>
+BinaryMessage encode(PhoneNumber from, PhoneNumber to,
+                     const typename MessageSchema<Id>::Body& body = {},
+                     Frame::View trailing = {})
+{
+    using Schema = MessageSchema<Id>;
+    static_assert(Schema::FIXED_SIZE <= BinaryMessage::MAX_SIZE);
+
+    trailing = trailing.first(std::min(trailing.size(), BinaryMessage::MAX_SIZE - Schema::FIXED_SIZE));
+    BinaryMessage message{ BinaryMessage::Value(static_cast<BinaryMessage::SizeType>(Schema::FIXED_SIZE + trailing.size())) };
+    std::uint8_t* out = message.value.data();
+    FieldCodec<MessageHeader>::encode(MessageHeader{Id, from, to}, out);
+    [out, &body]<std::size_t ...I>(std::index_sequence<I...>) {
+        (FieldCodec<std::tuple_element_t<I, typename Schema::Body>>::encode(std::get<I>(body), out + Schema::OFFSETS[I]), ...);
+    }(std::make_index_sequence<std::tuple_size<typename Schema::Body>::value>{});
+    std::copy(trailing.begin(), trailing.end(), out + Schema::FIXED_SIZE);
+    return message;
+}
+
+}
@@ -0,0 +1,115 @@
+#include "NarrowHeader.hpp"
+#include "MessageSchema.hpp"
+#include <algorithm>
+
+namespace common::schema
+{
+
+namespace
+{
+
+constexpr std::size_t EMBEDDED_HEADER_DIFFERENCE = HEADER_SIZE - NARROW_HEADER_SIZE;
+
+MessageId decodeNarrowMessageId(const std::uint8_t* in)
+{
+    std::uint8_t wide = *in | WIDE_HEADER_FLAG;
+    return FieldCodec<MessageId>::decode(&wide);
+}
+
+MessageHeader decodeNarrow(const std::uint8_t* in)
+{
+    return MessageHeader{decodeNarrowMessageId(in), PhoneNumber{in[1]}, PhoneNumber{in[2]}};
+}
+
+bool fitsNarrow(const MessageHeader& header)
+{
+    return header.from.value <= NARROW_MAX_PHONE_NUMBER and header.to.value <= NARROW_MAX_PHONE_NUMBER;
+}
+
+void encodeNarrow(const MessageHeader& header, std::uint8_t* out)
+{
+    out[0] = get(header.messageId);
+    out[1] = static_cast<std::uint8_t>(header.from.value);
+    out[2] = static_cast<std::uint8_t>(header.to.value);
+}
+
+bool embedsHeader(MessageId messageId)
+{
+    return messageId == MessageId::UnknownRecipient or messageId == MessageId::UnknownSender;
+}
+
+}
+
+bool hasNarrowHeader(Frame::View message)
+{
+    if (message.empty())
+    {
+        throw IncomingMessage::ReadEx("Empty message");
+    }
+    return (message[0] & WIDE_HEADER_FLAG) == 0u;
+}
+
+MessageHeader decodeNarrowHeader(Frame::View message)
+{
+    if (message.size() < NARROW_HEADER_SIZE)
+    {
+        throw IncomingMessage::ReadEx("Message shorter than narrow header: " + std::to_string(message.size()));
+    }
+    return decodeNarrow(message.data());
+}
+
+BinaryMessage widenHeader(Frame::View message)
+{
+    auto header = decodeNarrowHeader(message);
+    auto body = message.subspan(NARROW_HEADER_SIZE);
+    const bool embedded = embedsHeader(header.messageId) and body.size() == NARROW_HEADER_SIZE;
+    auto size = HEADER_SIZE + body.size() + (embedded ? EMBEDDED_HEADER_DIFFERENCE : 0u);
+    if (size > BinaryMessage::MAX_SIZE)
+    {
+        // truncated payload would be delivered as if it was complete
+        throw IncomingMessage::ReadEx("Message too long for wide header: " + std::to_string(message.size()));
+    }
+
+    BinaryMessage wide{BinaryMessage::Value(static_cast<BinaryMessage::SizeType>(size))};
+    FieldCodec<MessageHeader>::encode(header, wide.value.data());
+    if (embedded)
+    {
+        FieldCodec<MessageHeader>::encode(decodeNarrow(body.data()), wide.value.data() + HEADER_SIZE);
+    }
+    else
+    {
+        std::copy(body.begin(), body.end(), wide.value.data() + HEADER_SIZE);
+    }
+    return wide;
+}
+
+std::optional<BinaryMessage> narrowHeader(Frame::View message)
+{
+    auto header = decodeHeader(message);
+    auto body = message.subspan(HEADER_SIZE);
+    const bool embedded = embedsHeader(header.messageId) and body.size() == HEADER_SIZE;
+    std::optional<MessageHeader> embeddedHeader;
+    if (embedded)
+    {
+        embeddedHeader = FieldCodec<MessageHeader>::decode(body.data());
+    }
+    if (not fitsNarrow(header) or (embeddedHeader and not fitsNarrow(*embeddedHeader)))
+    {
+        return std::nullopt;
+    }
+    auto size = NARROW_HEADER_SIZE + body.size() - (embedded ? EMBEDDED_HEADER_DIFFERENCE : 0u);
+
+    BinaryMessage narrow{BinaryMessage::Value(static_cast<BinaryMessage::SizeType>(size))};
+    encodeNarrow(header, narrow.value.data());
+    if (embedded)
+    {
+        encodeNarrow(*embeddedHeader, narrow.value.data() + NARROW_HEADER_SIZE);
+    }
+    else
+    {
+        std::copy(body.begin(), body.end(), narrow.value.data() + NARROW_HEADER_SIZE);
+    }
+    return narrow;
+}
+
+}
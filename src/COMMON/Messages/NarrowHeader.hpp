@@ -0,0 +1,42 @@
+#pragma once
+
+#include <optional>
+#include "Messages/BinaryMessage.hpp"
+#include "Messages/Frame.hpp"
+#include "Messages/MessageHeader.hpp"
+#include "Messages/PhoneNumber.hpp"
+
+namespace common::schema
+{
+
+/**
+ * Header of old UE: MessageId without WIDE_HEADER_FLAG, 1 byte phone numbers.
+ * Such messages are converted at connection edge - so application sees only wide headers.
+ */
+constexpr std::size_t NARROW_HEADER_SIZE = 3u;
+constexpr PhoneNumber::Value NARROW_MAX_PHONE_NUMBER = 255u;
+
+/**
+ * @throw IncomingMessage::ReadEx for empty message
+ */
+bool hasNarrowHeader(Frame::View message);
+
+/**
+ * @throw IncomingMessage::ReadEx when message is shorter than narrow header
+ */
+MessageHeader decodeNarrowHeader(Frame::View message);
+
+/**
+ * Header (also the one embedded in UnknownRecipient/UnknownSender) widened, rest of message copied
+ * @throw IncomingMessage::ReadEx when message is shorter than narrow header
+ *        or when widened it would be longer than BinaryMessage::MAX_SIZE
+ */
+BinaryMessage widenHeader(Frame::View message);
+
+/**
+ * @return nothing when any phone number does not fit in 1 byte
+ * @throw IncomingMessage::ReadEx when message is shorter than header
+ */
+std::optional<BinaryMessage> narrowHeader(Frame::View message);
+
+}
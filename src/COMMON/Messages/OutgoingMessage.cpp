@@ -1,4 +1,5 @@
 #include "OutgoingMessage.hpp"
+#include "MessageSchema.hpp"
 #include <algorithm>
 #include <iterator>
 
@@ -30,7 +31,9 @@ void OutgoingMessage::writePhoneNumber(const PhoneNumber &phoneNumber)
 
 void OutgoingMessage::writeMessageId(MessageId messageId)
 {
-    writeNumber(get(messageId));
+    std::underlying_type_t<MessageId> value;
+    schema::FieldCodec<MessageId>::encode(messageId, &value);
+    writeNumber(value);
 }
 
 void OutgoingMessage::writeText(const std::string &text)
@@ -8,6 +8,7 @@ constexpr const PhoneNumber::Value PhoneNumber::INVALID_VALUE;
 constexpr const PhoneNumber::Value PhoneNumber::MIN_VALUE;
 constexpr const PhoneNumber::Value PhoneNumber::MAX_VALUE;
 constexpr const std::size_t PhoneNumber::DIGITS;
+constexpr const std::size_t PhoneNumber::MAX_DIGITS;
 
 
 std::istream& operator >> (std::istream& is, PhoneNumber& obj)
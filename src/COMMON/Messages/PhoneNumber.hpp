@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <iostream>
+#include <limits>
 #include <string>
 
 namespace common
@@ -9,11 +10,13 @@ namespace common
 
 struct PhoneNumber
 {
-    using Value = std::uint8_t;
+    using Value = std::uint32_t;
     static constexpr const Value INVALID_VALUE = 0;
     static constexpr const Value MIN_VALUE = 1;
-    static constexpr const Value MAX_VALUE = 255;
+    static constexpr const Value MAX_VALUE = std::numeric_limits<Value>::max();
+    // printed at least with so many digits
     static constexpr const std::size_t DIGITS = 3;
+    static constexpr const std::size_t MAX_DIGITS = std::numeric_limits<Value>::digits10 + 1;
 
     Value value;
 
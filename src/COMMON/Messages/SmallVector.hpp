@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace common
+{
+
+/**
+ * Vector keeping up to InlineCapacity elements in itself - so without any allocation.
+ * Only what LimitedVector needs from std::vector, only for trivially copyable values.
+ */
+template <typename ValueType, std::size_t InlineCapacity, typename Allocator = std::allocator<ValueType>>
+class SmallVector : private Allocator
+{
+    static_assert(std::is_trivially_copyable<ValueType>::value, "SmallVector copies values as bytes");
+    static_assert(InlineCapacity > 0u, "Use std::vector when nothing shall be kept inline");
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+public:
+    using value_type = ValueType;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType*;
+    using const_pointer = const ValueType*;
+    using reference = ValueType&;
+    using const_reference = const ValueType&;
+    using iterator = ValueType*;
+    using const_iterator = const ValueType*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    SmallVector() noexcept = default;
+    explicit SmallVector(size_type size, const value_type& value = value_type())
+    {
+        reserve(size);
+        std::fill_n(storage, size, value);
+        length = size;
+    }
+    template <std::forward_iterator Iterator>
+    SmallVector(Iterator first, Iterator last)
+    {
+        reserve(static_cast<size_type>(std::distance(first, last)));
+        std::copy(first, last, storage);
+        length = static_cast<size_type>(std::distance(first, last));
+    }
+    SmallVector(std::initializer_list<value_type> values)
+        : SmallVector(values.begin(), values.end())
+    {}
+    SmallVector(const SmallVector& other)
+        : SmallVector(other.begin(), other.end())
+    {}
+    SmallVector(SmallVector&& other) noexcept
+    {
+        takeOver(other);
+    }
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            reserve(other.size());
+            std::copy(other.begin(), other.end(), storage);
+            length = other.size();
+        }
+        return *this;
+    }
+    SmallVector& operator=(SmallVector&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            takeOver(other);
+        }
+        return *this;
+    }
+    ~SmallVector()
+    {
+        release();
+    }
+
+    iterator begin() noexcept { return storage; }
+    const_iterator begin() const noexcept { return storage; }
+    const_iterator cbegin() const noexcept { return storage; }
+    iterator end() noexcept { return storage + length; }
+    const_iterator end() const noexcept { return storage + length; }
+    const_iterator cend() const noexcept { return storage + length; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    reference operator[](size_type index) noexcept { return storage[index]; }
+    const_reference operator[](size_type index) const noexcept { return storage[index]; }
+    reference at(size_type index) { checkIndex(index); return storage[index]; }
+    const_reference at(size_type index) const { checkIndex(index); return storage[index]; }
+    pointer data() noexcept { return storage; }
+    const_pointer data() const noexcept { return storage; }
+    reference front() noexcept { return storage[0]; }
+    const_reference front() const noexcept { return storage[0]; }
+    reference back() noexcept { return storage[length - 1]; }
+    const_reference back() const noexcept { return storage[length - 1]; }
+
+    bool empty() const noexcept { return length == 0u; }
+    size_type size() const noexcept { return length; }
+    size_type capacity() const noexcept { return allocated; }
+    bool isInline() const noexcept { return storage == inlineStorage; }
+
+    void clear() noexcept
+    {
+        length = 0u;
+    }
+    void reserve(size_type newCapacity)
+    {
+        if (newCapacity <= allocated)
+        {
+            return;
+        }
+        pointer newStorage = AllocatorTraits::allocate(*this, newCapacity);
+        std::copy(begin(), end(), newStorage);
+        release();
+        storage = newStorage;
+        allocated = newCapacity;
+    }
+    void push_back(const value_type& value)
+    {
+        if (length == allocated)
+        {
+            reserve(2u * allocated);
+        }
+        storage[length++] = value;
+    }
+
+    friend bool operator == (const SmallVector& lhs, const SmallVector& rhs) noexcept
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    friend bool operator != (const SmallVector& lhs, const SmallVector& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+    friend bool operator < (const SmallVector& lhs, const SmallVector& rhs) noexcept
+    {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    friend bool operator > (const SmallVector& lhs, const SmallVector& rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+    friend bool operator <= (const SmallVector& lhs, const SmallVector& rhs) noexcept
+    {
+        return !(rhs < lhs);
+    }
+    friend bool operator >= (const SmallVector& lhs, const SmallVector& rhs) noexcept
+    {
+        return !(lhs < rhs);
+    }
+
+private:
+    void checkIndex(size_type index) const
+    {
+        if (index >= length)
+        {
+            throw std::out_of_range("SmallVector index out of range");
+        }
+    }
+    void release() noexcept
+    {
+        if (not isInline())
+        {
+            AllocatorTraits::deallocate(*this, storage, allocated);
+            storage = inlineStorage;
+            allocated = InlineCapacity;
+        }
+    }
+    void takeOver(SmallVector& other) noexcept
+    {
+        if (other.isInline())
+        {
+            std::copy(other.begin(), other.end(), inlineStorage);
+        }
+        else
+        {
+            storage = other.storage;
+            allocated = other.allocated;
+            other.storage = other.inlineStorage;
+            other.allocated = InlineCapacity;
+        }
+        length = other.length;
+        other.length = 0u;
+    }
+
+    value_type inlineStorage[InlineCapacity];
+    pointer storage = inlineStorage;
+    size_type length = 0u;
+    size_type allocated = InlineCapacity;
+};
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace common
+{
+
+constexpr std::size_t CACHE_LINE_SIZE = 64u;
+
+/**
+ * Counters and gauges are updated with relaxed atomics and each takes whole cache line - so metrics
+ * updated by different threads never share one.
+ */
+class alignas(CACHE_LINE_SIZE) Counter
+{
+public:
+    using Value = std::uint64_t;
+
+    void increment(Value by = 1u)
+    {
+        value.fetch_add(by, std::memory_order_relaxed);
+    }
+    Value get() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<Value> value{0u};
+};
+
+class alignas(CACHE_LINE_SIZE) Gauge
+{
+public:
+    using Value = std::int64_t;
+
+    void set(Value newValue)
+    {
+        value.store(newValue, std::memory_order_relaxed);
+    }
+    void add(Value by)
+    {
+        value.fetch_add(by, std::memory_order_relaxed);
+    }
+    Value get() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<Value> value{0};
+};
+
+enum class MetricType
+{
+    Counter,
+    Gauge
+};
+
+/**
+ * Family of metrics - one instance per label value (e.g. per connection), or all instances summed up
+ * when there is no label name.
+ */
+struct MetricDefinition
+{
+    const char* name;
+    const char* help;
+    MetricType type;
+    const char* labelName = nullptr;
+};
+
+}
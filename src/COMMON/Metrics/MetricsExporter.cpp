@@ -0,0 +1,160 @@
+#include "MetricsExporter.hpp"
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace common
+{
+
+MetricsExporter::MetricsExporter(MetricsRegistry &registry, MetricsRegistry::Format format,
+                                 Target target, std::string path, std::chrono::milliseconds period,
+                                 ILogger &logger)
+    : registry(registry),
+      format(format),
+      target(target),
+      path(std::move(path)),
+      period(period),
+      logger(logger)
+{
+    if (period.count() <= 0)
+    {
+        throw std::invalid_argument("Metrics export period shall be positive");
+    }
+    if (target == Target::UnixSocket)
+    {
+        listen();
+    }
+    exporter = std::thread(&MetricsExporter::run, this);
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    stopped.notify_all();
+    exporter.join();
+    if (listenFd >= 0)
+    {
+        ::close(listenFd);
+        ::unlink(path.c_str());
+    }
+}
+
+void MetricsExporter::listen()
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        throw std::system_error(ENAMETOOLONG, std::generic_category(), "metrics socket " + path);
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "metrics socket");
+    }
+    // left by previous run
+    ::unlink(path.c_str());
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+        or ::listen(listenFd, SOMAXCONN) < 0)
+    {
+        auto error = errno;
+        ::close(listenFd);
+        listenFd = -1;
+        throw std::system_error(error, std::generic_category(), "metrics socket " + path);
+    }
+}
+
+void MetricsExporter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (not stopping)
+    {
+        lock.unlock();
+        if (target == Target::File)
+        {
+            exportToFile();
+        }
+        else
+        {
+            serveClient();
+        }
+        lock.lock();
+        if (target == Target::File)
+        {
+            stopped.wait_for(lock, period, [this] { return stopping; });
+        }
+    }
+}
+
+void MetricsExporter::exportToFile()
+{
+    auto temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::trunc);
+        file << snapshot();
+        if (not file)
+        {
+            logger.logError("Metrics not written to: ", temporaryPath);
+            return;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        logger.logError("Metrics not written to: ", path, ": ", std::strerror(errno));
+    }
+}
+
+void MetricsExporter::serveClient()
+{
+    // period limits how long stopping waits
+    pollfd listening{listenFd, POLLIN, 0};
+    if (::poll(&listening, 1, static_cast<int>(period.count())) <= 0)
+    {
+        return;
+    }
+    auto clientFd = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (clientFd < 0)
+    {
+        logger.logError("Metrics client not accepted: ", std::strerror(errno));
+        return;
+    }
+    auto text = snapshot();
+    std::size_t sentLength = 0u;
+    while (sentLength < text.size())
+    {
+        auto result = ::send(clientFd, text.data() + sentLength, text.size() - sentLength, MSG_NOSIGNAL);
+        if (result < 0 and errno == EINTR)
+        {
+            continue;
+        }
+        if (result < 0)
+        {
+            logger.logError("Metrics not sent: ", std::strerror(errno));
+            break;
+        }
+        sentLength += static_cast<std::size_t>(result);
+    }
+    ::close(clientFd);
+}
+
+std::string MetricsExporter::snapshot() const
+{
+    std::ostringstream text;
+    registry.write(text, format);
+    return text.str();
+}
+
+}
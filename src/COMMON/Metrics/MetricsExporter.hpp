@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "MetricsRegistry.hpp"
+#include "Logger/ILogger.hpp"
+
+namespace common
+{
+
+/**
+ * Exports registry by own thread:
+ * - File - snapshot written every period (to temporary file renamed then, so readers never see it partially written),
+ * - UnixSocket - snapshot written to each accepted client, then connection is closed.
+ */
+class MetricsExporter
+{
+public:
+    enum class Target
+    {
+        File,
+        UnixSocket
+    };
+
+    /**
+     * @throw std::invalid_argument - for not positive period
+     * @throw std::system_error - when unix socket cannot be listened on
+     */
+    MetricsExporter(MetricsRegistry& registry, MetricsRegistry::Format format,
+                    Target target, std::string path, std::chrono::milliseconds period,
+                    ILogger& logger);
+    ~MetricsExporter();
+
+private:
+    void listen();
+    void run();
+    void exportToFile();
+    void serveClient();
+    std::string snapshot() const;
+
+    MetricsRegistry& registry;
+    MetricsRegistry::Format format;
+    Target target;
+    std::string path;
+    std::chrono::milliseconds period;
+    ILogger& logger;
+    int listenFd = -1;
+
+    std::mutex mutex;
+    std::condition_variable stopped;
+    bool stopping = false;
+    std::thread exporter;
+};
+
+}
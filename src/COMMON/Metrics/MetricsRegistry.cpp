@@ -0,0 +1,203 @@
+#include "MetricsRegistry.hpp"
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace common
+{
+
+namespace
+{
+
+const char* typeName(MetricType type)
+{
+    return type == MetricType::Counter ? "counter" : "gauge";
+}
+
+void writeEscaped(std::ostream& os, const std::string& text)
+{
+    for (auto character: text)
+    {
+        if (character == '"' or character == '\\')
+        {
+            os << '\\';
+        }
+        os << character;
+    }
+}
+
+bool sameDefinition(const MetricDefinition& lhs, const MetricDefinition& rhs)
+{
+    auto bothNullOrEqual = [](const char* lhs, const char* rhs)
+    {
+        return (lhs == nullptr or rhs == nullptr) ? lhs == rhs : std::strcmp(lhs, rhs) == 0;
+    };
+    return lhs.type == rhs.type and bothNullOrEqual(lhs.labelName, rhs.labelName);
+}
+
+}
+
+MetricsRegistry &MetricsRegistry::getGlobal()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::CounterPtr MetricsRegistry::addCounter(const MetricDefinition &definition, std::string labelValue)
+{
+    return add<Counter>(definition, MetricType::Counter, std::move(labelValue));
+}
+
+MetricsRegistry::GaugePtr MetricsRegistry::addGauge(const MetricDefinition &definition, std::string labelValue)
+{
+    return add<Gauge>(definition, MetricType::Gauge, std::move(labelValue));
+}
+
+template <typename Metric>
+std::shared_ptr<Metric> MetricsRegistry::add(const MetricDefinition &definition, MetricType type, std::string labelValue)
+{
+    auto metric = std::make_unique<Metric>();
+    std::lock_guard<std::mutex> lock(state->mutex);
+    auto& family = getFamily(definition, type);
+    std::list<Instance>::iterator instance;
+    if constexpr (std::is_same_v<Metric, Counter>)
+    {
+        instance = family.instances.insert(family.instances.end(), Instance{std::move(labelValue), metric.get(), nullptr});
+    }
+    else
+    {
+        instance = family.instances.insert(family.instances.end(), Instance{std::move(labelValue), nullptr, metric.get()});
+    }
+    std::weak_ptr<State> weakState = state;
+    // families are never erased - so the family and the instance stay valid till the metric is removed
+    return std::shared_ptr<Metric>(metric.release(), [weakState, &family, instance](Metric* metric)
+    {
+        if (auto state = weakState.lock())
+        {
+            Counter::Value lastValue = 0u;
+            if constexpr (std::is_same_v<Metric, Counter>)
+            {
+                lastValue = metric->get();
+            }
+            remove(*state, family, instance, lastValue);
+        }
+        delete metric;
+    });
+}
+
+MetricsRegistry::Family &MetricsRegistry::getFamily(const MetricDefinition &definition, MetricType type)
+{
+    if (definition.type != type)
+    {
+        throw std::invalid_argument(std::string("Metric ") + definition.name + " is not a " + typeName(type));
+    }
+    auto [family, added] = state->families.try_emplace(definition.name, Family{definition, {}, 0u});
+    if (not added and not sameDefinition(family->second.definition, definition))
+    {
+        throw std::invalid_argument(std::string("Metric ") + definition.name + " already defined differently");
+    }
+    return family->second;
+}
+
+void MetricsRegistry::remove(State &state, Family &family, std::list<Instance>::iterator instance,
+                             Counter::Value lastValue)
+{
+    std::lock_guard<std::mutex> lock(state.mutex);
+    family.instances.erase(instance);
+    family.closed += lastValue;
+}
+
+std::vector<MetricsRegistry::Sample> MetricsRegistry::samplesOf(const Family &family)
+{
+    auto valueOf = [](const Instance& instance)
+    {
+        return instance.counter ? static_cast<std::int64_t>(instance.counter->get())
+                                : static_cast<std::int64_t>(instance.gauge->get());
+    };
+    if (family.definition.labelName == nullptr)
+    {
+        auto sum = static_cast<std::int64_t>(family.closed);
+        for (auto& instance: family.instances)
+        {
+            sum += valueOf(instance);
+        }
+        return {Sample{{}, sum}};
+    }
+    std::vector<Sample> samples;
+    for (auto& instance: family.instances)
+    {
+        samples.push_back(Sample{instance.labelValue, valueOf(instance)});
+    }
+    if (family.closed != 0u)
+    {
+        samples.push_back(Sample{"closed", static_cast<std::int64_t>(family.closed)});
+    }
+    return samples;
+}
+
+void MetricsRegistry::write(std::ostream &os, Format format) const
+{
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (format == Format::Prometheus)
+    {
+        writePrometheus(os, state->families);
+    }
+    else
+    {
+        writeJson(os, state->families);
+    }
+}
+
+void MetricsRegistry::writePrometheus(std::ostream &os, const std::map<std::string, Family> &families)
+{
+    for (auto& [name, family]: families)
+    {
+        os << "# HELP " << name << ' ' << family.definition.help << '\n'
+           << "# TYPE " << name << ' ' << typeName(family.definition.type) << '\n';
+        for (auto& sample: samplesOf(family))
+        {
+            os << name;
+            if (family.definition.labelName)
+            {
+                os << '{' << family.definition.labelName << "=\"";
+                writeEscaped(os, sample.labelValue);
+                os << "\"}";
+            }
+            os << ' ' << sample.value << '\n';
+        }
+    }
+}
+
+void MetricsRegistry::writeJson(std::ostream &os, const std::map<std::string, Family> &families)
+{
+    os << '{';
+    const char* separator = "";
+    for (auto& [name, family]: families)
+    {
+        os << separator << '"' << name << "\":{\"type\":\"" << typeName(family.definition.type) << '"';
+        separator = ",";
+        auto samples = samplesOf(family);
+        if (family.definition.labelName)
+        {
+            os << ",\"label\":\"" << family.definition.labelName << "\",\"values\":{";
+            const char* valueSeparator = "";
+            for (auto& sample: samples)
+            {
+                os << valueSeparator << '"';
+                writeEscaped(os, sample.labelValue);
+                os << "\":" << sample.value;
+                valueSeparator = ",";
+            }
+            os << '}';
+        }
+        else
+        {
+            os << ",\"value\":" << samples.front().value;
+        }
+        os << '}';
+    }
+    os << "}\n";
+}
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <iosfwd>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Metrics.hpp"
+
+namespace common
+{
+
+/**
+ * Metrics are added and removed under the lock, updates are lock-free - registry is not touched then.
+ *
+ * Metric lives as long as its pointer: value of removed counter is kept in its family - in the "closed"
+ * instance (labelled families) or in the sum (families without label), so exported counters never go back.
+ */
+class MetricsRegistry
+{
+public:
+    enum class Format
+    {
+        Prometheus,
+        Json
+    };
+
+    using CounterPtr = std::shared_ptr<Counter>;
+    using GaugePtr = std::shared_ptr<Gauge>;
+
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    // process wide - updated by transports and BTS application
+    static MetricsRegistry& getGlobal();
+
+    /**
+     * @throw std::invalid_argument - when definition type does not match, or the same name was defined differently
+     */
+    CounterPtr addCounter(const MetricDefinition& definition, std::string labelValue = {});
+    GaugePtr addGauge(const MetricDefinition& definition, std::string labelValue = {});
+
+    void write(std::ostream& os, Format format) const;
+
+private:
+    struct Instance
+    {
+        std::string labelValue;
+        const Counter* counter;
+        const Gauge* gauge;
+    };
+    struct Family
+    {
+        MetricDefinition definition;
+        // removed in O(1) - there may be an instance per connection
+        std::list<Instance> instances;
+        Counter::Value closed = 0u;
+    };
+    struct Sample
+    {
+        std::string labelValue;
+        std::int64_t value;
+    };
+
+    struct State
+    {
+        std::mutex mutex;
+        std::map<std::string, Family> families;
+    };
+
+    Family& getFamily(const MetricDefinition& definition, MetricType type);
+    template <typename Metric>
+    std::shared_ptr<Metric> add(const MetricDefinition& definition, MetricType type, std::string labelValue);
+    static void remove(State& state, Family& family, std::list<Instance>::iterator instance, Counter::Value lastValue);
+    static std::vector<Sample> samplesOf(const Family& family);
+    static void writePrometheus(std::ostream& os, const std::map<std::string, Family>& families);
+    static void writeJson(std::ostream& os, const std::map<std::string, Family>& families);
+
+    // shared - so metrics removed after registry is gone (e.g. at exit) do not touch it
+    std::shared_ptr<State> state = std::make_shared<State>();
+};
+
+}
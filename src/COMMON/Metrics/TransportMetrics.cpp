@@ -0,0 +1,22 @@
+#include "TransportMetrics.hpp"
+
+namespace common
+{
+
+const MetricDefinition TransportMetrics::DECODE_ERRORS{
+    "transport_decode_errors_total", "Frames not decoded (wrong length) - connection closed then", MetricType::Counter};
+const MetricDefinition TransportMetrics::DISCONNECTS{
+    "transport_disconnects_total", "Connections lost or closed", MetricType::Counter};
+const MetricDefinition TransportMetrics::SEND_DROPPED{
+    "transport_send_dropped_total", "Frames dropped by congested connections (see SendQueue)", MetricType::Counter};
+const MetricDefinition TransportMetrics::SEND_OVERFLOWS{
+    "transport_send_overflows_total", "Connections closed because of send queue overflow", MetricType::Counter};
+
+TransportMetrics::TransportMetrics(MetricsRegistry &registry)
+    : decodeErrors(registry.addCounter(DECODE_ERRORS)),
+      disconnects(registry.addCounter(DISCONNECTS)),
+      sendDropped(registry.addCounter(SEND_DROPPED)),
+      sendOverflows(registry.addCounter(SEND_OVERFLOWS))
+{}
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "MetricsRegistry.hpp"
+
+namespace common
+{
+
+/**
+ * Metrics of one transport (connection) - summed up over all transports of the process
+ */
+struct TransportMetrics
+{
+    static const MetricDefinition DECODE_ERRORS;
+    static const MetricDefinition DISCONNECTS;
+    static const MetricDefinition SEND_DROPPED;
+    static const MetricDefinition SEND_OVERFLOWS;
+
+    explicit TransportMetrics(MetricsRegistry& registry = MetricsRegistry::getGlobal());
+
+    MetricsRegistry::CounterPtr decodeErrors;
+    MetricsRegistry::CounterPtr disconnects;
+    MetricsRegistry::CounterPtr sendDropped;
+    MetricsRegistry::CounterPtr sendOverflows;
+};
+
+}
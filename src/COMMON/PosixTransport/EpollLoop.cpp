@@ -0,0 +1,229 @@
+#include "EpollLoop.hpp"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+#include <system_error>
+#include <algorithm>
+
+namespace common
+{
+
+namespace
+{
+
+[[noreturn]] void throwSystemError(const char* what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+}
+
+EpollLoop::EpollLoop()
+    : epollFd(::epoll_create1(EPOLL_CLOEXEC)),
+      wakeUpFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    if (epollFd < 0 or wakeUpFd < 0)
+    {
+        auto error = errno;
+        if (epollFd >= 0) ::close(epollFd);
+        if (wakeUpFd >= 0) ::close(wakeUpFd);
+        errno = error;
+        throwSystemError("epoll loop creation");
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = WAKE_UP_REGISTRATION;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeUpFd, &event);
+}
+
+EpollLoop::~EpollLoop()
+{
+    ::close(wakeUpFd);
+    ::close(epollFd);
+}
+
+void EpollLoop::run()
+{
+    loopThread = std::this_thread::get_id();
+    running = true;
+    epoll_event events[MAX_EVENTS];
+    while (running)
+    {
+        int numberOfEvents = ::epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (numberOfEvents < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throwSystemError("epoll_wait");
+        }
+        for (int i = 0; i < numberOfEvents; ++i)
+        {
+            if (events[i].data.u64 == WAKE_UP_REGISTRATION)
+            {
+                runPostedTasks();
+            }
+            else
+            {
+                dispatch(events[i].data.u64, events[i].events);
+            }
+        }
+        runAfterEventsTasks();
+    }
+    runPostedTasks();
+    runAfterEventsTasks();
+    loopThread = std::thread::id{};
+}
+
+void EpollLoop::stop()
+{
+    post([this] { running = false; });
+}
+
+void EpollLoop::post(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        tasks.push_back(std::move(task));
+    }
+    wakeUp();
+}
+
+void EpollLoop::postAfterEvents(Task task)
+{
+    if (not isInLoopThread())
+    {
+        post(std::move(task));
+        return;
+    }
+    afterEventsTasks.push_back(std::move(task));
+}
+
+bool EpollLoop::isInLoopThread() const
+{
+    return loopThread == std::this_thread::get_id();
+}
+
+EpollLoop::Registration EpollLoop::add(int fd, std::uint32_t events, std::weak_ptr<IEpollHandler> handler)
+{
+    Registration registration;
+    {
+        std::lock_guard<std::mutex> lock(handlersMutex);
+        registration = ++lastRegistration;
+        handlers.emplace(registration, std::move(handler));
+    }
+
+    epoll_event event{};
+    event.events = events;
+    event.data.u64 = registration;
+    if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+    {
+        auto error = errno;
+        {
+            std::lock_guard<std::mutex> lock(handlersMutex);
+            handlers.erase(registration);
+        }
+        errno = error;
+        throwSystemError("epoll_ctl add");
+    }
+    return registration;
+}
+
+void EpollLoop::remove(int fd, Registration registration)
+{
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    std::lock_guard<std::mutex> lock(handlersMutex);
+    handlers.erase(registration);
+}
+
+void EpollLoop::wakeUp()
+{
+    std::uint64_t one = 1u;
+    [[maybe_unused]] auto written = ::write(wakeUpFd, &one, sizeof(one));
+}
+
+void EpollLoop::runPostedTasks()
+{
+    std::uint64_t counter;
+    [[maybe_unused]] auto readBytes = ::read(wakeUpFd, &counter, sizeof(counter));
+
+    std::vector<Task> tasksToRun;
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        tasksToRun.swap(tasks);
+    }
+    for (auto& task: tasksToRun)
+    {
+        task();
+    }
+}
+
+void EpollLoop::runAfterEventsTasks()
+{
+    // tasks might post next ones - run till none is left
+    while (not afterEventsTasks.empty())
+    {
+        std::vector<Task> tasksToRun;
+        tasksToRun.swap(afterEventsTasks);
+        for (auto& task: tasksToRun)
+        {
+            task();
+        }
+    }
+}
+
+void EpollLoop::dispatch(Registration registration, std::uint32_t events)
+{
+    std::shared_ptr<IEpollHandler> handler;
+    {
+        std::lock_guard<std::mutex> lock(handlersMutex);
+        auto it = handlers.find(registration);
+        if (it == handlers.end())
+        {
+            return;
+        }
+        handler = it->second.lock();
+    }
+    if (handler)
+    {
+        handler->handleEvents(events);
+    }
+}
+
+EpollLoopPool::EpollLoopPool(std::size_t numberOfThreads)
+{
+    for (std::size_t i = 0u; i < std::max<std::size_t>(1u, numberOfThreads); ++i)
+    {
+        loops.push_back(std::make_unique<EpollLoop>());
+    }
+    for (auto& loop: loops)
+    {
+        threads.emplace_back(&EpollLoop::run, loop.get());
+    }
+}
+
+EpollLoopPool::~EpollLoopPool()
+{
+    for (auto& loop: loops)
+    {
+        loop->stop();
+    }
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+}
+
+EpollLoop &EpollLoopPool::next()
+{
+    return *loops[nextLoop++ % loops.size()];
+}
+
+std::size_t EpollLoopPool::size() const
+{
+    return loops.size();
+}
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "IEpollHandler.hpp"
+
+namespace common
+{
+
+/**
+ * Event loop on top of epoll. Handlers are identified by registration (not fd),
+ * so descriptor numbers reused by the system never get events addressed to their previous owners.
+ * All functions but run() are thread safe.
+ */
+class EpollLoop
+{
+public:
+    using Task = std::function<void()>;
+    using Registration = std::uint64_t;
+
+    /**
+     * @throw std::system_error
+     */
+    EpollLoop();
+    ~EpollLoop();
+
+    EpollLoop(const EpollLoop&) = delete;
+    EpollLoop& operator=(const EpollLoop&) = delete;
+
+    /**
+     * Handles events till stop() is called
+     */
+    void run();
+    void stop();
+
+    /**
+     * Task is executed in the loop thread
+     */
+    void post(Task task);
+    /**
+     * Task is executed in the loop thread after the events being handled now - so it can gather their results,
+     * called outside of the loop thread it is the same as post()
+     */
+    void postAfterEvents(Task task);
+    bool isInLoopThread() const;
+
+    /**
+     * Handler is called only as long as it is alive, it shall be removed before fd is closed
+     * @throw std::system_error
+     */
+    Registration add(int fd, std::uint32_t events, std::weak_ptr<IEpollHandler> handler);
+    void remove(int fd, Registration registration);
+
+private:
+    void wakeUp();
+    void runPostedTasks();
+    void runAfterEventsTasks();
+    void dispatch(Registration registration, std::uint32_t events);
+
+    static constexpr Registration WAKE_UP_REGISTRATION = 0u;
+    static constexpr int MAX_EVENTS = 64;
+
+    int epollFd;
+    int wakeUpFd;
+    std::atomic<bool> running{false};
+    std::atomic<std::thread::id> loopThread{};
+
+    std::mutex tasksMutex;
+    std::vector<Task> tasks;
+    // loop thread only
+    std::vector<Task> afterEventsTasks;
+
+    std::mutex handlersMutex;
+    Registration lastRegistration = WAKE_UP_REGISTRATION;
+    std::unordered_map<Registration, std::weak_ptr<IEpollHandler>> handlers;
+};
+
+/**
+ * Number of EpollLoop (at least one) - each run in its own thread
+ */
+class EpollLoopPool
+{
+public:
+    EpollLoopPool(std::size_t numberOfThreads);
+    ~EpollLoopPool();
+
+    /**
+     * @return loops in round robin manner
+     */
+    EpollLoop& next();
+    std::size_t size() const;
+
+private:
+    std::vector<std::unique_ptr<EpollLoop>> loops;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> nextLoop{0u};
+};
+
+}
@@ -0,0 +1,129 @@
+#include "EpollServer.hpp"
+#include "EpollTransport.hpp"
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+namespace common
+{
+
+EpollServer::EpollServer(EpollLoopPool &loops, ILogger &logger, SendQueue::Options sendQueueOptions)
+    : loops(loops),
+      baseLogger(logger),
+      logger(logger, "[SERVER]"),
+      sendQueueOptions(sendQueueOptions)
+{}
+
+EpollServer::~EpollServer()
+{
+    if (listenFd >= 0)
+    {
+        listenLoop->remove(listenFd, registration);
+        ::close(listenFd);
+    }
+}
+
+void EpollServer::listen(std::uint16_t port)
+{
+    listenFd = ::socket(AF_INET6, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "listen socket");
+    }
+    int option = 1;
+    ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option));
+    option = 0;
+    ::setsockopt(listenFd, IPPROTO_IPV6, IPV6_V6ONLY, &option, sizeof(option));
+
+    sockaddr_in6 address{};
+    address.sin6_family = AF_INET6;
+    address.sin6_addr = in6addr_any;
+    address.sin6_port = htons(port);
+    socklen_t addressLength = sizeof(address);
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), addressLength) < 0
+        or ::listen(listenFd, SOMAXCONN) < 0
+        or ::getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &addressLength) < 0)
+    {
+        auto error = errno;
+        ::close(listenFd);
+        listenFd = -1;
+        throw std::system_error(error, std::generic_category(), "listen on port " + std::to_string(port));
+    }
+    this->port = ntohs(address.sin6_port);
+
+    listenLoop = &loops.next();
+    registration = listenLoop->add(listenFd, EPOLLIN | EPOLLET, weak_from_this());
+    logger.logInfo("server started, port: ", this->port, ", loops: ", loops.size());
+}
+
+std::uint16_t EpollServer::getPort() const
+{
+    return port;
+}
+
+void EpollServer::registerConnectionCallback(ConnectionCallback callback)
+{
+    std::lock_guard<std::mutex> lock(connectionCallbackMutex);
+    connectionCallback = callback;
+}
+
+void EpollServer::handleEvents(std::uint32_t)
+{
+    while (true)
+    {
+        int socketFd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (socketFd >= 0)
+        {
+            acceptConnection(socketFd);
+        }
+        else if (errno == EINTR or errno == ECONNABORTED)
+        {
+            continue;
+        }
+        else
+        {
+            if (errno != EAGAIN and errno != EWOULDBLOCK)
+            {
+                logger.logError("accept failed: ", std::strerror(errno));
+            }
+            return;
+        }
+    }
+}
+
+void EpollServer::acceptConnection(int socketFd)
+{
+    auto& loop = loops.next();
+    auto transport = std::make_shared<EpollTransport>(loop, socketFd, baseLogger, sendQueueOptions);
+    logger.logDebug("New connection from: ", transport->addressToString());
+
+    ConnectionCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(connectionCallbackMutex);
+        callback = connectionCallback;
+    }
+    if (not callback)
+    {
+        logger.logError("New connection from: ", transport->addressToString(), " discarded, application not interested!");
+        return;
+    }
+
+    loop.post([logger = logger, callback, transport]() mutable
+    {
+        try
+        {
+            callback(transport);
+            transport->start();
+        }
+        catch (std::exception& ex)
+        {
+            logger.logError("New connection from: ", transport->addressToString(), " failed: ", ex.what());
+        }
+    });
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "CommonEnvironment/ITransport.hpp"
+#include "CommonEnvironment/SendQueue.hpp"
+#include "Logger/PrefixedLogger.hpp"
+#include "EpollLoop.hpp"
+
+namespace common
+{
+
+/**
+ * Accepts TCP connections and spreads them (as EpollTransport) over the loops of EpollLoopPool.
+ * Connection callback is called in the thread of the loop that serves the new connection,
+ * the transport starts receiving right after the callback returns.
+ */
+class EpollServer : public IEpollHandler,
+                    public std::enable_shared_from_this<EpollServer>
+{
+public:
+    using ConnectionCallback = std::function<void(std::shared_ptr<ITransport>)>;
+
+    /**
+     * @param sendQueueOptions - for each accepted connection
+     */
+    EpollServer(EpollLoopPool& loops, ILogger& logger, SendQueue::Options sendQueueOptions = {});
+    ~EpollServer() override;
+
+    /**
+     * @param port - zero means any free port, see getPort()
+     * @throw std::system_error
+     */
+    void listen(std::uint16_t port);
+    std::uint16_t getPort() const;
+
+    void registerConnectionCallback(ConnectionCallback);
+
+    void handleEvents(std::uint32_t events) override;
+
+private:
+    void acceptConnection(int socketFd);
+
+    EpollLoopPool& loops;
+    ILogger& baseLogger;
+    PrefixedLogger logger;
+    const SendQueue::Options sendQueueOptions;
+    int listenFd = -1;
+    std::uint16_t port = 0u;
+    EpollLoop* listenLoop = nullptr;
+    EpollLoop::Registration registration{};
+
+    std::mutex connectionCallbackMutex;
+    ConnectionCallback connectionCallback;
+};
+
+}
@@ -0,0 +1,331 @@
+#include "EpollTransport.hpp"
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include "Statistics/ForwardingLatency.hpp"
+
+namespace common
+{
+
+namespace
+{
+
+std::string peerAddress(int socketFd)
+{
+    sockaddr_storage peer{};
+    socklen_t peerLength = sizeof(peer);
+    if (::getpeername(socketFd, reinterpret_cast<sockaddr*>(&peer), &peerLength) < 0)
+    {
+        return "unknown";
+    }
+    char host[INET6_ADDRSTRLEN] = "";
+    std::uint16_t port = 0u;
+    if (peer.ss_family == AF_INET)
+    {
+        auto& peer4 = reinterpret_cast<sockaddr_in&>(peer);
+        ::inet_ntop(AF_INET, &peer4.sin_addr, host, sizeof(host));
+        port = ntohs(peer4.sin_port);
+    }
+    else if (peer.ss_family == AF_INET6)
+    {
+        auto& peer6 = reinterpret_cast<sockaddr_in6&>(peer);
+        ::inet_ntop(AF_INET6, &peer6.sin6_addr, host, sizeof(host));
+        port = ntohs(peer6.sin6_port);
+    }
+    else
+    {
+        return "local-" + std::to_string(socketFd);
+    }
+    return std::string(host) + "-" + std::to_string(port);
+}
+
+bool isTemporaryError(int error)
+{
+    return error == EAGAIN or error == EWOULDBLOCK or error == EINTR;
+}
+
+// segments written by one sendmsg - two per frame, well below IOV_MAX
+constexpr std::size_t SEND_BATCH_SEGMENTS = 64u;
+
+}
+
+EpollTransport::EpollTransport(EpollLoop &loop, int socketFd, ILogger &logger, SendQueue::Options sendQueueOptions)
+    : loop(loop),
+      socketFd(socketFd),
+      address(peerAddress(socketFd)),
+      logger(logger),
+      sendQueue(sendQueueOptions)
+{
+    ::fcntl(socketFd, F_SETFL, ::fcntl(socketFd, F_GETFL) | O_NONBLOCK);
+    int noDelay = 1;
+    ::setsockopt(socketFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+}
+
+EpollTransport::~EpollTransport()
+{
+    if (registration and not closed.exchange(true))
+    {
+        loop.remove(socketFd, registration);
+    }
+    ::close(socketFd);
+}
+
+std::shared_ptr<EpollTransport> EpollTransport::connect(EpollLoop &loop, const std::string &host, std::uint16_t port, ILogger &logger,
+                                                        SendQueue::Options sendQueueOptions)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (int error = ::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses); error != 0)
+    {
+        throw std::system_error(std::make_error_code(std::errc::host_unreachable), host + ": " + ::gai_strerror(error));
+    }
+    std::unique_ptr<addrinfo, decltype(&::freeaddrinfo)> addressesGuard(addresses, &::freeaddrinfo);
+
+    int error = 0;
+    for (auto address = addresses; address; address = address->ai_next)
+    {
+        int socketFd = ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+        if (socketFd < 0)
+        {
+            error = errno;
+            continue;
+        }
+        if (::connect(socketFd, address->ai_addr, address->ai_addrlen) == 0)
+        {
+            return std::make_shared<EpollTransport>(loop, socketFd, logger, sendQueueOptions);
+        }
+        error = errno;
+        ::close(socketFd);
+    }
+    throw std::system_error(error, std::generic_category(), "connect to " + host + ":" + std::to_string(port));
+}
+
+void EpollTransport::start()
+{
+    if (registration)
+    {
+        return;
+    }
+    registration = loop.add(socketFd, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET, weak_from_this());
+}
+
+void EpollTransport::registerMessageCallback(ITransport::MessageCallback callback)
+{
+    std::lock_guard<std::mutex> lock(callbacksMutex);
+    messageCallback = callback ? std::make_shared<const MessageCallback>(std::move(callback)) : nullptr;
+}
+
+void EpollTransport::registerDisconnectedCallback(ITransport::DisconnectedCallback callback)
+{
+    std::lock_guard<std::mutex> lock(callbacksMutex);
+    disconnectedCallback = callback ? std::make_shared<const DisconnectedCallback>(std::move(callback)) : nullptr;
+}
+
+bool EpollTransport::sendMessage(Frame message)
+{
+    if (closed)
+    {
+        return false;
+    }
+
+    bool flushNeeded = false;
+    SendQueue::PushResult result;
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        flushNeeded = sendQueue.empty();
+        result = sendQueue.push(std::move(message));
+        congested = sendQueue.isCongested();
+    }
+
+    switch (result)
+    {
+    case SendQueue::PushResult::Queued:
+        break;
+    case SendQueue::PushResult::Dropped:
+        metrics.sendDropped->increment();
+        return false;
+    case SendQueue::PushResult::Overflow:
+        metrics.sendOverflows->increment();
+        logger.logError("Send queue overflow, disconnecting: ", address);
+        // loop sees the disconnection as any other
+        ::shutdown(socketFd, SHUT_RDWR);
+        return false;
+    }
+
+    if (flushNeeded)
+    {
+        // next frames of this loop iteration are only queued - all written by one flush
+        loop.postAfterEvents([weakThis = weak_from_this()]
+        {
+            if (auto self = weakThis.lock())
+            {
+                self->flushSendQueue();
+            }
+        });
+    }
+    // queued - no more latency on BTS side
+    ForwardingLatency::recordWritten();
+    return true;
+}
+
+bool EpollTransport::isCongested() const
+{
+    return congested;
+}
+
+std::string EpollTransport::addressToString() const
+{
+    return address;
+}
+
+void EpollTransport::handleEvents(std::uint32_t events)
+{
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+    {
+        readFrames();
+    }
+    if ((events & EPOLLOUT) and not closed)
+    {
+        flushSendQueue();
+    }
+}
+
+void EpollTransport::readFrames()
+{
+    while (not closed)
+    {
+        auto space = receiveBuffer.writableSpace();
+        auto result = ::read(socketFd, space.data(), space.size());
+        if (result > 0)
+        {
+            receiveBuffer.commit(static_cast<std::size_t>(result));
+            if (not decodeFrames())
+            {
+                close();
+            }
+        }
+        else if (result == 0)
+        {
+            close();
+        }
+        else if (errno == EINTR)
+        {
+            continue;
+        }
+        else
+        {
+            if (not isTemporaryError(errno))
+            {
+                logger.logError("Receive from: ", address, " failed: ", std::strerror(errno));
+                close();
+            }
+            return;
+        }
+    }
+}
+
+bool EpollTransport::decodeFrames()
+{
+    std::shared_ptr<const MessageCallback> callback;
+    {
+        std::lock_guard<std::mutex> lock(callbacksMutex);
+        callback = messageCallback;
+    }
+    try
+    {
+        while (auto frame = receiveBuffer.nextFrame())
+        {
+            if (callback)
+            {
+                ForwardingLatency::ReceivedFrame received;
+                (*callback)(Frame::copyOf(*frame));
+            }
+            else
+            {
+                logger.logError("Message received from: ", address, " - application not interested");
+            }
+        }
+    }
+    catch (std::length_error& error)
+    {
+        metrics.decodeErrors->increment();
+        logger.logError(error.what(), " from: ", address);
+        return false;
+    }
+    return true;
+}
+
+void EpollTransport::flushSendQueue()
+{
+    std::lock_guard<std::mutex> lock(sendMutex);
+    std::array<SendQueue::Segment, SEND_BATCH_SEGMENTS> segments;
+    std::array<iovec, SEND_BATCH_SEGMENTS> iovecs;
+    while (not sendQueue.empty() and not closed)
+    {
+        auto count = sendQueue.pending(segments);
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+            iovecs[i].iov_base = const_cast<std::uint8_t*>(segments[i].data());
+            iovecs[i].iov_len = segments[i].size();
+        }
+        // sendmsg - writev with MSG_NOSIGNAL
+        msghdr header{};
+        header.msg_iov = iovecs.data();
+        header.msg_iovlen = count;
+        auto result = ::sendmsg(socketFd, &header, MSG_NOSIGNAL);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (not isTemporaryError(errno))
+            {
+                logger.logError("Send to: ", address, " failed: ", std::strerror(errno));
+            }
+            break;
+        }
+        sendQueue.consume(static_cast<std::size_t>(result));
+    }
+    congested = sendQueue.isCongested();
+}
+
+void EpollTransport::close()
+{
+    if (closed.exchange(true))
+    {
+        return;
+    }
+    loop.remove(socketFd, registration);
+    metrics.disconnects->increment();
+
+    std::shared_ptr<const DisconnectedCallback> callback;
+    {
+        std::lock_guard<std::mutex> lock(callbacksMutex);
+        callback = disconnectedCallback;
+    }
+    if (callback)
+    {
+        logger.logDebug("Connection lost from: ", address);
+        (*callback)();
+    }
+    else
+    {
+        logger.logError("Connection lost from: ", address, " - application not interested!");
+    }
+}
+
+}
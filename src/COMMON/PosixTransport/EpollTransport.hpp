@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "CommonEnvironment/ITransport.hpp"
+#include "CommonEnvironment/FrameBuffer.hpp"
+#include "CommonEnvironment/SendQueue.hpp"
+#include "Logger/ILogger.hpp"
+#include "Metrics/TransportMetrics.hpp"
+#include "EpollLoop.hpp"
+
+namespace common
+{
+
+/**
+ * ITransport over non-blocking TCP (or any stream) socket, served by EpollLoop.
+ * Reads are edge triggered and drain the socket. Sends are queued (SendQueue) and written after the loop handles
+ * current events (EpollLoop::postAfterEvents) - so all frames produced in one loop iteration go in one write,
+ * what the socket does not accept waits till it is writable again.
+ *
+ * Callbacks are called in the loop thread, sendMessage() can be called from any thread.
+ */
+class EpollTransport : public ITransport,
+                       public IEpollHandler,
+                       public std::enable_shared_from_this<EpollTransport>
+{
+public:
+    /**
+     * Takes ownership of the connected socket
+     */
+    EpollTransport(EpollLoop& loop, int socketFd, ILogger& logger, SendQueue::Options sendQueueOptions = {});
+    ~EpollTransport() override;
+
+    /**
+     * @throw std::system_error
+     */
+    static std::shared_ptr<EpollTransport> connect(EpollLoop& loop, const std::string& host, std::uint16_t port, ILogger& logger,
+                                                   SendQueue::Options sendQueueOptions = {});
+
+    /**
+     * Starts handling the socket events - call it when callbacks are registered.
+     * Started transport is not started again - so it can be started by one owner, then handed over to the next one
+     * @throw std::system_error
+     */
+    void start();
+
+    void registerMessageCallback(MessageCallback) override;
+    void registerDisconnectedCallback(DisconnectedCallback) override;
+    bool sendMessage(Frame) override;
+    bool isCongested() const override;
+    std::string addressToString() const override;
+
+    void handleEvents(std::uint32_t events) override;
+
+private:
+    void readFrames();
+    bool decodeFrames();
+    void flushSendQueue();
+    void close();
+
+    EpollLoop& loop;
+    int socketFd;
+    std::string address;
+    ILogger& logger;
+    EpollLoop::Registration registration{};
+    std::atomic<bool> closed{false};
+    TransportMetrics metrics;
+
+    std::mutex callbacksMutex;
+    std::shared_ptr<const MessageCallback> messageCallback;
+    std::shared_ptr<const DisconnectedCallback> disconnectedCallback;
+
+    FrameBuffer receiveBuffer;
+
+    std::mutex sendMutex;
+    SendQueue sendQueue;
+    // copy of sendQueue.isCongested() - readable without the lock
+    std::atomic<bool> congested{false};
+};
+
+}
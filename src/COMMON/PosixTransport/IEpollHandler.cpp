@@ -0,0 +1 @@
+#include "IEpollHandler.hpp"
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+namespace common
+{
+
+class IEpollHandler
+{
+public:
+    virtual ~IEpollHandler() = default;
+
+    /**
+     * Called in the thread of EpollLoop the handler is registered in
+     * @param events - epoll events mask, like EPOLLIN
+     */
+    virtual void handleEvents(std::uint32_t events) = 0;
+};
+
+}
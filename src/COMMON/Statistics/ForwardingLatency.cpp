@@ -0,0 +1,92 @@
+#include "ForwardingLatency.hpp"
+
+namespace common
+{
+
+namespace
+{
+
+struct ThreadTrace
+{
+    bool received = false;
+    bool decoded = false;
+    ForwardingLatency::Clock::time_point receivedAt;
+    ForwardingLatency::Clock::time_point lockedAt;
+    MessageId messageId{};
+};
+
+thread_local ThreadTrace threadTrace;
+
+}
+
+ForwardingLatency::ReceivedFrame::ReceivedFrame()
+{
+    threadTrace.received = true;
+    threadTrace.decoded = false;
+    threadTrace.receivedAt = Clock::now();
+    threadTrace.lockedAt = threadTrace.receivedAt;
+}
+
+ForwardingLatency::ReceivedFrame::~ReceivedFrame()
+{
+    threadTrace.received = false;
+}
+
+ForwardingLatency::StageScope::StageScope(Stage stage)
+    : stage(stage),
+      start(Clock::now())
+{}
+
+ForwardingLatency::StageScope::~StageScope()
+{
+    if (threadTrace.received and threadTrace.decoded)
+    {
+        record(stage, threadTrace.messageId, Clock::now() - start);
+    }
+}
+
+LatencyHistograms &ForwardingLatency::getHistograms()
+{
+    static LatencyHistograms histograms({"lock wait", "relay", "send queue", "total"});
+    return histograms;
+}
+
+void ForwardingLatency::setMessageId(MessageId messageId)
+{
+    if (not threadTrace.received)
+    {
+        return;
+    }
+    threadTrace.messageId = messageId;
+    threadTrace.decoded = true;
+    record(LockWait, messageId, threadTrace.lockedAt - threadTrace.receivedAt);
+}
+
+void ForwardingLatency::markLocked()
+{
+    threadTrace.lockedAt = Clock::now();
+}
+
+std::optional<ForwardingLatency::Trace> ForwardingLatency::getTrace()
+{
+    if (threadTrace.received and threadTrace.decoded)
+    {
+        return Trace{threadTrace.receivedAt, threadTrace.messageId};
+    }
+    return std::nullopt;
+}
+
+void ForwardingLatency::record(Stage stage, MessageId messageId, Clock::duration latency)
+{
+    getHistograms().record(stage, messageId, std::chrono::duration_cast<std::chrono::nanoseconds>(latency));
+}
+
+void ForwardingLatency::recordWritten()
+{
+    if (threadTrace.received and threadTrace.decoded)
+    {
+        record(Total, threadTrace.messageId, Clock::now() - threadTrace.receivedAt);
+    }
+}
+
+}
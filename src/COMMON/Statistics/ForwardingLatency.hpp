@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include "LatencyHistograms.hpp"
+
+namespace common
+{
+
+/**
+ * Latency of frames forwarded by BTS - from reading the frame from the sender socket
+ * till writing it to the recipient socket, in stages.
+ *
+ * Recording is always on - a received frame is traced in the thread that read it (ReceivedFrame scope),
+ * the stages done synchronously in that thread need no arguments. The stage done in other thread (transport
+ * queue) is recorded with the Trace taken before hand-over.
+ */
+class ForwardingLatency
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum Stage : std::size_t
+    {
+        LockWait,  // frame read -> SyncGuard of UeConnection taken
+        Relay,     // recipient lookup and hand-over to its transport
+        SendQueue, // hand-over -> written to recipient socket (transports with own sending thread)
+        Total      // frame read -> written to recipient socket
+    };
+
+    struct Trace
+    {
+        Clock::time_point receivedAt;
+        MessageId messageId;
+    };
+
+    /**
+     * Transport: scope of handling one received frame
+     */
+    class ReceivedFrame
+    {
+    public:
+        ReceivedFrame();
+        ~ReceivedFrame();
+        ReceivedFrame(const ReceivedFrame&) = delete;
+        ReceivedFrame& operator=(const ReceivedFrame&) = delete;
+    };
+
+    /**
+     * Records duration of the scope - when frame is traced
+     */
+    class StageScope
+    {
+    public:
+        explicit StageScope(Stage stage);
+        ~StageScope();
+        StageScope(const StageScope&) = delete;
+        StageScope& operator=(const StageScope&) = delete;
+
+    private:
+        Stage stage;
+        Clock::time_point start;
+    };
+
+    static LatencyHistograms& getHistograms();
+
+    // UeConnection: frame decoded - till then MessageId is not known and nothing is recorded
+    static void setMessageId(MessageId messageId);
+    // UeConnection: SyncGuard taken, recorded as LockWait when MessageId is known
+    static void markLocked();
+
+    // trace of the frame handled by this thread - when MessageId is already known
+    static std::optional<Trace> getTrace();
+    static void record(Stage stage, MessageId messageId, Clock::duration latency);
+    // Total of the frame handled by this thread
+    static void recordWritten();
+};
+
+}
@@ -0,0 +1,122 @@
+#include "Histogram.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <ostream>
+
+namespace common
+{
+
+void Histogram::record(Value value)
+{
+    buckets[bucketOf(value)].fetch_add(1u, std::memory_order_relaxed);
+    count.fetch_add(1u, std::memory_order_relaxed);
+    auto previousMax = max.load(std::memory_order_relaxed);
+    while (value > previousMax and not max.compare_exchange_weak(previousMax, value, std::memory_order_relaxed))
+    {}
+}
+
+void Histogram::merge(const Histogram &other)
+{
+    for (std::size_t i = 0u; i < NUMBER_OF_BUCKETS; ++i)
+    {
+        if (auto inBucket = other.buckets[i].load(std::memory_order_relaxed))
+        {
+            buckets[i].fetch_add(inBucket, std::memory_order_relaxed);
+        }
+    }
+    count.fetch_add(other.getCount(), std::memory_order_relaxed);
+    auto otherMax = other.getMax();
+    auto previousMax = max.load(std::memory_order_relaxed);
+    while (otherMax > previousMax and not max.compare_exchange_weak(previousMax, otherMax, std::memory_order_relaxed))
+    {}
+}
+
+void Histogram::reset()
+{
+    for (auto& bucket: buckets)
+    {
+        bucket.store(0u, std::memory_order_relaxed);
+    }
+    count.store(0u, std::memory_order_relaxed);
+    max.store(0u, std::memory_order_relaxed);
+}
+
+std::uint64_t Histogram::getCount() const
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+Histogram::Value Histogram::getMax() const
+{
+    return max.load(std::memory_order_relaxed);
+}
+
+Histogram::Value Histogram::getPercentile(double percent) const
+{
+    // buckets are summed up - not count, which may be ahead of them while recording
+    std::uint64_t total = 0u;
+    for (auto& bucket: buckets)
+    {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0u)
+    {
+        return 0u;
+    }
+    auto rank = static_cast<std::uint64_t>(std::ceil(total * std::clamp(percent, 0.0, 100.0) / 100.0));
+    rank = std::max<std::uint64_t>(rank, 1u);
+    std::uint64_t seen = 0u;
+    for (std::size_t i = 0u; i < NUMBER_OF_BUCKETS; ++i)
+    {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            return std::min(highestOf(i), getMax());
+        }
+    }
+    return getMax();
+}
+
+std::size_t Histogram::bucketOf(Value value)
+{
+    if (value < SUB_BUCKETS)
+    {
+        return static_cast<std::size_t>(value);
+    }
+    // value >> shift is in [SUB_BUCKETS, 2 * SUB_BUCKETS)
+    unsigned shift = std::bit_width(value) - 1u - SUB_BUCKET_BITS;
+    return (shift + 1u) * SUB_BUCKETS + static_cast<std::size_t>((value >> shift) - SUB_BUCKETS);
+}
+
+Histogram::Value Histogram::lowestOf(std::size_t bucket)
+{
+    if (bucket < SUB_BUCKETS)
+    {
+        return bucket;
+    }
+    unsigned shift = static_cast<unsigned>(bucket / SUB_BUCKETS - 1u);
+    return (SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+}
+
+Histogram::Value Histogram::highestOf(std::size_t bucket)
+{
+    if (bucket + 1u == NUMBER_OF_BUCKETS)
+    {
+        return std::numeric_limits<Value>::max();
+    }
+    return lowestOf(bucket + 1u) - 1u;
+}
+
+std::ostream& operator<<(std::ostream& os, const Histogram& histogram)
+{
+    return os << "count: " << histogram.getCount()
+              << ", p50: " << histogram.getPercentile(50.0)
+              << ", p90: " << histogram.getPercentile(90.0)
+              << ", p99: " << histogram.getPercentile(99.0)
+              << ", p99.9: " << histogram.getPercentile(99.9)
+              << ", max: " << histogram.getMax();
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+
+namespace common
+{
+
+/**
+ * Log-linear histogram: each power of 2 is split into SUB_BUCKETS equal buckets,
+ * so any value is kept with relative error below 1/SUB_BUCKETS - from 0 up to UINT64_MAX in fixed memory.
+ *
+ * record() is lock-free (relaxed atomics) and never allocates - can be called from many threads at once,
+ * readers see a consistent enough picture for percentiles.
+ */
+class Histogram
+{
+public:
+    using Value = std::uint64_t;
+
+    static constexpr unsigned SUB_BUCKET_BITS = 4u;
+    static constexpr std::size_t SUB_BUCKETS = std::size_t{1u} << SUB_BUCKET_BITS;
+    static constexpr std::size_t NUMBER_OF_BUCKETS = (64u - SUB_BUCKET_BITS + 1u) * SUB_BUCKETS;
+
+    void record(Value value);
+    void merge(const Histogram& other);
+    void reset();
+
+    std::uint64_t getCount() const;
+    Value getMax() const;
+    /**
+     * @param percent - from 0 to 100
+     * @return highest value of the bucket the percentile falls into (not more than max recorded), 0 when empty
+     */
+    Value getPercentile(double percent) const;
+
+    static std::size_t bucketOf(Value value);
+    static Value lowestOf(std::size_t bucket);
+    static Value highestOf(std::size_t bucket);
+
+private:
+    std::array<std::atomic<std::uint64_t>, NUMBER_OF_BUCKETS> buckets{};
+    std::atomic<std::uint64_t> count{0u};
+    std::atomic<Value> max{0u};
+};
+
+/**
+ * count: n, p50: .., p90: .., p99: .., p99.9: .., max: ..
+ */
+std::ostream& operator<<(std::ostream& os, const Histogram& histogram);
+
+}
@@ -0,0 +1,133 @@
+#include "LatencyHistograms.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <ostream>
+#include <utility>
+
+namespace common
+{
+
+struct LatencyHistograms::Shard
+{
+    explicit Shard(std::size_t numberOfStages)
+        : histograms(std::make_unique<Histogram[]>(numberOfStages * NUMBER_OF_MESSAGE_IDS))
+    {}
+
+    Histogram& get(std::size_t stage, MessageId messageId)
+    {
+        return histograms[stage * NUMBER_OF_MESSAGE_IDS + common::get(messageId)];
+    }
+
+    std::unique_ptr<Histogram[]> histograms;
+};
+
+namespace
+{
+
+std::uint64_t nextId()
+{
+    static std::atomic<std::uint64_t> lastId{0u};
+    return ++lastId;
+}
+
+}
+
+LatencyHistograms::LatencyHistograms(std::vector<std::string> stageNames)
+    : id(nextId()),
+      stageNames(std::move(stageNames))
+{}
+
+LatencyHistograms::~LatencyHistograms() = default;
+
+void LatencyHistograms::record(std::size_t stage, MessageId messageId, std::chrono::nanoseconds latency)
+{
+    if (stage >= stageNames.size() or get(messageId) >= NUMBER_OF_MESSAGE_IDS)
+    {
+        return;
+    }
+    getThreadShard().get(stage, messageId).record(static_cast<Histogram::Value>(std::max<std::int64_t>(latency.count(), 0)));
+}
+
+void LatencyHistograms::collect(std::size_t stage, MessageId messageId, Histogram &merged) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& shard: shards)
+    {
+        merged.merge(shard->get(stage, messageId));
+    }
+}
+
+void LatencyHistograms::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& shard: shards)
+    {
+        for (std::size_t i = 0u; i < stageNames.size() * NUMBER_OF_MESSAGE_IDS; ++i)
+        {
+            shard->histograms[i].reset();
+        }
+    }
+}
+
+std::size_t LatencyHistograms::getNumberOfStages() const
+{
+    return stageNames.size();
+}
+
+const std::string &LatencyHistograms::getStageName(std::size_t stage) const
+{
+    return stageNames.at(stage);
+}
+
+LatencyHistograms::Shard &LatencyHistograms::getThreadShard()
+{
+    // usually one instance per process - so it is nearly always the first one
+    thread_local std::vector<std::pair<std::uint64_t, Shard*>> threadShards;
+    for (auto& [owner, shard]: threadShards)
+    {
+        if (owner == id)
+        {
+            return *shard;
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    shards.push_back(std::make_unique<Shard>(stageNames.size()));
+    threadShards.emplace_back(id, shards.back().get());
+    return *shards.back();
+}
+
+std::ostream& operator<<(std::ostream& os, const LatencyHistograms& histograms)
+{
+    auto printMicroseconds = [&os](Histogram::Value nanoseconds)
+    {
+        os << std::setw(10) << std::fixed << std::setprecision(1) << nanoseconds / 1000.0;
+    };
+    os << std::left << std::setw(12) << "stage" << std::setw(18) << "message" << std::right
+       << std::setw(10) << "count" << std::setw(10) << "p50[us]" << std::setw(10) << "p90"
+       << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max" << "\n";
+    for (std::size_t stage = 0u; stage < histograms.getNumberOfStages(); ++stage)
+    {
+        for (std::size_t id = 0u; id < NUMBER_OF_MESSAGE_IDS; ++id)
+        {
+            Histogram merged;
+            histograms.collect(stage, static_cast<MessageId>(id), merged);
+            if (merged.getCount() == 0u)
+            {
+                continue;
+            }
+            os << std::left << std::setw(12) << histograms.getStageName(stage)
+               << std::setw(18) << to_string(static_cast<MessageId>(id)) << std::right
+               << std::setw(10) << merged.getCount();
+            for (double percent: {50.0, 90.0, 99.0, 99.9})
+            {
+                printMicroseconds(merged.getPercentile(percent));
+            }
+            printMicroseconds(merged.getMax());
+            os << "\n";
+        }
+    }
+    return os;
+}
+
+}
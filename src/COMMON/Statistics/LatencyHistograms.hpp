@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Histogram.hpp"
+#include "Messages/MessageId.hpp"
+
+namespace common
+{
+
+/**
+ * Latency histograms [ns] for each stage and MessageId.
+ *
+ * Each thread records into its own shard of histograms - recording threads share no cache lines and take no lock
+ * (but the first record of the thread), shards are merged on read.
+ */
+class LatencyHistograms
+{
+public:
+    explicit LatencyHistograms(std::vector<std::string> stageNames);
+    ~LatencyHistograms();
+
+    void record(std::size_t stage, MessageId messageId, std::chrono::nanoseconds latency);
+    // all threads shards added to merged
+    void collect(std::size_t stage, MessageId messageId, Histogram& merged) const;
+    void reset();
+
+    std::size_t getNumberOfStages() const;
+    const std::string& getStageName(std::size_t stage) const;
+
+private:
+    struct Shard;
+    Shard& getThreadShard();
+
+    // never reused - so thread's cached shard of destroyed instance is never taken for this one
+    const std::uint64_t id;
+    const std::vector<std::string> stageNames;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+/**
+ * Table of non empty histograms: stage, message, count, p50, p90, p99, p99.9, max [us]
+ */
+std::ostream& operator<<(std::ostream& os, const LatencyHistograms& histograms);
+
+}
@@ -1,7 +1,13 @@
 #include "TestCommands.hpp"
 #include <sstream>
 #include <stdexcept>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include "Messages/OutgoingMessage.hpp"
 #include "Messages/MessageId.hpp"
@@ -9,6 +15,128 @@
 namespace common
 {
 
+namespace
+{
+
+/**
+ * Waits for the tasks of the group also when the command posting them throws -
+ * they refer to what is destroyed by unwinding (e.g. the group itself)
+ */
+class GroupJoin
+{
+public:
+    GroupJoin(WorkerPool& workers, WorkerPool::Group& group)
+        : workers(workers),
+          group(group)
+    {}
+
+    ~GroupJoin()
+    {
+        if (joined)
+        {
+            return;
+        }
+        try
+        {
+            workers.wait(group);
+        }
+        catch (...)
+        {
+            // the exception being unwound is reported instead
+        }
+    }
+
+    void join()
+    {
+        joined = true;
+        workers.wait(group);
+    }
+
+private:
+    WorkerPool& workers;
+    WorkerPool::Group& group;
+    bool joined = false;
+};
+
+}
+
+/**
+ * Open-loop pacing: n-th message is due at start + n * interval, no matter how long sending of the previous ones took
+ * (late messages are sent at once - never skipped)
+ */
+class TestCommands::Pacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Pacer(double messagesPerSecond)
+        : interval(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / messagesPerSecond))),
+          start(Clock::now()),
+          lastSent(start)
+    {}
+
+    void waitForSlot(Histogram& jitter)
+    {
+        Clock::time_point due;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            due = start + interval * slots++;
+        }
+        std::this_thread::sleep_until(due);
+        jitter.record(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - due).count());
+    }
+
+    void sent()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++sentCount;
+        lastSent = std::max(lastSent, Clock::now());
+    }
+
+    std::string report(double requestedRate)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto elapsed = std::chrono::duration<double>(lastSent - start).count();
+        // n messages are n-1 intervals apart
+        auto achievedRate = sentCount > 1u ? (sentCount - 1u) / elapsed : 0.0;
+        std::ostringstream oss;
+        oss << "rate requested: " << requestedRate << "/s, achieved: " << std::fixed << std::setprecision(1)
+            << achievedRate << "/s (" << sentCount << " messages in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(lastSent - start).count() << "ms)\n";
+        return oss.str();
+    }
+
+private:
+    const Clock::duration interval;
+    const Clock::time_point start;
+    std::mutex mutex;
+    std::uint64_t slots = 0u;
+    std::uint64_t sentCount = 0u;
+    Clock::time_point lastSent;
+};
+
+namespace
+{
+
+int hexDigitValue(char digit)
+{
+    if (digit >= '0' and digit <= '9')
+    {
+        return digit - '0';
+    }
+    if (digit >= 'a' and digit <= 'f')
+    {
+        return digit - 'a' + 10;
+    }
+    if (digit >= 'A' and digit <= 'F')
+    {
+        return digit - 'A' + 10;
+    }
+    return -1;
+}
+
+}
+
 const TestCommands::TextCommandMap TestCommands::textCommandMap =
 {
 
@@ -27,6 +155,14 @@ const TestCommands::TextCommandMap TestCommands::textCommandMap =
     {"thread", &TestCommands::readThreadCommand },
     {"t", &TestCommands::readThreadCommand },
 
+    {"join", &TestCommands::readJoinCommand },
+    {"j", &TestCommands::readJoinCommand },
+
+    {"parallel", &TestCommands::readParallelCommand },
+    {"p", &TestCommands::readParallelCommand },
+
+    {"rate", &TestCommands::readRateCommand },
+
     {"write", &TestCommands::readWriteCommand },
     {"text", &TestCommands::readWriteCommand },
     {"echo", &TestCommands::readWriteCommand },
@@ -43,12 +179,47 @@ TestCommands::TestCommands(std::string args)
     }
 }
 
+TestCommands TestCommands::fromFile(const std::string &path)
+{
+    std::ifstream file(path);
+    if (not file)
+    {
+        throw std::runtime_error("Cannot open test commands file: " + path);
+    }
+    std::string args;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        args.append(line, 0u, line.find('#')).push_back('\n');
+    }
+    return TestCommands(args);
+}
+
 void TestCommands::run(Parameters parameters)
 {
-    for (auto&& command : commands)
+    for (auto& sent: statistics.sent)
     {
-        command(parameters);
+        sent.store(0u, std::memory_order_relaxed);
     }
+    statistics.jitter.reset();
+    auto start = std::chrono::steady_clock::now();
+    {
+        WorkerPool::Group group;
+        WorkerPool workers(parameters.numberOfThreads);
+        Context context{parameters, workers, group, statistics, nullptr};
+        GroupJoin groupJoin(workers, group);
+        for (auto&& command : commands)
+        {
+            command(context);
+        }
+        groupJoin.join();
+    }
+    statistics.elapsed = std::chrono::steady_clock::now() - start;
+}
+
+const TestCommands::Statistics &TestCommands::getStatistics() const
+{
+    return statistics;
 }
 
 TestCommands::Command TestCommands::readCommand(std::istream &is)
@@ -77,11 +248,11 @@ TestCommands::Command TestCommands::readRepeatCommand(std::istream &is)
     {
         throwError("'repeat' needs sub command!");
     }
-    return [howMany, subCommand](Parameters parameters)
+    return [howMany, subCommand](const Context& context)
     {
         for (unsigned i = 0; i < howMany; ++i)
         {
-            subCommand(parameters);
+            subCommand(context);
         }
     };
 }
@@ -100,11 +271,11 @@ TestCommands::Command TestCommands::readGroupCommand(std::istream &is)
         }
         subCommands.push_back(subCommand);
     }
-    return [subCommands](Parameters parameters)
+    return [subCommands](const Context& context)
     {
         for (auto&& subCommand: subCommands)
         {
-            subCommand(parameters);
+            subCommand(context);
         }
     };
 }
@@ -116,28 +287,97 @@ TestCommands::Command TestCommands::readThreadCommand(std::istream &is)
     {
         throwError("'thread' needs sub command!");
     }
-    return [subCommand](Parameters parameters)
+    return [subCommand](const Context& context)
     {
-        std::thread t([subCommand, parameters] {
-            subCommand(parameters);
+        context.workers.post(context.group, [subCommand, context] {
+            runReportingFailure(subCommand, context, "thread");
         });
-        t.detach();
+    };
+}
+
+void TestCommands::runReportingFailure(const Command& subCommand, const Context& context, const char* name)
+{
+    try
+    {
+        subCommand(context);
+    }
+    catch (std::exception& ex)
+    {
+        context.parameters.printText(std::string(" ") + name + " command failed: " + ex.what());
+    }
+}
+
+TestCommands::Command TestCommands::readJoinCommand(std::istream &)
+{
+    return [](const Context& context)
+    {
+        context.workers.wait(context.group);
+    };
+}
+
+TestCommands::Command TestCommands::readParallelCommand(std::istream &is)
+{
+    unsigned howMany = readArg<unsigned>(is, "'parallel' needs how-many-at-once number");
+    Command subCommand = readCommand(is);
+    if (not subCommand)
+    {
+        throwError("'parallel' needs sub command!");
+    }
+    return [howMany, subCommand](const Context& context)
+    {
+        // at most Parameters::numberOfThreads of them run at once
+        WorkerPool::Group group;
+        Context subContext{context.parameters, context.workers, group, context.statistics, context.pacer};
+        GroupJoin groupJoin(context.workers, group);
+        for (unsigned i = 0; i < howMany; ++i)
+        {
+            context.workers.post(group, [subCommand, &subContext]
+            {
+                runReportingFailure(subCommand, subContext, "parallel");
+            });
+        }
+        groupJoin.join();
+    };
+}
+
+TestCommands::Command TestCommands::readRateCommand(std::istream &is)
+{
+    double messagesPerSecond = readArg<double>(is, "'rate' needs messages per second number");
+    if (not std::isfinite(messagesPerSecond) or messagesPerSecond <= 0.0)
+    {
+        throwError("'rate' needs positive messages per second number");
+    }
+    Command subCommand = readCommand(is);
+    if (not subCommand)
+    {
+        throwError("'rate' needs sub command!");
+    }
+    return [messagesPerSecond, subCommand](const Context& context)
+    {
+        Pacer pacer(messagesPerSecond);
+        WorkerPool::Group group;
+        Context subContext{context.parameters, context.workers, group, context.statistics, &pacer};
+        GroupJoin groupJoin(context.workers, group);
+        subCommand(subContext);
+        // messages sent by 'thread' sub commands count too
+        groupJoin.join();
+        context.parameters.printText(pacer.report(messagesPerSecond));
     };
 }
 
 TestCommands::Command TestCommands::readWriteCommand(std::istream &is)
 {
     std::string message = readArg<std::string>(is, "`write` needs message to write!");
-    return [message](Parameters parameters)
+    return [message](const Context& context)
     {
-        parameters.printText(message);
+        context.parameters.printText(message);
     };
 }
 
 TestCommands::Command TestCommands::readWaitCommand(std::istream &is)
 {
     std::uint32_t waitTime = readArg<std::uint32_t>(is, "'wait' needs wait time (ms)");
-    return [waitTime](Parameters)
+    return [waitTime](const Context&)
     {
         std::this_thread::sleep_for(std::chrono::milliseconds(waitTime));
     };
@@ -147,18 +387,27 @@ TestCommands::Command TestCommands::readSendCommand(std::istream &is)
 {
     MessageId messageId = readArg<MessageId>(is, "'send' needs MessageId", MessageId::Sib);
     PhoneNumber from = readArg<PhoneNumber>(is, "'send' needs From(PhoneNumber)");
-    PhoneNumber to = readArg<PhoneNumber>(is, "'send' needs From(PhoneNumber)");
+    PhoneNumber to = readArg<PhoneNumber>(is, "'send' needs To(PhoneNumber)");
     std::string messageBody = readMessageBody(is);
     OutgoingMessage messageBuilder(messageId, from, to);
     if (not messageBody.empty())
     {
         messageBuilder.writeText(messageBody);
     }
-    auto message = messageBuilder.getMessage();
+    Frame message = messageBuilder.getMessage();
 
-    return [to, message](Parameters parameters)
+    return [messageId, to, message](const Context& context)
     {
-        parameters.sendMessage(message, to);
+        if (context.pacer)
+        {
+            context.pacer->waitForSlot(context.statistics.jitter);
+        }
+        context.parameters.sendMessage(message, to);
+        context.statistics.sent[get(messageId)].fetch_add(1u, std::memory_order_relaxed);
+        if (context.pacer)
+        {
+            context.pacer->sent();
+        }
     };
 }
 
@@ -192,13 +441,13 @@ std::string TestCommands::readMessageBody(std::istream &is)
     hexBody.reserve(body.length() / 2);
     for (std::string::size_type i = 0; i < body.length(); i += 2)
     {
-        std::istringstream oneNumberStream(body.substr(i, 2));
-        unsigned oneNumber;
-        if (not (oneNumberStream >> std::hex >> oneNumber))
+        int high = hexDigitValue(body[i]);
+        int low = hexDigitValue(body[i + 1]);
+        if (high < 0 or low < 0)
         {
             throwError(body.substr(i, 2) + ": is not hex number!");
         }
-        hexBody += static_cast<char>(oneNumber);
+        hexBody += static_cast<char>(high * 16 + low);
     }
     return hexBody;
 }
@@ -208,4 +457,35 @@ void TestCommands::throwError(std::string msg)
     throw std::runtime_error("Parse error: " + msg);
 }
 
+std::uint64_t TestCommands::Statistics::getTotalSent() const
+{
+    std::uint64_t total = 0u;
+    for (auto& sentOfId: sent)
+    {
+        total += sentOfId.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::ostream& operator<<(std::ostream& os, const TestCommands::Statistics& statistics)
+{
+    auto total = statistics.getTotalSent();
+    auto seconds = std::chrono::duration<double>(statistics.elapsed).count();
+    os << "sent: " << total << " messages in "
+       << std::chrono::duration_cast<std::chrono::milliseconds>(statistics.elapsed).count() << "ms ("
+       << std::fixed << std::setprecision(1) << (seconds > 0.0 ? total / seconds : 0.0) << " msg/s)\n";
+    for (std::size_t id = 0u; id < statistics.sent.size(); ++id)
+    {
+        if (auto sent = statistics.sent[id].load(std::memory_order_relaxed))
+        {
+            os << "\t" << static_cast<MessageId>(id) << ": " << sent << "\n";
+        }
+    }
+    if (statistics.jitter.getCount() > 0u)
+    {
+        os << "jitter [us]: " << statistics.jitter << "\n";
+    }
+    return os;
+}
+
 }
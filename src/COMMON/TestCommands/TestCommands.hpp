@@ -1,7 +1,13 @@
 #pragma once
 
 #include "Messages/PhoneNumber.hpp"
-#include "Messages/BinaryMessage.hpp"
+#include "Messages/Frame.hpp"
+#include "Messages/MessageId.hpp"
+#include "Statistics/Histogram.hpp"
+#include "WorkerPool.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <map>
 #include <functional>
@@ -10,25 +16,73 @@
 namespace common
 {
 
+/**
+ * @example Commands
+ *
+ * repeat 10 send Sms 1 2 hello          - 10 messages
+ * thread repeat 100 send Sms 1 2 hello  - run by worker thread, 'join' waits for it
+ * parallel 4 repeat 100 send Sms 1 2 x  - 4 copies at once, waits for all of them
+ * rate 1000 repeat 10000 send Sms 1 2 x - sent at 1000 msg/s, achieved rate is printed
+ *
+ * Commands are parsed once - messages are encoded then, sending allocates nothing.
+ */
 class TestCommands
 {
 public:
     TestCommands(std::string args);
+    /**
+     * Scenario file - commands as above in any number of lines, '#' starts comment till end of line
+     * @throw std::runtime_error
+     */
+    static TestCommands fromFile(const std::string& path);
 
     using PrintText = std::function<void(std::string)>;
-    using SendMessage = std::function<void(const BinaryMessage&,
+    // the same frame (shared payload) is given for each send of the same 'send' command
+    using SendMessage = std::function<void(const Frame&,
                                            PhoneNumber /*to*/)>;
     struct Parameters
     {
         PrintText printText;
         SendMessage sendMessage;
+        // bound of 'thread' and 'parallel' commands running at once
+        std::size_t numberOfThreads = 8u;
     };
+    struct Statistics
+    {
+        std::array<std::atomic<std::uint64_t>, NUMBER_OF_MESSAGE_IDS> sent{};
+        std::chrono::steady_clock::duration elapsed{};
+        // how late messages paced by 'rate' were sent [us]
+        Histogram jitter;
+
+        std::uint64_t getTotalSent() const;
+    };
+
+    /**
+     * Returns when all commands are done - including these run by 'thread'
+     */
     void run(Parameters parameters);
+    // of the last run
+    const Statistics& getStatistics() const;
 
 private:
-    using Command = std::function<void(Parameters)>;
+    class Pacer;
+
+    /**
+     * Commands run by 'thread' are posted into the group of the enclosing scope - 'join' waits for them
+     */
+    struct Context
+    {
+        Parameters parameters;
+        WorkerPool& workers;
+        WorkerPool::Group& group;
+        Statistics& statistics;
+        // set inside 'rate'
+        Pacer* pacer;
+    };
+    using Command = std::function<void(const Context&)>;
     using Commands = std::vector<Command>;
     Commands commands;
+    Statistics statistics;
 
     Command readCommand(std::istream& is);
     Command readRepeatCommand(std::istream& is);
@@ -37,16 +91,26 @@ private:
     Command readGroupCommand(std::istream& is);
     Command readThreadCommand(std::istream& is);
     Command readWriteCommand(std::istream& is);
+    Command readJoinCommand(std::istream& is);
+    Command readParallelCommand(std::istream& is);
+    Command readRateCommand(std::istream& is);
 
     template <typename T>
     T readArg(std::istream& is, std::string onFailure, T defaultValue = T{});
     std::string readMessageBody(std::istream& is);
 
     void throwError(std::string msg);
+    // exception of command run by worker is printed - it would be lost (or terminate the worker thread) otherwise
+    static void runReportingFailure(const Command& subCommand, const Context& context, const char* name);
 
     using ReadCommandFunction = Command(TestCommands::*)(std::istream& is);
     using TextCommandMap = std::map<std::string, ReadCommandFunction>;
     static const TextCommandMap textCommandMap;
 };
 
+/**
+ * Messages sent per MessageId, throughput and jitter distribution
+ */
+std::ostream& operator<<(std::ostream& os, const TestCommands::Statistics& statistics);
+
 }
@@ -0,0 +1,109 @@
+#include "WorkerPool.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace common
+{
+
+WorkerPool::WorkerPool(std::size_t numberOfThreads)
+{
+    if (numberOfThreads == 0u)
+    {
+        throw std::invalid_argument("Worker pool needs at least one thread");
+    }
+    threads.reserve(numberOfThreads);
+    for (std::size_t i = 0u; i < numberOfThreads; ++i)
+    {
+        threads.emplace_back(&WorkerPool::run, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerPool::post(Group &group, Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++group.pending;
+        tasks.push_back(QueuedTask{&group, std::move(task)});
+    }
+    changed.notify_all();
+}
+
+void WorkerPool::wait(Group &group)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (group.pending > 0u)
+    {
+        if (tasks.empty())
+        {
+            changed.wait(lock);
+        }
+        else
+        {
+            runFront(lock);
+        }
+    }
+    if (group.error)
+    {
+        std::rethrow_exception(std::exchange(group.error, nullptr));
+    }
+}
+
+std::size_t WorkerPool::size() const
+{
+    return threads.size();
+}
+
+void WorkerPool::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        changed.wait(lock, [this] { return stopping or not tasks.empty(); });
+        if (tasks.empty())
+        {
+            return;
+        }
+        runFront(lock);
+    }
+}
+
+void WorkerPool::runFront(std::unique_lock<std::mutex> &lock)
+{
+    auto queued = std::move(tasks.front());
+    tasks.pop_front();
+    lock.unlock();
+    std::exception_ptr error;
+    try
+    {
+        queued.task();
+    }
+    catch (...)
+    {
+        // kept for wait() - escaping the worker thread would terminate the process
+        error = std::current_exception();
+    }
+    lock.lock();
+    if (error and not queued.group->error)
+    {
+        queued.group->error = error;
+    }
+    if (--queued.group->pending == 0u)
+    {
+        changed.notify_all();
+    }
+}
+
+}
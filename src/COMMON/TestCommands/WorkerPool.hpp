@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace common
+{
+
+/**
+ * Fixed number of threads running posted tasks in FIFO order.
+ *
+ * Tasks are posted into a Group - so one can wait for own tasks only. The waiting thread runs queued tasks
+ * meanwhile - so waiting from inside a task (nested groups) does not block the pool when all threads wait.
+ */
+class WorkerPool
+{
+public:
+    using Task = std::function<void()>;
+
+    class Group
+    {
+    public:
+        Group() = default;
+        Group(const Group&) = delete;
+        Group& operator=(const Group&) = delete;
+
+    private:
+        friend class WorkerPool;
+        std::size_t pending = 0u;
+        // the first one thrown by the group tasks
+        std::exception_ptr error;
+    };
+
+    /**
+     * @throw std::invalid_argument for zero threads
+     */
+    explicit WorkerPool(std::size_t numberOfThreads);
+    // all posted tasks are run before threads are joined
+    ~WorkerPool();
+
+    void post(Group& group, Task task);
+    /**
+     * @throw the first exception thrown by the group tasks - rethrown when all of them are finished
+     */
+    void wait(Group& group);
+    std::size_t size() const;
+
+private:
+    struct QueuedTask
+    {
+        Group* group;
+        Task task;
+    };
+
+    void run();
+    // called with the lock held, unlocks for the task
+    void runFront(std::unique_lock<std::mutex>& lock);
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<QueuedTask> tasks;
+    bool stopping = false;
+    std::vector<std::thread> threads;
+};
+
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <future>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Logger/AsyncLogger.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+
+class AsyncLoggerTestSuite : public Test
+{
+protected:
+    const std::string message1 = "Not yet!";
+    const std::string message2 = "Now!";
+
+    std::ostringstream debugLog, infoLog, errorLog, commonLog;
+
+    std::unique_ptr<AsyncLogger> createLogger(AsyncLogger::Options options = AsyncLogger::Options{})
+    {
+        return std::make_unique<AsyncLogger>(
+            std::initializer_list<AsyncLogger::LevelInfo>{
+                { "[DEBUG]", { &debugLog, &commonLog } },
+                { "", { &infoLog, &commonLog } },
+                { "[ERROR]", { &errorLog, &commonLog } }
+            },
+            options);
+    }
+
+    static long countLines(const std::ostringstream& log)
+    {
+        auto str = log.str();
+        return std::count(str.begin(), str.end(), '\n');
+    }
+};
+
+TEST_F(AsyncLoggerTestSuite, shallPrintToStreamsOfLevelAfterFlush)
+{
+    auto objectUnderTest = createLogger();
+    objectUnderTest->logDebug(message1);
+    objectUnderTest->logError(message2);
+    objectUnderTest->flush();
+
+    ASSERT_THAT(debugLog.str(), AllOf(HasSubstr(message1), HasSubstr("[DEBUG]")));
+    ASSERT_THAT(errorLog.str(), AllOf(HasSubstr(message2), HasSubstr("[ERROR]")));
+    ASSERT_THAT(infoLog.str(), IsEmpty());
+    ASSERT_EQ(2, countLines(commonLog));
+}
+
+TEST_F(AsyncLoggerTestSuite, shallPrintInOrderOfLogging)
+{
+    auto objectUnderTest = createLogger();
+    objectUnderTest->logInfo(message1);
+    objectUnderTest->logInfo(message2);
+    objectUnderTest->flush();
+
+    auto str = infoLog.str();
+    ASSERT_LT(str.find(message1), str.find(message2));
+}
+
+TEST_F(AsyncLoggerTestSuite, shallWriteAllLinesOnDestruction)
+{
+    auto objectUnderTest = createLogger();
+    for (int i = 0; i < 100; ++i)
+    {
+        objectUnderTest->logDebug(message1, i);
+    }
+    objectUnderTest.reset();
+    ASSERT_EQ(100, countLines(debugLog));
+}
+
+TEST_F(AsyncLoggerTestSuite, shallNotLoseLinesOfManyThreadsWhenBlocking)
+{
+    constexpr int NUMBER_OF_THREADS = 4;
+    constexpr int LINES_PER_THREAD = 1000;
+    auto objectUnderTest = createLogger({ 16u, AsyncLogger::OverflowPolicy::Block });
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUMBER_OF_THREADS; ++i)
+    {
+        threads.emplace_back([&] {
+            for (int j = 0; j < LINES_PER_THREAD; ++j)
+            {
+                objectUnderTest->logInfo(message1, j);
+            }
+        });
+    }
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+    objectUnderTest->flush();
+
+    ASSERT_EQ(NUMBER_OF_THREADS * LINES_PER_THREAD, countLines(infoLog));
+    ASSERT_EQ(0u, objectUnderTest->getDroppedCount());
+}
+
+TEST_F(AsyncLoggerTestSuite, shallNotPrintBelowMinimumLevel)
+{
+    auto objectUnderTest = createLogger();
+    objectUnderTest->setMinimumLevel(ILogger::INFO_LEVEL);
+    objectUnderTest->logDebug(message1);
+    objectUnderTest->logInfo(message2);
+    objectUnderTest->flush();
+
+    ASSERT_THAT(debugLog.str(), IsEmpty());
+    ASSERT_THAT(infoLog.str(), HasSubstr(message2));
+}
+
+/**
+ * Stream blocking the writer thread on first write - till released
+ */
+class BlockingStreamBuf : public std::stringbuf
+{
+public:
+    std::promise<void> entered;
+    std::promise<void> released;
+
+protected:
+    std::streamsize xsputn(const char* s, std::streamsize count) override
+    {
+        if (not blocked)
+        {
+            blocked = true;
+            entered.set_value();
+            released.get_future().wait();
+        }
+        return std::stringbuf::xsputn(s, count);
+    }
+
+private:
+    bool blocked = false;
+};
+
+TEST_F(AsyncLoggerTestSuite, shallCountAndReportDroppedLines)
+{
+    BlockingStreamBuf blockingBuf;
+    std::ostream blockingLog(&blockingBuf);
+    auto entered = blockingBuf.entered.get_future();
+    AsyncLogger objectUnderTest{
+        { { "[DEBUG]", { &blockingLog } }, { "", { &blockingLog } }, { "[ERROR]", { &blockingLog } } },
+        { 2u, AsyncLogger::OverflowPolicy::Drop }
+    };
+
+    objectUnderTest.logInfo(message1);
+    entered.wait();
+    objectUnderTest.logInfo(message1);
+    objectUnderTest.logInfo(message1);
+    objectUnderTest.logInfo(message2);
+    ASSERT_EQ(1u, objectUnderTest.getDroppedCount());
+
+    blockingBuf.released.set_value();
+    objectUnderTest.flush();
+    ASSERT_THAT(blockingBuf.str(), Not(HasSubstr(message2)));
+    objectUnderTest.logInfo(message2);
+    objectUnderTest.flush();
+    ASSERT_THAT(blockingBuf.str(), AllOf(HasSubstr("lines dropped: 1"), HasSubstr(message2)));
+}
+
+} // namespace common
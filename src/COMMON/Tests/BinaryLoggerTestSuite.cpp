@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+
+#include "Logger/BinaryLogger.hpp"
+#include "Logger/BinaryLogReader.hpp"
+#include "Logger/Logger.hpp"
+#include "Logger/PrefixedLogger.hpp"
+#include "Messages.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+
+class BinaryLoggerTestSuite : public Test
+{
+protected:
+    const MessageHeader HEADER{MessageId::Sms, PhoneNumber{1}, PhoneNumber{2}};
+    const BinaryMessage MESSAGE{BinaryMessage::Value(100u, 0xAB)};
+    const std::string ADDRESS = "127.0.0.1:1234";
+
+    std::stringstream binaryLog;
+    BinaryLogger objectUnderTest{binaryLog};
+    PrefixedLogger prefixedLogger{objectUnderTest, "[UE]"};
+
+    std::vector<std::string> decode(BinaryLogReader::Filter filter = {})
+    {
+        objectUnderTest.flush();
+        std::istringstream input(binaryLog.str());
+        BinaryLogReader reader(input, filter);
+        std::vector<std::string> lines;
+        while (auto line = reader.readLine())
+        {
+            lines.push_back(*line);
+        }
+        return lines;
+    }
+};
+
+TEST_F(BinaryLoggerTestSuite, shallBeDecodedAsLoggerPrints)
+{
+    std::ostringstream textLog;
+    Logger logger{{"[DEBUG]", {&textLog}}, {"", {&textLog}}, {"[ERROR]", {&textLog}}};
+    PrefixedLogger prefixedTextLogger{logger, "[UE]"};
+
+    prefixedTextLogger.logDebug("Message received from: ", ADDRESS, " body: ", MESSAGE);
+    prefixedTextLogger.logError("Cannot forward: ", HEADER);
+    prefixedTextLogger.logInfo("Attached");
+    prefixedLogger.logDebug("Message received from: ", ADDRESS, " body: ", MESSAGE);
+    prefixedLogger.logError("Cannot forward: ", HEADER);
+    prefixedLogger.logInfo("Attached");
+
+    std::string expected;
+    for (auto& line: decode())
+    {
+        expected += line + '\n';
+    }
+    ASSERT_EQ(textLog.str(), expected);
+}
+
+TEST_F(BinaryLoggerTestSuite, shallWritePrefixAndFormatOnce)
+{
+    prefixedLogger.logDebug("Forwarded: ", HEADER);
+    auto firstLineSize = binaryLog.str().size();
+    prefixedLogger.logDebug("Forwarded: ", HEADER);
+    auto secondLineSize = binaryLog.str().size() - firstLineSize;
+
+    ASSERT_LT(secondLineSize, firstLineSize);
+    ASSERT_THAT(decode(), ElementsAre(HasSubstr("[UE]Forwarded: "), HasSubstr("[UE]Forwarded: ")));
+}
+
+TEST_F(BinaryLoggerTestSuite, shallWriteMessageInBinary)
+{
+    std::ostringstream hexMessage;
+    hexMessage << MESSAGE;
+    prefixedLogger.logDebug("body: ", MESSAGE);
+    auto logSize = binaryLog.str().size();
+    prefixedLogger.logDebug("body: ", MESSAGE);
+    ASSERT_LT(binaryLog.str().size() - logSize, hexMessage.str().size() / 2u + 50u);
+}
+
+TEST_F(BinaryLoggerTestSuite, shallFilterByPhoneNumberAndMessageId)
+{
+    prefixedLogger.logDebug("Forwarded: ", HEADER);
+    prefixedLogger.logDebug("Attached: ", PhoneNumber{3});
+    prefixedLogger.logDebug("Not supported: ", MessageId::CallTalk);
+
+    ASSERT_THAT(decode({PhoneNumber{2}, std::nullopt}), ElementsAre(HasSubstr("Forwarded")));
+    ASSERT_THAT(decode({PhoneNumber{3}, std::nullopt}), ElementsAre(HasSubstr("Attached")));
+    ASSERT_THAT(decode({std::nullopt, MessageId::CallTalk}), ElementsAre(HasSubstr("Not supported")));
+    ASSERT_THAT(decode({PhoneNumber{1}, MessageId::CallTalk}), IsEmpty());
+}
+
+TEST_F(BinaryLoggerTestSuite, shallNotLogBelowMinimumLevel)
+{
+    objectUnderTest.setMinimumLevel(ILogger::INFO_LEVEL);
+    prefixedLogger.logDebug("Forwarded: ", HEADER);
+    prefixedLogger.logInfo("Attached");
+    ASSERT_THAT(decode(), ElementsAre(HasSubstr("Attached")));
+}
+
+TEST_F(BinaryLoggerTestSuite, shallNotReadTextLogNorTruncatedLog)
+{
+    std::istringstream textLog("#1,tid:1[DEBUG]:text log\n");
+    ASSERT_THROW(BinaryLogReader{textLog}, BinaryLogReader::ReadEx);
+
+    prefixedLogger.logInfo("Attached");
+    auto log = binaryLog.str();
+    std::istringstream truncatedLog(log.substr(0u, log.size() - 1u));
+    BinaryLogReader reader(truncatedLog);
+    ASSERT_THROW(reader.readLine(), BinaryLogReader::ReadEx);
+}
+
+}
@@ -0,0 +1,323 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "PosixTransport/EpollTransport.hpp"
+#include "PosixTransport/EpollServer.hpp"
+#include "Messages/MessageId.hpp"
+#include "Mocks/ILoggerMock.hpp"
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+namespace common
+{
+
+class EpollTransportTestSuite : public Test
+{
+protected:
+    explicit EpollTransportTestSuite(SendQueue::Options sendQueueOptions = {})
+    {
+        int sockets[2];
+        ::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+        peerFd = sockets[1];
+        objectUnderTest = std::make_shared<EpollTransport>(loop, sockets[0], loggerMock, sendQueueOptions);
+        objectUnderTest->registerMessageCallback([this](Frame message) { onMessage(std::move(message)); });
+        objectUnderTest->registerDisconnectedCallback([this] { onDisconnected(); });
+        objectUnderTest->start();
+    }
+    ~EpollTransportTestSuite()
+    {
+        objectUnderTest.reset();
+        if (peerFd >= 0)
+        {
+            ::close(peerFd);
+        }
+    }
+
+    void onMessage(Frame message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(std::move(message));
+        condition.notify_all();
+    }
+    void onDisconnected()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        disconnected = true;
+        condition.notify_all();
+    }
+    bool waitForMessages(std::size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return condition.wait_for(lock, 5s, [this, count] { return received.size() >= count; });
+    }
+    bool waitForDisconnection()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return condition.wait_for(lock, 5s, [this] { return disconnected; });
+    }
+    void writeToPeer(const std::vector<std::uint8_t>& bytes)
+    {
+        ASSERT_EQ(static_cast<ssize_t>(bytes.size()), ::write(peerFd, bytes.data(), bytes.size()));
+    }
+    std::vector<std::uint8_t> readFromPeer(std::size_t length)
+    {
+        std::vector<std::uint8_t> bytes(length);
+        std::size_t readLength = 0u;
+        while (readLength < length)
+        {
+            auto result = ::read(peerFd, bytes.data() + readLength, length - readLength);
+            if (result <= 0)
+            {
+                break;
+            }
+            readLength += result;
+        }
+        bytes.resize(readLength);
+        return bytes;
+    }
+    template <typename Task>
+    auto runInLoop(Task task)
+    {
+        std::packaged_task<decltype(task())()> packagedTask(std::move(task));
+        auto result = packagedTask.get_future();
+        loop.post([&packagedTask] { packagedTask(); });
+        return result.get();
+    }
+
+    const BinaryMessage MESSAGE{{0x11, 0x22, 0x33, 0x44, 0x55}};
+    const std::vector<std::uint8_t> FRAME{0x00, 0x05, 0x11, 0x22, 0x33, 0x44, 0x55};
+
+    NiceMock<ILoggerMock> loggerMock;
+    EpollLoopPool loops{1u};
+    EpollLoop& loop = loops.next();
+    int peerFd = -1;
+    std::shared_ptr<EpollTransport> objectUnderTest;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<Frame> received;
+    bool disconnected = false;
+};
+
+TEST_F(EpollTransportTestSuite, shallReceiveMessage)
+{
+    writeToPeer(FRAME);
+
+    ASSERT_TRUE(waitForMessages(1u));
+    ASSERT_EQ(Frame(MESSAGE), received[0]);
+}
+
+TEST_F(EpollTransportTestSuite, shallReceiveManyMessagesWrittenTogether)
+{
+    std::vector<std::uint8_t> frames;
+    for (int i = 0; i < 3; ++i)
+    {
+        frames.insert(frames.end(), FRAME.begin(), FRAME.end());
+    }
+    writeToPeer(frames);
+
+    ASSERT_TRUE(waitForMessages(3u));
+    ASSERT_EQ(Frame(MESSAGE), received[2]);
+}
+
+TEST_F(EpollTransportTestSuite, shallWaitForRestOfPartialMessage)
+{
+    writeToPeer({FRAME.begin(), FRAME.begin() + 3});
+    std::this_thread::sleep_for(50ms);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_TRUE(received.empty());
+    }
+
+    writeToPeer({FRAME.begin() + 3, FRAME.end()});
+
+    ASSERT_TRUE(waitForMessages(1u));
+    ASSERT_EQ(Frame(MESSAGE), received[0]);
+}
+
+TEST_F(EpollTransportTestSuite, shallSendMessageWithSizePrefix)
+{
+    ASSERT_TRUE(objectUnderTest->sendMessage(MESSAGE));
+
+    ASSERT_EQ(FRAME, readFromPeer(FRAME.size()));
+}
+
+TEST_F(EpollTransportTestSuite, shallSendInOrderWhatSocketDoesNotAcceptAtOnce)
+{
+    const std::size_t NUMBER_OF_MESSAGES = 10000u;
+    const Frame bigMessage{BinaryMessage{BinaryMessage::Value(1000u, 0xAB)}};
+    for (std::size_t i = 0u; i < NUMBER_OF_MESSAGES; ++i)
+    {
+        ASSERT_TRUE(objectUnderTest->sendMessage(bigMessage));
+    }
+
+    for (std::size_t i = 0u; i < NUMBER_OF_MESSAGES; ++i)
+    {
+        auto frame = readFromPeer(2u + bigMessage.size());
+        ASSERT_EQ(2u + bigMessage.size(), frame.size());
+        ASSERT_EQ(0x03, frame[0]);
+        ASSERT_EQ(0xE8, frame[1]);
+        ASSERT_EQ(0xAB, frame.back());
+    }
+}
+
+TEST_F(EpollTransportTestSuite, shallWriteTogetherMessagesSentInOneLoopIteration)
+{
+    runInLoop([this]
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            objectUnderTest->sendMessage(MESSAGE);
+        }
+        return 0;
+    });
+
+    std::vector<std::uint8_t> frames;
+    for (int i = 0; i < 3; ++i)
+    {
+        frames.insert(frames.end(), FRAME.begin(), FRAME.end());
+    }
+    ASSERT_EQ(frames, readFromPeer(frames.size()));
+}
+
+TEST_F(EpollTransportTestSuite, shallReportDisconnectionWhenPeerCloses)
+{
+    ::close(peerFd);
+    peerFd = -1;
+
+    ASSERT_TRUE(waitForDisconnection());
+    ASSERT_FALSE(objectUnderTest->sendMessage(MESSAGE));
+}
+
+TEST_F(EpollTransportTestSuite, shallDisconnectOnWrongMessageSize)
+{
+    writeToPeer({0xFF, 0xFF, 0x00});
+
+    ASSERT_TRUE(waitForDisconnection());
+}
+
+class EpollTransportWithSmallSendQueueTestSuite : public EpollTransportTestSuite
+{
+protected:
+    static constexpr std::size_t LIMIT = 1024u * 1024u;
+
+    explicit EpollTransportWithSmallSendQueueTestSuite(SendQueue::OverflowPolicy policy = SendQueue::OverflowPolicy::DropCallTalk)
+        : EpollTransportTestSuite(SendQueue::Options{4u * CALL_TALK_FRAME_LENGTH, CALL_TALK_FRAME_LENGTH, LIMIT, policy})
+    {}
+
+    static constexpr std::size_t CALL_TALK_FRAME_LENGTH = 2u + 8u;
+    const BinaryMessage CALL_TALK{{get(MessageId::CallTalk), 1, 2, 3, 4, 5, 6, 7}};
+    const BinaryMessage CALL_DROPPED{{get(MessageId::CallDropped), 1, 2, 3, 4, 5, 6, 7}};
+};
+
+TEST_F(EpollTransportWithSmallSendQueueTestSuite, shallDropCallTalkButSendControlMessagesWhenCongested)
+{
+    // nothing is written till the loop iteration ends - so the queue gets congested
+    auto [numberOfCallTalkSent, controlMessageSent, congested] = runInLoop([this]
+    {
+        std::size_t numberOfCallTalkSent = 0u;
+        while (objectUnderTest->sendMessage(CALL_TALK))
+        {
+            ++numberOfCallTalkSent;
+        }
+        return std::make_tuple(numberOfCallTalkSent, objectUnderTest->sendMessage(CALL_DROPPED),
+                               objectUnderTest->isCongested());
+    });
+    ASSERT_EQ(5u, numberOfCallTalkSent);
+    ASSERT_TRUE(controlMessageSent);
+    ASSERT_TRUE(congested);
+
+    auto written = readFromPeer((numberOfCallTalkSent + 1u) * CALL_TALK_FRAME_LENGTH);
+    ASSERT_EQ(get(MessageId::CallTalk), written[2]);
+    ASSERT_EQ(get(MessageId::CallDropped), written[numberOfCallTalkSent * CALL_TALK_FRAME_LENGTH + 2u]);
+    ASSERT_FALSE(runInLoop([this] { return objectUnderTest->isCongested(); }));
+}
+
+class EpollTransportDisconnectingWhenCongestedTestSuite : public EpollTransportWithSmallSendQueueTestSuite
+{
+protected:
+    EpollTransportDisconnectingWhenCongestedTestSuite()
+        : EpollTransportWithSmallSendQueueTestSuite(SendQueue::OverflowPolicy::Disconnect)
+    {}
+};
+
+TEST_F(EpollTransportDisconnectingWhenCongestedTestSuite, shallDisconnectWhenCongested)
+{
+    auto numberOfSent = runInLoop([this]
+    {
+        std::size_t numberOfSent = 0u;
+        while (objectUnderTest->sendMessage(CALL_DROPPED))
+        {
+            ++numberOfSent;
+        }
+        return numberOfSent;
+    });
+    ASSERT_EQ(5u, numberOfSent);
+
+    ASSERT_TRUE(waitForDisconnection());
+}
+
+class EpollServerTestSuite : public Test
+{
+protected:
+    NiceMock<ILoggerMock> loggerMock;
+    EpollLoopPool loops{2u};
+    std::shared_ptr<EpollServer> objectUnderTest = std::make_shared<EpollServer>(loops, loggerMock);
+};
+
+TEST_F(EpollServerTestSuite, shallExchangeMessagesWithConnectedClient)
+{
+    const BinaryMessage MESSAGE{{0x01, 0x02, 0x03}};
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<Frame> receivedByServer;
+    std::vector<Frame> receivedByClient;
+    std::shared_ptr<ITransport> serverSide;
+
+    objectUnderTest->registerConnectionCallback([&](std::shared_ptr<ITransport> transport)
+    {
+        transport->registerMessageCallback([&, transport = transport.get()](Frame message)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                receivedByServer.push_back(message);
+            }
+            transport->sendMessage(std::move(message));
+        });
+        std::lock_guard<std::mutex> lock(mutex);
+        serverSide = transport;
+    });
+    objectUnderTest->listen(0u);
+
+    auto client = EpollTransport::connect(loops.next(), "localhost", objectUnderTest->getPort(), loggerMock);
+    client->registerMessageCallback([&](Frame message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        receivedByClient.push_back(std::move(message));
+        condition.notify_all();
+    });
+    client->start();
+    client->sendMessage(MESSAGE);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(condition.wait_for(lock, 5s, [&] { return not receivedByClient.empty(); }));
+    ASSERT_EQ(Frame(MESSAGE), receivedByServer.at(0));
+    ASSERT_EQ(Frame(MESSAGE), receivedByClient.at(0));
+    lock.unlock();
+
+    client->registerMessageCallback(nullptr);
+    serverSide->registerMessageCallback(nullptr);
+}
+
+}
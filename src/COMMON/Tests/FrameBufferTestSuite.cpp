@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "CommonEnvironment/FrameBuffer.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class FrameBufferTestSuite : public Test
+{
+protected:
+    using Bytes = std::vector<BinaryMessage::ValueType>;
+
+    FrameBuffer objectUnderTest{0u};
+
+    static Bytes frame(const Bytes& message)
+    {
+        Bytes result{ static_cast<std::uint8_t>(message.size() >> 8), static_cast<std::uint8_t>(message.size()) };
+        result.insert(result.end(), message.begin(), message.end());
+        return result;
+    }
+    void receive(const Bytes& data)
+    {
+        auto space = objectUnderTest.writableSpace();
+        ASSERT_LE(data.size(), space.size());
+        std::copy(data.begin(), data.end(), space.begin());
+        objectUnderTest.commit(data.size());
+    }
+    std::vector<Bytes> takeFrames()
+    {
+        std::vector<Bytes> result;
+        while (auto frame = objectUnderTest.nextFrame())
+        {
+            result.emplace_back(frame->begin(), frame->end());
+        }
+        return result;
+    }
+};
+
+TEST_F(FrameBufferTestSuite, shallHoldAtLeastFrameOfMaxSize)
+{
+    ASSERT_EQ(FrameBuffer::MAX_FRAME_LENGTH, objectUnderTest.capacity());
+    ASSERT_EQ(FrameBuffer::MAX_FRAME_LENGTH, objectUnderTest.writableSpace().size());
+}
+
+TEST_F(FrameBufferTestSuite, shallNotHandOutFrameWhenEmpty)
+{
+    ASSERT_FALSE(objectUnderTest.nextFrame());
+}
+
+TEST_F(FrameBufferTestSuite, shallHandOutAllCompleteFrames)
+{
+    const Bytes first{1, 2, 3}, second{}, third{4};
+    Bytes data = frame(first);
+    for (auto& next: {frame(second), frame(third)})
+    {
+        data.insert(data.end(), next.begin(), next.end());
+    }
+    receive(data);
+
+    ASSERT_THAT(takeFrames(), ElementsAre(first, second, third));
+    ASSERT_EQ(0u, objectUnderTest.bufferedLength());
+}
+
+TEST_F(FrameBufferTestSuite, shallWaitForRestOfPartialFrame)
+{
+    const Bytes message{1, 2, 3, 4, 5};
+    const Bytes data = frame(message);
+
+    receive(Bytes(data.begin(), data.begin() + 1));
+    ASSERT_THAT(takeFrames(), IsEmpty());
+    receive(Bytes(data.begin() + 1, data.begin() + 4));
+    ASSERT_THAT(takeFrames(), IsEmpty());
+    ASSERT_EQ(4u, objectUnderTest.bufferedLength());
+
+    receive(Bytes(data.begin() + 4, data.end()));
+    ASSERT_THAT(takeFrames(), ElementsAre(message));
+}
+
+TEST_F(FrameBufferTestSuite, shallMovePartialFrameToBeginningWhenBufferIsFull)
+{
+    const Bytes big(BinaryMessage::MAX_SIZE - 10u, 0xAB);
+    const Bytes message{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    Bytes data = frame(big);
+    const Bytes second = frame(message);
+    data.insert(data.end(), second.begin(), second.begin() + 10);
+    receive(data);
+    ASSERT_THAT(takeFrames(), ElementsAre(big));
+    ASSERT_EQ(objectUnderTest.capacity() - 10u, objectUnderTest.writableSpace().size());
+
+    receive(Bytes(second.begin() + 10, second.end()));
+    ASSERT_THAT(takeFrames(), ElementsAre(message));
+}
+
+TEST_F(FrameBufferTestSuite, shallThrowOnFrameLongerThanMaxSize)
+{
+    constexpr std::size_t wrongSize = BinaryMessage::MAX_SIZE + 1u;
+    receive({ static_cast<std::uint8_t>(wrongSize >> 8), static_cast<std::uint8_t>(wrongSize) });
+    ASSERT_THROW(objectUnderTest.nextFrame(), std::length_error);
+}
+
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "Messages/Frame.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class FrameTestSuite : public Test
+{
+protected:
+    const BinaryMessage MESSAGE{{0x11, 0x22, 0x33, 0x44}};
+};
+
+TEST_F(FrameTestSuite, shallBeEmptyByDefault)
+{
+    Frame objectUnderTest;
+    ASSERT_TRUE(objectUnderTest.empty());
+    ASSERT_EQ(0u, objectUnderTest.size());
+    ASSERT_EQ(objectUnderTest.begin(), objectUnderTest.end());
+}
+
+TEST_F(FrameTestSuite, shallTakeOverMessageWithoutCopy)
+{
+    const BinaryMessage bigMessage{BinaryMessage::Value(BinaryMessage::INLINE_SIZE + 1u, 0xAB)};
+    BinaryMessage message = bigMessage;
+    auto payload = message.value.data();
+    Frame objectUnderTest(std::move(message));
+    ASSERT_EQ(payload, objectUnderTest.data());
+    ASSERT_THAT(objectUnderTest, ElementsAreArray(bigMessage.value));
+}
+
+TEST_F(FrameTestSuite, shallShareCopiedPayload)
+{
+    Frame objectUnderTest = Frame::copyOf(Frame::View(MESSAGE.value.data(), MESSAGE.value.size()));
+    Frame copy = objectUnderTest;
+    ASSERT_NE(MESSAGE.value.data(), objectUnderTest.data());
+    ASSERT_EQ(objectUnderTest.data(), copy.data());
+    ASSERT_THAT(copy, ElementsAreArray(MESSAGE.value));
+}
+
+TEST_F(FrameTestSuite, shallSliceWithoutCopy)
+{
+    Frame objectUnderTest(MESSAGE);
+    Frame slice = objectUnderTest.slice(1u, 2u);
+    ASSERT_EQ(objectUnderTest.data() + 1, slice.data());
+    ASSERT_THAT(slice, ElementsAre(0x22, 0x33));
+    ASSERT_THROW(objectUnderTest.slice(3u, 2u), std::out_of_range);
+}
+
+TEST_F(FrameTestSuite, shallCompareContent)
+{
+    ASSERT_EQ(Frame(MESSAGE), Frame::copyOf(Frame::View(MESSAGE.value.data(), MESSAGE.value.size())));
+    ASSERT_NE(Frame(MESSAGE), Frame(MESSAGE).slice(0u, 3u));
+}
+
+TEST_F(FrameTestSuite, shallConvertToMessage)
+{
+    ASSERT_EQ(MESSAGE.value, Frame(MESSAGE).toMessage().value);
+}
+
+TEST_F(FrameTestSuite, shallPrintAsHex)
+{
+    std::ostringstream os;
+    os << Frame(MESSAGE);
+    ASSERT_EQ("11223344", os.str());
+}
+
+}
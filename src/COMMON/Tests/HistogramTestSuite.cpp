@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "Statistics/Histogram.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class HistogramTestSuite : public Test
+{
+protected:
+    Histogram objectUnderTest;
+};
+
+TEST_F(HistogramTestSuite, shallKeepSmallValuesExactly)
+{
+    for (Histogram::Value value = 0u; value < Histogram::SUB_BUCKETS; ++value)
+    {
+        ASSERT_EQ(value, Histogram::lowestOf(Histogram::bucketOf(value)));
+        ASSERT_EQ(value, Histogram::highestOf(Histogram::bucketOf(value)));
+    }
+}
+
+TEST_F(HistogramTestSuite, shallKeepAnyValueWithinItsBucket)
+{
+    const std::vector<Histogram::Value> values{16u, 17u, 31u, 32u, 33u, 1000u, 123456789u, Histogram::Value{1u} << 40,
+                                               std::numeric_limits<Histogram::Value>::max()};
+    for (auto value: values)
+    {
+        auto bucket = Histogram::bucketOf(value);
+        ASSERT_LT(bucket, Histogram::NUMBER_OF_BUCKETS);
+        ASSERT_LE(Histogram::lowestOf(bucket), value);
+        ASSERT_GE(Histogram::highestOf(bucket), value);
+        // relative error below 1/SUB_BUCKETS
+        ASSERT_LT(Histogram::highestOf(bucket) - Histogram::lowestOf(bucket),
+                  Histogram::lowestOf(bucket) / Histogram::SUB_BUCKETS);
+    }
+}
+
+TEST_F(HistogramTestSuite, shallReturnZeroPercentilesWhenEmpty)
+{
+    ASSERT_EQ(0u, objectUnderTest.getCount());
+    ASSERT_EQ(0u, objectUnderTest.getPercentile(50.0));
+}
+
+TEST_F(HistogramTestSuite, shallReturnPercentiles)
+{
+    for (Histogram::Value value = 1u; value <= 1000u; ++value)
+    {
+        objectUnderTest.record(value);
+    }
+
+    ASSERT_EQ(1000u, objectUnderTest.getCount());
+    ASSERT_EQ(1000u, objectUnderTest.getMax());
+    ASSERT_EQ(1u, objectUnderTest.getPercentile(0.0));
+    ASSERT_NEAR(500.0, objectUnderTest.getPercentile(50.0), 500.0 / Histogram::SUB_BUCKETS);
+    ASSERT_NEAR(990.0, objectUnderTest.getPercentile(99.0), 990.0 / Histogram::SUB_BUCKETS);
+    ASSERT_EQ(1000u, objectUnderTest.getPercentile(100.0));
+}
+
+TEST_F(HistogramTestSuite, shallMergeAndReset)
+{
+    Histogram other;
+    other.record(7u);
+    other.record(5000u);
+    objectUnderTest.record(3u);
+
+    objectUnderTest.merge(other);
+    ASSERT_EQ(3u, objectUnderTest.getCount());
+    ASSERT_EQ(5000u, objectUnderTest.getMax());
+    ASSERT_EQ(7u, objectUnderTest.getPercentile(50.0));
+
+    objectUnderTest.reset();
+    ASSERT_EQ(0u, objectUnderTest.getCount());
+    ASSERT_EQ(0u, objectUnderTest.getMax());
+}
+
+TEST_F(HistogramTestSuite, shallPrintPercentiles)
+{
+    objectUnderTest.record(10u);
+    std::ostringstream printout;
+    printout << objectUnderTest;
+    ASSERT_EQ("count: 1, p50: 10, p90: 10, p99: 10, p99.9: 10, max: 10", printout.str());
+}
+
+}
@@ -7,6 +7,7 @@
 #include <iterator>
 
 #include "Messages/IncomingMessage.hpp"
+#include "Messages/MessageSchema.hpp"
 
 using namespace ::testing;
 
@@ -16,7 +17,7 @@ namespace common
 class IncomingMessageTestSuite : public Test
 {
 protected:
-    const MessageHeader messageHeader{MessageId::CallDropped, PhoneNumber{0x12}, PhoneNumber{0x34}};
+    const MessageHeader messageHeader{MessageId::CallDropped, PhoneNumber{0x12}, PhoneNumber{0x12345678}};
     const std::string text = "Something stupid";
     const std::uint8_t oneByte = 0x78;
     const std::uint32_t number = 0x11223344;
@@ -51,18 +52,26 @@ TEST_F(IncomingMessageTestSuite, shallAcceptEmptyInputButHeaderWontBePresent)
 
 TEST_F(IncomingMessageTestSuite, shallAcceptLessThanHeaderButHeaderWontBePresent)
 {
-    Input lessThanHeader{Input::Value(sizeof(MessageHeader) - 1)};
+    Input lessThanHeader{Input::Value(schema::HEADER_SIZE - 1)};
     makeObjectUnderTest(lessThanHeader);
     ASSERT_THROW(assertHeader(), IncomingMessage::ReadEx);
 }
 
 IncomingMessageTestSuite::Input IncomingMessageTestSuite::createInputForHeader(const MessageHeader& messageHeader)
 {
-    static_assert(sizeof(PhoneNumber::value) == 1,
+    static_assert(sizeof(PhoneNumber::value) == 4,
                   "You need to redefine this test");
     static_assert(sizeof(MessageId) == 1,
                   "You need to redefine this test");
-    return { { get(messageHeader.messageId), messageHeader.from.value, messageHeader.to.value } };
+    Input input{ { static_cast<std::uint8_t>(get(messageHeader.messageId) | schema::WIDE_HEADER_FLAG) } };
+    for (auto phoneNumber : { messageHeader.from.value, messageHeader.to.value })
+    {
+        for (int shift = 24; shift >= 0; shift -= 8)
+        {
+            input.value.push_back(static_cast<std::uint8_t>(phoneNumber >> shift));
+        }
+    }
+    return input;
 }
 
 
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Statistics/LatencyHistograms.hpp"
+#include "Statistics/ForwardingLatency.hpp"
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+namespace common
+{
+
+class LatencyHistogramsTestSuite : public Test
+{
+protected:
+    enum Stage { First, Second };
+
+    LatencyHistograms objectUnderTest{{"first", "second"}};
+
+    std::uint64_t countOf(std::size_t stage, MessageId messageId)
+    {
+        Histogram merged;
+        objectUnderTest.collect(stage, messageId, merged);
+        return merged.getCount();
+    }
+};
+
+TEST_F(LatencyHistogramsTestSuite, shallKeepStagesAndMessagesApart)
+{
+    objectUnderTest.record(First, MessageId::Sms, 10us);
+    objectUnderTest.record(First, MessageId::Sms, 20us);
+    objectUnderTest.record(Second, MessageId::CallTalk, 30us);
+
+    ASSERT_EQ(2u, countOf(First, MessageId::Sms));
+    ASSERT_EQ(0u, countOf(First, MessageId::CallTalk));
+    ASSERT_EQ(1u, countOf(Second, MessageId::CallTalk));
+}
+
+TEST_F(LatencyHistogramsTestSuite, shallMergeRecordsOfAllThreads)
+{
+    constexpr std::size_t NUMBER_OF_THREADS = 4u;
+    constexpr std::size_t RECORDS = 1000u;
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0u; t < NUMBER_OF_THREADS; ++t)
+    {
+        threads.emplace_back([this]
+        {
+            for (std::size_t i = 0u; i < RECORDS; ++i)
+            {
+                objectUnderTest.record(First, MessageId::Sms, std::chrono::nanoseconds(i));
+            }
+        });
+    }
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    Histogram merged;
+    objectUnderTest.collect(First, MessageId::Sms, merged);
+    ASSERT_EQ(NUMBER_OF_THREADS * RECORDS, merged.getCount());
+    ASSERT_EQ(RECORDS - 1u, merged.getMax());
+}
+
+TEST_F(LatencyHistogramsTestSuite, shallResetAllThreadsRecords)
+{
+    objectUnderTest.record(First, MessageId::Sms, 10us);
+    std::thread([this] { objectUnderTest.record(First, MessageId::Sms, 10us); }).join();
+
+    objectUnderTest.reset();
+    ASSERT_EQ(0u, countOf(First, MessageId::Sms));
+}
+
+TEST_F(LatencyHistogramsTestSuite, shallPrintOnlyRecordedInMicroseconds)
+{
+    objectUnderTest.record(Second, MessageId::Sms, 1500ns);
+
+    std::ostringstream printout;
+    printout << objectUnderTest;
+    ASSERT_THAT(printout.str(), HasSubstr("second"));
+    ASSERT_THAT(printout.str(), HasSubstr("Sms"));
+    ASSERT_THAT(printout.str(), HasSubstr("1.5"));
+    ASSERT_THAT(printout.str(), Not(HasSubstr("first")));
+}
+
+class ForwardingLatencyTestSuite : public Test
+{
+protected:
+    ForwardingLatencyTestSuite()
+    {
+        ForwardingLatency::getHistograms().reset();
+    }
+
+    std::uint64_t countOf(ForwardingLatency::Stage stage, MessageId messageId)
+    {
+        Histogram merged;
+        ForwardingLatency::getHistograms().collect(stage, messageId, merged);
+        return merged.getCount();
+    }
+};
+
+TEST_F(ForwardingLatencyTestSuite, shallRecordStagesOfReceivedFrame)
+{
+    {
+        ForwardingLatency::ReceivedFrame received;
+        ForwardingLatency::markLocked();
+        ForwardingLatency::setMessageId(MessageId::Sms);
+        {
+            ForwardingLatency::StageScope relay(ForwardingLatency::Relay);
+            ASSERT_TRUE(ForwardingLatency::getTrace().has_value());
+            ForwardingLatency::recordWritten();
+        }
+    }
+
+    ASSERT_EQ(1u, countOf(ForwardingLatency::LockWait, MessageId::Sms));
+    ASSERT_EQ(1u, countOf(ForwardingLatency::Relay, MessageId::Sms));
+    ASSERT_EQ(1u, countOf(ForwardingLatency::Total, MessageId::Sms));
+}
+
+TEST_F(ForwardingLatencyTestSuite, shallNotRecordOutsideOfReceivedFrame)
+{
+    ForwardingLatency::setMessageId(MessageId::Sib);
+    {
+        ForwardingLatency::StageScope relay(ForwardingLatency::Relay);
+        ForwardingLatency::recordWritten();
+    }
+
+    ASSERT_FALSE(ForwardingLatency::getTrace().has_value());
+    ASSERT_EQ(0u, countOf(ForwardingLatency::Total, MessageId::Sib));
+    ASSERT_EQ(0u, countOf(ForwardingLatency::LockWait, MessageId::Sib));
+}
+
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+
+#include "Logger/LogRecord.hpp"
+#include "Messages.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+
+class LogRecordTestSuite : public Test
+{
+protected:
+    const PhoneNumber PHONE{123};
+    const MessageHeader HEADER{MessageId::Sms, PhoneNumber{1}, PhoneNumber{2}};
+    const BinaryMessage MESSAGE{{0x01, 0xAB}};
+    const std::string TEXT = "text";
+    const std::uint8_t CHARACTER = 'c';
+    const double NUMBER = 1.25;
+
+    LogRecord objectUnderTest;
+
+    template <typename ...Value>
+    static std::string print(const Value& ...value)
+    {
+        std::ostringstream os;
+        ((os << value), ...);
+        return os.str();
+    }
+};
+
+TEST_F(LogRecordTestSuite, shallBePrintedAsValues)
+{
+    objectUnderTest.add("phone: ");
+    objectUnderTest.add(PHONE);
+    objectUnderTest.add(", header: ");
+    objectUnderTest.add(HEADER);
+    objectUnderTest.add(HEADER.messageId);
+    objectUnderTest.add(MESSAGE);
+    objectUnderTest.add(Frame(MESSAGE));
+    objectUnderTest.add(TEXT);
+    objectUnderTest.add(CHARACTER);
+    objectUnderTest.add(-12);
+    objectUnderTest.add(34u);
+    objectUnderTest.add(NUMBER);
+    objectUnderTest.add(true);
+
+    ASSERT_EQ(print("phone: ", PHONE, ", header: ", HEADER, HEADER.messageId, MESSAGE, Frame(MESSAGE),
+                    TEXT, CHARACTER, -12, 34u, NUMBER, true),
+              objectUnderTest.toText());
+}
+
+TEST_F(LogRecordTestSuite, shallKeepLiteralsInFormat)
+{
+    objectUnderTest.add("phone: ");
+    objectUnderTest.add(PHONE);
+    objectUnderTest.add("!");
+    ASSERT_EQ(std::string("phone: ") + LogRecord::PLACEHOLDER + "!", objectUnderTest.getFormat());
+}
+
+TEST_F(LogRecordTestSuite, shallPutOuterPrefixFirst)
+{
+    objectUnderTest.add(TEXT);
+    objectUnderTest.addPrefix("[inner]");
+    objectUnderTest.addPrefix("[outer]");
+    ASSERT_EQ("[outer][inner]" + TEXT, objectUnderTest.toText());
+}
+
+TEST_F(LogRecordTestSuite, shallReferToPhoneNumberAndMessageIdOfHeader)
+{
+    objectUnderTest.add(HEADER);
+    auto arguments = objectUnderTest.getArguments();
+    ASSERT_TRUE(LogRecord::refersTo(arguments, std::nullopt, std::nullopt));
+    ASSERT_TRUE(LogRecord::refersTo(arguments, HEADER.from, std::nullopt));
+    ASSERT_TRUE(LogRecord::refersTo(arguments, HEADER.to, MessageId::Sms));
+    ASSERT_FALSE(LogRecord::refersTo(arguments, PHONE, std::nullopt));
+    ASSERT_FALSE(LogRecord::refersTo(arguments, HEADER.from, MessageId::Sib));
+}
+
+}
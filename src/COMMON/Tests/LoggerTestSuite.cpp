@@ -92,4 +92,16 @@ TEST_P(LoggerTestSuite, shallPrintMultipleLinesForMultipleLogsToStreams)
     ASSERT_EQ(2, std::count(str.begin(), str.end(), '\n'));
 }
 
+TEST_P(LoggerTestSuite, shallNotPrintBelowMinimumLevel)
+{
+    objectUnderTest.setMinimumLevel(GetParam() + 1);
+    ASSERT_FALSE(objectUnderTest.isEnabled(GetParam()));
+    printLog(message1);
+    ASSERT_THAT(getLog1(), IsEmpty());
+
+    objectUnderTest.setMinimumLevel(GetParam());
+    printLog(message2);
+    ASSERT_THAT(getLog1(), HasSubstr(message2));
+}
+
 } // namespace common
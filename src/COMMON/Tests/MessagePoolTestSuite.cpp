@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <thread>
+#include <vector>
+
+#include "Messages/MessagePool.hpp"
+#include "Messages/BinaryMessage.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class MessagePoolTestSuite : public Test
+{
+protected:
+    static constexpr std::size_t SIZE = 100u;
+    static constexpr std::size_t SIZE_CLASS = 1u; // 256 bytes
+};
+
+TEST_F(MessagePoolTestSuite, shallReuseBlockReleasedInSameThread)
+{
+    void* first = MessagePool::allocate(SIZE);
+    MessagePool::deallocate(first, SIZE);
+    void* second = MessagePool::allocate(SIZE);
+    ASSERT_EQ(first, second);
+    MessagePool::deallocate(second, SIZE);
+}
+
+TEST_F(MessagePoolTestSuite, shallAllocateAlignedBlocks)
+{
+    for (auto size: {1u, 64u, 65u, 1000u, 8192u, 10000u})
+    {
+        void* memory = MessagePool::allocate(size);
+        ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(memory) % alignof(std::max_align_t));
+        MessagePool::deallocate(memory, size);
+    }
+}
+
+TEST_F(MessagePoolTestSuite, shallReturnBlockReleasedInOtherThreadToItsOwner)
+{
+    // blocks released remotely are taken when there is nothing cached locally
+    std::vector<void*> cached;
+    while (MessagePool::cachedInThisThread(SIZE_CLASS) > 0u)
+    {
+        cached.push_back(MessagePool::allocate(SIZE));
+    }
+    void* memory = MessagePool::allocate(SIZE);
+    std::thread([memory] { MessagePool::deallocate(memory, SIZE); }).join();
+
+    void* next = MessagePool::allocate(SIZE);
+    ASSERT_EQ(memory, next);
+    MessagePool::deallocate(next, SIZE);
+    for (auto block: cached)
+    {
+        MessagePool::deallocate(block, SIZE);
+    }
+}
+
+TEST_F(MessagePoolTestSuite, shallSurviveBlocksOutlivingTheirThread)
+{
+    std::vector<void*> blocks(100u);
+    std::thread([&blocks] {
+        for (auto& block: blocks)
+        {
+            block = MessagePool::allocate(SIZE);
+        }
+    }).join();
+    for (auto block: blocks)
+    {
+        MessagePool::deallocate(block, SIZE);
+    }
+    std::thread([] {
+        // takes over cache of the finished thread
+        MessagePool::deallocate(MessagePool::allocate(SIZE), SIZE);
+    }).join();
+}
+
+TEST_F(MessagePoolTestSuite, shallLimitBlocksCachedByThread)
+{
+    std::vector<void*> blocks(MessagePool::MAX_CACHED_PER_CLASS + 10u);
+    for (auto& block: blocks)
+    {
+        block = MessagePool::allocate(SIZE);
+    }
+    for (auto block: blocks)
+    {
+        MessagePool::deallocate(block, SIZE);
+    }
+    ASSERT_EQ(MessagePool::MAX_CACHED_PER_CLASS, MessagePool::cachedInThisThread(SIZE_CLASS));
+}
+
+TEST_F(MessagePoolTestSuite, shallKeepSmallMessageInline)
+{
+    BinaryMessage message{{1, 2, 3}};
+    for (std::size_t i = message.value.size(); i < BinaryMessage::INLINE_SIZE; ++i)
+    {
+        message.value.push_back(static_cast<std::uint8_t>(i));
+    }
+    ASSERT_EQ(BinaryMessage::INLINE_SIZE, message.value.capacity());
+
+    message.value.push_back(0xFF);
+    ASSERT_LT(BinaryMessage::INLINE_SIZE, message.value.capacity());
+    ASSERT_EQ(0xFF, message.value.back());
+    ASSERT_EQ(3, message.value[2]);
+}
+
+TEST_F(MessagePoolTestSuite, shallCopyAndMoveMessages)
+{
+    const BinaryMessage small{{1, 2, 3}};
+    const BinaryMessage big{BinaryMessage::Value(1000u, 0xAB)};
+    for (auto& original: {small, big})
+    {
+        BinaryMessage copy = original;
+        ASSERT_EQ(original.value, copy.value);
+        BinaryMessage moved = std::move(copy);
+        ASSERT_EQ(original.value, moved.value);
+        ASSERT_TRUE(copy.value.empty());
+        copy = moved;
+        ASSERT_EQ(original.value, copy.value);
+    }
+}
+
+}
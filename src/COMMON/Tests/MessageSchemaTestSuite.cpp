@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+
+#include "Messages/MessageSchema.hpp"
+#include "Messages/OutgoingMessage.hpp"
+#include "Messages/CellLoad.hpp"
+
+using namespace ::testing;
+
+namespace common::schema
+{
+
+class MessageSchemaTestSuite : public Test
+{
+protected:
+    const PhoneNumber FROM{123};
+    const PhoneNumber TO{45};
+    const BtsId BTS_ID{0x01020304u};
+
+    static Frame::View viewOf(const BinaryMessage& message)
+    {
+        return Frame::View(message.value.data(), message.value.size());
+    }
+};
+
+TEST_F(MessageSchemaTestSuite, shallHaveSizesOfSpecification)
+{
+    static_assert(HEADER_SIZE == 9u);
+    static_assert(MessageSchema<MessageId::Sib>::FIXED_SIZE == 13u);
+    static_assert(MessageSchema<MessageId::AttachResponse>::FIXED_SIZE == 10u);
+    static_assert(MessageSchema<MessageId::UnknownSender>::FIXED_SIZE == 18u);
+    static_assert(MessageSchema<MessageId::CallDropped>::FIXED_SIZE == 9u);
+}
+
+TEST_F(MessageSchemaTestSuite, shallEncodeWideHeader)
+{
+    auto message = encode<MessageId::CallDropped>(PhoneNumber{0x01020304u}, PhoneNumber{70000u});
+    ASSERT_THAT(message.value, ElementsAre(get(MessageId::CallDropped) | WIDE_HEADER_FLAG,
+                                           0x01, 0x02, 0x03, 0x04,
+                                           0x00, 0x01, 0x11, 0x70));
+}
+
+TEST_F(MessageSchemaTestSuite, shallNotDecodeNarrowHeader)
+{
+    const BinaryMessage narrow{{get(MessageId::CallDropped), 1, 2, 0, 0, 0, 0, 0, 0}};
+    ASSERT_THROW(decodeHeader(viewOf(narrow)), IncomingMessage::ReadEx);
+}
+
+TEST_F(MessageSchemaTestSuite, shallEncodeAsOutgoingMessage)
+{
+    OutgoingMessage expected{MessageId::Sib, FROM, TO};
+    expected.writeBtsId(BTS_ID);
+    ASSERT_EQ(expected.getMessage().value, (encode<MessageId::Sib>(FROM, TO, {BTS_ID}).value));
+}
+
+TEST_F(MessageSchemaTestSuite, shallEncodeHeaderField)
+{
+    const MessageHeader rejected{MessageId::Sms, TO, FROM};
+    OutgoingMessage expected{MessageId::UnknownRecipient, FROM, TO};
+    expected.writeMessageHeader(rejected);
+    ASSERT_EQ(expected.getMessage().value, (encode<MessageId::UnknownRecipient>(FROM, TO, {rejected}).value));
+}
+
+TEST_F(MessageSchemaTestSuite, shallDecodeOutgoingMessage)
+{
+    OutgoingMessage message{MessageId::AttachResponse, FROM, TO};
+    message.writeNumber(true);
+    auto binaryMessage = message.getMessage();
+
+    auto decoded = decode<MessageId::AttachResponse>(viewOf(binaryMessage));
+    ASSERT_EQ(MessageId::AttachResponse, decoded.header.messageId);
+    ASSERT_EQ(FROM, decoded.header.from);
+    ASSERT_EQ(TO, decoded.header.to);
+    ASSERT_TRUE(decoded.get<0>());
+    ASSERT_TRUE(decoded.trailing.empty());
+}
+
+TEST_F(MessageSchemaTestSuite, shallKeepTrailingBytesInPlace)
+{
+    const BinaryMessage::Value encryptedText{0x00, 'H', 'i'};
+    auto message = encode<MessageId::Sms>(FROM, TO, {}, Frame::View(encryptedText.data(), encryptedText.size()));
+    ASSERT_EQ(HEADER_SIZE + encryptedText.size(), message.value.size());
+
+    auto decoded = decode<MessageId::Sms>(viewOf(message));
+    ASSERT_EQ(message.value.data() + HEADER_SIZE, decoded.trailing.data());
+    ASSERT_TRUE(std::equal(decoded.trailing.begin(), decoded.trailing.end(),
+                           encryptedText.begin(), encryptedText.end()));
+}
+
+TEST_F(MessageSchemaTestSuite, shallCarryOptionalCellLoadInSib)
+{
+    const std::uint8_t load[] = {42u};
+    auto sibWithLoad = encode<MessageId::Sib>(FROM, TO, {BTS_ID}, load);
+    auto decoded = decode<MessageId::Sib>(viewOf(sibWithLoad));
+    ASSERT_EQ(BTS_ID, decoded.get<0>());
+    ASSERT_EQ(CellLoad{42u}, CellLoad::decode(decoded.trailing));
+
+    auto sib = encode<MessageId::Sib>(FROM, TO, {BTS_ID});
+    ASSERT_EQ(std::nullopt, CellLoad::decode(decode<MessageId::Sib>(viewOf(sib)).trailing));
+}
+
+TEST_F(MessageSchemaTestSuite, shallComputeCellLoadOfMoreLoadedResource)
+{
+    ASSERT_EQ(CellLoad{0u}, CellLoad::of(10u, 0u, 500.0, 0.0));
+    ASSERT_EQ(CellLoad{25u}, CellLoad::of(10u, 40u, 100.0, 1000.0));
+    ASSERT_EQ(CellLoad{50u}, CellLoad::of(10u, 40u, 500.0, 1000.0));
+    ASSERT_TRUE(CellLoad::of(50u, 40u, 0.0, 0.0).isFull());
+    ASSERT_EQ(CellLoad::FULL, CellLoad::of(50u, 40u, 0.0, 0.0).percent);
+}
+
+TEST_F(MessageSchemaTestSuite, shallNotDecodeMessageOfWrongSize)
+{
+    auto message = encode<MessageId::AttachRequest>(FROM, TO, {BTS_ID});
+    ASSERT_THROW(decode<MessageId::AttachRequest>(viewOf(message).first(6u)), IncomingMessage::ReadEx);
+    message.value.push_back(0u);
+    ASSERT_THROW(decode<MessageId::AttachRequest>(viewOf(message)), IncomingMessage::ReadEx);
+    ASSERT_THROW(decode<MessageId::CallTalk>(viewOf(message).first(2u)), IncomingMessage::ReadEx);
+}
+
+TEST_F(MessageSchemaTestSuite, shallNotDecodeOtherMessage)
+{
+    auto message = encode<MessageId::AttachRequest>(FROM, TO, {BTS_ID});
+    ASSERT_THROW(decode<MessageId::Sib>(viewOf(message)), IncomingMessage::ReadEx);
+}
+
+TEST_F(MessageSchemaTestSuite, shallDecodeHeader)
+{
+    auto message = encode<MessageId::CallDropped>(FROM, TO);
+    auto header = decodeHeader(viewOf(message));
+    ASSERT_EQ(MessageId::CallDropped, header.messageId);
+    ASSERT_EQ(FROM, header.from);
+    ASSERT_EQ(TO, header.to);
+
+    ASSERT_THROW(decodeHeader(viewOf(message).first(2u)), IncomingMessage::ReadEx);
+    const BinaryMessage unknownId{{0xFF, 0x01, 0x02}};
+    ASSERT_THROW(decodeHeader(viewOf(unknownId)), IncomingMessage::ReadEx);
+}
+
+}
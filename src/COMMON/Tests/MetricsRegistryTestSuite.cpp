@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "Metrics/MetricsRegistry.hpp"
+#include "Metrics/MetricsExporter.hpp"
+#include "Mocks/ILoggerMock.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class MetricsRegistryTestSuite : public Test
+{
+protected:
+    const MetricDefinition MESSAGES{"messages_total", "Messages", MetricType::Counter, "ue"};
+    const MetricDefinition ERRORS{"errors_total", "Errors", MetricType::Counter};
+    const MetricDefinition CONNECTIONS{"connections", "Connections", MetricType::Gauge};
+
+    MetricsRegistry objectUnderTest;
+
+    std::string write(MetricsRegistry::Format format = MetricsRegistry::Format::Prometheus)
+    {
+        std::ostringstream os;
+        objectUnderTest.write(os, format);
+        return os.str();
+    }
+};
+
+TEST_F(MetricsRegistryTestSuite, shallTakeWholeCacheLinePerMetric)
+{
+    ASSERT_EQ(CACHE_LINE_SIZE, alignof(Counter));
+    ASSERT_EQ(CACHE_LINE_SIZE, sizeof(Counter));
+    ASSERT_EQ(CACHE_LINE_SIZE, alignof(Gauge));
+}
+
+TEST_F(MetricsRegistryTestSuite, shallWriteLabelledCounterPerInstance)
+{
+    auto first = objectUnderTest.addCounter(MESSAGES, "a");
+    auto second = objectUnderTest.addCounter(MESSAGES, "b");
+    first->increment(5u);
+    second->increment();
+
+    ASSERT_EQ("# HELP messages_total Messages\n"
+              "# TYPE messages_total counter\n"
+              "messages_total{ue=\"a\"} 5\n"
+              "messages_total{ue=\"b\"} 1\n",
+              write());
+}
+
+TEST_F(MetricsRegistryTestSuite, shallSumUpCountersWithoutLabel)
+{
+    auto first = objectUnderTest.addCounter(ERRORS);
+    auto second = objectUnderTest.addCounter(ERRORS);
+    first->increment(2u);
+    second->increment(3u);
+
+    ASSERT_THAT(write(), HasSubstr("errors_total 5\n"));
+}
+
+TEST_F(MetricsRegistryTestSuite, shallKeepValueOfRemovedCounters)
+{
+    auto kept = objectUnderTest.addCounter(MESSAGES, "kept");
+    auto removed = objectUnderTest.addCounter(MESSAGES, "removed");
+    auto error = objectUnderTest.addCounter(ERRORS);
+    kept->increment();
+    removed->increment(7u);
+    error->increment(2u);
+    removed.reset();
+    error.reset();
+
+    auto text = write();
+    ASSERT_THAT(text, HasSubstr("messages_total{ue=\"kept\"} 1\n"));
+    ASSERT_THAT(text, HasSubstr("messages_total{ue=\"closed\"} 7\n"));
+    ASSERT_THAT(text, Not(HasSubstr("\"removed\"")));
+    ASSERT_THAT(text, HasSubstr("errors_total 2\n"));
+}
+
+TEST_F(MetricsRegistryTestSuite, shallSumUpGaugesOfExistingInstancesOnly)
+{
+    auto first = objectUnderTest.addGauge(CONNECTIONS);
+    auto second = objectUnderTest.addGauge(CONNECTIONS);
+    first->set(1);
+    second->set(4);
+    second->add(-1);
+    ASSERT_THAT(write(), HasSubstr("# TYPE connections gauge\nconnections 4\n"));
+
+    second.reset();
+    ASSERT_THAT(write(), HasSubstr("connections 1\n"));
+}
+
+TEST_F(MetricsRegistryTestSuite, shallRejectMetricNotMatchingItsDefinition)
+{
+    ASSERT_THROW(objectUnderTest.addGauge(ERRORS), std::invalid_argument);
+
+    auto error = objectUnderTest.addCounter(ERRORS);
+    const MetricDefinition LABELLED_ERRORS{"errors_total", "Errors", MetricType::Counter, "ue"};
+    ASSERT_THROW(objectUnderTest.addCounter(LABELLED_ERRORS, "a"), std::invalid_argument);
+}
+
+TEST_F(MetricsRegistryTestSuite, shallEscapeLabelValue)
+{
+    auto counter = objectUnderTest.addCounter(MESSAGES, "a\"b\\c");
+
+    ASSERT_THAT(write(), HasSubstr("messages_total{ue=\"a\\\"b\\\\c\"} 0\n"));
+}
+
+TEST_F(MetricsRegistryTestSuite, shallWriteJson)
+{
+    auto message = objectUnderTest.addCounter(MESSAGES, "a");
+    auto error = objectUnderTest.addCounter(ERRORS);
+    auto connection = objectUnderTest.addGauge(CONNECTIONS);
+    message->increment(3u);
+    connection->set(1);
+
+    ASSERT_EQ("{\"connections\":{\"type\":\"gauge\",\"value\":1},"
+              "\"errors_total\":{\"type\":\"counter\",\"value\":0},"
+              "\"messages_total\":{\"type\":\"counter\",\"label\":\"ue\",\"values\":{\"a\":3}}}\n",
+              write(MetricsRegistry::Format::Json));
+}
+
+TEST_F(MetricsRegistryTestSuite, shallCountFromManyThreads)
+{
+    constexpr std::size_t NUMBER_OF_THREADS = 4u;
+    constexpr std::size_t INCREMENTS = 10000u;
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < NUMBER_OF_THREADS; ++i)
+    {
+        threads.emplace_back([this, i]
+        {
+            auto counter = objectUnderTest.addCounter(MESSAGES, std::to_string(i));
+            for (std::size_t j = 0; j < INCREMENTS; ++j)
+            {
+                counter->increment();
+            }
+        });
+    }
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_THAT(write(), HasSubstr("messages_total{ue=\"closed\"} " + std::to_string(NUMBER_OF_THREADS * INCREMENTS)));
+}
+
+TEST(MetricsRegistryLifetimeTestSuite, shallAllowMetricToOutliveRegistry)
+{
+    const MetricDefinition ERRORS{"errors_total", "Errors", MetricType::Counter};
+    auto registry = std::make_unique<MetricsRegistry>();
+    auto counter = registry->addCounter(ERRORS);
+    registry.reset();
+
+    counter->increment();
+    counter.reset();
+}
+
+class MetricsExporterTestSuite : public MetricsRegistryTestSuite
+{
+protected:
+    const std::chrono::milliseconds PERIOD{10};
+    const std::chrono::seconds TIMEOUT{2};
+    const std::string PATH = "/tmp/MetricsExporterTestSuite." + std::to_string(::getpid());
+
+    NiceMock<ILoggerMock> loggerMock;
+    MetricsRegistry::CounterPtr errors = objectUnderTest.addCounter(ERRORS);
+
+    MetricsExporterTestSuite()
+    {
+        errors->increment(4u);
+    }
+    ~MetricsExporterTestSuite()
+    {
+        std::remove(PATH.c_str());
+    }
+
+    std::unique_ptr<MetricsExporter> createExporter(MetricsExporter::Target target)
+    {
+        return std::make_unique<MetricsExporter>(objectUnderTest, MetricsRegistry::Format::Prometheus,
+                                                 target, PATH, PERIOD, loggerMock);
+    }
+};
+
+TEST_F(MetricsExporterTestSuite, shallNotAcceptZeroPeriod)
+{
+    ASSERT_THROW(MetricsExporter(objectUnderTest, MetricsRegistry::Format::Json, MetricsExporter::Target::File,
+                                 PATH, std::chrono::milliseconds(0), loggerMock),
+                 std::invalid_argument);
+}
+
+TEST_F(MetricsExporterTestSuite, shallExportToFilePeriodically)
+{
+    auto exporter = createExporter(MetricsExporter::Target::File);
+    errors->increment();
+
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    std::string text;
+    while (text.find("errors_total 5\n") == std::string::npos and std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(PERIOD);
+        std::ifstream file(PATH);
+        text.assign(std::istreambuf_iterator<char>(file), {});
+    }
+    ASSERT_THAT(text, HasSubstr("errors_total 5\n"));
+}
+
+TEST_F(MetricsExporterTestSuite, shallServeSnapshotOnUnixSocket)
+{
+    auto exporter = createExporter(MetricsExporter::Target::UnixSocket);
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, PATH.c_str());
+    int clientFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_EQ(0, ::connect(clientFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
+    std::string text;
+    char buffer[256];
+    ssize_t length;
+    while ((length = ::read(clientFd, buffer, sizeof(buffer))) > 0)
+    {
+        text.append(buffer, static_cast<std::size_t>(length));
+    }
+    ::close(clientFd);
+
+    ASSERT_THAT(text, HasSubstr("errors_total 4\n"));
+}
+
+}
@@ -13,7 +13,8 @@ struct ITransportMock : public ITransport
 
     MOCK_METHOD(void, registerMessageCallback, (MessageCallback), (final));
     MOCK_METHOD(void, registerDisconnectedCallback, (DisconnectedCallback), (final));
-    MOCK_METHOD(bool, sendMessage, (BinaryMessage), (final));
+    MOCK_METHOD(bool, sendMessage, (Frame), (final));
+    MOCK_METHOD(bool, isCongested, (), (const, final));
     MOCK_METHOD(std::string, addressToString, (), (const, final));
 };
 
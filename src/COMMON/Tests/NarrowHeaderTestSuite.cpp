@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+#include "Messages/NarrowHeader.hpp"
+#include "Messages/MessageSchema.hpp"
+
+using namespace ::testing;
+
+namespace common::schema
+{
+
+class NarrowHeaderTestSuite : public Test
+{
+protected:
+    const PhoneNumber FROM{123};
+    const PhoneNumber TO{45};
+    const PhoneNumber WIDE_NUMBER{256};
+    const BtsId BTS_ID{0x01020304u};
+
+    static Frame::View viewOf(const BinaryMessage& message)
+    {
+        return Frame::View(message.value.data(), message.value.size());
+    }
+};
+
+TEST_F(NarrowHeaderTestSuite, shallTellNarrowHeader)
+{
+    const BinaryMessage narrow{{get(MessageId::Sib), 0, 0, 1, 2, 3, 4}};
+    ASSERT_TRUE(hasNarrowHeader(viewOf(narrow)));
+    ASSERT_FALSE(hasNarrowHeader(viewOf(encode<MessageId::Sib>(FROM, TO, {BTS_ID}))));
+    ASSERT_THROW(hasNarrowHeader(Frame::View{}), IncomingMessage::ReadEx);
+}
+
+TEST_F(NarrowHeaderTestSuite, shallWidenHeader)
+{
+    const BinaryMessage narrow{{get(MessageId::Sms), 123, 45, 'h', 'i'}};
+    const std::uint8_t text[] = {'h', 'i'};
+
+    ASSERT_EQ(encode<MessageId::Sms>(FROM, TO, {}, text).value, widenHeader(viewOf(narrow)).value);
+}
+
+TEST_F(NarrowHeaderTestSuite, shallWidenEmbeddedHeader)
+{
+    const BinaryMessage narrow{{get(MessageId::UnknownRecipient), 0, 123, get(MessageId::Sms), 123, 45}};
+
+    auto wide = widenHeader(viewOf(narrow));
+    auto decoded = decode<MessageId::UnknownRecipient>(viewOf(wide));
+    ASSERT_EQ(FROM, decoded.header.to);
+    ASSERT_EQ(MessageId::Sms, decoded.get<0>().messageId);
+    ASSERT_EQ(TO, decoded.get<0>().to);
+}
+
+TEST_F(NarrowHeaderTestSuite, shallNarrowWhatWasWidened)
+{
+    const MessageHeader rejected{MessageId::CallRequest, FROM, TO};
+    for (auto wide: {encode<MessageId::Sib>(PhoneNumber{}, PhoneNumber{}, {BTS_ID}),
+                     encode<MessageId::UnknownSender>(PhoneNumber{}, FROM, {rejected}),
+                     encode<MessageId::CallDropped>(FROM, TO)})
+    {
+        auto narrow = narrowHeader(viewOf(wide));
+        ASSERT_TRUE(narrow);
+        ASSERT_TRUE(hasNarrowHeader(viewOf(*narrow)));
+        ASSERT_EQ(wide.value, widenHeader(viewOf(*narrow)).value);
+    }
+}
+
+TEST_F(NarrowHeaderTestSuite, shallNotNarrowWideNumber)
+{
+    const MessageHeader rejected{MessageId::Sms, WIDE_NUMBER, TO};
+    ASSERT_FALSE(narrowHeader(viewOf(encode<MessageId::Sms>(WIDE_NUMBER, TO))));
+    ASSERT_FALSE(narrowHeader(viewOf(encode<MessageId::UnknownRecipient>(PhoneNumber{}, TO, {rejected}))));
+}
+
+TEST_F(NarrowHeaderTestSuite, shallNotWidenTooShortMessage)
+{
+    const BinaryMessage tooShort{{get(MessageId::Sms), 1}};
+    ASSERT_THROW(widenHeader(viewOf(tooShort)), IncomingMessage::ReadEx);
+}
+
+TEST_F(NarrowHeaderTestSuite, shallWidenMessageUpToMaxSize)
+{
+    std::vector<std::uint8_t> narrow(BinaryMessage::MAX_SIZE - HEADER_SIZE + NARROW_HEADER_SIZE, 'x');
+    narrow[0] = get(MessageId::Sms);
+
+    auto wide = widenHeader(Frame::View(narrow));
+    ASSERT_EQ(BinaryMessage::MAX_SIZE, wide.value.size());
+    ASSERT_EQ('x', wide.value[BinaryMessage::MAX_SIZE - 1u]);
+}
+
+TEST_F(NarrowHeaderTestSuite, shallNotWidenMessageOverMaxSize)
+{
+    std::vector<std::uint8_t> narrow(BinaryMessage::MAX_SIZE - HEADER_SIZE + NARROW_HEADER_SIZE + 1u, 'x');
+    narrow[0] = get(MessageId::Sms);
+    narrow[1] = static_cast<std::uint8_t>(FROM.value);
+    narrow[2] = static_cast<std::uint8_t>(TO.value);
+
+    ASSERT_THROW(widenHeader(Frame::View(narrow)), IncomingMessage::ReadEx);
+    auto header = decodeNarrowHeader(Frame::View(narrow));
+    ASSERT_EQ(MessageId::Sms, header.messageId);
+    ASSERT_EQ(FROM, header.from);
+    ASSERT_EQ(TO, header.to);
+}
+
+}
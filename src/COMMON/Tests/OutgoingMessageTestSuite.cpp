@@ -9,6 +9,7 @@
 
 
 #include "Messages/OutgoingMessage.hpp"
+#include "Messages/MessageSchema.hpp"
 
 using namespace ::testing;
 
@@ -30,17 +31,21 @@ protected:
         messageToSend = objectUnderTest.getMessage();
     }
 
-    template <typename T>
-    PhoneNumber phone(T value)
+    PhoneNumber phone(std::size_t offset)
     {
-        return PhoneNumber{ static_cast<decltype(PhoneNumber::value)>(value) };
+        PhoneNumber::Value value{};
+        for (std::size_t i = 0; i < sizeof(value); ++i)
+        {
+            value = (value << 8u) | messageToSend.value[offset + i];
+        }
+        return PhoneNumber{value};
     }
 
     void assertHeader()
     {
-        ASSERT_EQ(get(GetParam().messageId), messageToSend.value[0]);
-        ASSERT_EQ(GetParam().from, phone(messageToSend.value[1]));
-        ASSERT_EQ(GetParam().to, phone(messageToSend.value[2]));
+        ASSERT_EQ(get(GetParam().messageId) | schema::WIDE_HEADER_FLAG, messageToSend.value[0]);
+        ASSERT_EQ(GetParam().from, phone(1u));
+        ASSERT_EQ(GetParam().to, phone(1u + sizeof(PhoneNumber::Value)));
     }
 };
 
@@ -58,8 +63,8 @@ TEST_P(OutgoingMessageTestSuite, shallEncodeMessageHeaderAndString)
     getMessage();
     assertHeader();
 
-    ASSERT_THAT(text, ElementsAreArray(messageToSend.value.data() + sizeof(MessageHeader),
-                                       messageToSend.value.size() - sizeof(MessageHeader)));
+    ASSERT_THAT(text, ElementsAreArray(messageToSend.value.data() + schema::HEADER_SIZE,
+                                       messageToSend.value.size() - schema::HEADER_SIZE));
 }
 
 TEST_P(OutgoingMessageTestSuite, shallEncodeMessageHeaderAndOneByte)
@@ -70,8 +75,8 @@ TEST_P(OutgoingMessageTestSuite, shallEncodeMessageHeaderAndOneByte)
     getMessage();
     assertHeader();
 
-    ASSERT_EQ(sizeof(MessageHeader) + 1u, messageToSend.value.size());
-    ASSERT_EQ(number, messageToSend.value[sizeof(MessageHeader)]);
+    ASSERT_EQ(schema::HEADER_SIZE + 1u, messageToSend.value.size());
+    ASSERT_EQ(number, messageToSend.value[schema::HEADER_SIZE]);
 }
 
 TEST_P(OutgoingMessageTestSuite, shallEncodeMessageHeaderAndTwoByteNumber)
@@ -84,9 +89,9 @@ TEST_P(OutgoingMessageTestSuite, shallEncodeMessageHeaderAndTwoByteNumber)
     getMessage();
     assertHeader();
 
-    ASSERT_EQ(sizeof(MessageHeader) + 2u, messageToSend.value.size());
-    ASSERT_EQ(highByte, messageToSend.value[sizeof(MessageHeader)]);
-    ASSERT_EQ(lowByte, messageToSend.value[sizeof(MessageHeader) + 1]);
+    ASSERT_EQ(schema::HEADER_SIZE + 2u, messageToSend.value.size());
+    ASSERT_EQ(highByte, messageToSend.value[schema::HEADER_SIZE]);
+    ASSERT_EQ(lowByte, messageToSend.value[schema::HEADER_SIZE + 1]);
 }
 
 TEST_P(OutgoingMessageTestSuite, shallEncodeMessageHeaderAndTwoNumbersAndString)
@@ -104,13 +109,13 @@ TEST_P(OutgoingMessageTestSuite, shallEncodeMessageHeaderAndTwoNumbersAndString)
     getMessage();
     assertHeader();
 
-    ASSERT_EQ(sizeof(MessageHeader) + 3u + text.length(), messageToSend.value.size());
-    ASSERT_EQ(highByte, messageToSend.value[sizeof(MessageHeader)]);
-    ASSERT_EQ(lowByte, messageToSend.value[sizeof(MessageHeader) + 1]);
-    ASSERT_EQ(number2, messageToSend.value[sizeof(MessageHeader) + 2]);
+    ASSERT_EQ(schema::HEADER_SIZE + 3u + text.length(), messageToSend.value.size());
+    ASSERT_EQ(highByte, messageToSend.value[schema::HEADER_SIZE]);
+    ASSERT_EQ(lowByte, messageToSend.value[schema::HEADER_SIZE + 1]);
+    ASSERT_EQ(number2, messageToSend.value[schema::HEADER_SIZE + 2]);
 
-    ASSERT_THAT(text, ElementsAreArray(messageToSend.value.data() + sizeof(MessageHeader) + 3u,
-                                       messageToSend.value.size() - sizeof(MessageHeader) - 3u));
+    ASSERT_THAT(text, ElementsAreArray(messageToSend.value.data() + schema::HEADER_SIZE + 3u,
+                                       messageToSend.value.size() - schema::HEADER_SIZE - 3u));
 }
 
 INSTANTIATE_TEST_SUITE_P(
@@ -119,7 +124,8 @@ INSTANTIATE_TEST_SUITE_P(
         Values(
             MessageHeader{MessageId::AttachRequest, 0x02, 0x03},
             MessageHeader{MessageId::AttachResponse, 0x13, 0xFF},
-            MessageHeader{MessageId::AttachRequest, 0xFF, 0xDD}
+            MessageHeader{MessageId::AttachRequest, 0xFF, 0xDD},
+            MessageHeader{MessageId::Sms, 0x12345678, 0xFFFFFFFF}
             ));
 
 }
@@ -2,6 +2,9 @@
 #include <gmock/gmock.h>
 
 
+#include <sstream>
+
+#include "Logger/Logger.hpp"
 #include "Logger/PrefixedLogger.hpp"
 #include "Mocks/ILoggerMock.hpp"
 
@@ -42,4 +45,31 @@ TEST_F(PrefixedLoggerTestSuite, shallPrintPrefixToErrorStream)
     objectUnderTest.logError(message2);
 }
 
+struct FormattedValue
+{
+    bool* formatted;
+    friend std::ostream& operator << (std::ostream& os, const FormattedValue& value)
+    {
+        *value.formatted = true;
+        return os;
+    }
+};
+
+TEST(PrefixedLoggerLevelTestSuite, shallNotFormatValuesOfLevelDisabledByAdaptee)
+{
+    std::ostringstream logStream;
+    Logger adaptee{{"[DEBUG]", {&logStream}}, {"", {&logStream}}, {"[ERROR]", {&logStream}}};
+    adaptee.setMinimumLevel(ILogger::INFO_LEVEL);
+    PrefixedLogger objectUnderTest{adaptee, "[prefix]"};
+
+    bool formatted = false;
+    objectUnderTest.logDebug(FormattedValue{&formatted});
+    ASSERT_FALSE(formatted);
+    ASSERT_THAT(logStream.str(), IsEmpty());
+
+    objectUnderTest.logInfo(FormattedValue{&formatted});
+    ASSERT_TRUE(formatted);
+    ASSERT_THAT(logStream.str(), HasSubstr("[prefix]"));
+}
+
 } // namespace common
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+#include "CommonEnvironment/SendQueue.hpp"
+#include "Messages/MessageSchema.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class SendQueueTestSuite : public Test
+{
+protected:
+    using Bytes = std::vector<BinaryMessage::ValueType>;
+
+    // frame of 2 bytes prefix + 8 bytes message
+    static constexpr std::size_t FRAME_LENGTH = 10u;
+
+    static SendQueue::Options options(SendQueue::OverflowPolicy policy = SendQueue::OverflowPolicy::DropCallTalk)
+    {
+        return SendQueue::Options{3u * FRAME_LENGTH, FRAME_LENGTH, 5u * FRAME_LENGTH, policy};
+    }
+    static Bytes message(MessageId messageId)
+    {
+        return Bytes{ get(messageId), 1, 2, 3, 4, 5, 6, 7 };
+    }
+    SendQueue::PushResult push(MessageId messageId)
+    {
+        auto bytes = message(messageId);
+        return objectUnderTest.push(Frame::copyOf(Frame::View(bytes)));
+    }
+    Bytes pending() const
+    {
+        std::vector<SendQueue::Segment> segments(16u);
+        segments.resize(objectUnderTest.pending(segments));
+        Bytes bytes;
+        for (auto segment: segments)
+        {
+            bytes.insert(bytes.end(), segment.begin(), segment.end());
+        }
+        return bytes;
+    }
+    void pushUntilCongested()
+    {
+        while (not objectUnderTest.isCongested())
+        {
+            ASSERT_EQ(SendQueue::PushResult::Queued, push(MessageId::Sms));
+        }
+    }
+
+    SendQueue objectUnderTest{options()};
+};
+
+TEST_F(SendQueueTestSuite, shallQueueSizePrefixedFrames)
+{
+    ASSERT_TRUE(objectUnderTest.empty());
+    ASSERT_EQ(SendQueue::PushResult::Queued, push(MessageId::Sms));
+    ASSERT_EQ(SendQueue::PushResult::Queued, push(MessageId::CallTalk));
+
+    Bytes expected{0, 8};
+    auto sms = message(MessageId::Sms);
+    expected.insert(expected.end(), sms.begin(), sms.end());
+    expected.insert(expected.end(), {0, 8});
+    auto callTalk = message(MessageId::CallTalk);
+    expected.insert(expected.end(), callTalk.begin(), callTalk.end());
+    ASSERT_THAT(pending(), ElementsAreArray(expected));
+}
+
+TEST_F(SendQueueTestSuite, shallKeepNotConsumedBytes)
+{
+    push(MessageId::Sms);
+    push(MessageId::Sms);
+    objectUnderTest.consume(FRAME_LENGTH + 3u);
+
+    ASSERT_EQ(FRAME_LENGTH - 3u, objectUnderTest.size());
+    ASSERT_THAT(pending(), ElementsAre(1, 2, 3, 4, 5, 6, 7));
+    objectUnderTest.consume(FRAME_LENGTH);
+    ASSERT_TRUE(objectUnderTest.empty());
+}
+
+TEST_F(SendQueueTestSuite, shallQueueFramesWithoutCopyingThem)
+{
+    auto bytes = message(MessageId::Sms);
+    auto frame = Frame::copyOf(Frame::View(bytes));
+    objectUnderTest.push(frame);
+
+    std::array<SendQueue::Segment, 2u> segments;
+    ASSERT_EQ(2u, objectUnderTest.pending(segments));
+    ASSERT_THAT(Bytes(segments[0].begin(), segments[0].end()), ElementsAre(0, 8));
+    ASSERT_EQ(frame.data(), segments[1].data());
+    ASSERT_EQ(frame.size(), segments[1].size());
+}
+
+TEST_F(SendQueueTestSuite, shallFillNotMoreSegmentsThanGiven)
+{
+    push(MessageId::Sms);
+    push(MessageId::CallTalk);
+    objectUnderTest.consume(1u);
+
+    std::array<SendQueue::Segment, 3u> segments;
+    ASSERT_EQ(3u, objectUnderTest.pending(segments));
+    ASSERT_EQ(1u, segments[0].size());
+    ASSERT_EQ(8u, segments[1].size());
+    ASSERT_EQ(2u, segments[2].size());
+}
+
+TEST_F(SendQueueTestSuite, shallBeCongestedAboveHighWatermarkTillLowWatermark)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        push(MessageId::Sms);
+    }
+    ASSERT_FALSE(objectUnderTest.isCongested());
+    push(MessageId::Sms);
+    ASSERT_TRUE(objectUnderTest.isCongested());
+
+    objectUnderTest.consume(2u * FRAME_LENGTH);
+    ASSERT_TRUE(objectUnderTest.isCongested());
+    objectUnderTest.consume(FRAME_LENGTH);
+    ASSERT_FALSE(objectUnderTest.isCongested());
+}
+
+TEST_F(SendQueueTestSuite, shallDropCallTalkButQueueControlMessagesWhenCongested)
+{
+    pushUntilCongested();
+    auto size = objectUnderTest.size();
+
+    ASSERT_EQ(SendQueue::PushResult::Dropped, push(MessageId::CallTalk));
+    ASSERT_EQ(size, objectUnderTest.size());
+    ASSERT_EQ(SendQueue::PushResult::Queued, push(MessageId::CallDropped));
+    ASSERT_EQ(size + FRAME_LENGTH, objectUnderTest.size());
+}
+
+TEST_F(SendQueueTestSuite, shallOverflowAboveLimitWhatever)
+{
+    pushUntilCongested();
+    ASSERT_EQ(SendQueue::PushResult::Queued, push(MessageId::Sms));
+    ASSERT_EQ(SendQueue::PushResult::Overflow, push(MessageId::Sms));
+    ASSERT_EQ(5u * FRAME_LENGTH, objectUnderTest.size());
+}
+
+TEST_F(SendQueueTestSuite, shallOverflowWhenCongestedWithDisconnectPolicy)
+{
+    SendQueue objectUnderTest{options(SendQueue::OverflowPolicy::Disconnect)};
+    auto bytes = message(MessageId::Sms);
+    while (not objectUnderTest.isCongested())
+    {
+        ASSERT_EQ(SendQueue::PushResult::Queued, objectUnderTest.push(Frame::copyOf(Frame::View(bytes))));
+    }
+    ASSERT_EQ(SendQueue::PushResult::Overflow, objectUnderTest.push(Frame::copyOf(Frame::View(bytes))));
+}
+
+TEST_F(SendQueueTestSuite, shallRecognizeCallTalkInWideHeader)
+{
+    Bytes callTalk{ static_cast<std::uint8_t>(get(MessageId::CallTalk) | schema::WIDE_HEADER_FLAG), 0, 0 };
+    Bytes sms{ static_cast<std::uint8_t>(get(MessageId::Sms) | schema::WIDE_HEADER_FLAG), 0, 0 };
+    ASSERT_TRUE(SendQueue::isDroppable(Frame::View(callTalk)));
+    ASSERT_FALSE(SendQueue::isDroppable(Frame::View(sms)));
+    ASSERT_FALSE(SendQueue::isDroppable(Frame::View()));
+}
+
+TEST_F(SendQueueTestSuite, shallNotAcceptWatermarksOutOfOrder)
+{
+    ASSERT_THROW(SendQueue(SendQueue::Options{10u, 20u, 30u}), std::invalid_argument);
+    ASSERT_THROW(SendQueue(SendQueue::Options{40u, 20u, 30u}), std::invalid_argument);
+}
+
+}
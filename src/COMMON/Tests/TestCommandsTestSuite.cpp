@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "TestCommands/TestCommands.hpp"
+#include "Messages/MessageSchema.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class TestCommandsTestSuite : public Test
+{
+protected:
+    const PhoneNumber TO{2};
+    // sending to it fails
+    const PhoneNumber UNREACHABLE{3};
+
+    std::mutex mutex;
+    std::vector<PhoneNumber> sentTo;
+    std::vector<Frame> sentMessages;
+    std::string printed;
+    TestCommands::Parameters parameters;
+
+    TestCommandsTestSuite()
+    {
+        parameters.numberOfThreads = 4u;
+        parameters.sendMessage = [this](const Frame& message, PhoneNumber to)
+        {
+            if (to == UNREACHABLE)
+            {
+                throw std::runtime_error("not sent");
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            sentTo.push_back(to);
+            sentMessages.push_back(message);
+        };
+        parameters.printText = [this](std::string text)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            printed += text;
+        };
+    }
+
+    void run(std::string commands)
+    {
+        TestCommands objectUnderTest(std::move(commands));
+        objectUnderTest.run(parameters);
+    }
+};
+
+TEST_F(TestCommandsTestSuite, shallSendMessageEncodedOnce)
+{
+    run("repeat 2 send Sms 1 2 0x00ff7A");
+
+    ASSERT_EQ(2u, sentMessages.size());
+    // the same payload - not copied per send
+    ASSERT_EQ(sentMessages[0].data(), sentMessages[1].data());
+    auto body = sentMessages[0].view().last(3);
+    ASSERT_THAT(std::vector<std::uint8_t>(body.begin(), body.end()), ElementsAre(0x00, 0xff, 0x7a));
+}
+
+TEST_F(TestCommandsTestSuite, shallSendToPhoneNumberWiderThanByte)
+{
+    run("send Sms 70000 4000000000 hi");
+
+    ASSERT_THAT(sentTo, ElementsAre(PhoneNumber{4000000000u}));
+    auto header = schema::decodeHeader(sentMessages[0].view());
+    ASSERT_EQ(PhoneNumber{70000u}, header.from);
+    ASSERT_EQ(PhoneNumber{4000000000u}, header.to);
+}
+
+TEST_F(TestCommandsTestSuite, shallNotParsePhoneNumberOutOfRange)
+{
+    ASSERT_THROW(run("send Sms 1 5000000000 hi"), std::runtime_error);
+}
+
+TEST_F(TestCommandsTestSuite, shallNotParseInvalidHexBody)
+{
+    ASSERT_THROW(run("send Sms 1 2 0x0g"), std::runtime_error);
+    ASSERT_THROW(run("send Sms 1 2 0x012"), std::runtime_error);
+}
+
+TEST_F(TestCommandsTestSuite, shallCountSentMessagesPerMessageId)
+{
+    TestCommands objectUnderTest("repeat 3 send Sms 1 2 x thread repeat 2 send CallRequest 1 2 x");
+    objectUnderTest.run(parameters);
+
+    auto& statistics = objectUnderTest.getStatistics();
+    ASSERT_EQ(5u, statistics.getTotalSent());
+    ASSERT_EQ(3u, statistics.sent[get(MessageId::Sms)]);
+    ASSERT_EQ(2u, statistics.sent[get(MessageId::CallRequest)]);
+    ASSERT_EQ(0u, statistics.jitter.getCount());
+}
+
+TEST_F(TestCommandsTestSuite, shallRecordJitterOfPacedMessages)
+{
+    TestCommands objectUnderTest("rate 1000 repeat 10 send Sms 1 2 x");
+    objectUnderTest.run(parameters);
+
+    std::ostringstream report;
+    report << objectUnderTest.getStatistics();
+    ASSERT_EQ(10u, objectUnderTest.getStatistics().jitter.getCount());
+    ASSERT_THAT(report.str(), HasSubstr("Sms: 10"));
+    ASSERT_THAT(report.str(), HasSubstr("jitter [us]: count: 10"));
+}
+
+TEST_F(TestCommandsTestSuite, shallRunCommandsFromFile)
+{
+    auto path = TempDir() + "TestCommandsTestSuite.scenario";
+    {
+        std::ofstream file(path);
+        file << "# attach storm\n"
+                "repeat 2   # twice\n"
+                "  send Sms 1 2 x\n"
+                "echo done\n";
+    }
+    auto objectUnderTest = TestCommands::fromFile(path);
+    objectUnderTest.run(parameters);
+
+    ASSERT_EQ(2u, sentTo.size());
+    ASSERT_EQ("done", printed);
+}
+
+TEST_F(TestCommandsTestSuite, shallNotLoadMissingFile)
+{
+    ASSERT_THROW(TestCommands::fromFile("/not/existing/scenario"), std::runtime_error);
+}
+
+TEST_F(TestCommandsTestSuite, shallSendRepeatedMessages)
+{
+    run("repeat 5 send Sms 1 2 hello");
+    ASSERT_THAT(sentTo, ElementsAre(TO, TO, TO, TO, TO));
+}
+
+TEST_F(TestCommandsTestSuite, shallNotParseUnknownCommand)
+{
+    ASSERT_THROW(run("fly 5"), std::runtime_error);
+}
+
+TEST_F(TestCommandsTestSuite, shallFinishRunWhenThreadCommandsAreDone)
+{
+    run("repeat 50 thread repeat 10 send Sms 1 2 x");
+    ASSERT_EQ(500u, sentTo.size());
+}
+
+TEST_F(TestCommandsTestSuite, shallWaitForThreadCommandsOnJoin)
+{
+    run("group 3 thread group 2 wait 20 echo first join echo second");
+    ASSERT_EQ("firstsecond", printed);
+}
+
+TEST_F(TestCommandsTestSuite, shallRunParallelCopiesOfCommand)
+{
+    run("parallel 10 repeat 10 send Sms 1 2 x echo done");
+    ASSERT_EQ(100u, sentTo.size());
+    ASSERT_EQ("done", printed);
+}
+
+TEST_F(TestCommandsTestSuite, shallPaceMessagesAtRequestedRate)
+{
+    auto start = std::chrono::steady_clock::now();
+    run("rate 500 parallel 4 repeat 10 send Sms 1 2 x");
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(40u, sentTo.size());
+    // 40 messages are 39 intervals of 2ms apart
+    ASSERT_GE(elapsed, std::chrono::milliseconds(78));
+    ASSERT_THAT(printed, HasSubstr("rate requested: 500/s"));
+    ASSERT_THAT(printed, HasSubstr("40 messages"));
+}
+
+TEST_F(TestCommandsTestSuite, shallReportFailureOfParallelCommands)
+{
+    run("parallel 4 send Sms 1 3 x echo done");
+    ASSERT_THAT(printed, HasSubstr("parallel command failed: not sent"));
+    ASSERT_THAT(printed, EndsWith("done"));
+}
+
+TEST_F(TestCommandsTestSuite, shallWaitForThreadCommandsWhenRateCommandFails)
+{
+    ASSERT_THROW(run("rate 2000 group 2 thread repeat 20 send Sms 1 2 x send Sms 1 3 x"), std::runtime_error);
+    ASSERT_EQ(20u, sentTo.size());
+}
+
+TEST_F(TestCommandsTestSuite, shallNotParseNotPositiveRate)
+{
+    ASSERT_THROW(run("rate 0 send Sms 1 2 x"), std::runtime_error);
+}
+
+}
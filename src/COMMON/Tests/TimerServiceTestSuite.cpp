@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+#include "Timers/TimerService.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class TimerServiceTestSuite : public Test
+{
+protected:
+    static constexpr std::chrono::milliseconds TICK{2};
+    static constexpr std::chrono::milliseconds DURATION{30};
+    static constexpr std::chrono::seconds TIMEOUT{2};
+
+    TimerService objectUnderTest{TICK};
+    TimerService::Timer timer;
+};
+
+TEST_F(TimerServiceTestSuite, shallNotAcceptZeroTick)
+{
+    ASSERT_THROW(TimerService(std::chrono::milliseconds(0)), std::invalid_argument);
+}
+
+TEST_F(TimerServiceTestSuite, shallExpireNotEarlierThanAfterDuration)
+{
+    std::promise<TimerService::Clock::time_point> expired;
+    auto scheduledAt = TimerService::Clock::now();
+    objectUnderTest.schedule(timer, DURATION, [&] { expired.set_value(TimerService::Clock::now()); });
+
+    auto expiredAt = expired.get_future();
+    ASSERT_EQ(std::future_status::ready, expiredAt.wait_for(TIMEOUT));
+    ASSERT_GE(expiredAt.get() - scheduledAt, DURATION);
+}
+
+TEST_F(TimerServiceTestSuite, shallNotExpireCancelledTimer)
+{
+    std::atomic_bool expired{false};
+    objectUnderTest.schedule(timer, DURATION, [&] { expired = true; });
+    objectUnderTest.cancel(timer);
+
+    std::this_thread::sleep_for(2 * DURATION);
+    ASSERT_FALSE(expired);
+    ASSERT_EQ(0u, objectUnderTest.size());
+}
+
+TEST_F(TimerServiceTestSuite, shallExpireTimersOfManyClients)
+{
+    constexpr std::size_t NUMBER_OF_TIMERS = 1000u;
+    std::vector<TimerService::Timer> timers(NUMBER_OF_TIMERS);
+    std::atomic<std::size_t> expired{0u};
+    std::promise<void> allExpired;
+    for (std::size_t i = 0; i < NUMBER_OF_TIMERS; ++i)
+    {
+        objectUnderTest.schedule(timers[i], std::chrono::milliseconds(i % 50u), [&]
+        {
+            if (++expired == NUMBER_OF_TIMERS)
+            {
+                allExpired.set_value();
+            }
+        });
+    }
+
+    ASSERT_EQ(std::future_status::ready, allExpired.get_future().wait_for(TIMEOUT));
+    ASSERT_EQ(0u, objectUnderTest.size());
+}
+
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "Timers/TimingWheel.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class TimingWheelTestSuite : public Test
+{
+protected:
+    using Ticks = TimingWheel::Ticks;
+
+    TimingWheel objectUnderTest;
+    TimingWheel::Timer timer;
+    StrictMock<MockFunction<void()>> callbackMock;
+
+    TimingWheel::Callback callback()
+    {
+        return callbackMock.AsStdFunction();
+    }
+};
+
+TEST_F(TimingWheelTestSuite, shallExpireTimerAtItsTick)
+{
+    objectUnderTest.schedule(timer, 10u, callback());
+    ASSERT_EQ(0u, objectUnderTest.advance(9u));
+    ASSERT_TRUE(timer.isScheduled());
+
+    EXPECT_CALL(callbackMock, Call());
+    ASSERT_EQ(1u, objectUnderTest.advance(10u));
+    ASSERT_FALSE(timer.isScheduled());
+    ASSERT_TRUE(objectUnderTest.empty());
+}
+
+TEST_F(TimingWheelTestSuite, shallExpirePastTimerOnNextAdvance)
+{
+    objectUnderTest.advance(100u);
+    objectUnderTest.schedule(timer, 50u, callback());
+
+    EXPECT_CALL(callbackMock, Call());
+    ASSERT_EQ(1u, objectUnderTest.advance(101u));
+}
+
+TEST_F(TimingWheelTestSuite, shallNotExpireCancelledTimer)
+{
+    objectUnderTest.schedule(timer, 10u, callback());
+    objectUnderTest.cancel(timer);
+
+    ASSERT_FALSE(timer.isScheduled());
+    ASSERT_EQ(0u, objectUnderTest.advance(100u));
+    ASSERT_TRUE(objectUnderTest.empty());
+}
+
+TEST_F(TimingWheelTestSuite, shallRescheduleScheduledTimer)
+{
+    objectUnderTest.schedule(timer, 10u, callback());
+    objectUnderTest.schedule(timer, 20u, callback());
+    ASSERT_EQ(1u, objectUnderTest.size());
+    ASSERT_EQ(0u, objectUnderTest.advance(19u));
+
+    EXPECT_CALL(callbackMock, Call());
+    ASSERT_EQ(1u, objectUnderTest.advance(20u));
+}
+
+TEST_F(TimingWheelTestSuite, shallCancelTimerOnItsDestruction)
+{
+    auto shortLivedTimer = std::make_unique<TimingWheel::Timer>();
+    objectUnderTest.schedule(*shortLivedTimer, 10u, callback());
+    shortLivedTimer.reset();
+
+    ASSERT_TRUE(objectUnderTest.empty());
+    ASSERT_EQ(0u, objectUnderTest.advance(100u));
+}
+
+TEST_F(TimingWheelTestSuite, shallAllowCallbackToRescheduleItsTimer)
+{
+    std::vector<Ticks> expiredAt;
+    std::function<void()> periodic = [&]
+    {
+        expiredAt.push_back(objectUnderTest.getNextTick() - 1u);
+        if (expiredAt.size() < 3u)
+        {
+            objectUnderTest.schedule(timer, expiredAt.back() + 100u, periodic);
+        }
+    };
+    objectUnderTest.schedule(timer, 100u, periodic);
+    objectUnderTest.advance(1000u);
+
+    ASSERT_THAT(expiredAt, ElementsAre(100u, 200u, 300u));
+}
+
+TEST_F(TimingWheelTestSuite, shallExpireTimersOfAllLevelsAtTheirTicks)
+{
+    const std::vector<Ticks> expiries{
+        1u, 63u, 64u, 65u, 4095u, 4096u, 4097u, 70000u,
+        (Ticks{1} << 18) + 3u, (Ticks{1} << 24) - 1u, (Ticks{1} << 24) + 5u};
+    std::vector<TimingWheel::Timer> timers(expiries.size());
+    std::map<Ticks, Ticks> expiredAt;
+    for (std::size_t i = 0; i < expiries.size(); ++i)
+    {
+        objectUnderTest.schedule(timers[i], expiries[i], [&, expiry = expiries[i]]
+        {
+            expiredAt[expiry] = objectUnderTest.getNextTick() - 1u;
+        });
+    }
+
+    ASSERT_EQ(expiries.size(), objectUnderTest.advance(expiries.back()));
+    for (auto expiry: expiries)
+    {
+        ASSERT_EQ(expiry, expiredAt[expiry]);
+    }
+}
+
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "TestCommands/WorkerPool.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class WorkerPoolTestSuite : public Test
+{
+protected:
+    static constexpr std::size_t NUMBER_OF_THREADS = 3u;
+
+    WorkerPool::Group group;
+    WorkerPool objectUnderTest{NUMBER_OF_THREADS};
+};
+
+TEST_F(WorkerPoolTestSuite, shallNotAcceptZeroThreads)
+{
+    ASSERT_THROW(WorkerPool(0u), std::invalid_argument);
+}
+
+TEST_F(WorkerPoolTestSuite, shallWaitForAllTasksOfGroup)
+{
+    constexpr std::size_t NUMBER_OF_TASKS = 100u;
+    std::atomic<std::size_t> done{0u};
+    for (std::size_t i = 0u; i < NUMBER_OF_TASKS; ++i)
+    {
+        objectUnderTest.post(group, [&done]
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            ++done;
+        });
+    }
+
+    objectUnderTest.wait(group);
+    ASSERT_EQ(NUMBER_OF_TASKS, done);
+}
+
+TEST_F(WorkerPoolTestSuite, shallRunNotMoreTasksAtOnceThanThreads)
+{
+    std::atomic<std::size_t> running{0u};
+    std::atomic<std::size_t> maxRunning{0u};
+    for (std::size_t i = 0u; i < 10u * NUMBER_OF_THREADS; ++i)
+    {
+        objectUnderTest.post(group, [&]
+        {
+            auto nowRunning = ++running;
+            auto previousMax = maxRunning.load();
+            while (nowRunning > previousMax and not maxRunning.compare_exchange_weak(previousMax, nowRunning))
+            {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            --running;
+        });
+    }
+
+    // the waiting thread helps - so one more
+    objectUnderTest.wait(group);
+    ASSERT_LE(maxRunning, NUMBER_OF_THREADS + 1u);
+}
+
+TEST_F(WorkerPoolTestSuite, shallNotBlockWhenAllThreadsWaitForNestedGroups)
+{
+    std::atomic<std::size_t> done{0u};
+    for (std::size_t i = 0u; i < 2u * NUMBER_OF_THREADS; ++i)
+    {
+        objectUnderTest.post(group, [&]
+        {
+            WorkerPool::Group nested;
+            for (std::size_t j = 0u; j < NUMBER_OF_THREADS; ++j)
+            {
+                objectUnderTest.post(nested, [&done] { ++done; });
+            }
+            objectUnderTest.wait(nested);
+        });
+    }
+
+    objectUnderTest.wait(group);
+    ASSERT_EQ(2u * NUMBER_OF_THREADS * NUMBER_OF_THREADS, done);
+}
+
+TEST_F(WorkerPoolTestSuite, shallRethrowFromWaitWhenTaskThrew)
+{
+    std::atomic<std::size_t> done{0u};
+    for (std::size_t i = 0u; i < 10u; ++i)
+    {
+        objectUnderTest.post(group, [&done, i]
+        {
+            if (i == 5u)
+            {
+                throw std::runtime_error("task failed");
+            }
+            ++done;
+        });
+    }
+
+    ASSERT_THROW(objectUnderTest.wait(group), std::runtime_error);
+    ASSERT_EQ(9u, done);
+    // reported once
+    objectUnderTest.wait(group);
+}
+
+}
@@ -0,0 +1,86 @@
+#include "TimerService.hpp"
+#include <stdexcept>
+
+namespace common
+{
+
+TimerService::TimerService(std::chrono::milliseconds tick)
+    : TICK(tick),
+      epoch(Clock::now())
+{
+    if (TICK.count() <= 0)
+    {
+        throw std::invalid_argument("Timer service tick shall be positive");
+    }
+    driver = std::thread(&TimerService::run, this);
+}
+
+TimerService::~TimerService()
+{
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        stopping = true;
+    }
+    scheduled.notify_all();
+    driver.join();
+}
+
+void TimerService::schedule(Timer &timer, std::chrono::milliseconds duration, Callback callback)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    auto wasEmpty = wheel.empty();
+    if (wasEmpty)
+    {
+        // idle wheel catches up with the time at once
+        wheel.advance(ticksAt(Clock::now()));
+    }
+    // rounded up - so not expired earlier than requested
+    auto expiry = (Clock::now() - epoch + duration + TICK - Clock::duration(1)) / TICK;
+    wheel.schedule(timer, static_cast<TimingWheel::Ticks>(expiry), std::move(callback));
+    if (wasEmpty)
+    {
+        scheduled.notify_all();
+    }
+}
+
+void TimerService::cancel(Timer &timer)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    wheel.cancel(timer);
+}
+
+std::size_t TimerService::size() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return wheel.size();
+}
+
+void TimerService::run()
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex);
+    while (not stopping)
+    {
+        wheel.advance(ticksAt(Clock::now()));
+        if (wheel.empty())
+        {
+            // no tick processing when idle
+            scheduled.wait(lock, [this] { return stopping or not wheel.empty(); });
+        }
+        else
+        {
+            scheduled.wait_until(lock, timeOf(wheel.getNextTick()), [this] { return stopping; });
+        }
+    }
+}
+
+TimingWheel::Ticks TimerService::ticksAt(Clock::time_point time) const
+{
+    return static_cast<TimingWheel::Ticks>((time - epoch) / TICK);
+}
+
+TimerService::Clock::time_point TimerService::timeOf(TimingWheel::Ticks ticks) const
+{
+    return epoch + ticks * TICK;
+}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "TimingWheel.hpp"
+
+namespace common
+{
+
+/**
+ * Timers of many clients driven by one thread - the thread advances TimingWheel as the time passes.
+ *
+ * Callbacks are called in the driver thread - clients shall hand the timeout over to their own thread,
+ * callbacks are allowed to schedule/cancel timers.
+ * Timer shall be cancelled (or expired) before it is destroyed.
+ */
+class TimerService
+{
+public:
+    using Timer = TimingWheel::Timer;
+    using Callback = TimingWheel::Callback;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::milliseconds DEFAULT_TICK{10};
+
+    TimerService(std::chrono::milliseconds tick = DEFAULT_TICK);
+    ~TimerService();
+
+    // expires not earlier than after given duration, rounded up to whole ticks
+    void schedule(Timer& timer, std::chrono::milliseconds duration, Callback callback);
+    void cancel(Timer& timer);
+
+    std::size_t size() const;
+
+private:
+    void run();
+    TimingWheel::Ticks ticksAt(Clock::time_point time) const;
+    Clock::time_point timeOf(TimingWheel::Ticks ticks) const;
+
+    const std::chrono::milliseconds TICK;
+    const Clock::time_point epoch;
+
+    // recursive - callbacks are called with it locked
+    mutable std::recursive_mutex mutex;
+    std::condition_variable_any scheduled;
+    TimingWheel wheel;
+    bool stopping = false;
+    std::thread driver;
+};
+
+}
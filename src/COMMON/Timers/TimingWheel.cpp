@@ -0,0 +1,197 @@
+#include "TimingWheel.hpp"
+#include <algorithm>
+
+namespace common
+{
+
+TimingWheel::Timer::~Timer()
+{
+    if (wheel and isScheduled())
+    {
+        wheel->cancel(*this);
+    }
+}
+
+bool TimingWheel::Timer::isScheduled() const
+{
+    return next != nullptr;
+}
+
+void TimingWheel::Timer::unlink()
+{
+    prev->next = next;
+    next->prev = prev;
+    prev = next = nullptr;
+}
+
+void TimingWheel::Timer::linkBefore(Timer &node)
+{
+    prev = node.prev;
+    next = &node;
+    prev->next = this;
+    node.prev = this;
+}
+
+void TimingWheel::Timer::makeEmptyList()
+{
+    prev = next = this;
+}
+
+bool TimingWheel::Timer::isEmptyList() const
+{
+    return next == this;
+}
+
+void TimingWheel::Timer::moveListTo(Timer &list)
+{
+    if (isEmptyList())
+    {
+        list.makeEmptyList();
+        return;
+    }
+    list.next = next;
+    list.prev = prev;
+    next->prev = &list;
+    prev->next = &list;
+    makeEmptyList();
+}
+
+TimingWheel::TimingWheel(Ticks now)
+    : nextTick(now + 1)
+{
+    for (auto& slots: wheels)
+    {
+        for (auto& slot: slots)
+        {
+            slot.makeEmptyList();
+        }
+    }
+}
+
+TimingWheel::~TimingWheel()
+{
+    // timers outliving the wheel shall not refer to it
+    for (auto& slots: wheels)
+    {
+        for (auto& slot: slots)
+        {
+            while (not slot.isEmptyList())
+            {
+                auto& timer = *slot.next;
+                timer.unlink();
+                timer.wheel = nullptr;
+            }
+            slot.prev = slot.next = nullptr;
+        }
+    }
+}
+
+void TimingWheel::schedule(Timer &timer, Ticks expiry, Callback callback)
+{
+    if (timer.isScheduled())
+    {
+        cancel(timer);
+    }
+    timer.wheel = this;
+    timer.expiry = expiry;
+    timer.callback = std::move(callback);
+    place(timer);
+    ++numberOfTimers;
+}
+
+void TimingWheel::cancel(Timer &timer)
+{
+    if (timer.isScheduled())
+    {
+        timer.unlink();
+        --numberOfTimers;
+    }
+}
+
+std::size_t TimingWheel::advance(Ticks now)
+{
+    std::size_t expired = 0;
+    while (nextTick <= now)
+    {
+        if (empty())
+        {
+            // nothing to move down or expire in skipped ticks
+            nextTick = now + 1;
+            break;
+        }
+        expired += processTick();
+    }
+    return expired;
+}
+
+void TimingWheel::place(Timer &timer)
+{
+    // timer is placed in the finest level covering its expiry, at the slot of its expiry in that level
+    // the slot is reached when nextTick gets there - then timer is moved down to finer level (see cascade)
+    auto expiry = std::max(timer.expiry, nextTick);
+    auto delta = expiry - nextTick;
+    std::size_t level = 0;
+    while (level + 1 < LEVELS and delta >= (Ticks{1} << (LEVEL_BITS * (level + 1))))
+    {
+        ++level;
+    }
+    if (delta >= (Ticks{1} << (LEVEL_BITS * LEVELS)))
+    {
+        // beyond the wheel range - it is placed again when the farthest slot is reached
+        expiry = nextTick + (Ticks{1} << (LEVEL_BITS * LEVELS)) - 1;
+    }
+    auto slot = (expiry >> (LEVEL_BITS * level)) & (SLOTS - 1);
+    timer.linkBefore(wheels[level][slot]);
+}
+
+void TimingWheel::cascade(std::size_t level)
+{
+    Timer timers;
+    wheels[level][(nextTick >> (LEVEL_BITS * level)) & (SLOTS - 1)].moveListTo(timers);
+    while (not timers.isEmptyList())
+    {
+        auto& timer = *timers.next;
+        timer.unlink();
+        place(timer);
+    }
+    timers.prev = timers.next = nullptr;
+}
+
+std::size_t TimingWheel::processTick()
+{
+    auto slot = nextTick & (SLOTS - 1);
+    for (std::size_t level = 1; level < LEVELS; ++level)
+    {
+        // finer level has just wrapped - timers of next slot of this level are moved down
+        if (((nextTick >> (LEVEL_BITS * (level - 1))) & (SLOTS - 1)) != 0)
+        {
+            break;
+        }
+        cascade(level);
+    }
+
+    Timer expiring;
+    wheels[0][slot].moveListTo(expiring);
+    auto now = nextTick++;
+    std::size_t expired = 0;
+    while (not expiring.isEmptyList())
+    {
+        auto& timer = *expiring.next;
+        timer.unlink();
+        if (timer.expiry > now)
+        {
+            // placed at the end of the wheel range
+            place(timer);
+            continue;
+        }
+        --numberOfTimers;
+        ++expired;
+        // callback may reschedule this timer (with new callback)
+        auto callback = std::move(timer.callback);
+        callback();
+    }
+    expiring.prev = expiring.next = nullptr;
+    return expired;
+}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+
+namespace common
+{
+
+/**
+ * Hierarchical timing wheel: LEVELS wheels of SLOTS lists each, every level SLOTS times coarser than previous one.
+ * Timers are intrusive list nodes owned by clients - so schedule/cancel is O(1),
+ * expiring is O(1) per timer (amortized - including moving down from coarser levels).
+ *
+ * Time is counted in ticks, its duration is up to the user (see TimerService). Not thread safe.
+ */
+class TimingWheel
+{
+public:
+    using Ticks = std::uint64_t;
+    using Callback = std::function<void()>;
+
+    static constexpr unsigned LEVEL_BITS = 6;
+    static constexpr std::size_t SLOTS = std::size_t{1} << LEVEL_BITS;
+    static constexpr std::size_t LEVELS = 4;
+
+    class Timer
+    {
+    public:
+        Timer() = default;
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+        // cancels itself - shall not race with the wheel then
+        ~Timer();
+
+        bool isScheduled() const;
+
+    private:
+        friend class TimingWheel;
+        void unlink();
+        void linkBefore(Timer& node);
+        void makeEmptyList();
+        bool isEmptyList() const;
+        void moveListTo(Timer& list);
+
+        TimingWheel* wheel = nullptr;
+        Timer* prev = nullptr;
+        Timer* next = nullptr;
+        Ticks expiry = 0;
+        Callback callback;
+    };
+
+    TimingWheel(Ticks now = 0);
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+    ~TimingWheel();
+
+    // timer expires when wheel is advanced to given tick - or on next advance when it is already past
+    // already scheduled timer is rescheduled
+    void schedule(Timer& timer, Ticks expiry, Callback callback);
+    void cancel(Timer& timer);
+
+    // callbacks of all expired timers are called, they are allowed to schedule/cancel any timer
+    // @return number of expired timers
+    std::size_t advance(Ticks now);
+
+    // ticks up to nextTick - 1 are processed
+    Ticks getNextTick() const { return nextTick; }
+    std::size_t size() const { return numberOfTimers; }
+    bool empty() const { return numberOfTimers == 0; }
+
+private:
+    using Slots = std::array<Timer, SLOTS>;
+
+    void place(Timer& timer);
+    std::size_t processTick();
+    void cascade(std::size_t level);
+
+    std::array<Slots, LEVELS> wheels;
+    Ticks nextTick;
+    std::size_t numberOfTimers = 0;
+};
+
+}
@@ -1,6 +1,6 @@
 #include "BtsPort.hpp"
-#include "Messages/IncomingMessage.hpp"
-#include "Messages/OutgoingMessage.hpp"
+#include "Messages/MessageSchema.hpp"
+#include "Messages/NarrowHeader.hpp"
 
 namespace ue
 {
@@ -13,7 +13,7 @@ BtsPort::BtsPort(common::ILogger &logger, common::ITransport &transport, common:
 
 void BtsPort::start(IBtsEventsHandler &handler)
 {
-    transport.registerMessageCallback([this](BinaryMessage msg) {handleMessage(msg);});
+    transport.registerMessageCallback([this](Frame msg) {handleMessage(msg);});
     this->handler = &handler;
 }
 
@@ -23,26 +23,30 @@ void BtsPort::stop()
     handler = nullptr;
 }
 
-void BtsPort::handleMessage(BinaryMessage msg)
+void BtsPort::handleMessage(Frame msg)
 {
     try
     {
-        common::IncomingMessage reader{msg};
-        auto msgId = reader.readMessageId();
-        auto from = reader.readPhoneNumber();
-        auto to = reader.readPhoneNumber();
+        namespace schema = common::schema;
+        if (schema::hasNarrowHeader(msg.view()))
+        {
+            // sent by BTS till our AttachRequest
+            msg = schema::widenHeader(msg.view());
+        }
+        auto header = schema::decodeHeader(msg.view());
 
-        switch (msgId)
+        switch (header.messageId)
         {
         case common::MessageId::Sib:
         {
-            auto btsId = reader.readBtsId();
-            handler->handleSib(btsId);
+            auto sib = schema::decode<common::MessageId::Sib>(msg.view());
+            handler->handleSib(sib.get<0>());
             break;
         }
         case common::MessageId::AttachResponse:
         {
-            bool accept = reader.readNumber<std::uint8_t>() != 0u;
+            auto response = schema::decode<common::MessageId::AttachResponse>(msg.view());
+            bool accept = response.get<0>();
             if (accept)
                 handler->handleAttachAccept();
             else
@@ -50,7 +54,7 @@ void BtsPort::handleMessage(BinaryMessage msg)
             break;
         }
         default:
-            logger.logError("unknow message: ", msgId, ", from: ", from);
+            logger.logError("unknow message: ", header.messageId, ", from: ", header.from);
 
         }
     }
@@ -64,11 +68,9 @@ void BtsPort::handleMessage(BinaryMessage msg)
 void BtsPort::sendAttachRequest(common::BtsId btsId)
 {
     logger.logDebug("sendAttachRequest: ", btsId);
-    common::OutgoingMessage msg{common::MessageId::AttachRequest,
-                                phoneNumber,
-                                common::PhoneNumber{}};
-    msg.writeBtsId(btsId);
-    transport.sendMessage(msg.getMessage());
+    transport.sendMessage(common::schema::encode<common::MessageId::AttachRequest>(phoneNumber,
+                                                                                   common::PhoneNumber{},
+                                                                                   {btsId}));
 
 
 }
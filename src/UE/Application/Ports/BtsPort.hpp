@@ -18,7 +18,7 @@ public:
     void sendAttachRequest(common::BtsId) override;
 
 private:
-    void handleMessage(BinaryMessage msg);
+    void handleMessage(Frame msg);
 
     common::PrefixedLogger logger;
     common::ITransport& transport;
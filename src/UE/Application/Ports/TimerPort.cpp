@@ -3,10 +3,17 @@
 namespace ue
 {
 
-TimerPort::TimerPort(common::ILogger &logger)
-    : logger(logger, "[TIMER PORT]")
+TimerPort::TimerPort(common::ILogger &logger, common::TimerService &timerService, Executor ownerThread)
+    : logger(logger, "[TIMER PORT]"),
+      timerService(timerService),
+      ownerThread(std::move(ownerThread))
 {}
 
+TimerPort::~TimerPort()
+{
+    timerService.cancel(timer);
+}
+
 void TimerPort::start(ITimerEventsHandler &handler)
 {
     logger.logDebug("Started");
@@ -16,17 +23,36 @@ void TimerPort::start(ITimerEventsHandler &handler)
 void TimerPort::stop()
 {
     logger.logDebug("Stoped");
+    stopTimer();
     handler = nullptr;
 }
 
 void TimerPort::startTimer(Duration duration)
 {
     logger.logDebug("Start timer: ", duration.count(), "ms");
+    // called in the timer service thread
+    timerService.schedule(timer, duration, [this, timerGeneration = ++generation]
+    {
+        ownerThread([this, timerGeneration] { handleTimeout(timerGeneration); });
+    });
 }
 
 void TimerPort::stopTimer()
 {
     logger.logDebug("Stop timer");
+    ++generation;
+    timerService.cancel(timer);
+}
+
+void TimerPort::handleTimeout(std::uint64_t timerGeneration)
+{
+    if (timerGeneration != generation or handler == nullptr)
+    {
+        logger.logDebug("Timeout of stopped timer ignored");
+        return;
+    }
+    logger.logDebug("Timeout");
+    handler->handleTimeout();
 }
 
 }
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include "ITimerPort.hpp"
 #include "Logger/PrefixedLogger.hpp"
+#include "Timers/TimerService.hpp"
 
 namespace ue
 {
@@ -9,7 +12,12 @@ namespace ue
 class TimerPort : public ITimerPort
 {
 public:
-    TimerPort(common::ILogger& logger);
+    // runs given task in the thread of the port owner (e.g. in its message loop)
+    // tasks shall not be run after the port is destroyed
+    using Executor = std::function<void(std::function<void()>)>;
+
+    TimerPort(common::ILogger& logger, common::TimerService& timerService, Executor ownerThread);
+    ~TimerPort();
 
     void start(ITimerEventsHandler& handler);
     void stop();
@@ -19,7 +27,14 @@ public:
     void stopTimer() override;
 
 private:
+    void handleTimeout(std::uint64_t timerGeneration);
+
     common::PrefixedLogger logger;
+    common::TimerService& timerService;
+    Executor ownerThread;
+    common::TimerService::Timer timer;
+    // changed on every start/stop - so timeout already handed over to the owner thread is ignored
+    std::uint64_t generation = 0;
     ITimerEventsHandler* handler = nullptr;
 };
 
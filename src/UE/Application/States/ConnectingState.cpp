@@ -1,4 +1,6 @@
 #include "ConnectingState.hpp"
+#include "ConnectedState.hpp"
+#include "NotConnectedState.hpp"
 
 namespace ue
 {
@@ -8,4 +10,24 @@ ConnectingState::ConnectingState(Context &context)
 {
 }
 
+void ConnectingState::handleTimeout()
+{
+    context.user.showNotConnected();
+    context.setState<NotConnectedState>();
+}
+
+void ConnectingState::handleAttachAccept()
+{
+    context.timer.stopTimer();
+    context.user.showConnected();
+    context.setState<ConnectedState>();
+}
+
+void ConnectingState::handleAttachReject()
+{
+    context.timer.stopTimer();
+    context.user.showNotConnected();
+    context.setState<NotConnectedState>();
+}
+
 }
@@ -8,7 +8,16 @@ namespace ue
 class ConnectingState : public BaseState
 {
 public:
+    static constexpr ITimerPort::Duration ATTACH_TIMEOUT{500};
+
     ConnectingState(Context& context);
+
+    // ITimerEventsHandler interface
+    void handleTimeout() override;
+
+    // IBtsEventsHandler interface
+    void handleAttachAccept() override;
+    void handleAttachReject() override;
 };
 
 }
@@ -1,4 +1,5 @@
 #include "NotConnectedState.hpp"
+#include "ConnectingState.hpp"
 
 namespace ue
 {
@@ -9,4 +10,12 @@ NotConnectedState::NotConnectedState(Context &context)
 
 }
 
+void NotConnectedState::handleSib(common::BtsId btsId)
+{
+    context.bts.sendAttachRequest(btsId);
+    context.user.showConnecting();
+    context.timer.startTimer(ConnectingState::ATTACH_TIMEOUT);
+    context.setState<ConnectingState>();
+}
+
 }
@@ -9,6 +9,9 @@ class NotConnectedState : public BaseState
 {
 public:
     NotConnectedState(Context& context);
+
+    // IBtsEventsHandler interface
+    void handleSib(common::BtsId btsId) override;
 };
 
 }
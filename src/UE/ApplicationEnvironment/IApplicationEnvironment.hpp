@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include "IUeGui.hpp"
 #include "ITransport.hpp"
 #include "Logger/Logger.hpp"
@@ -20,6 +21,8 @@ public:
     virtual ILogger& getLogger() = 0;
 
     virtual void startMessageLoop() = 0;
+    // task is run in the message loop thread - callable from any thread
+    virtual void runInMessageLoop(std::function<void()> task) = 0;
 
     virtual PhoneNumber getMyPhoneNumber() const = 0;
 
@@ -7,5 +7,6 @@ namespace ue
 
 using common::ITransport;
 using common::BinaryMessage;
+using common::Frame;
 
 }
@@ -42,6 +42,7 @@ ApplicationEnvironment::ApplicationEnvironment(int& argc, char* argv[])
       gui(logger),
       transport(*configuration, logger)
 {
+    loggerBase.setMinimumLevel(configuration->getNumber<ILogger::Level>("log_level", ILogger::DEBUG_LEVEL));
 }
 
 ue::IUeGui& ApplicationEnvironment::getUeGui()
@@ -65,6 +66,11 @@ void ApplicationEnvironment::startMessageLoop()
     qApplication.exec();
 }
 
+void ApplicationEnvironment::runInMessageLoop(std::function<void()> task)
+{
+    QMetaObject::invokeMethod(&qApplication, std::move(task), Qt::QueuedConnection);
+}
+
 std::unique_ptr<common::MultiLineConfig> ApplicationEnvironment::readConfiguration(int argc, char *argv[])
 {
     auto commandLineConfig = std::make_unique<common::MultiLineConfig>(argc - 1, argv + 1);
@@ -23,6 +23,7 @@ public:
     std::int32_t getProperty(std::string const& name, std::int32_t defaultValue) const override;
 
     void startMessageLoop() override;
+    void runInMessageLoop(std::function<void()> task) override;
 
 private:
     std::unique_ptr<common::MultiLineConfig> configuration;
@@ -2,7 +2,7 @@
 
 #include <QPalette>
 #include <QFont>
-#include <QIntValidator>
+#include <QRegularExpressionValidator>
 
 namespace ue
 {
@@ -10,8 +10,9 @@ namespace ue
 QtPhoneNumberEdit::QtPhoneNumberEdit()
 {
     setFont(QFont( "Arial Narrow", 16));
-    setValidator( new QIntValidator(PhoneNumber::MIN_VALUE, PhoneNumber::MAX_VALUE, this));
-    setMaxLength(PhoneNumber::DIGITS);
+    // QIntValidator is limited to int - range of PhoneNumber is checked in getPhoneNumber()
+    setValidator( new QRegularExpressionValidator(QRegularExpression(QString("[0-9]{1,%1}").arg(PhoneNumber::MAX_DIGITS)), this));
+    setMaxLength(PhoneNumber::MAX_DIGITS);
     setStyleSheet("background-color:rgba( 255, 255, 255, 0% );");
 }
 
@@ -24,7 +25,7 @@ PhoneNumber QtPhoneNumberEdit::getPhoneNumber() const
 {
     bool ok = false;
     decltype(PhoneNumber::value) val = text().toUInt(&ok, 10);
-    if (ok)
+    if (ok and val >= PhoneNumber::MIN_VALUE)
         return PhoneNumber{val};
     return PhoneNumber{};
 }
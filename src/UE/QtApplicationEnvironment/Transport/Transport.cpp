@@ -4,7 +4,7 @@
 #include <string>
 #include "Config/MultiLineConfig.hpp"
 #include "Messages/OutgoingMessage.hpp"
-#include "Messages/IncomingMessage.hpp"
+#include <stdexcept>
 #include <functional>
 
 namespace ue
@@ -77,18 +77,24 @@ void Transport::registerDisconnectedCallback(ITransport::DisconnectedCallback di
     this->disconnectedCallback = disconnectedCallback;
 }
 
-bool Transport::sendMessage(BinaryMessage message)
+bool Transport::sendMessage(Frame message)
 {
     common::OutgoingMessage sizeEncoder;
-    sizeEncoder.writeNumber<BinaryMessage::SizeType>(message.value.size());
+    sizeEncoder.writeNumber<BinaryMessage::SizeType>(message.size());
     BinaryMessage size = sizeEncoder.getMessage();
 
     QByteArray array{};
     array.append(reinterpret_cast<char*>(size.value.data()), size.value.size());
-    array.append(reinterpret_cast<char*>(message.value.data()), message.value.size());
+    array.append(reinterpret_cast<const char*>(message.data()), message.size());
     return emit sendMessageSignal(array);
 }
 
+bool Transport::isCongested() const
+{
+    // written by Qt as fast as BTS reads - not limited here
+    return false;
+}
+
 std::string Transport::addressToString() const
 {
     if(not isConnected())
@@ -100,29 +106,32 @@ std::string Transport::addressToString() const
 
 void Transport::readData()
 {
-    const std::size_t sizeSize = sizeof(BinaryMessage::SizeType);
-    quint64 bytesAvailable;
-    while ((bytesAvailable = socket->bytesAvailable()) >= sizeSize)
+    try
     {
-        BinaryMessage sizeEncoded{ BinaryMessage::Value(sizeSize) };
-        socket->read(reinterpret_cast<char*>(sizeEncoded.value.data()), sizeSize);
-        common::IncomingMessage sizeDecoder(sizeEncoded);
-        BinaryMessage::SizeType messageLength = sizeDecoder.readNumber<BinaryMessage::SizeType>();
-
-        if (bytesAvailable < sizeSize + messageLength)
+        while (socket->bytesAvailable() > 0)
         {
-            logger.logError("Wrong size: ", std::size_t(messageLength),
-                            " - available bytes: ", bytesAvailable);
-            continue;
-        }
-
-        BinaryMessage message{ BinaryMessage::Value(messageLength) };
-        socket->read(reinterpret_cast<char*>(message.value.data()), messageLength);
-        if (messageCallback)
-        {
-            messageCallback(std::move(message));
+            auto space = receiveBuffer.writableSpace();
+            auto length = socket->read(reinterpret_cast<char*>(space.data()), space.size());
+            if (length <= 0)
+            {
+                break;
+            }
+            receiveBuffer.commit(length);
+
+            while (auto frame = receiveBuffer.nextFrame())
+            {
+                if (messageCallback)
+                {
+                    messageCallback(Frame::copyOf(*frame));
+                }
+            }
         }
     }
+    catch (std::length_error& error)
+    {
+        logger.logError(error.what());
+        socket->abort();
+    }
 }
 
 void Transport::handleError(QAbstractSocket::SocketError socketError)
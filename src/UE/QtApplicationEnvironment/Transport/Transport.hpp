@@ -3,6 +3,7 @@
 #include <memory>
 #include <QAbstractSocket>
 #include "Logger/PrefixedLogger.hpp"
+#include "CommonEnvironment/FrameBuffer.hpp"
 
 class QTcpSocket;
 class QNetworkSession;
@@ -26,7 +27,8 @@ public:
     ~Transport();
     void registerMessageCallback(MessageCallback messageCallback) override;
     void registerDisconnectedCallback(DisconnectedCallback disconnectedCallback) override;
-    bool sendMessage(BinaryMessage message) override;
+    bool sendMessage(Frame message) override;
+    bool isCongested() const override;
     std::string addressToString() const override;
 
 private slots:
@@ -45,6 +47,7 @@ private:
     std::string server;
     std::unique_ptr<QTcpSocket> socket;
     std::unique_ptr<QNetworkSession> session;
+    common::FrameBuffer receiveBuffer;
     MessageCallback messageCallback;
     DisconnectedCallback disconnectedCallback;
 };
@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 
 #include "Application.hpp"
+#include "States/ConnectingState.hpp"
 #include "Mocks/ILoggerMock.hpp"
 #include "Mocks/IBtsPortMock.hpp"
 #include "Mocks/IUserPortMock.hpp"
@@ -30,10 +31,68 @@ protected:
 };
 
 struct ApplicationNotConnectedTestSuite : ApplicationTestSuite
-{};
+{
+    const common::BtsId BTS_ID{42};
+
+    void receiveSib();
+};
+
+void ApplicationNotConnectedTestSuite::receiveSib()
+{
+    EXPECT_CALL(btsPortMock, sendAttachRequest(BTS_ID));
+    EXPECT_CALL(userPortMock, showConnecting());
+    EXPECT_CALL(timerPortMock, startTimer(ConnectingState::ATTACH_TIMEOUT));
+    objectUnderTest.handleSib(BTS_ID);
+}
 
-TEST_F(ApplicationNotConnectedTestSuite, todo)
+TEST_F(ApplicationNotConnectedTestSuite, shallSendAttachRequestOnSib)
 {
+    receiveSib();
+}
+
+struct ApplicationConnectingTestSuite : ApplicationNotConnectedTestSuite
+{
+    ApplicationConnectingTestSuite()
+    {
+        receiveSib();
+        verifyAndClearExpectations();
+    }
+
+    void verifyAndClearExpectations()
+    {
+        Mock::VerifyAndClearExpectations(&btsPortMock);
+        Mock::VerifyAndClearExpectations(&userPortMock);
+        Mock::VerifyAndClearExpectations(&timerPortMock);
+    }
+};
+
+TEST_F(ApplicationConnectingTestSuite, shallShowConnectedOnAttachAccept)
+{
+    EXPECT_CALL(timerPortMock, stopTimer());
+    EXPECT_CALL(userPortMock, showConnected());
+    objectUnderTest.handleAttachAccept();
+}
+
+TEST_F(ApplicationConnectingTestSuite, shallShowNotConnectedOnAttachReject)
+{
+    EXPECT_CALL(timerPortMock, stopTimer());
+    EXPECT_CALL(userPortMock, showNotConnected());
+    objectUnderTest.handleAttachReject();
+}
+
+TEST_F(ApplicationConnectingTestSuite, shallShowNotConnectedOnTimeout)
+{
+    EXPECT_CALL(userPortMock, showNotConnected());
+    objectUnderTest.handleTimeout();
+}
+
+TEST_F(ApplicationConnectingTestSuite, shallAttachAgainOnSibAfterTimeout)
+{
+    EXPECT_CALL(userPortMock, showNotConnected());
+    objectUnderTest.handleTimeout();
+    verifyAndClearExpectations();
+
+    receiveSib();
 }
 
 }
@@ -60,6 +60,15 @@ TEST_F(BtsPortTestSuite, shallHandleSib)
     messageCallback(msg.getMessage());
 }
 
+TEST_F(BtsPortTestSuite, shallHandleSibWithNarrowHeader)
+{
+    // BTS does not know if UE is old one - till UE sends AttachRequest
+    EXPECT_CALL(handlerMock, handleSib(BTS_ID));
+    const common::BinaryMessage narrowSib{{common::get(common::MessageId::Sib), 0, 0,
+                                           0x00, 0xC8, 0x39, 0xBD}};
+    messageCallback(narrowSib);
+}
+
 TEST_F(BtsPortTestSuite, shallHandleAttachAccept)
 {
     EXPECT_CALL(handlerMock, handleAttachAccept());
@@ -82,7 +91,7 @@ TEST_F(BtsPortTestSuite, shallHandleAttachReject)
 
 TEST_F(BtsPortTestSuite, shallSendAttachRequest)
 {
-    common::BinaryMessage msg;
+    common::Frame msg;
     EXPECT_CALL(transportMock, sendMessage(_)).WillOnce([&msg](auto param) { msg = std::move(param); return true; });
     objectUnderTest.sendAttachRequest(BTS_ID);
     common::IncomingMessage reader(msg);
@@ -1,6 +1,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 #include "Ports/TimerPort.hpp"
 #include "Mocks/ILoggerMock.hpp"
 #include "Mocks/ITimerPortMock.hpp"
@@ -10,15 +14,56 @@ namespace ue
 {
 using namespace ::testing;
 
+/**
+ * Tasks of the port owner's thread - run by the test thread
+ */
+class OwnerThreadTasks
+{
+public:
+    void post(std::function<void()> task)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+        posted.notify_all();
+    }
+
+    bool waitAndRunAll(std::chrono::milliseconds timeout)
+    {
+        std::deque<std::function<void()>> tasksToRun;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (not posted.wait_for(lock, timeout, [this] { return not tasks.empty(); }))
+            {
+                return false;
+            }
+            tasksToRun.swap(tasks);
+        }
+        for (auto& task: tasksToRun)
+        {
+            task();
+        }
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable posted;
+    std::deque<std::function<void()>> tasks;
+};
+
 class TimerPortTestSuite : public Test
 {
 protected:
     const common::PhoneNumber PHONE_NUMBER{112};
+    const ITimerPort::Duration DURATION{20};
+    const std::chrono::seconds TIMEOUT{2};
     NiceMock<common::ILoggerMock> loggerMock;
     StrictMock<ITimerEventsHandlerMock> handlerMock;
+    common::TimerService timerService{std::chrono::milliseconds(1)};
+    OwnerThreadTasks ownerThreadTasks;
 
-
-    TimerPort objectUnderTest{loggerMock};
+    TimerPort objectUnderTest{loggerMock, timerService,
+                              [this](std::function<void()> task) { ownerThreadTasks.post(std::move(task)); }};
 
     TimerPortTestSuite()
     {
@@ -34,4 +79,42 @@ TEST_F(TimerPortTestSuite, shallStart)
 {
 }
 
+TEST_F(TimerPortTestSuite, shallHandleTimeoutInOwnerThread)
+{
+    objectUnderTest.startTimer(DURATION);
+
+    EXPECT_CALL(handlerMock, handleTimeout());
+    ASSERT_TRUE(ownerThreadTasks.waitAndRunAll(TIMEOUT));
+}
+
+TEST_F(TimerPortTestSuite, shallNotHandleTimeoutOfStoppedTimer)
+{
+    objectUnderTest.startTimer(DURATION);
+    objectUnderTest.stopTimer();
+
+    ASSERT_FALSE(ownerThreadTasks.waitAndRunAll(2 * DURATION));
+}
+
+TEST_F(TimerPortTestSuite, shallIgnoreTimeoutHandedOverBeforeTimerWasStopped)
+{
+    objectUnderTest.startTimer(DURATION);
+    // timeout handed over, but not yet handled in owner thread - when timer is stopped
+    std::this_thread::sleep_for(3 * DURATION);
+    objectUnderTest.stopTimer();
+
+    ASSERT_TRUE(ownerThreadTasks.waitAndRunAll(TIMEOUT));
+}
+
+TEST_F(TimerPortTestSuite, shallHandleOnlyLastStartedTimer)
+{
+    EXPECT_CALL(handlerMock, handleTimeout());
+
+    objectUnderTest.startTimer(DURATION);
+    std::this_thread::sleep_for(3 * DURATION);
+    objectUnderTest.startTimer(DURATION);
+
+    ASSERT_TRUE(ownerThreadTasks.waitAndRunAll(TIMEOUT));
+    ownerThreadTasks.waitAndRunAll(3 * DURATION);
+}
+
 }
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+#include "UeFarm.hpp"
+#include "Messages/CellLoad.hpp"
+#include "Messages/MessageSchema.hpp"
+#include "PosixTransport/EpollServer.hpp"
+#include "Mocks/ILoggerMock.hpp"
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+namespace ue
+{
+
+namespace schema = common::schema;
+using common::MessageId;
+
+/**
+ * BTS accepting every attach and forwarding messages between attached UEs.
+ * Its load is one percent per attached UE - including those attached before the test.
+ */
+class FakeBts
+{
+public:
+    FakeBts(common::ILogger& logger, std::size_t attachedBefore = 0u)
+        : attachedBefore(attachedBefore),
+          server(std::make_shared<common::EpollServer>(loops, logger))
+    {
+        server->registerConnectionCallback([this](std::shared_ptr<common::ITransport> transport)
+        {
+            auto connection = transport.get();
+            connection->registerMessageCallback([this, connection](Frame message)
+            {
+                handleMessage(*connection, std::move(message));
+            });
+            std::lock_guard<std::mutex> lock(mutex);
+            const std::uint8_t load[] = {static_cast<std::uint8_t>(countAttached())};
+            connection->sendMessage(schema::encode<MessageId::Sib>(PhoneNumber{}, PhoneNumber{}, {common::BtsId{1}}, load));
+            connections.push_back(std::move(transport));
+        });
+        server->listen(0u);
+    }
+    ~FakeBts()
+    {
+        server.reset();
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& connection: connections)
+        {
+            connection->registerMessageCallback(nullptr);
+        }
+    }
+
+    std::uint16_t getPort() const
+    {
+        return server->getPort();
+    }
+
+    std::size_t getLoad()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return countAttached();
+    }
+
+private:
+    std::size_t countAttached() const
+    {
+        return attachedBefore + attached.size();
+    }
+
+    void handleMessage(common::ITransport& connection, Frame message)
+    {
+        auto header = schema::decodeHeader(message.view());
+        std::lock_guard<std::mutex> lock(mutex);
+        if (header.messageId == MessageId::AttachRequest)
+        {
+            attached[header.from.value] = &connection;
+            connection.sendMessage(schema::encode<MessageId::AttachResponse>(PhoneNumber{}, header.from, {true}));
+            return;
+        }
+        auto recipient = attached.find(header.to.value);
+        if (recipient != attached.end())
+        {
+            recipient->second->sendMessage(std::move(message));
+        }
+    }
+
+    const std::size_t attachedBefore;
+    common::EpollLoopPool loops{1u};
+    std::shared_ptr<common::EpollServer> server;
+    std::mutex mutex;
+    std::vector<std::shared_ptr<common::ITransport>> connections;
+    std::map<PhoneNumber::Value, common::ITransport*> attached;
+};
+
+class UeFarmTestSuite : public Test
+{
+protected:
+    const std::size_t NUMBER_OF_UE = 10u;
+    NiceMock<common::ILoggerMock> loggerMock;
+    FakeBts bts{loggerMock};
+    UeFarm::Options options;
+
+    UeFarmTestSuite()
+    {
+        options.port = bts.getPort();
+        options.firstPhoneNumber = PhoneNumber{100};
+        options.numberOfUe = NUMBER_OF_UE;
+    }
+
+    static bool waitUntil(std::function<bool()> condition)
+    {
+        auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (not condition())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(5ms);
+        }
+        return true;
+    }
+};
+
+TEST_F(UeFarmTestSuite, shallAttachAllUe)
+{
+    UeFarm objectUnderTest{loggerMock, options};
+    objectUnderTest.start();
+
+    auto& statistics = objectUnderTest.getStatistics();
+    ASSERT_TRUE(waitUntil([&] { return statistics.attachAccepts == NUMBER_OF_UE; }));
+    ASSERT_EQ(NUMBER_OF_UE, statistics.attachAttempts);
+    ASSERT_EQ(0u, statistics.attachFailures);
+    ASSERT_EQ(0u, statistics.connectFailures);
+}
+
+TEST_F(UeFarmTestSuite, shallSendSmsToPeersWhenAttached)
+{
+    options.script.smsPeriod = 20ms;
+    UeFarm objectUnderTest{loggerMock, options};
+    objectUnderTest.start();
+
+    auto& statistics = objectUnderTest.getStatistics();
+    ASSERT_TRUE(waitUntil([&] { return statistics.smsReceived >= 2u * NUMBER_OF_UE; }));
+    objectUnderTest.stop();
+    ASSERT_GE(statistics.smsSent, statistics.smsReceived);
+}
+
+TEST_F(UeFarmTestSuite, shallAnswerCallRequestsOfPeers)
+{
+    options.script.callPeriod = 20ms;
+    UeFarm objectUnderTest{loggerMock, options};
+    objectUnderTest.start();
+
+    auto& statistics = objectUnderTest.getStatistics();
+    ASSERT_TRUE(waitUntil([&] { return statistics.callsAccepted >= NUMBER_OF_UE; }));
+    objectUnderTest.stop();
+    ASSERT_GE(statistics.callRequestsReceived, statistics.callsAccepted);
+}
+
+TEST_F(UeFarmTestSuite, shallAttachUeToLeastLoadedBts)
+{
+    // 0, 4 and 8 attached before - so 12 new UE even them out
+    constexpr std::size_t NEW_UE = 12u;
+    FakeBts loadedBts{loggerMock, 4u};
+    FakeBts moreLoadedBts{loggerMock, 8u};
+    options.servers = {{"localhost", bts.getPort()}, {"localhost", loadedBts.getPort()}, {"localhost", moreLoadedBts.getPort()}};
+    options.numberOfUe = NEW_UE;
+    // so every UE is attached before the next one reads SIB
+    options.startInterval = 50ms;
+    UeFarm objectUnderTest{loggerMock, options};
+    objectUnderTest.start();
+
+    auto& statistics = objectUnderTest.getStatistics();
+    ASSERT_TRUE(waitUntil([&] { return statistics.attachAccepts == NEW_UE; }));
+    auto uePerServer = objectUnderTest.getUePerServer();
+    ASSERT_EQ(NEW_UE, std::accumulate(uePerServer.begin(), uePerServer.end(), std::size_t{0u}));
+    for (auto* fakeBts: {&bts, &loadedBts, &moreLoadedBts})
+    {
+        ASSERT_THAT(fakeBts->getLoad(), AllOf(Ge(7u), Le(9u)));
+    }
+}
+
+TEST_F(UeFarmTestSuite, shallCountConnectFailures)
+{
+    options.port = 1u;
+    UeFarm objectUnderTest{loggerMock, options};
+    objectUnderTest.start();
+
+    ASSERT_EQ(NUMBER_OF_UE, objectUnderTest.getStatistics().connectFailures);
+}
+
+TEST_F(UeFarmTestSuite, shallNotAcceptPhoneNumbersOutOfRange)
+{
+    options.firstPhoneNumber = PhoneNumber{PhoneNumber::MAX_VALUE - 5u};
+    UeFarm objectUnderTest{loggerMock, options};
+
+    ASSERT_THROW(objectUnderTest.start(), std::invalid_argument);
+}
+
+}
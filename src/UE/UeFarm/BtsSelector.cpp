@@ -0,0 +1,163 @@
+#include "BtsSelector.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include "Messages/CellLoad.hpp"
+#include "Messages/MessageSchema.hpp"
+#include "Messages/NarrowHeader.hpp"
+
+namespace ue
+{
+
+namespace schema = common::schema;
+using common::CellLoad;
+using common::MessageId;
+
+namespace
+{
+
+/**
+ * Filled in the loop thread by transport callbacks - kept alive by them, as they might outlive select()
+ */
+struct Answers
+{
+    explicit Answers(std::size_t numberOfCandidates)
+        : sibs(numberOfCandidates),
+          answered(numberOfCandidates, false)
+    {}
+
+    void sibReceived(std::size_t index, Frame message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (not answered[index])
+        {
+            sibs[index] = std::move(message);
+            answered[index] = true;
+            changed.notify_all();
+        }
+    }
+
+    void disconnected(std::size_t index)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        answered[index] = true;
+        changed.notify_all();
+    }
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::optional<Frame>> sibs;
+    std::vector<bool> answered;
+};
+
+bool isSib(Frame::View message)
+{
+    // with narrow or wide header
+    return not message.empty() and (message[0] & ~schema::WIDE_HEADER_FLAG) == common::get(MessageId::Sib);
+}
+
+/**
+ * @throw IncomingMessage::ReadEx for malformed SIB
+ */
+CellLoad loadOf(Frame sib)
+{
+    if (schema::hasNarrowHeader(sib.view()))
+    {
+        sib = schema::widenHeader(sib.view());
+    }
+    auto load = CellLoad::decode(schema::decode<MessageId::Sib>(sib.view()).trailing);
+    return load.value_or(CellLoad{0u});
+}
+
+}
+
+BtsSelector::BtsSelector(std::vector<BtsEndpoint> candidates, common::ILogger &logger,
+                         std::chrono::milliseconds sibTimeout)
+    : candidates(std::move(candidates)),
+      logger(logger, "[SELECTOR]"),
+      sibTimeout(sibTimeout)
+{}
+
+BtsSelector::Selected BtsSelector::select(common::EpollLoop &loop, PhoneNumber phoneNumber)
+{
+    auto answers = std::make_shared<Answers>(candidates.size());
+    std::vector<std::shared_ptr<common::EpollTransport>> transports(candidates.size());
+    for (std::size_t index = 0u; index < candidates.size(); ++index)
+    {
+        auto& candidate = candidates[index];
+        try
+        {
+            transports[index] = common::EpollTransport::connect(loop, candidate.host, candidate.port, logger);
+        }
+        catch (std::system_error const& ex)
+        {
+            logger.logInfo("BTS not connected: ", candidate.host, ":", candidate.port, ", ", ex.what());
+            answers->disconnected(index);
+            continue;
+        }
+        transports[index]->registerMessageCallback([answers, index](Frame message)
+        {
+            if (isSib(message.view()))
+            {
+                answers->sibReceived(index, std::move(message));
+            }
+        });
+        transports[index]->registerDisconnectedCallback([answers, index] { answers->disconnected(index); });
+        transports[index]->start();
+    }
+
+    std::vector<std::optional<Frame>> sibs;
+    {
+        std::unique_lock<std::mutex> lock(answers->mutex);
+        answers->changed.wait_for(lock, sibTimeout, [&answers]
+        {
+            return std::find(answers->answered.begin(), answers->answered.end(), false) == answers->answered.end();
+        });
+        sibs = answers->sibs;
+    }
+
+    std::optional<std::size_t> selected;
+    CellLoad selectedLoad{};
+    // starting from the phone number - so ties are broken in turn
+    for (std::size_t i = 0u; i < candidates.size(); ++i)
+    {
+        auto index = (phoneNumber.value + i) % candidates.size();
+        if (not sibs[index])
+        {
+            continue;
+        }
+        CellLoad load{};
+        try
+        {
+            load = loadOf(*sibs[index]);
+        }
+        catch (std::exception const& ex)
+        {
+            logger.logError("SIB not decoded from: ", transports[index]->addressToString(), ", ", ex.what());
+            continue;
+        }
+        if (not selected or load.percent < selectedLoad.percent)
+        {
+            selected = index;
+            selectedLoad = load;
+        }
+    }
+
+    for (auto& transport: transports)
+    {
+        if (transport)
+        {
+            transport->registerDisconnectedCallback(nullptr);
+        }
+    }
+    if (not selected)
+    {
+        throw std::system_error(std::make_error_code(std::errc::host_unreachable), "no SIB from any BTS");
+    }
+    logger.logDebug("selected: ", transports[*selected]->addressToString(), ", load: ", selectedLoad);
+    return Selected{*selected, transports[*selected], *sibs[*selected]};
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Logger/PrefixedLogger.hpp"
+#include "Messages/PhoneNumber.hpp"
+#include "Messages/Frame.hpp"
+#include "PosixTransport/EpollTransport.hpp"
+
+namespace ue
+{
+
+using common::Frame;
+using common::PhoneNumber;
+
+struct BtsEndpoint
+{
+    std::string host;
+    std::uint16_t port;
+};
+
+/**
+ * Chooses BTS for UE the way real UE chooses a cell: connects to all candidates, reads the first SIB of each
+ * and keeps the connection to the least loaded one (see CellLoad) - the other connections are dropped.
+ * BTS not announcing its load counts as idle, fully loaded BTS is chosen only when all are full.
+ * Equally loaded BTS are chosen in turn by phone number - so UEs starting together spread over them.
+ */
+class BtsSelector
+{
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_SIB_TIMEOUT{1000};
+
+    struct Selected
+    {
+        std::size_t index;
+        std::shared_ptr<common::EpollTransport> transport;
+        // already received - shall be handled by UE as the first message
+        Frame sib;
+    };
+
+    BtsSelector(std::vector<BtsEndpoint> candidates, common::ILogger& logger,
+                std::chrono::milliseconds sibTimeout = DEFAULT_SIB_TIMEOUT);
+
+    /**
+     * Blocks till every candidate sent SIB, disconnected or sibTimeout elapsed.
+     * Selected transport is started, its callbacks shall be replaced by UE.
+     * @throw std::system_error when no candidate sent SIB
+     */
+    Selected select(common::EpollLoop& loop, PhoneNumber phoneNumber);
+
+private:
+    std::vector<BtsEndpoint> candidates;
+    common::PrefixedLogger logger;
+    std::chrono::milliseconds sibTimeout;
+};
+
+}
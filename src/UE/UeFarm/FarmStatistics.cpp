@@ -0,0 +1,22 @@
+#include "FarmStatistics.hpp"
+#include <ostream>
+
+namespace ue
+{
+
+std::ostream &operator<<(std::ostream &os, const FarmStatistics &statistics)
+{
+    auto value = [](const FarmStatistics::Counter& counter) { return counter.load(std::memory_order_relaxed); };
+    return os << "attach: " << value(statistics.attachAccepts) << "/" << value(statistics.attachAttempts)
+              << " (failed: " << value(statistics.attachFailures) << ")"
+              << ", sms sent: " << value(statistics.smsSent)
+              << ", received: " << value(statistics.smsReceived)
+              << ", calls requested: " << value(statistics.callRequestsSent)
+              << ", received: " << value(statistics.callRequestsReceived)
+              << ", accepted: " << value(statistics.callsAccepted)
+              << ", unknown recipient: " << value(statistics.unknownRecipients)
+              << ", connect failures: " << value(statistics.connectFailures)
+              << ", disconnections: " << value(statistics.disconnections);
+}
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+
+namespace ue
+{
+
+/**
+ * Aggregate counters of all UE of the farm - updated from many threads
+ */
+struct FarmStatistics
+{
+    using Counter = std::atomic<std::uint64_t>;
+
+    Counter connectFailures{0u};
+    Counter disconnections{0u};
+    Counter attachAttempts{0u};
+    Counter attachAccepts{0u};
+    Counter attachFailures{0u};
+    Counter smsSent{0u};
+    Counter smsReceived{0u};
+    Counter callRequestsSent{0u};
+    Counter callRequestsReceived{0u};
+    Counter callsAccepted{0u};
+    Counter unknownRecipients{0u};
+
+    static void increment(Counter& counter)
+    {
+        counter.fetch_add(1u, std::memory_order_relaxed);
+    }
+};
+
+std::ostream& operator<<(std::ostream& os, const FarmStatistics& statistics);
+
+}
@@ -0,0 +1,215 @@
+#include "FarmUe.hpp"
+#include "Messages/MessageSchema.hpp"
+#include "Messages/NarrowHeader.hpp"
+
+namespace ue
+{
+
+namespace schema = common::schema;
+using common::MessageId;
+
+FarmUe::FarmUe(PhoneNumber phoneNumber,
+               PhoneNumber firstPeer,
+               std::size_t numberOfPeers,
+               std::shared_ptr<common::EpollTransport> transport,
+               common::EpollLoop &loop,
+               common::TimerService &timerService,
+               common::ILogger &logger,
+               FarmStatistics &statistics,
+               const Script &script)
+    : phoneNumber(phoneNumber),
+      firstPeer(firstPeer),
+      numberOfPeers(numberOfPeers),
+      transport(std::move(transport)),
+      loop(loop),
+      timerService(timerService),
+      logger(logger, " [phone:" + to_string(phoneNumber) + "]"),
+      statistics(statistics),
+      script(script),
+      random(phoneNumber.value),
+      btsTransport(*this->transport),
+      btsPort(this->logger, btsTransport, phoneNumber),
+      userPort(this->logger, gui, phoneNumber, statistics),
+      timerPort(this->logger, timerService, [&loop](std::function<void()> task) { loop.post(std::move(task)); }),
+      application(phoneNumber, this->logger, btsPort, userPort, timerPort)
+{}
+
+void FarmUe::start(std::optional<Frame> firstMessage)
+{
+    running = true;
+    btsPort.start(application);
+    userPort.start(application);
+    timerPort.start(application);
+
+    transport->registerMessageCallback([this](Frame message) { handleMessage(std::move(message)); });
+    transport->registerDisconnectedCallback([this]
+    {
+        logger.logError("disconnected");
+        FarmStatistics::increment(statistics.disconnections);
+    });
+    transport->start();
+    if (firstMessage)
+    {
+        handleMessage(std::move(*firstMessage));
+    }
+
+    // spread over the period - so the farm does not send in bursts
+    auto randomDelay = [this](std::chrono::milliseconds period)
+    {
+        return std::chrono::milliseconds(std::uniform_int_distribution<long>(0, period.count())(random));
+    };
+    if (script.smsPeriod.count() > 0)
+    {
+        scheduleUserAction(smsTimer, randomDelay(script.smsPeriod), script.smsPeriod, &FarmUe::sendSms);
+    }
+    if (script.callPeriod.count() > 0)
+    {
+        scheduleUserAction(callTimer, randomDelay(script.callPeriod), script.callPeriod, &FarmUe::requestCall);
+    }
+}
+
+void FarmUe::stop()
+{
+    running = false;
+    timerService.cancel(smsTimer);
+    timerService.cancel(callTimer);
+    transport->registerMessageCallback(nullptr);
+    transport->registerDisconnectedCallback(nullptr);
+
+    timerPort.stop();
+    userPort.stop();
+    btsPort.stop();
+}
+
+void FarmUe::handleMessage(Frame message)
+{
+    try
+    {
+        if (schema::hasNarrowHeader(message.view()))
+        {
+            message = schema::widenHeader(message.view());
+        }
+        auto header = schema::decodeHeader(message.view());
+        switch (header.messageId)
+        {
+        case MessageId::Sms:
+            FarmStatistics::increment(statistics.smsReceived);
+            break;
+        case MessageId::CallRequest:
+            FarmStatistics::increment(statistics.callRequestsReceived);
+            transport->sendMessage(schema::encode<MessageId::CallAccepted>(phoneNumber, header.from));
+            break;
+        case MessageId::CallAccepted:
+            FarmStatistics::increment(statistics.callsAccepted);
+            transport->sendMessage(schema::encode<MessageId::CallDropped>(phoneNumber, header.from));
+            break;
+        case MessageId::CallDropped:
+        case MessageId::CallTalk:
+            break;
+        case MessageId::UnknownRecipient:
+            FarmStatistics::increment(statistics.unknownRecipients);
+            break;
+        default:
+            btsTransport.forward(std::move(message));
+        }
+    }
+    catch (std::exception const& ex)
+    {
+        logger.logError("handleMessage error: ", ex.what());
+    }
+}
+
+void FarmUe::scheduleUserAction(common::TimerService::Timer &timer, std::chrono::milliseconds delay,
+                                std::chrono::milliseconds period, UserAction action)
+{
+    // called in the timer service thread - action is done in the loop thread
+    timerService.schedule(timer, delay, [this, &timer, period, action]
+    {
+        loop.post([this, &timer, period, action]
+        {
+            if (not running)
+            {
+                return;
+            }
+            if (gui.getStatus() == HeadlessUeGui::Status::Connected)
+            {
+                (this->*action)();
+            }
+            scheduleUserAction(timer, period, period, action);
+        });
+    });
+}
+
+void FarmUe::sendSms()
+{
+    std::vector<std::uint8_t> text(script.smsLength, 'x');
+    auto peer = choosePeer();
+    logger.logDebug("send SMS to: ", peer);
+    if (transport->sendMessage(schema::encode<MessageId::Sms>(phoneNumber, peer, {}, text)))
+    {
+        FarmStatistics::increment(statistics.smsSent);
+    }
+}
+
+void FarmUe::requestCall()
+{
+    auto peer = choosePeer();
+    logger.logDebug("request call to: ", peer);
+    if (transport->sendMessage(schema::encode<MessageId::CallRequest>(phoneNumber, peer)))
+    {
+        FarmStatistics::increment(statistics.callRequestsSent);
+    }
+}
+
+PhoneNumber FarmUe::choosePeer()
+{
+    if (numberOfPeers < 2u)
+    {
+        return phoneNumber;
+    }
+    // any but itself
+    auto index = std::uniform_int_distribution<std::size_t>(0u, numberOfPeers - 2u)(random);
+    auto peer = PhoneNumber{static_cast<PhoneNumber::Value>(firstPeer.value + index)};
+    if (peer.value >= phoneNumber.value)
+    {
+        ++peer.value;
+    }
+    return peer;
+}
+
+FarmUe::BtsTransport::BtsTransport(common::ITransport &transport)
+    : transport(transport)
+{}
+
+void FarmUe::BtsTransport::registerMessageCallback(MessageCallback callback)
+{
+    messageCallback = std::move(callback);
+}
+
+void FarmUe::BtsTransport::registerDisconnectedCallback(DisconnectedCallback)
+{}
+
+bool FarmUe::BtsTransport::sendMessage(Frame message)
+{
+    return transport.sendMessage(std::move(message));
+}
+
+bool FarmUe::BtsTransport::isCongested() const
+{
+    return transport.isCongested();
+}
+
+std::string FarmUe::BtsTransport::addressToString() const
+{
+    return transport.addressToString();
+}
+
+void FarmUe::BtsTransport::forward(Frame message)
+{
+    if (messageCallback)
+    {
+        messageCallback(std::move(message));
+    }
+}
+
+}
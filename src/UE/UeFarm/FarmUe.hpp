@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <random>
+#include "Application.hpp"
+#include "Ports/BtsPort.hpp"
+#include "Ports/TimerPort.hpp"
+#include "PosixTransport/EpollTransport.hpp"
+#include "Timers/TimerService.hpp"
+#include "FarmStatistics.hpp"
+#include "FarmUserPort.hpp"
+#include "HeadlessUeGui.hpp"
+
+namespace ue
+{
+
+/**
+ * One UE of the farm: ue::Application with its ports, served by one EpollLoop - all its events
+ * (messages, timeouts, user actions) are handled in the loop thread.
+ *
+ * Scripted user sends SMS and requests calls to random peers of the farm, answers every call request
+ * and drops the call as soon as it is accepted - Application does not handle SMS and calls yet,
+ * so this traffic is taken from the transport before BtsPort.
+ */
+class FarmUe
+{
+public:
+    struct Script
+    {
+        // zero - nothing sent
+        std::chrono::milliseconds smsPeriod{0};
+        std::chrono::milliseconds callPeriod{0};
+        std::size_t smsLength = 16u;
+    };
+
+    FarmUe(PhoneNumber phoneNumber,
+           PhoneNumber firstPeer,
+           std::size_t numberOfPeers,
+           std::shared_ptr<common::EpollTransport> transport,
+           common::EpollLoop& loop,
+           common::TimerService& timerService,
+           common::ILogger& logger,
+           FarmStatistics& statistics,
+           const Script& script);
+
+    /**
+     * Shall be called in the loop thread, no task posted by the UE is handled after stop()
+     * @param firstMessage - received before the UE was started (e.g. SIB read by BtsSelector)
+     */
+    void start(std::optional<Frame> firstMessage = std::nullopt);
+    void stop();
+
+private:
+    class BtsTransport : public common::ITransport
+    {
+    public:
+        BtsTransport(common::ITransport& transport);
+
+        void registerMessageCallback(MessageCallback callback) override;
+        void registerDisconnectedCallback(DisconnectedCallback) override;
+        bool sendMessage(Frame message) override;
+        bool isCongested() const override;
+        std::string addressToString() const override;
+
+        void forward(Frame message);
+
+    private:
+        common::ITransport& transport;
+        MessageCallback messageCallback;
+    };
+
+    using UserAction = void (FarmUe::*)();
+
+    void handleMessage(Frame message);
+    void scheduleUserAction(common::TimerService::Timer& timer, std::chrono::milliseconds delay,
+                            std::chrono::milliseconds period, UserAction action);
+    void sendSms();
+    void requestCall();
+    PhoneNumber choosePeer();
+
+    PhoneNumber phoneNumber;
+    PhoneNumber firstPeer;
+    std::size_t numberOfPeers;
+    std::shared_ptr<common::EpollTransport> transport;
+    common::EpollLoop& loop;
+    common::TimerService& timerService;
+    common::PrefixedLogger logger;
+    FarmStatistics& statistics;
+    Script script;
+    std::minstd_rand random;
+
+    BtsTransport btsTransport;
+    HeadlessUeGui gui;
+    BtsPort btsPort;
+    FarmUserPort userPort;
+    TimerPort timerPort;
+    Application application;
+
+    common::TimerService::Timer smsTimer;
+    common::TimerService::Timer callTimer;
+    bool running = false;
+};
+
+}
@@ -0,0 +1,35 @@
+#include "FarmUserPort.hpp"
+
+namespace ue
+{
+
+FarmUserPort::FarmUserPort(common::ILogger &logger, IUeGui &gui, common::PhoneNumber phoneNumber, FarmStatistics &statistics)
+    : UserPort(logger, gui, phoneNumber),
+      statistics(statistics)
+{}
+
+void FarmUserPort::showNotConnected()
+{
+    if (connecting)
+    {
+        FarmStatistics::increment(statistics.attachFailures);
+        connecting = false;
+    }
+    UserPort::showNotConnected();
+}
+
+void FarmUserPort::showConnecting()
+{
+    FarmStatistics::increment(statistics.attachAttempts);
+    connecting = true;
+    UserPort::showConnecting();
+}
+
+void FarmUserPort::showConnected()
+{
+    FarmStatistics::increment(statistics.attachAccepts);
+    connecting = false;
+    UserPort::showConnected();
+}
+
+}
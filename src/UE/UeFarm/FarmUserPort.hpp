@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Ports/UserPort.hpp"
+#include "FarmStatistics.hpp"
+
+namespace ue
+{
+
+/**
+ * UserPort counting what is shown to the user into farm statistics
+ */
+class FarmUserPort : public UserPort
+{
+public:
+    FarmUserPort(common::ILogger& logger, IUeGui& gui, common::PhoneNumber phoneNumber, FarmStatistics& statistics);
+
+    void showNotConnected() override;
+    void showConnecting() override;
+    void showConnected() override;
+
+private:
+    FarmStatistics& statistics;
+    bool connecting = false;
+};
+
+}
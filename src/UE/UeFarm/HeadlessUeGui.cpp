@@ -0,0 +1,117 @@
+#include "HeadlessUeGui.hpp"
+
+namespace ue
+{
+
+void HeadlessUeGui::setCloseGuard(CloseGuard)
+{}
+
+void HeadlessUeGui::setAcceptCallback(Callback)
+{}
+
+void HeadlessUeGui::setRejectCallback(Callback)
+{}
+
+void HeadlessUeGui::setTitle(const std::string&)
+{}
+
+void HeadlessUeGui::showConnected()
+{
+    status = Status::Connected;
+}
+
+void HeadlessUeGui::showConnecting()
+{
+    status = Status::Connecting;
+}
+
+void HeadlessUeGui::showNotConnected()
+{
+    status = Status::NotConnected;
+}
+
+void HeadlessUeGui::showNewSms(bool)
+{}
+
+void HeadlessUeGui::showPeerUserNotAvailable(PhoneNumber)
+{}
+
+IUeGui::IListViewMode &HeadlessUeGui::setListViewMode()
+{
+    // menu is shown only when connected - see UserPort::showConnected
+    status = Status::Connected;
+    return *this;
+}
+
+IUeGui::ISmsComposeMode &HeadlessUeGui::setSmsComposeMode()
+{
+    return *this;
+}
+
+IUeGui::IDialMode &HeadlessUeGui::setDialMode()
+{
+    return *this;
+}
+
+IUeGui::ICallMode &HeadlessUeGui::setCallMode()
+{
+    return *this;
+}
+
+IUeGui::ITextMode &HeadlessUeGui::setAlertMode()
+{
+    return *this;
+}
+
+IUeGui::ITextMode &HeadlessUeGui::setViewTextMode()
+{
+    return *this;
+}
+
+IUeGui::IListViewMode::OptionalSelection HeadlessUeGui::getCurrentItemIndex() const
+{
+    return {false, 0u};
+}
+
+void HeadlessUeGui::addSelectionListItem(const std::string&, const std::string&)
+{}
+
+void HeadlessUeGui::clearSelectionList()
+{}
+
+PhoneNumber HeadlessUeGui::getPhoneNumber() const
+{
+    return {};
+}
+
+std::string HeadlessUeGui::getSmsText() const
+{
+    return {};
+}
+
+void HeadlessUeGui::clearSmsText()
+{}
+
+void HeadlessUeGui::appendIncomingText(const std::string&)
+{}
+
+void HeadlessUeGui::clearIncomingText()
+{}
+
+void HeadlessUeGui::clearOutgoingText()
+{}
+
+std::string HeadlessUeGui::getOutgoingText() const
+{
+    return {};
+}
+
+void HeadlessUeGui::setText(const std::string&)
+{}
+
+HeadlessUeGui::Status HeadlessUeGui::getStatus() const
+{
+    return status;
+}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "IUeGui.hpp"
+#include "UeGui/IListViewMode.hpp"
+#include "UeGui/ISmsComposeMode.hpp"
+#include "UeGui/IDialMode.hpp"
+#include "UeGui/ICallMode.hpp"
+#include "UeGui/ITextMode.hpp"
+
+namespace ue
+{
+
+/**
+ * IUeGui without any window - it only keeps the connection status shown,
+ * nothing is typed into it.
+ */
+class HeadlessUeGui : public IUeGui,
+                      public IUeGui::IListViewMode,
+                      public IUeGui::ISmsComposeMode,
+                      public IUeGui::IDialMode,
+                      public IUeGui::ICallMode,
+                      public IUeGui::ITextMode
+{
+public:
+    enum class Status
+    {
+        NotConnected,
+        Connecting,
+        Connected
+    };
+
+    // IUeGui interface
+    void setCloseGuard(CloseGuard closeGuard) override;
+    void setAcceptCallback(Callback callback) override;
+    void setRejectCallback(Callback callback) override;
+
+    void setTitle(const std::string& title) override;
+    void showConnected() override;
+    void showConnecting() override;
+    void showNotConnected() override;
+    void showNewSms(bool present) override;
+    void showPeerUserNotAvailable(PhoneNumber) override;
+
+    IUeGui::IListViewMode& setListViewMode() override;
+    IUeGui::ISmsComposeMode& setSmsComposeMode() override;
+    IUeGui::IDialMode& setDialMode() override;
+    IUeGui::ICallMode& setCallMode() override;
+    IUeGui::ITextMode& setAlertMode() override;
+    IUeGui::ITextMode& setViewTextMode() override;
+
+    // IListViewMode interface
+    OptionalSelection getCurrentItemIndex() const override;
+    void addSelectionListItem(const std::string& label, const std::string& tooltip) override;
+    void clearSelectionList() override;
+
+    // ISmsComposeMode, IDialMode interfaces
+    PhoneNumber getPhoneNumber() const override;
+    std::string getSmsText() const override;
+    void clearSmsText() override;
+
+    // ICallMode interface
+    void appendIncomingText(const std::string& text) override;
+    void clearIncomingText() override;
+    void clearOutgoingText() override;
+    std::string getOutgoingText() const override;
+
+    // ITextMode interface
+    void setText(const std::string& text) override;
+
+    Status getStatus() const;
+
+private:
+    Status status = Status::NotConnected;
+};
+
+}
@@ -0,0 +1,130 @@
+#include <pthread.h>
+#include <signal.h>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include "Config/MultiLineConfig.hpp"
+#include "Logger/AsyncLogger.hpp"
+#include "UeFarm.hpp"
+
+namespace
+{
+
+sigset_t blockTerminationSignals()
+{
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    return signals;
+}
+
+/**
+ * @param servers - host:port,host:port...
+ * @throw std::logic_error for host:port not parsed
+ */
+std::vector<ue::BtsEndpoint> parseServers(const std::string& servers)
+{
+    std::vector<ue::BtsEndpoint> endpoints;
+    std::istringstream input(servers);
+    std::string server;
+    while (std::getline(input, server, ','))
+    {
+        auto colon = server.rfind(':');
+        if (colon == std::string::npos)
+        {
+            throw std::invalid_argument("no port in: " + server);
+        }
+        auto port = std::stoul(server.substr(colon + 1u));
+        if (port == 0u or port > std::numeric_limits<std::uint16_t>::max())
+        {
+            throw std::out_of_range("port out of range in: " + server);
+        }
+        endpoints.push_back(ue::BtsEndpoint{server.substr(0u, colon), static_cast<std::uint16_t>(port)});
+    }
+    return endpoints;
+}
+
+void printUePerServer(const ue::UeFarm::Options& options, const ue::UeFarm& farm)
+{
+    auto uePerServer = farm.getUePerServer();
+    for (std::size_t index = 0u; index < uePerServer.size(); ++index)
+    {
+        std::cout << "  " << options.servers[index].host << ":" << options.servers[index].port
+                  << " UEs: " << uePerServer[index] << std::endl;
+    }
+}
+
+}
+
+/**
+ * @example UeFarm server=localhost port=8181 phone=1 count=200 io_threads=2 sms_period_ms=1000 duration_s=60
+ * @example UeFarm servers=localhost:8181,localhost:8191,localhost:8201 phone=1 count=300 start_interval_ms=10
+ *          every UE attaches to the least loaded BTS - run them with max_attached (and/or max_forward_rate) set
+ */
+int main(int argc, char* argv[])
+{
+    // blocked before any thread is started - so all threads inherit it
+    auto terminationSignals = blockTerminationSignals();
+
+    common::MultiLineConfig configuration(argc - 1, argv + 1);
+    ue::UeFarm::Options options;
+    options.server = configuration.getString("server", options.server);
+    options.port = configuration.getNumber<std::uint16_t>("port", options.port);
+    try
+    {
+        options.servers = parseServers(configuration.getString("servers", ""));
+    }
+    catch (std::logic_error const& ex)
+    {
+        std::cerr << "servers shall be host:port,host:port... - " << ex.what() << std::endl;
+        return 1;
+    }
+    options.firstPhoneNumber.value = configuration.getNumber<ue::PhoneNumber::Value>("phone", options.firstPhoneNumber.value);
+    options.numberOfUe = configuration.getNumber<std::size_t>("count", options.numberOfUe);
+    options.ioThreads = configuration.getNumber<std::size_t>("io_threads", options.ioThreads);
+    options.startInterval = std::chrono::milliseconds(configuration.getNumber<long>("start_interval_ms", 0));
+    options.script.smsPeriod = std::chrono::milliseconds(configuration.getNumber<long>("sms_period_ms", 0));
+    options.script.callPeriod = std::chrono::milliseconds(configuration.getNumber<long>("call_period_ms", 0));
+    options.script.smsLength = configuration.getNumber<std::size_t>("sms_length", options.script.smsLength);
+    auto duration = configuration.getNumber<long>("duration_s", 0);
+    auto reportPeriod = configuration.getNumber<long>("report_period_s", 5);
+
+    // all UEs log into one file - console is for the reports only
+    std::ofstream logFile(configuration.getString("log", "UeFarm.log"));
+    common::AsyncLogger logger({{"[DEBUG]", {&logFile}}, {"", {&logFile}}, {"[ERROR]", {&logFile}}});
+    logger.setMinimumLevel(configuration.getNumber<common::ILogger::Level>("log_level", common::ILogger::INFO_LEVEL));
+
+    ue::UeFarm farm(logger, options);
+    try
+    {
+        farm.start();
+    }
+    catch (std::exception const& ex)
+    {
+        std::cerr << "UeFarm not started: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    // till SIGINT/SIGTERM, or duration_s (when given) elapsed
+    long elapsed = 0;
+    while (duration <= 0 or elapsed < duration)
+    {
+        auto wait = duration > 0 ? std::min(reportPeriod, duration - elapsed) : reportPeriod;
+        timespec timeout{wait, 0};
+        if (sigtimedwait(&terminationSignals, nullptr, &timeout) >= 0)
+        {
+            break;
+        }
+        elapsed += wait;
+        std::cout << "[" << elapsed << "s] " << farm.getStatistics() << std::endl;
+        printUePerServer(options, farm);
+    }
+
+    farm.stop();
+    std::cout << "final: " << farm.getStatistics() << std::endl;
+    return 0;
+}
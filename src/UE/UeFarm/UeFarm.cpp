@@ -0,0 +1,127 @@
+#include "UeFarm.hpp"
+#include <future>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include "PosixTransport/EpollTransport.hpp"
+
+namespace ue
+{
+
+UeFarm::UeFarm(common::ILogger &logger, const Options &options)
+    : logger(logger, "[FARM]"),
+      options(options),
+      loops(options.ioThreads),
+      selector(options.servers, logger),
+      uePerServer(options.servers.size(), 0u)
+{}
+
+UeFarm::~UeFarm()
+{
+    stop();
+}
+
+void UeFarm::start()
+{
+    if (options.firstPhoneNumber.value < PhoneNumber::MIN_VALUE
+        or options.numberOfUe > std::size_t{PhoneNumber::MAX_VALUE} - options.firstPhoneNumber.value + 1u)
+    {
+        throw std::invalid_argument("UE farm phone numbers out of range");
+    }
+    PhoneNumber lastPhoneNumber{static_cast<PhoneNumber::Value>(options.firstPhoneNumber.value + options.numberOfUe - 1u)};
+    logger.logInfo("starting ", options.numberOfUe, " UEs: ", options.firstPhoneNumber, "..", lastPhoneNumber);
+
+    ues.reserve(options.numberOfUe);
+    for (std::size_t i = 0u; i < options.numberOfUe; ++i)
+    {
+        PhoneNumber phoneNumber{static_cast<PhoneNumber::Value>(options.firstPhoneNumber.value + i)};
+        auto& loop = loops.next();
+        std::shared_ptr<common::EpollTransport> transport;
+        std::optional<Frame> firstMessage;
+        try
+        {
+            transport = connect(loop, phoneNumber, firstMessage);
+        }
+        catch (std::system_error const& ex)
+        {
+            logger.logError("UE ", phoneNumber, " not connected: ", ex.what());
+            FarmStatistics::increment(statistics.connectFailures);
+            continue;
+        }
+
+        auto ue = std::make_unique<FarmUe>(phoneNumber, options.firstPhoneNumber, options.numberOfUe,
+                                           std::move(transport), loop, timerService, logger,
+                                           statistics, options.script);
+        loop.post([ue = ue.get(), firstMessage = std::move(firstMessage)] { ue->start(firstMessage); });
+        ues.push_back(RunningUe{loop, std::move(ue)});
+
+        if (options.startInterval.count() > 0)
+        {
+            std::this_thread::sleep_for(options.startInterval);
+        }
+    }
+}
+
+void UeFarm::stop()
+{
+    if (ues.empty())
+    {
+        return;
+    }
+    logger.logInfo("stopping ", ues.size(), " UEs");
+    // tasks posted before stop (e.g. timeouts) still find their UEs alive - UEs are destroyed in the next round
+    runInLoopsAndWait([](RunningUe& running) { running.ue->stop(); });
+    runInLoopsAndWait([](RunningUe& running) { running.ue.reset(); });
+    ues.clear();
+}
+
+const FarmStatistics &UeFarm::getStatistics() const
+{
+    return statistics;
+}
+
+std::vector<std::size_t> UeFarm::getUePerServer() const
+{
+    return uePerServer;
+}
+
+std::shared_ptr<common::EpollTransport> UeFarm::connect(common::EpollLoop &loop, PhoneNumber phoneNumber,
+                                                        std::optional<Frame>& firstMessage)
+{
+    if (options.servers.size() < 2u)
+    {
+        auto server = options.servers.empty() ? BtsEndpoint{options.server, options.port} : options.servers.front();
+        auto transport = common::EpollTransport::connect(loop, server.host, server.port, logger);
+        if (not uePerServer.empty())
+        {
+            ++uePerServer.front();
+        }
+        return transport;
+    }
+    auto selected = selector.select(loop, phoneNumber);
+    ++uePerServer[selected.index];
+    firstMessage = std::move(selected.sib);
+    return std::move(selected.transport);
+}
+
+void UeFarm::runInLoopsAndWait(std::function<void(RunningUe&)> task)
+{
+    std::vector<std::future<void>> done;
+    done.reserve(ues.size());
+    for (auto& running: ues)
+    {
+        auto finished = std::make_shared<std::promise<void>>();
+        done.push_back(finished->get_future());
+        running.loop.post([&running, &task, finished]
+        {
+            task(running);
+            finished->set_value();
+        });
+    }
+    for (auto& future: done)
+    {
+        future.wait();
+    }
+}
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Logger/PrefixedLogger.hpp"
+#include "PosixTransport/EpollLoop.hpp"
+#include "Timers/TimerService.hpp"
+#include "BtsSelector.hpp"
+#include "FarmStatistics.hpp"
+#include "FarmUe.hpp"
+
+namespace ue
+{
+
+/**
+ * Many UEs in one process - each with its own connection to BTS, all served by a few EpollLoops
+ * and one TimerService.
+ */
+class UeFarm
+{
+public:
+    struct Options
+    {
+        std::string server = "localhost";
+        std::uint16_t port = 8181u;
+        // when more than one - every UE connects to the least loaded of them (see BtsSelector), not to server:port
+        std::vector<BtsEndpoint> servers;
+        PhoneNumber firstPhoneNumber{1};
+        std::size_t numberOfUe = 100u;
+        std::size_t ioThreads = 2u;
+        // between connecting consecutive UEs - so BTS is not flooded with attach requests
+        std::chrono::milliseconds startInterval{0};
+        FarmUe::Script script;
+    };
+
+    UeFarm(common::ILogger& logger, const Options& options);
+    ~UeFarm();
+
+    /**
+     * UEs not connected are counted as FarmStatistics::connectFailures
+     * @throw std::invalid_argument for phone numbers out of range
+     */
+    void start();
+    void stop();
+
+    const FarmStatistics& getStatistics() const;
+    /**
+     * @return number of UEs connected to each of Options::servers - when selected from many
+     */
+    std::vector<std::size_t> getUePerServer() const;
+
+private:
+    struct RunningUe
+    {
+        common::EpollLoop& loop;
+        std::unique_ptr<FarmUe> ue;
+    };
+
+    void runInLoopsAndWait(std::function<void(RunningUe&)> task);
+    std::shared_ptr<common::EpollTransport> connect(common::EpollLoop& loop, PhoneNumber phoneNumber,
+                                                    std::optional<Frame>& firstMessage);
+
+    common::PrefixedLogger logger;
+    Options options;
+    FarmStatistics statistics;
+    common::EpollLoopPool loops;
+    common::TimerService timerService;
+    BtsSelector selector;
+    std::vector<RunningUe> ues;
+    std::vector<std::size_t> uePerServer;
+};
+
+}
@@ -17,7 +17,8 @@ int main(int argc, char* argv[])
 
     BtsPort bts(logger, tranport, phoneNumber);
     UserPort user(logger, gui, phoneNumber);
-    TimerPort timer(logger);
+    common::TimerService timerService;
+    TimerPort timer(logger, timerService, [&appEnv](std::function<void()> task) { appEnv->runInMessageLoop(std::move(task)); });
     Application app(phoneNumber, logger, bts, user, timer);
     bts.start(app);
     user.start(app);
@@ -3,6 +3,10 @@ macro(set_compiler_options)
 # add_definitions(-std=c++14)
 set(CMAKE_CXX_STANDARD 20)
 set(CMAKE_CXX_FLAGS "-g -Og ${CMAKE_CXX_FLAGS}")
+option(STRIP_DEBUG_LOGS "Remove logDebug() calls at compile time" OFF)
+if(STRIP_DEBUG_LOGS)
+add_definitions(-DCOMMON_LOGGER_STRIP_DEBUG)
+endif()
 endmacro()
 
 macro(set_qt_options)
@@ -40,3 +44,11 @@ file(COPY ${IMAGES_DIRECTORY}/images DESTINATION .)
 endmacro()
 
 
+
+macro(set_benchmark_options)
+include_directories(${COMMON_DIR}/Benchmarks)
+endmacro()
+
+macro(target_link_benchmark)
+target_link_libraries(${PROJECT_NAME} CommonBenchmarkTools)
+endmacro()